@@ -133,7 +133,7 @@ static optiga_lib_status_t __get_chip_cert(uint16_t cert_oid,
 		}
 
 		//Get end entity device certificate
-		status = optiga_util_read_data(cert_oid, 0, p_tmp_cert_pointer, p_cert_size);
+		status = optiga_util_read_data(&optiga_comms, cert_oid, 0, p_tmp_cert_pointer, p_cert_size);
 		if(OPTIGA_LIB_SUCCESS != status)
 		{
 			break;
@@ -216,7 +216,7 @@ static optiga_lib_status_t __authenticate_chip(uint8_t* p_pubkey, uint16_t pubke
         }
 
 		//Sign random with OPTIGA™ Trust X
-        status = optiga_crypt_ecdsa_sign(digest, LENGTH_SHA256,
+        status = optiga_crypt_ecdsa_sign(&optiga_comms, digest, LENGTH_SHA256,
 									     privkey_oid,
 										 signature, &signature_size);
         if (OPTIGA_LIB_SUCCESS != status)
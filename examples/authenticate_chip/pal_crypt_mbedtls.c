@@ -258,7 +258,7 @@ optiga_lib_status_t pal_crypt_init(void)
 	mbedtls_entropy_init( &entropy );
 	uint8_t personalization[32];
 
-	optiga_crypt_random(eDRNG, personalization, 32);
+	optiga_crypt_random(&optiga_comms, eDRNG, personalization, 32);
 
 	mbedtls_ctr_drbg_init( &ctr_drbg );
 
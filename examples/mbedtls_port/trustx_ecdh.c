@@ -60,7 +60,7 @@ int mbedtls_ecdh_gen_public( mbedtls_ecp_group *grp, mbedtls_mpi *d, mbedtls_ecp
 	grp->id == MBEDTLS_ECP_DP_SECP256R1 ? ( curve_id = OPTIGA_ECC_NIST_P_256 )
                                                 : ( curve_id = OPTIGA_ECC_NIST_P_384 );
     //invoke optiga command to generate a key pair.
-	status = optiga_crypt_ecc_generate_keypair( curve_id,
+	status = optiga_crypt_ecc_generate_keypair(&optiga_comms, curve_id,
                                                 (optiga_key_usage_t)( OPTIGA_KEY_USAGE_KEY_AGREEMENT | OPTIGA_KEY_USAGE_AUTHENTICATION ),
 												FALSE,
 												&optiga_key_id,
@@ -122,7 +122,7 @@ int mbedtls_ecdh_compute_shared( mbedtls_ecp_group *grp, mbedtls_mpi *z,
 		publickey.length = public_key_length + 3;
 
         //Invoke optiga command to generate shared secret and store in the OID/buffer.
-        status = optiga_crypt_ecdh(OPTIGA_KEY_STORE_ID_E0F3,
+        status = optiga_crypt_ecdh(&optiga_comms, OPTIGA_KEY_STORE_ID_E0F3,
         						   &publickey,
         						   1,
                                    buf);
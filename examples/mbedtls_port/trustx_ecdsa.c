@@ -51,7 +51,7 @@ int mbedtls_ecdsa_sign( mbedtls_ecp_group *grp, mbedtls_mpi *r, mbedtls_mpi *s,
     unsigned char *p = der_signature;
     const unsigned char *end = der_signature + dslen;
 
-    if(optiga_crypt_ecdsa_sign((unsigned char *)buf, blen, CONFIG_OPTIGA_TRUST_X_PRIVKEY_SLOT, der_signature, &dslen) != OPTIGA_LIB_SUCCESS)
+    if(optiga_crypt_ecdsa_sign(&optiga_comms, (unsigned char *)buf, blen, CONFIG_OPTIGA_TRUST_X_PRIVKEY_SLOT, der_signature, &dslen) != OPTIGA_LIB_SUCCESS)
     {
 		ret = MBEDTLS_ERR_PK_BAD_INPUT_DATA;
 		goto cleanup;
@@ -123,7 +123,7 @@ int mbedtls_ecdsa_verify( mbedtls_ecp_group *grp,
         blen = truncated_hash_length;
     }
 
-    status = optiga_crypt_ecdsa_verify ( (uint8_t *) buf, blen,
+    status = optiga_crypt_ecdsa_verify (&optiga_comms, (uint8_t *) buf, blen,
                                          (uint8_t *) p, signature_len,
 										 OPTIGA_CRYPT_HOST_DATA, (void *)&public_key );
     if ( status != OPTIGA_LIB_SUCCESS )
@@ -157,7 +157,7 @@ int mbedtls_ecdsa_genkey( mbedtls_ecdsa_context *ctx, mbedtls_ecp_group_id gid,
     grp->id == MBEDTLS_ECP_DP_SECP256R1 ? ( curve_id = OPTIGA_ECC_NIST_P_256 )
                                         : ( curve_id = OPTIGA_ECC_NIST_P_384 ); 
     //invoke optiga command to generate a key pair.
-    status = optiga_crypt_ecc_generate_keypair( curve_id,
+    status = optiga_crypt_ecc_generate_keypair(&optiga_comms, curve_id,
                                                 (optiga_key_usage_t)( OPTIGA_KEY_USAGE_KEY_AGREEMENT | OPTIGA_KEY_USAGE_AUTHENTICATION ),
                                                 FALSE,
                                                 &privkey_oid,
@@ -60,7 +60,7 @@ optiga_lib_status_t example_optiga_crypt_ecc_generate_keypair(void)
         optiga_key_id = OPTIGA_KEY_STORE_ID_E0F1;
         //for Session based, use OPTIGA_KEY_ID_SESSION_BASED as key id as shown below.
         //optiga_key_id = OPTIGA_KEY_ID_SESSION_BASED;
-        return_status = optiga_crypt_ecc_generate_keypair(OPTIGA_ECC_NIST_P_256,
+        return_status = optiga_crypt_ecc_generate_keypair(&optiga_comms, OPTIGA_ECC_NIST_P_256,
                                                           (uint8_t)OPTIGA_KEY_USAGE_SIGN,
                                                           FALSE,
 														  &optiga_key_id,
@@ -84,7 +84,7 @@ optiga_lib_status_t example_optiga_crypt_ecdh(void)
          *       - Export Public Key
          */
         optiga_key_id = OPTIGA_SESSION_ID_E100;
-        return_status = optiga_crypt_ecc_generate_keypair(OPTIGA_ECC_NIST_P_256,
+        return_status = optiga_crypt_ecc_generate_keypair(&optiga_comms, OPTIGA_ECC_NIST_P_256,
                                                           (uint8_t)OPTIGA_KEY_USAGE_KEY_AGREEMENT,
                                                           FALSE,
                                                           &optiga_key_id,
@@ -103,7 +103,7 @@ optiga_lib_status_t example_optiga_crypt_ecdh(void)
          *       - Provide the peer public key details
          *       - Export the generated shared secret
          */
-        return_status = optiga_crypt_ecdh(optiga_key_id,
+        return_status = optiga_crypt_ecdh(&optiga_comms, optiga_key_id,
                                           &peer_public_key_details, 
                                           TRUE,
                                           shared_secret);
@@ -63,7 +63,7 @@ optiga_lib_status_t example_optiga_crypt_ecdsa_sign(void)
          * Sign the digest -
          *       - Use Private key from Key Store ID E0F0 
          */
-        return_status = optiga_crypt_ecdsa_sign(digest,
+        return_status = optiga_crypt_ecdsa_sign(&optiga_comms, digest,
                                                 sizeof(digest),
 												OPTIGA_KEY_STORE_ID_E0F0,
                                                 signature, 
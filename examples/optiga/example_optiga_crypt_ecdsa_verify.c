@@ -98,7 +98,7 @@ optiga_lib_status_t example_optiga_crypt_ecdsa_verify(void)
     do
     {
 
-        return_status = optiga_crypt_ecdsa_verify (digest,
+        return_status = optiga_crypt_ecdsa_verify (&optiga_comms, digest,
                                                    sizeof(digest),
                                                    signature,
                                                    sizeof(signature),
@@ -70,7 +70,7 @@ optiga_lib_status_t example_optiga_crypt_hash(void)
                                  sizeof(hash_context_buffer),OPTIGA_HASH_TYPE_SHA_256);
 
         //Hash start
-        return_status = optiga_crypt_hash_start(&hash_context);
+        return_status = optiga_crypt_hash_start(&optiga_comms, &hash_context);
         if(return_status != OPTIGA_LIB_SUCCESS)
         {
             break;
@@ -80,7 +80,7 @@ optiga_lib_status_t example_optiga_crypt_hash(void)
         hash_data_host.buffer = data_to_hash;
         hash_data_host.length = sizeof(data_to_hash);
 
-        return_status = optiga_crypt_hash_update(&hash_context,
+        return_status = optiga_crypt_hash_update(&optiga_comms, &hash_context,
         		                                 // OPTIGA_CRYPT_OID_DATA stands for OID
         										 OPTIGA_CRYPT_HOST_DATA,
                                                  &hash_data_host);
@@ -90,7 +90,7 @@ optiga_lib_status_t example_optiga_crypt_hash(void)
         }
 
         // hash finalize
-        return_status = optiga_crypt_hash_finalize(&hash_context,
+        return_status = optiga_crypt_hash_finalize(&optiga_comms, &hash_context,
                                                    digest);
 
         if(return_status != OPTIGA_LIB_SUCCESS)
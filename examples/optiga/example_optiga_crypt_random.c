@@ -51,7 +51,7 @@ optiga_lib_status_t example_optiga_crypt_random(void)
          * Generate Random -
          *       - Specify the Random type as TRNG
          */
-        return_status = optiga_crypt_random(OPTIGA_RNG_TYPE_TRNG, 
+        return_status = optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, 
                                             random_data_buffer,
                                             sizeof(random_data_buffer));
 
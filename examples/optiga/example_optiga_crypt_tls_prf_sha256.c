@@ -95,7 +95,7 @@ optiga_lib_status_t example_optiga_crypt_tls_prf_sha256(void)
          *       - Export Public Key
          */
         optiga_key_id = OPTIGA_SESSION_ID_E100;
-        return_status = optiga_crypt_ecc_generate_keypair(OPTIGA_ECC_NIST_P_256,
+        return_status = optiga_crypt_ecc_generate_keypair(&optiga_comms, OPTIGA_ECC_NIST_P_256,
                                                           (uint8_t)OPTIGA_KEY_USAGE_KEY_AGREEMENT,
                                                           FALSE,
                                                           &optiga_key_id,
@@ -114,7 +114,7 @@ optiga_lib_status_t example_optiga_crypt_tls_prf_sha256(void)
          *       - Provide the peer public key details
          *       - Export the generated shared secret
          */
-        return_status = optiga_crypt_ecdh(optiga_key_id,
+        return_status = optiga_crypt_ecdh(&optiga_comms, optiga_key_id,
                                           &peer_public_key_details,
                                           FALSE,
 										  (uint8_t *)&optiga_key_id);
@@ -128,7 +128,7 @@ optiga_lib_status_t example_optiga_crypt_tls_prf_sha256(void)
          * Derive key (e.g. decryption key) using optiga_crypt_tls_prf_sha256 with I2C communication.
          *       - Use shared secret from F1D0 data object
          */
-        return_status = optiga_crypt_tls_prf_sha256(optiga_key_id, /* Input secret OID */
+        return_status = optiga_crypt_tls_prf_sha256(&optiga_comms, optiga_key_id, /* Input secret OID */
                                                     label,
                                                     sizeof(label),
                                                     random_seed,
@@ -58,7 +58,7 @@ optiga_lib_status_t example_optiga_util_read_data(void)
          * 1. Read data from a data object (e.g. certificate data object)
          *    using optiga_util_read_data.
          */
-        return_status = optiga_util_read_data(optiga_oid,
+        return_status = optiga_util_read_data(&optiga_comms, optiga_oid,
                                               offset,
                                               read_data_buffer,
                                               &bytes_to_read);
@@ -75,7 +75,7 @@ optiga_lib_status_t example_optiga_util_read_data(void)
          */
         optiga_oid = eDEVICE_PUBKEY_CERT_IFX;
         bytes_to_read = sizeof(read_data_buffer);
-        return_status = optiga_util_read_metadata(optiga_oid,
+        return_status = optiga_util_read_metadata(&optiga_comms, optiga_oid,
                                                   read_data_buffer,
                                                   &bytes_to_read);
 
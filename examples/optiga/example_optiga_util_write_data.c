@@ -112,7 +112,7 @@ optiga_lib_status_t example_optiga_util_write_data(void)
     {
         /* 0. FW version before 1.40.1118 doesn't support update of the Trust Anchor
         */
-        return_status = optiga_util_read_data(eCOPROCESSOR_UID,
+        return_status = optiga_util_read_data(&optiga_comms, eCOPROCESSOR_UID,
         									  0x00,
 											  coprocessor_uid,
 											  &coprocessor_uid_len);
@@ -124,7 +124,7 @@ optiga_lib_status_t example_optiga_util_write_data(void)
 			offset = 0x00;
 			// Maximum Power, Minimum Power limitation
 			uint8_t current_limit = 15;
-			return_status = optiga_util_write_data(optiga_oid,
+			return_status = optiga_util_write_data(&optiga_comms, optiga_oid,
 												   OPTIGA_UTIL_WRITE_ONLY,
 												   offset,
 												   &current_limit,
@@ -147,7 +147,7 @@ optiga_lib_status_t example_optiga_util_write_data(void)
          */
         optiga_oid = 0xE0E8;
         offset = 0x00;
-        return_status = optiga_util_write_data(optiga_oid,
+        return_status = optiga_util_write_data(&optiga_comms, optiga_oid,
         									   OPTIGA_UTIL_ERASE_AND_WRITE,
                                                offset,
                                                trust_anchor, 
@@ -168,7 +168,7 @@ optiga_lib_status_t example_optiga_util_write_data(void)
          * Sample metadata: write "Read" access condition as LcsO < Operational
          *
          */
-        return_status = optiga_util_write_metadata(0xE0E8,
+        return_status = optiga_util_write_metadata(&optiga_comms, 0xE0E8,
                                                    metadata,
                                                    sizeof(metadata));
 
@@ -19,7 +19,7 @@ int mbedtls_hardware_poll( void *data,
 
 	optiga_lib_status_t status = OPTIGA_LIB_ERROR;
 
-	status = optiga_crypt_random(eTRNG, output, len);
+	status = optiga_crypt_random(&optiga_comms, eTRNG, output, len);
 	if ( status !=  OPTIGA_LIB_SUCCESS)
 	{
 		*olen = 0;
@@ -34,6 +34,8 @@
 #include "optiga/common/Util.h"
 #include "optiga/cmd/CommandLib.h"
 #include "optiga/common/MemoryMgmt.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_event.h"
 
 #ifdef USE_CMDLIB_WITH_RTOS
 #include "optiga/pal/pal_os_timer.h"
@@ -41,10 +43,8 @@
 
 /// @cond hidden
 
-static optiga_comms_t* p_optiga_comms;
-
 ///Maximum size of buffer, considering Maximum size of arbitrary data (1500) and header bytes
-#define MAX_APDU_BUFF_LEN           	1558
+#define MAX_APDU_BUFF_LEN           	CMD_LIB_APDU_BUFFER_SIZE
 	
 ///Get Data Parameter
 #define PARAM_GET_DATA              	0x00
@@ -215,7 +215,7 @@ static optiga_comms_t* p_optiga_comms;
 #define TAG_CERTIFICATE_OID             0x32
 
 ///Invalid value for Max size of comms buffer
-#define INVALID_MAX_COMMS_BUFF_SIZE     0xFFFF
+#define INVALID_MAX_COMMS_BUFF_SIZE     0x0000
 
 ///Tag for digest
 #define TAG_DIGEST                      0x01
@@ -271,10 +271,6 @@ static optiga_comms_t* p_optiga_comms;
 ///Error in security chip indicating data out of boundary
 #define ERR_DATA_OUT_OF_BOUND           0x00000008    
 
-//Maximum size of the communication buffer
-/*lint --e{552} suppress "Temporary" */
-uint16_t wMaxCommsBuffer = INVALID_MAX_COMMS_BUFF_SIZE;
-
 //Finds minimum amongst the given 2 value
 #define MIN(a,b) ((a<b)?a:b)
 
@@ -288,41 +284,26 @@ uint16_t wMaxCommsBuffer = INVALID_MAX_COMMS_BUFF_SIZE;
 #define ECC_NIST_P_384_KEY_LEN          48
 
 /**
- * Initializes the APDU buffer in stack.<br>
- **/
-#define INIT_STACK_APDUBUFFER(pbBuffer,wLen)\
-{											\
-	/*lint --e{733,830} suppress "Used only within Command Lib Block" */\
-	uint8_t rgbAPDUBuffer[wLen];			\
-	pbBuffer = rgbAPDUBuffer;				\
-}
-
-/**
- * Initializes the APDU buffer in heap.<br>
+ * Takes the APDU buffer of the optiga comms instance for the running command, see #CmdLib_AcquireApduBuffer.<br>
  **/
-#define INIT_HEAP_APDUBUFFER(pbBuffer,wLen)					\
+#define INIT_APDUBUFFER(pbBuffer,wLen)						\
 {															\
-	if(INVALID_MAX_COMMS_BUFF_SIZE == wMaxCommsBuffer)		\
+	int32_t i4AcquireStatus = CmdLib_AcquireApduBuffer(PpsOptigaComms,(uint16_t)(wLen),&(pbBuffer));	\
+	if(CMD_LIB_OK != i4AcquireStatus)						\
 	{														\
-		i4Status = (int32_t)CMD_DEV_EXEC_ERROR;				\
-        break;                                              \
-	}														\
-	pbBuffer = (uint8_t*)OCP_MALLOC(wLen);					\
-	if(NULL == pbBuffer)									\
-	{														\
-		i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;	\
+		i4Status = i4AcquireStatus;							\
 		break;												\
 	}														\
-}															\
+}
 
 /**
- * Frees the heap memory.<br>
+ * Returns the APDU buffer taken by #INIT_APDUBUFFER.<br>
  **/
-#define FREE_HEAP_APDUBUFFER(pbBuffer)      \
+#define FREE_APDUBUFFER(pbBuffer)			\
 {											\
 	if(NULL != pbBuffer)					\
 	{										\
-		OCP_FREE(pbBuffer);					\
+		CmdLib_ReleaseApduBuffer(PpsOptigaComms);	\
 		pbBuffer = NULL;					\
 	}										\
 }
@@ -376,6 +357,18 @@ typedef struct sApduData_d
     uint16_t wResponseLength;
 }sApduData_d;
 
+/**
+ * \brief Segments of an APDU exchange, in use by the communication layer until the exchange is completed.
+ */
+typedef struct sApduVector_d
+{
+    ///Segments of the command
+    sbBlob_d rgsTxVector[2];
+
+    ///Segments of the response
+    sbBlob_d rgsRxVector[2];
+}sApduVector_d;
+
 /**
  * \brief Enumeration to specify the sequence of message/record.
  */
@@ -392,12 +385,180 @@ typedef enum eFragSeq_d
     eContinue = 0x02
 }eFragSeq_d;
 
-volatile static host_lib_status_t optiga_comms_status;
-
-//lint --e{715, 818} suppress "This is ignored as app_event_handler_t handler function prototype requires this argument.This will be used for object based implementation"
+//lint --e{818} suppress "This is ignored as app_event_handler_t handler function prototype requires this argument"
 static void optiga_comms_event_handler(void* upper_layer_ctx, host_lib_status_t event)
 {
-    optiga_comms_status = event;
+#ifdef PAL_OS_HAS_EVENT_WAIT
+    pal_os_event_notify(&((optiga_comms_t*)upper_layer_ctx)->comms_status, (uint32_t)event);
+#else
+    ((optiga_comms_t*)upper_layer_ctx)->comms_status = event;
+#endif
+}
+
+/**
+ * \brief Waits till the ongoing optiga comms transaction is completed.
+ * With #PAL_OS_HAS_EVENT_WAIT the caller sleeps until #optiga_comms_event_handler is invoked,
+ * otherwise the status is polled.
+ */
+_STATIC_H void CmdLib_WaitForCompletion(optiga_comms_t* PpsOptigaComms)
+{
+#ifdef PAL_OS_HAS_EVENT_WAIT
+    pal_os_event_wait(&PpsOptigaComms->comms_status, OPTIGA_COMMS_BUSY);
+#else
+    while(PpsOptigaComms->comms_status == OPTIGA_COMMS_BUSY)
+    {
+#ifdef USE_CMDLIB_WITH_RTOS
+        pal_os_timer_delay_in_milliseconds(1);
+#endif
+    }
+#endif
+}
+
+/**
+ * \brief Waits until the in use flag is cleared by the holder and sets it.
+ *
+ * With #PAL_OS_HAS_LOCK_FLAG the caller waits in the queue of the platform, which hands the flag to the
+ * next waiter on release. Otherwise the flag is checked under the pal os lock until it is cleared.
+ */
+_STATIC_H void CmdLib_AcquireInUse(volatile uint32_t* PpdwInUse)
+{
+#ifdef PAL_OS_HAS_LOCK_FLAG
+    //lint --e{534} suppress "The flag is acquired once the call returns"
+    pal_os_lock_acquire_flag(PpdwInUse);
+#else
+    uint8_t bAcquired = FALSE;
+
+    do
+    {
+        while(PAL_STATUS_SUCCESS != pal_os_lock_acquire()){};
+        if(FALSE == *PpdwInUse)
+        {
+            *PpdwInUse = TRUE;
+            bAcquired = TRUE;
+        }
+        pal_os_lock_release();
+
+        if(FALSE == bAcquired)
+        {
+#ifdef PAL_OS_HAS_EVENT_WAIT
+            pal_os_event_wait(PpdwInUse, TRUE);
+#elif defined USE_CMDLIB_WITH_RTOS
+            pal_os_timer_delay_in_milliseconds(1);
+#endif
+        }
+    }while(FALSE == bAcquired);
+#endif
+}
+
+/**
+ * \brief Clears the in use flag set using #CmdLib_AcquireInUse.
+ */
+_STATIC_H void CmdLib_ReleaseInUse(volatile uint32_t* PpdwInUse)
+{
+#if defined PAL_OS_HAS_LOCK_FLAG
+    pal_os_lock_release_flag(PpdwInUse);
+#elif defined PAL_OS_HAS_EVENT_WAIT
+    pal_os_event_notify(PpdwInUse, FALSE);
+#else
+    *PpdwInUse = FALSE;
+#endif
+}
+
+/**
+ * \brief Gets exclusive use of the optiga comms instance for one APDU exchange.
+ * Instances are independent, hence different OPTIGAs are used concurrently.
+ */
+_STATIC_H void CmdLib_AcquireComms(optiga_comms_t* PpsOptigaComms)
+{
+    CmdLib_AcquireInUse(&PpsOptigaComms->in_use);
+}
+
+/**
+ * \brief Releases the optiga comms instance acquired using #CmdLib_AcquireComms.
+ */
+_STATIC_H void CmdLib_ReleaseComms(optiga_comms_t* PpsOptigaComms)
+{
+    CmdLib_ReleaseInUse(&PpsOptigaComms->in_use);
+}
+
+/**
+ * \brief Invokes the object write handler of the optiga comms instance, if any, before a data object is written.
+ * The instance must be acquired using #CmdLib_AcquireComms, so the handler is not raced by the users of the instance.
+ */
+_STATIC_H void CmdLib_NotifyObjectWrite(optiga_comms_t* PpsOptigaComms, uint16_t PwOid)
+{
+    if(NULL != PpsOptigaComms->object_write_handler)
+    {
+        PpsOptigaComms->object_write_handler((void*)PpsOptigaComms, PwOid);
+    }
+}
+
+/**
+ * \brief Gets exclusive use of the APDU buffer of the optiga comms instance for one command.
+ *
+ * The buffer is allocated at the first use after the maximum communication buffer size is read and then reused,
+ * hence the command library does no heap allocation in steady state. A buffer provided by the application in
+ * #optiga_comms_t is used as is. With #USE_CMDLIB_WITHOUT_HEAP the buffer must be provided by the application.
+ *
+ * \retval    #CMD_LIB_OK
+ * \retval    #CMD_DEV_EXEC_ERROR, if the maximum communication buffer size is not yet read
+ * \retval    #CMD_LIB_INSUFFICIENT_MEMORY, if the buffer is smaller than PwLen or can not be allocated
+ */
+_STATIC_H int32_t CmdLib_AcquireApduBuffer(optiga_comms_t* PpsOptigaComms, uint16_t PwLen, uint8_t** PppbBuffer)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_OK;
+#ifndef USE_CMDLIB_WITHOUT_HEAP
+    uint16_t wSize;
+#endif
+
+    if(INVALID_MAX_COMMS_BUFF_SIZE == PpsOptigaComms->max_comms_buffer)
+    {
+        return (int32_t)CMD_DEV_EXEC_ERROR;
+    }
+
+    CmdLib_AcquireInUse(&PpsOptigaComms->apdu_buffer_in_use);
+    do
+    {
+        if(NULL == PpsOptigaComms->p_apdu_buffer)
+        {
+#ifdef USE_CMDLIB_WITHOUT_HEAP
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+#else
+            //Large enough for any command, GetMessage needs a fixed size
+            wSize = (PpsOptigaComms->max_comms_buffer > MAX_APDU_BUFF_LEN)?
+                    PpsOptigaComms->max_comms_buffer:MAX_APDU_BUFF_LEN;
+            PpsOptigaComms->p_apdu_buffer = (uint8_t*)OCP_MALLOC(wSize);
+            if(NULL == PpsOptigaComms->p_apdu_buffer)
+            {
+                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+                break;
+            }
+            PpsOptigaComms->apdu_buffer_size = wSize;
+            PpsOptigaComms->apdu_buffer_allocations++;
+#endif
+        }
+        if(PwLen > PpsOptigaComms->apdu_buffer_size)
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+        *PppbBuffer = PpsOptigaComms->p_apdu_buffer;
+    }while(FALSE);
+
+    if(CMD_LIB_OK != i4Status)
+    {
+        CmdLib_ReleaseInUse(&PpsOptigaComms->apdu_buffer_in_use);
+    }
+    return i4Status;
+}
+
+/**
+ * \brief Releases the APDU buffer acquired using #CmdLib_AcquireApduBuffer.
+ */
+_STATIC_H void CmdLib_ReleaseApduBuffer(optiga_comms_t* PpsOptigaComms)
+{
+    CmdLib_ReleaseInUse(&PpsOptigaComms->apdu_buffer_in_use);
 }
 
 /**
@@ -412,7 +573,7 @@ static void optiga_comms_event_handler(void* upper_layer_ctx, host_lib_status_t
  * \retval    #CMD_DEV_EXEC_ERROR   
  *
  */
-_STATIC_H int32_t CmdLib_GetDeviceError(void)
+_STATIC_H int32_t CmdLib_GetDeviceError(optiga_comms_t* PpsOptigaComms)
 {
     int32_t i4Status  = (int32_t)CMD_DEV_ERROR;
     uint8_t rgbErrorCmd[] = {CMD_GETDATA,0x00,0x00,0x02,(uint8_t)(OID_ERROR>>8),(uint8_t)OID_ERROR};
@@ -420,9 +581,10 @@ _STATIC_H int32_t CmdLib_GetDeviceError(void)
 
     do
     {
-        p_optiga_comms->upper_layer_handler = optiga_comms_event_handler;
-        optiga_comms_status  = OPTIGA_COMMS_BUSY;
-        i4Status  =  optiga_comms_transceive(p_optiga_comms,rgbErrorCmd,&wBufferLength,
+        PpsOptigaComms->upper_layer_handler = optiga_comms_event_handler;
+        PpsOptigaComms->upper_layer_ctx = PpsOptigaComms;
+        PpsOptigaComms->comms_status  = OPTIGA_COMMS_BUSY;
+        i4Status  =  optiga_comms_transceive(PpsOptigaComms,rgbErrorCmd,&wBufferLength,
                                                  rgbErrorCmd,&wBufferLength);
         if(OPTIGA_COMMS_SUCCESS != i4Status)
         {
@@ -431,12 +593,8 @@ _STATIC_H int32_t CmdLib_GetDeviceError(void)
         }
 
         //wait for completion
-        while(optiga_comms_status == OPTIGA_COMMS_BUSY){
-#ifdef USE_CMDLIB_WITH_RTOS
-        	pal_os_timer_delay_in_milliseconds(1);
-#endif
-        };
-        if(optiga_comms_status != OPTIGA_COMMS_SUCCESS)
+        CmdLib_WaitForCompletion(PpsOptigaComms);
+        if(PpsOptigaComms->comms_status != OPTIGA_COMMS_SUCCESS)
         {
             i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
             break;
@@ -457,48 +615,83 @@ _STATIC_H int32_t CmdLib_GetDeviceError(void)
 
 
 /**
- * \brief Formats data as per Security Chip application and send using the communication functions.
+ * \brief Formats data as per Security Chip application and starts sending it using the communication functions.
+ *
+ * The APDU is sent from prgbAPDUBuffer, followed by PpsTxData if not NULL. PpsTxData is part of wPayloadLength.
+ * If PpsRxData is not NULL, only the response header is received into prgbRespBuffer and the rest of the
+ * response into PpsRxData. The data are framed and received in place, without copying them to prgbAPDUBuffer.
+ * The buffers and PpsVector must remain valid until #TransceiveAPDUVectorFinish returns.
+ * The optiga comms instance must be acquired by the caller using #CmdLib_AcquireComms.
  */
-_STATIC_H int32_t TransceiveAPDU(sApduData_d *PpsApduData,uint8_t bGetError)
-{  
-    //lint --e{818} suppress "PpsResponse is out parameter"
+_STATIC_H int32_t TransceiveAPDUVectorStart(optiga_comms_t* PpsOptigaComms,sApduData_d *PpsApduData,
+                                            const sbBlob_d *PpsTxData,const sbBlob_d *PpsRxData,
+                                            sApduVector_d *PpsVector)
+{
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
-    uint16_t wTotalLength;
-    do
-    {
-        if(NULL == PpsApduData || NULL == p_optiga_comms)
-        { 
-            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
-            break;
-        }
-        PpsApduData->prgbAPDUBuffer[OFFSET_CMD] = PpsApduData->bCmd;
-        PpsApduData->prgbAPDUBuffer[OFFSET_PARAM] = PpsApduData->bParam;
+    uint8_t bTxCount = 1;
+    uint8_t bRxCount = 1;
 
-        //copy length
-        PpsApduData->prgbAPDUBuffer[OFFSET_LENGTH] = (uint8_t)(PpsApduData->wPayloadLength >> BITS_PER_BYTE);
-        PpsApduData->prgbAPDUBuffer[OFFSET_LENGTH+1] = (uint8_t)PpsApduData->wPayloadLength;
+    if(NULL == PpsApduData || NULL == PpsOptigaComms)
+    { 
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
 
-        //update total length to consider total header length
-        wTotalLength = PpsApduData->wPayloadLength + LEN_APDUHEADER;
+    PpsApduData->prgbAPDUBuffer[OFFSET_CMD] = PpsApduData->bCmd;
+    PpsApduData->prgbAPDUBuffer[OFFSET_PARAM] = PpsApduData->bParam;
 
-        p_optiga_comms->upper_layer_handler = optiga_comms_event_handler;
-        optiga_comms_status  = OPTIGA_COMMS_BUSY;
-        i4Status  =  optiga_comms_transceive(p_optiga_comms,PpsApduData->prgbAPDUBuffer,&wTotalLength,
-                                                PpsApduData->prgbRespBuffer,&PpsApduData->wResponseLength);
-        if(OPTIGA_COMMS_SUCCESS != i4Status)
+    //copy length
+    PpsApduData->prgbAPDUBuffer[OFFSET_LENGTH] = (uint8_t)(PpsApduData->wPayloadLength >> BITS_PER_BYTE);
+    PpsApduData->prgbAPDUBuffer[OFFSET_LENGTH+1] = (uint8_t)PpsApduData->wPayloadLength;
+
+    //total length considers total header length
+    PpsVector->rgsTxVector[0].prgbStream = PpsApduData->prgbAPDUBuffer;
+    PpsVector->rgsTxVector[0].wLen = PpsApduData->wPayloadLength + LEN_APDUHEADER;
+    if(NULL != PpsTxData)
+    {
+        PpsVector->rgsTxVector[0].wLen -= PpsTxData->wLen;
+        PpsVector->rgsTxVector[1] = *PpsTxData;
+        bTxCount++;
+    }
+    PpsVector->rgsRxVector[0].prgbStream = PpsApduData->prgbRespBuffer;
+    PpsVector->rgsRxVector[0].wLen = PpsApduData->wResponseLength;
+    if(NULL != PpsRxData)
+    {
+        PpsVector->rgsRxVector[0].wLen = LEN_APDUHEADER;
+        PpsVector->rgsRxVector[1] = *PpsRxData;
+        bRxCount++;
+    }
+
+    PpsOptigaComms->upper_layer_handler = optiga_comms_event_handler;
+    PpsOptigaComms->upper_layer_ctx = PpsOptigaComms;
+    PpsOptigaComms->comms_status  = OPTIGA_COMMS_BUSY;
+    i4Status  =  optiga_comms_transceive_vector(PpsOptigaComms,PpsVector->rgsTxVector,bTxCount,
+                                                PpsVector->rgsRxVector,bRxCount,&PpsApduData->wResponseLength);
+    if(OPTIGA_COMMS_SUCCESS != i4Status)
+    {
+        return (int32_t)CMD_DEV_EXEC_ERROR;
+    }
+    return (int32_t)CMD_LIB_OK;
+}
+
+/**
+ * \brief Waits for the completion of an APDU exchange started using #TransceiveAPDUVectorStart and checks the response.
+ */
+_STATIC_H int32_t TransceiveAPDUVectorFinish(optiga_comms_t* PpsOptigaComms,const sApduData_d *PpsApduData,
+                                             uint8_t bGetError)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+
+    do
+    {
+        //wait for completion
+        CmdLib_WaitForCompletion(PpsOptigaComms);
+        
+        if(PpsOptigaComms->comms_status == OPTIGA_COMMS_MEM_ERROR)
         {
-            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
-        //wait for completion
-        do
-        {
-#ifdef USE_CMDLIB_WITH_RTOS
-        	pal_os_timer_delay_in_milliseconds(1);
-#endif
-        }while(optiga_comms_status == OPTIGA_COMMS_BUSY);
-        
-        if(optiga_comms_status != OPTIGA_COMMS_SUCCESS)
+        if(PpsOptigaComms->comms_status != OPTIGA_COMMS_SUCCESS)
         {
             i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
             break;
@@ -508,7 +701,7 @@ _STATIC_H int32_t TransceiveAPDU(sApduData_d *PpsApduData,uint8_t bGetError)
         {
             if(TRUE == bGetError)
             {
-                i4Status = CmdLib_GetDeviceError();
+                i4Status = CmdLib_GetDeviceError(PpsOptigaComms);
             }
             else
             {
@@ -523,20 +716,70 @@ _STATIC_H int32_t TransceiveAPDU(sApduData_d *PpsApduData,uint8_t bGetError)
     return i4Status;
 }
 
+/**
+ * \brief Formats data as per Security Chip application and send using the communication functions.
+ *
+ * Exchanges one APDU using #TransceiveAPDUVectorStart and #TransceiveAPDUVectorFinish.
+ * The optiga comms instance must be acquired by the caller using #CmdLib_AcquireComms.
+ */
+_STATIC_H int32_t TransceiveAPDUVectorHeld(optiga_comms_t* PpsOptigaComms,sApduData_d *PpsApduData,
+                                           const sbBlob_d *PpsTxData,const sbBlob_d *PpsRxData,uint8_t bGetError)
+{  
+    //lint --e{818} suppress "PpsResponse is out parameter"
+    int32_t i4Status;
+    sApduVector_d sVector;
+
+    i4Status = TransceiveAPDUVectorStart(PpsOptigaComms,PpsApduData,PpsTxData,PpsRxData,&sVector);
+    if(CMD_LIB_OK != i4Status)
+    {
+        return i4Status;
+    }
+    return TransceiveAPDUVectorFinish(PpsOptigaComms,PpsApduData,bGetError);
+}
+
+/**
+ * \brief Acquires the optiga comms instance and exchanges one APDU as #TransceiveAPDUVectorHeld.
+ */
+_STATIC_H int32_t TransceiveAPDUVector(optiga_comms_t* PpsOptigaComms,sApduData_d *PpsApduData,
+                                       const sbBlob_d *PpsTxData,const sbBlob_d *PpsRxData,uint8_t bGetError)
+{
+    int32_t i4Status;
+
+    if(NULL == PpsOptigaComms)
+    {
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
+
+    CmdLib_AcquireComms(PpsOptigaComms);
+    i4Status = TransceiveAPDUVectorHeld(PpsOptigaComms,PpsApduData,PpsTxData,PpsRxData,bGetError);
+    CmdLib_ReleaseComms(PpsOptigaComms);
+
+    return i4Status;
+}
+
+/**
+ * \brief Formats data as per Security Chip application and send using the communication functions.
+ */
+_STATIC_H int32_t TransceiveAPDU(optiga_comms_t* PpsOptigaComms,sApduData_d *PpsApduData,uint8_t bGetError)
+{  
+    return TransceiveAPDUVector(PpsOptigaComms,PpsApduData,NULL,NULL,bGetError);
+}
+
 /**
  * \brief Read the maximum size of communication buffer supported by the security chip by reading "Max comms buffer size" OID.
  */
-_STATIC_H int32_t GetMaxCommsBuffer()
+_STATIC_H int32_t GetMaxCommsBuffer(optiga_comms_t* PpsOptigaComms)
 { 
 #define GETDATA_MAX_COMMS_SIZE  10
 #define OID_MAX_COMMS_SIZE      0xE0C6
 
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
+    uint8_t rgbAPDUBuffer[GETDATA_MAX_COMMS_SIZE];
     
     do
     { 
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer,GETDATA_MAX_COMMS_SIZE);
+		sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
@@ -549,14 +792,14 @@ _STATIC_H int32_t GetMaxCommsBuffer()
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(OID_MAX_COMMS_SIZE >> BITS_PER_BYTE);
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD +1] = (uint8_t)OID_MAX_COMMS_SIZE;        
         
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
         }
         
         //Assign value to MaxCommsBuffer
-        wMaxCommsBuffer = (uint16_t )((sApduData.prgbRespBuffer[LEN_APDUHEADER] << 8) | (sApduData.prgbRespBuffer[LEN_APDUHEADER+1]));
+        PpsOptigaComms->max_comms_buffer = (uint16_t )((sApduData.prgbRespBuffer[LEN_APDUHEADER] << 8) | (sApduData.prgbRespBuffer[LEN_APDUHEADER+1]));
     }while(FALSE);
 	
 #undef GETDATA_MAX_COMMS_SIZE  
@@ -570,7 +813,7 @@ _STATIC_H int32_t GetMaxCommsBuffer()
  * \brief A common function for CmdLib_Encrypt and CmdLib_Decrypt.
  * 
  */
-_STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_t PbCmd, uint8_t PbParam);
+_STATIC_H int32_t CmdLib_EncDecHelper(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsCryptoVector, uint8_t PbCmd, uint8_t PbParam);
 
 /**
 * A common function for CmdLib_Encrypt and CmdLib_Decrypt.<br>
@@ -589,7 +832,7 @@ _STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-_STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_t PbCmd, uint8_t PbParam)
+_STATIC_H int32_t CmdLib_EncDecHelper(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsCryptoVector, uint8_t PbCmd, uint8_t PbParam)
 {
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     uint16_t wRespLen;
@@ -642,7 +885,7 @@ _STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_
         sApduData.bCmd = PbCmd;
         sApduData.bParam = PbParam;
 
-		wMaxPlaintText = wMaxCommsBuffer - OVERHEAD_UPDOWNLINK;
+		wMaxPlaintText = PpsOptigaComms->max_comms_buffer - OVERHEAD_UPDOWNLINK;
 
         //Data that is yet to be encrypted/decrypted
         wDataRemaining = PpsCryptoVector->wInDataLength;
@@ -691,7 +934,7 @@ _STATIC_H int32_t CmdLib_EncDecHelper(sProcCryptoData_d *PpsCryptoVector, uint8_
             sApduData.wResponseLength = PpsCryptoVector->sOutData.wBufferLength - wTotalEncDecLen;
 
             //Now Transmit data
-            i4Status = TransceiveAPDU(&sApduData,bGetError);
+            i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,bGetError);
             if(CMD_LIB_OK != i4Status)
             {
                 if(PARAM_DEC_DATA == PbParam)
@@ -804,24 +1047,11 @@ _STATIC_H int32_t Get_KeySize(eAlgId_d PeAlgoIden,uint8_t* pbKeySize )
 
 /// @endcond
 
-/**
-* Sets the OPTIGA Comms context provided by user application in the command libary.
-* 
-* <br>
-* \param[in] p_input_optiga_comms Pointer to OPTIGA comms context
-*
-* \retval  #CMD_LIB_OK
-* \retval  #CMD_LIB_ERROR
-*/
-void CmdLib_SetOptigaCommsContext(const optiga_comms_t *p_input_optiga_comms)
-{
-	p_optiga_comms = (optiga_comms_t*)p_input_optiga_comms;
-}
-
 /**
 * Opens the Security Chip Application. The Unique Application Identifier is used internally by 
 * the function while forming a command APDU.
 * 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 *\param[in] PpsOpenApp Pointer to a structure #sOpenApp_d containing inputs for opening application on security chip
 *
 * Notes:
@@ -832,7 +1062,7 @@ void CmdLib_SetOptigaCommsContext(const optiga_comms_t *p_input_optiga_comms)
 * \retval  #CMD_LIB_INVALID_PARAM
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
+int32_t CmdLib_OpenApplication(optiga_comms_t* PpsOptigaComms, const sOpenApp_d* PpsOpenApp)
 {
 /// @cond hidden
 #define OPEN_APDU_BUF_LEN    25
@@ -841,10 +1071,12 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     uint8_t rgbUID[] = {UNIQUE_APP_IDENTIFIER};
     sApduData_d sApduData;
+    uint8_t rgbAPDUBuffer[OPEN_APDU_BUF_LEN];
+    uint8_t* pbApduBuffer = NULL;
      
     do
     {
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer,OPEN_APDU_BUF_LEN);
+		sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         if(NULL == PpsOpenApp)
         {
@@ -866,18 +1098,26 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
         sApduData.wPayloadLength = sizeof(rgbUID);
 		sApduData.wResponseLength = OPEN_APDU_BUF_LEN;
         OCP_MEMCPY(sApduData.prgbAPDUBuffer+OFFSET_PAYLOAD, rgbUID, sizeof(rgbUID));
-        i4Status = TransceiveAPDU(&sApduData,FALSE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,FALSE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
         }
 
         //Read Max comms buffer size if not already read
-        if(INVALID_MAX_COMMS_BUFF_SIZE == wMaxCommsBuffer)
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsOptigaComms->max_comms_buffer)
         {
             //Get Maximum Comms buffer size
-            i4Status = GetMaxCommsBuffer();
+            i4Status = GetMaxCommsBuffer(PpsOptigaComms);
+            if(CMD_LIB_OK != i4Status)
+            {
+                break;
+            }
         }
+
+        //Set up the APDU buffer now, to have no allocation in the commands
+        INIT_APDUBUFFER(pbApduBuffer,0);
+        FREE_APDUBUFFER(pbApduBuffer);
     }while(FALSE);
 
 /// @cond hidden
@@ -888,6 +1128,43 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
 }
 
 #ifdef MODULE_ENABLE_READ_WRITE
+/**
+* Acquires the optiga comms instance for a batch of commands issued using the InBatch functions.
+* 
+* <br>
+* Notes:
+* - Other tasks using the same instance wait until #CmdLib_EndBatch is called.<br>
+* - Only the InBatch functions must be used on the instance until #CmdLib_EndBatch is called,
+*   any other function of the command library waits for the instance forever.<br>
+* 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_BeginBatch(optiga_comms_t* PpsOptigaComms)
+{
+    if(NULL == PpsOptigaComms)
+    {
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
+    CmdLib_AcquireComms(PpsOptigaComms);
+    return (int32_t)CMD_LIB_OK;
+}
+
+/**
+* Releases the optiga comms instance acquired using #CmdLib_BeginBatch.
+* 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*/
+void CmdLib_EndBatch(optiga_comms_t* PpsOptigaComms)
+{
+    if(NULL != PpsOptigaComms)
+    {
+        CmdLib_ReleaseComms(PpsOptigaComms);
+    }
+}
+
 /**
 * Reads data or metadata of the specified data object by issuing GetDataObject command based on input parameters.
 * 
@@ -895,7 +1172,9 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
 * Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
 * - The function does not verify if the read access is permitted for the data object.<br>
+* - The optiga comms instance is acquired once for all the chained APDUs of the read.<br>
 * 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 *\param[in] PpsGDVector Pointer to Get Data Object inputs
 *\param[in,out] PpsResponse Pointer to Response structure
 *
@@ -905,28 +1184,57 @@ int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp)
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse)
+int32_t CmdLib_GetDataObject(optiga_comms_t* PpsOptigaComms, const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse)
 {
-/// @cond hidden
-#define ALLOCATE_ADDITIONAL_BYTES	6		// hdr(4) + oid(2)
-/// @endcond 
+    int32_t i4Status;
+
+    if(NULL == PpsOptigaComms)
+    {
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
 
+    CmdLib_AcquireComms(PpsOptigaComms);
+    i4Status = CmdLib_GetDataObjectInBatch(PpsOptigaComms,PpsGDVector,PpsResponse);
+    CmdLib_ReleaseComms(PpsOptigaComms);
+
+    return i4Status;
+}
+
+/**
+* Reads data or metadata of the specified data object as #CmdLib_GetDataObject,
+* on an optiga comms instance acquired using #CmdLib_BeginBatch.
+* 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*\param[in] PpsGDVector Pointer to Get Data Object inputs
+*\param[in,out] PpsResponse Pointer to Response structure
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR 
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_GetDataObjectInBatch(optiga_comms_t* PpsOptigaComms, const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse)
+{
     //lint --e{818} suppress "PpsResponse is out parameter"
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     uint16_t wTotalRecvLen = 0;
     uint16_t wReadLen = 0;
     uint16_t wOffset = 0;
     sApduData_d sApduData;
-    sApduData.prgbAPDUBuffer = NULL;
+    //Only the command and the response header are formatted here, the data is received in place
+    uint8_t rgbAPDUBuffer[LEN_APDUHEADER + LEN_PL_OIDDATA];
+    uint8_t rgbRespHeader[LEN_APDUHEADER];
+    sbBlob_d sRxData;
     do
     {
-//To use stack memory for APDU buffer, define STACK_ALLOC macro locally and else heap memory is used
-#ifdef STACK_ALLOC
-        #error "Implement the inilization of stack memory for the required buffer"
-		//INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer, wLen);    //wLen to be replaced with the required const length
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wMaxCommsBuffer + ALLOCATE_ADDITIONAL_BYTES);
-#endif
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsOptigaComms->max_comms_buffer)
+        {
+            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            break;
+        }
+        sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
+        sRxData.wLen = 0;
 
         if((NULL == PpsGDVector)||(NULL == PpsResponse)||(NULL == PpsResponse->prgbBuffer))
         {
@@ -939,7 +1247,7 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
             break;
         }
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer+ALLOCATE_ADDITIONAL_BYTES;      
+        sApduData.prgbRespBuffer = rgbRespHeader;
         sApduData.bCmd = CMD_GETDATA; 
         //copy OID
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsGDVector->wOID >> BITS_PER_BYTE);
@@ -971,14 +1279,17 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
                 sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID +1] = (uint8_t)wOffset;
 
                 //copy read length
-                wReadLen = MIN((wMaxCommsBuffer-LEN_APDUHEADER),(PpsGDVector->wLength-wTotalRecvLen));
+                wReadLen = MIN((PpsOptigaComms->max_comms_buffer-LEN_APDUHEADER),(PpsGDVector->wLength-wTotalRecvLen));
                 sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + BYTES_OFFSET] = (uint8_t)(wReadLen >> BITS_PER_BYTE);
                 sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + BYTES_OFFSET +1] = (uint8_t)wReadLen;
             }
 
-            sApduData.wResponseLength = wMaxCommsBuffer;
+            sApduData.wResponseLength = LEN_APDUHEADER;
 
-            i4Status = TransceiveAPDU(&sApduData,TRUE);
+            //Receive the read data directly into the user buffer, a larger response is reported as insufficient memory
+            sRxData.prgbStream = PpsResponse->prgbBuffer+wTotalRecvLen;
+            sRxData.wLen = MIN((PpsOptigaComms->max_comms_buffer-LEN_APDUHEADER),(PpsResponse->wBufferLength-wTotalRecvLen));
+            i4Status = TransceiveAPDUVectorHeld(PpsOptigaComms,&sApduData,NULL,&sRxData,TRUE);
             if(CMD_LIB_OK != i4Status)
             {
                 break;
@@ -986,13 +1297,6 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
             //strip 4 byte apdu header
             sApduData.wResponseLength -= LEN_APDUHEADER;
 
-            //Copy read data
-            if(((PpsResponse->wBufferLength-wTotalRecvLen) < sApduData.wResponseLength))
-            {
-                i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
-                break;
-            }
-            OCP_MEMCPY(PpsResponse->prgbBuffer+wTotalRecvLen,sApduData.prgbRespBuffer+LEN_APDUHEADER,sApduData.wResponseLength);
             //Update total received data
             wTotalRecvLen += sApduData.wResponseLength;
             //increment the offset to get data from
@@ -1009,8 +1313,8 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
         if((CMD_LIB_OK != i4Status)&&((wTotalRecvLen == 0)||
         (ERR_DATA_OUT_OF_BOUND != (i4Status^(int32_t)CMD_DEV_ERROR))))
         {
-            //Clear existing data
-            OCP_MEMSET(PpsResponse->prgbBuffer,0,wTotalRecvLen);
+            //Clear existing data, including the part of a response which did not fit
+            OCP_MEMSET(PpsResponse->prgbBuffer,0,wTotalRecvLen + sRxData.wLen);
             PpsResponse->wRespLength = 0;
             break;
         }
@@ -1019,16 +1323,6 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
         i4Status = (int32_t)CMD_LIB_OK;
     }while(FALSE);  
 
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else
-	#undef STACK_ALLOC
-#endif
-
-///@cond hidden
-#undef ALLOCATE_ADDITIONAL_BYTES
-///@endcond
-
     return i4Status;
 }
 
@@ -1052,6 +1346,11 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
 * - In case of failure,it is possible that partial data is written into the data object.<br>
 *   In such a case, the user should decide if the data has to be re-written.
 *
+* - The optiga comms instance is acquired once for all the chained APDUs of the write.<br>
+*
+* - The object write handler of the instance, if any, is invoked before the first APDU.<br>
+*
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 *\param[in] PpsSDVector Pointer to Set Data Object inputs
 *
 * \retval  #CMD_LIB_OK
@@ -1061,10 +1360,45 @@ int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsR
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
+int32_t CmdLib_SetDataObject(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector)
+{
+    int32_t i4Status;
+
+    if(NULL == PpsOptigaComms)
+    {
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
+
+    CmdLib_AcquireComms(PpsOptigaComms);
+    if(NULL != PpsSDVector)
+    {
+        CmdLib_NotifyObjectWrite(PpsOptigaComms, PpsSDVector->wOID);
+    }
+    i4Status = CmdLib_SetDataObjectInBatch(PpsOptigaComms,PpsSDVector);
+    CmdLib_ReleaseComms(PpsOptigaComms);
+
+    return i4Status;
+}
+
+/**
+* Writes data or metadata to the specified data object as #CmdLib_SetDataObject,
+* on an optiga comms instance acquired using #CmdLib_BeginBatch.
+* The object write handler is not invoked, the caller keeps the values it cached coherent.
+* 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*\param[in] PpsSDVector Pointer to Set Data Object inputs
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR 
+* \retval  #CMD_LIB_INVALID_PARAM 
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_DEV_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_SetDataObjectInBatch(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector)
 {
 /// @cond hidden
-#define BUFFER_SIZE (wMaxCommsBuffer)
+#define OVERHEAD (OFFSET_PAYLOAD+BYTES_OID+BYTES_OFFSET)
 /// @endcond
 
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
@@ -1072,17 +1406,19 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
     uint16_t wWriteLen = 0;
     uint16_t wOffset;
     sApduData_d sApduData;
-    sApduData.prgbAPDUBuffer = NULL;
+    //Only the command header and the response are formatted here, the data is sent in place
+    uint8_t rgbAPDUBuffer[OVERHEAD];
+    uint8_t rgbResponse[LEN_APDUHEADER];
+    sbBlob_d sTxData;
 
     do
     {
-//To use stack memory for APDU buffer, define STACK_ALLOC macro locally and else heap memory is used
-#ifdef STACK_ALLOC
-        #error "Implement the inilization of stack memory for the required buffer"
-		//INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer, wLen);    //wLen to be replaced with the required const length
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,BUFFER_SIZE);
-#endif
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsOptigaComms->max_comms_buffer)
+        {
+            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            break;
+        }
+        sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         if((NULL == PpsSDVector)||(NULL == PpsSDVector->prgbData))
         {
@@ -1119,7 +1455,7 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
         }
 
         //Set the pointer to the response buffer
-        sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer+7;
+        sApduData.prgbRespBuffer = rgbResponse;
         //copy OID
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsSDVector->wOID >> BITS_PER_BYTE);
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + 1] = (uint8_t)PpsSDVector->wOID;
@@ -1132,11 +1468,7 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
             {
                 sApduData.bParam = PARAM_SET_DATA;
             }
-/// @cond hidden
-#define OVERHEAD (OFFSET_PAYLOAD+BYTES_OID+BYTES_OFFSET)
-/// @endcond
-
-            wWriteLen = MIN((wMaxCommsBuffer-OVERHEAD),(PpsSDVector->wLength-wTotalWriteLen));
+            wWriteLen = MIN((PpsOptigaComms->max_comms_buffer-OVERHEAD),(PpsSDVector->wLength-wTotalWriteLen));
            
             //set data payload length is 4(OID length + offset length) plus length of data to write
             sApduData.wPayloadLength = BYTES_OID + BYTES_OFFSET + wWriteLen;
@@ -1144,14 +1476,14 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
             //copy offset
             sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID] = (uint8_t)(wOffset >> BITS_PER_BYTE);
             sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + 1] = (uint8_t)wOffset;                
-            //copy the data
-
-            OCP_MEMCPY(sApduData.prgbAPDUBuffer+OVERHEAD,PpsSDVector->prgbData+wTotalWriteLen,wWriteLen);
+            //the data is sent from the user buffer
+            sTxData.prgbStream = PpsSDVector->prgbData+wTotalWriteLen;
+            sTxData.wLen = wWriteLen;
 
 			//Set Response buffer length
-			sApduData.wResponseLength = BUFFER_SIZE;
+			sApduData.wResponseLength = sizeof(rgbResponse);
 
-            i4Status = TransceiveAPDU(&sApduData,TRUE);
+            i4Status = TransceiveAPDUVectorHeld(PpsOptigaComms,&sApduData,&sTxData,NULL,TRUE);
             if(CMD_LIB_OK != i4Status)
             {
                 break;
@@ -1161,16 +1493,189 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
 			wOffset += wWriteLen;
         }while(wTotalWriteLen != PpsSDVector->wLength);        
     }while(FALSE);  
-
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else
-	#undef STACK_ALLOC
-#endif
 	
 /// @cond hidden
 #undef OVERHEAD
-#undef BUFFER_SIZE
+/// @endcond
+
+    return i4Status;
+}
+
+/**
+* Writes data to the specified data object as #CmdLib_SetDataObject, with the data got chunk by chunk
+* from the callback of the stream instead of PpsSDVector->prgbData.
+*
+* - PpsSDVector->wLength is the total number of bytes to write and PpsSDVector->prgbData is not used.<br>
+*
+* - The buffer of the stream is split in two chunks of up to (maximum communication buffer size - 8) bytes.
+*   The next chunk is got from the callback while the current chunk is sent to the security chip.<br>
+*
+* - The buffer must hold two chunks of #CMD_LIB_STREAM_MIN_CHUNK bytes, or of PpsSDVector->wLength bytes if smaller,
+*   otherwise #CMD_LIB_INSUFFICIENT_MEMORY is returned. A smaller buffer would need a command for every few bytes.<br>
+*
+* - The progress callback, if any, is invoked after each chunk written.<br>
+*
+* - The callbacks must not use the same optiga comms instance, which is acquired for the whole write.<br>
+*
+* - The object write handler of the instance, if any, is invoked before the first APDU.<br>
+*
+* - In case of failure,it is possible that partial data is written into the data object.<br>
+*
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*\param[in] PpsSDVector Pointer to Set Data Object inputs
+*\param[in] PpsStream Pointer to the stream providing the data
+*
+* \retval  #CMD_LIB_OK
+* \retval  #CMD_LIB_ERROR 
+* \retval  #CMD_LIB_INVALID_PARAM 
+* \retval  #CMD_LIB_INSUFFICIENT_MEMORY
+* \retval  #CMD_LIB_LENZERO_ERROR
+* \retval  #CMD_DEV_ERROR
+* \retval  #CMD_LIB_NULL_PARAM
+*/
+int32_t CmdLib_SetDataObjectStream(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector, const sDataStream_d *PpsStream)
+{
+/// @cond hidden
+#define OVERHEAD (OFFSET_PAYLOAD+BYTES_OID+BYTES_OFFSET)
+/// @endcond
+
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    int32_t i4ChunkStatus;
+    uint16_t wTotalWriteLen = 0;
+    uint16_t wWriteLen;
+    uint16_t wNextLen;
+    uint16_t wChunkLen;
+    uint16_t wOffset;
+    uint8_t* prgbChunk;
+    sApduData_d sApduData;
+    sApduVector_d sVector;
+    //Only the command header and the response are formatted here, the data is sent from the chunk
+    uint8_t rgbAPDUBuffer[OVERHEAD];
+    uint8_t rgbResponse[LEN_APDUHEADER];
+    sbBlob_d sTxData;
+
+    if(NULL == PpsOptigaComms)
+    {
+        return (int32_t)CMD_LIB_NULL_PARAM;
+    }
+
+    CmdLib_AcquireComms(PpsOptigaComms);
+    do
+    {
+        if(INVALID_MAX_COMMS_BUFF_SIZE == PpsOptigaComms->max_comms_buffer)
+        {
+            i4Status = (int32_t)CMD_DEV_EXEC_ERROR;
+            break;
+        }
+        if((NULL == PpsSDVector) || (NULL == PpsStream) ||
+           (NULL == PpsStream->pfGetChunk) || (NULL == PpsStream->prgbBuffer))
+        {
+            i4Status = (int32_t)CMD_LIB_NULL_PARAM;
+            break;
+        }
+        if(0x00 == PpsSDVector->wLength)
+        {
+            i4Status = (int32_t)CMD_LIB_LENZERO_ERROR;
+            break;
+        }
+        CmdLib_NotifyObjectWrite(PpsOptigaComms, PpsSDVector->wOID);
+
+        sApduData.bCmd = CMD_SETDATA;
+        if((eDATA == PpsSDVector->eDataOrMdata)&&
+        (eWRITE == PpsSDVector->eWriteOption))
+        {
+            sApduData.bParam = PARAM_SET_DATA;
+        }
+        else if((eDATA == PpsSDVector->eDataOrMdata)&&
+        (eERASE_AND_WRITE == PpsSDVector->eWriteOption))
+        {
+            sApduData.bParam = PARAM_SET_DATA_ERASE;
+        }
+        else
+        {
+            i4Status = (int32_t)CMD_LIB_INVALID_PARAM;
+            break;
+        }
+
+        //Two chunks are needed to get the next chunk while the current one is sent
+        wChunkLen = MIN((PpsOptigaComms->max_comms_buffer-OVERHEAD),(PpsStream->wBufferLength/2));
+        if((0x00 == wChunkLen) ||
+           ((wChunkLen < CMD_LIB_STREAM_MIN_CHUNK) && (wChunkLen < PpsSDVector->wLength)))
+        {
+            i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
+            break;
+        }
+
+        sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
+        sApduData.prgbRespBuffer = rgbResponse;
+        //copy OID
+        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsSDVector->wOID >> BITS_PER_BYTE);
+        sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + 1] = (uint8_t)PpsSDVector->wOID;
+        wOffset = PpsSDVector->wOffset;
+
+        prgbChunk = PpsStream->prgbBuffer;
+        wWriteLen = MIN(wChunkLen,PpsSDVector->wLength);
+        if(0 != PpsStream->pfGetChunk(PpsStream->pCtx,prgbChunk,wWriteLen))
+        {
+            i4Status = (int32_t)CMD_LIB_ERROR;
+            break;
+        }
+        do
+        {
+            //While chaining for erase & write option, all subsequent write must be only write operation
+            if((sApduData.bParam == PARAM_SET_DATA_ERASE)&&
+            (wTotalWriteLen != 0))
+            {
+                sApduData.bParam = PARAM_SET_DATA;
+            }
+            //set data payload length is 4(OID length + offset length) plus length of data to write
+            sApduData.wPayloadLength = BYTES_OID + BYTES_OFFSET + wWriteLen;
+
+            //copy offset
+            sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID] = (uint8_t)(wOffset >> BITS_PER_BYTE);
+            sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_OID + 1] = (uint8_t)wOffset;
+            sTxData.prgbStream = prgbChunk;
+            sTxData.wLen = wWriteLen;
+            sApduData.wResponseLength = sizeof(rgbResponse);
+
+            i4Status = TransceiveAPDUVectorStart(PpsOptigaComms,&sApduData,&sTxData,NULL,&sVector);
+            if(CMD_LIB_OK != i4Status)
+            {
+                break;
+            }
+
+            //Get the next chunk into the other half of the buffer while the current chunk is sent
+            wTotalWriteLen += wWriteLen;
+            wOffset += wWriteLen;
+            wNextLen = MIN(wChunkLen,(PpsSDVector->wLength-wTotalWriteLen));
+            prgbChunk = (prgbChunk == PpsStream->prgbBuffer) ? (PpsStream->prgbBuffer + wChunkLen) : PpsStream->prgbBuffer;
+            i4ChunkStatus = (int32_t)CMD_LIB_OK;
+            if((0x00 != wNextLen) && (0 != PpsStream->pfGetChunk(PpsStream->pCtx,prgbChunk,wNextLen)))
+            {
+                i4ChunkStatus = (int32_t)CMD_LIB_ERROR;
+            }
+
+            i4Status = TransceiveAPDUVectorFinish(PpsOptigaComms,&sApduData,TRUE);
+            if(CMD_LIB_OK != i4Status)
+            {
+                break;
+            }
+            if(NULL != PpsStream->pfProgress)
+            {
+                PpsStream->pfProgress(PpsStream->pCtx,wTotalWriteLen);
+            }
+            if(CMD_LIB_OK != i4ChunkStatus)
+            {
+                i4Status = i4ChunkStatus;
+                break;
+            }
+            wWriteLen = wNextLen;
+        }while(wTotalWriteLen != PpsSDVector->wLength);
+    }while(FALSE);
+    CmdLib_ReleaseComms(PpsOptigaComms);
+
+/// @cond hidden
+#undef OVERHEAD
 /// @endcond
 
     return i4Status;
@@ -1184,12 +1689,14 @@ int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector)
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
 * - The function does not verify if the read access is permitted for the data object.<br>
 * 
+* \param[in] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
+*
 * \retval  #CMD_LIB_OK
 * \retval  #CMD_LIB_ERROR 
 */
-uint16_t CmdLib_GetMaxCommsBufferSize(Void)
+uint16_t CmdLib_GetMaxCommsBufferSize(const optiga_comms_t* PpsOptigaComms)
 {
-	return wMaxCommsBuffer;
+	return PpsOptigaComms->max_comms_buffer;
 }
 #endif /* MODULE_ENABLE_READ_WRITE */
 
@@ -1208,6 +1715,7 @@ uint16_t CmdLib_GetMaxCommsBufferSize(Void)
 * - The \ref #sAuthMsg_d.prgbRnd and \ref #sAuthMsg_d.wRndLength carry the challenge to be signed.
 * - The length of challenge should be between 8 and 256 bytes. If the length of challenge is out of this range, #CMD_LIB_INVALID_LEN error is returned.<br>
 * 
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 *\param[in] PpsAuthMsg Pointer to Get Signature Object inputs
 *\param[in,out] PpsResponse Pointer to Response structure
 *
@@ -1218,10 +1726,9 @@ uint16_t CmdLib_GetMaxCommsBufferSize(Void)
 * \retval  #CMD_LIB_NULL_PARAM
 * \retval  #CMD_LIB_INVALID_LEN
 */
-int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsResponse)
+int32_t CmdLib_GetSignature(optiga_comms_t* PpsOptigaComms, const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsResponse)
 {
 /// @cond hidden
-#define STACK_ALLOC
 #define GETSIGN_APDU_BUF_LEN	270             //4 (cmd header) + 256 (Max Payload) + additional 10 
 /// @endcond
 
@@ -1229,15 +1736,11 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
 	sAuthScheme_d sAuthScheme;
+    uint8_t rgbAPDUBuffer[GETSIGN_APDU_BUF_LEN];
 
     do
     { 
-//To use stack memory for APDU buffer, define STACK_ALLOC locally else heap memory is used
-#ifdef STACK_ALLOC
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer,GETSIGN_APDU_BUF_LEN);
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,GETSIGN_APDU_BUF_LEN);
-#endif
+		sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         if((NULL == PpsAuthMsg)||(NULL == PpsAuthMsg->prgbRnd)||
         (NULL == PpsResponse)||(NULL == PpsResponse->prgbBuffer))
@@ -1260,7 +1763,7 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
         //Set Auth scheme  
 		sAuthScheme.eAuthScheme = eECDSA;
 		sAuthScheme.wDevicePrivKey = PpsAuthMsg->wOIDDevPrivKey;
-		i4Status = CmdLib_SetAuthScheme(&sAuthScheme);
+		i4Status = CmdLib_SetAuthScheme(PpsOptigaComms,&sAuthScheme);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1273,7 +1776,7 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
 		sApduData.wResponseLength = GETSIGN_APDU_BUF_LEN;
         //copy the random number
         OCP_MEMCPY(sApduData.prgbAPDUBuffer+OFFSET_PAYLOAD,PpsAuthMsg->prgbRnd,PpsAuthMsg->wRndLength);
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1284,7 +1787,7 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
         sApduData.bParam = PARAM_GET_AUTH_MSG;        
         sApduData.wPayloadLength = 0;
 		sApduData.wResponseLength = GETSIGN_APDU_BUF_LEN;
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1301,11 +1804,6 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
         OCP_MEMCPY(PpsResponse->prgbBuffer,sApduData.prgbAPDUBuffer+LEN_APDUHEADER,sApduData.wResponseLength);
 
     }while(FALSE);
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else	
-	#undef STACK_ALLOC
-#endif
 
 ///@cond hidden
 #undef GETSIGN_APDU_BUF_LEN
@@ -1322,6 +1820,7 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
  * - Command chaining is not supported in this API.<br>
  * - If the requested length of random bytes is either more than communication buffer size or more than the buffer size in PpsResponse,#CMD_LIB_INSUFFICIENT_MEMORY error is returned.<br>
  * 
+ *\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
  *\param[in]		PpsRng		Pointer to sRngOptions_d to specify random number generation
  *\param[in,out]	PpsResponse Pointer to sCmdResponse_d to store random number
  *
@@ -1332,7 +1831,7 @@ int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsRes
  * \retval  #CMD_DEV_ERROR
  * \retval  #CMD_LIB_NULL_PARAM
  */
-int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse)
+int32_t CmdLib_GetRandom(optiga_comms_t* PpsOptigaComms, const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse)
 {
     //lint --e{818} suppress "PpsResponse is out parameter"
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
@@ -1355,7 +1854,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
         }
 
         //If the length of requested random bytes is more than the maximum comms buffer size
-        if((wMaxCommsBuffer) < (LEN_APDUHEADER + PpsRng->wRandomDataLen))
+        if((PpsOptigaComms->max_comms_buffer) < (LEN_APDUHEADER + PpsRng->wRandomDataLen))
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
@@ -1365,7 +1864,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
         sApduData.bParam = (uint8_t)PpsRng->eRngType;        
         sApduData.wPayloadLength = LEN_PL_OID;
 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer, (LEN_APDUHEADER + PpsRng->wRandomDataLen));
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer, (LEN_APDUHEADER + PpsRng->wRandomDataLen));
 
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(PpsRng->wRandomDataLen >> BITS_PER_BYTE);
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + 1] = (uint8_t)PpsRng->wRandomDataLen;
@@ -1374,7 +1873,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
 
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1391,7 +1890,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
 
     }while(FALSE);
 
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
     return i4Status;
 }
@@ -1404,6 +1903,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
 * - Currently only 1 session OID (0xE100) is supported by the security chip.
 *
+*\param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 *\param[in] PpsAuthVector Pointer to Authentication Scheme data
 *
 * \retval  #CMD_LIB_OK
@@ -1413,7 +1913,7 @@ int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsRespons
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
+int32_t CmdLib_SetAuthScheme(optiga_comms_t* PpsOptigaComms, const sAuthScheme_d *PpsAuthVector)
 {
 /// @cond hidden
 #define SET_AUTH_SCHEME_APDU_BUF_LEN    10
@@ -1422,10 +1922,11 @@ int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
     uint16_t wPayloadSize;
+    uint8_t rgbAPDUBuffer[SET_AUTH_SCHEME_APDU_BUF_LEN];
     
     do
     {
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer, SET_AUTH_SCHEME_APDU_BUF_LEN);
+		sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         if(NULL == PpsAuthVector)
         {
@@ -1478,7 +1979,7 @@ int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
         }
 
         //Transmit the Data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1541,6 +2042,7 @@ int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
 *   &nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp;&nbsp; Available_Size = (wMaxCommsBuffer - #CALC_HASH_FIXED_OVERHEAD_SIZE - #CALC_HASH_IMPORT_AND_EXPORT_OVERHEAD_SIZE - #CALC_HASH_SHA256_CONTEXT_SIZE)<br>
 *
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in,out] PpsCalcHash Pointer to #sCalcHash_d that contains information to calculate hash
 *
 * \retval  #CMD_LIB_OK
@@ -1550,7 +2052,7 @@ int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector)
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
+int32_t CmdLib_CalcHash(optiga_comms_t* PpsOptigaComms, sCalcHash_d* PpsCalcHash)
 {
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
 	sApduData_d sApduData;
@@ -1639,7 +2141,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
         }
         
         //Validate the size of input data with the Communication buffer
-        if((wInDataLen + wOptTagLen + CALC_HASH_FIXED_OVERHEAD_SIZE) > wMaxCommsBuffer)
+        if((wInDataLen + wOptTagLen + CALC_HASH_FIXED_OVERHEAD_SIZE) > PpsOptigaComms->max_comms_buffer)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
@@ -1672,7 +2174,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
         }
         
         // Allocate the memory        
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer, wMemoryAllocLen);
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer, wMemoryAllocLen);
                 
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = (uint8_t)(((uint8_t)eHashDataType << NIBBLE_LEN) | (uint8_t) PpsCalcHash->eHashSequence);
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD + BYTES_SEQ] = (uint8_t)(wInDataLen >> 8);
@@ -1730,7 +2232,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
         
         sApduData.wResponseLength = wMemoryAllocLen;
         
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1775,7 +2277,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
         
     }while(FALSE);
     
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+	FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
 /// @cond hidden
 #undef INDATA_LEN_OID
@@ -1803,6 +2305,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.<br>
 * - If the the data to be sent to security chip is more than communication buffer,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in]     PpsVerifySign  Pointer to information for verifying signature
 * \param[in,out] PpsDigest      pointer to a blob which holds the Digest
 * \param[in,out] PpsSignature   pointer to a blob which holds the Signature to be verified
@@ -1814,7 +2317,7 @@ int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash)
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature)
+int32_t CmdLib_VerifySign(optiga_comms_t* PpsOptigaComms, const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature)
 {
 
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
@@ -1852,18 +2355,18 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
         {
             wCalApduLen = OFFSET_PAYLOAD + OID_APDU_INDATA_LEN + PpsDigest->wLen + PpsSignature->wLen;
         }
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsOptigaComms->max_comms_buffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
         //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
 
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
-				sApduData.wResponseLength = wMaxCommsBuffer;
+				sApduData.wResponseLength = PpsOptigaComms->max_comms_buffer;
         //Set digest tag, length, data
         sApduData.prgbAPDUBuffer[OFFSET_PAYLOAD] = TAG_DIGEST;
         Utility_SetUint16(&sApduData.prgbAPDUBuffer[wWritePosition + TAG_LENGTH_OFFSET], PpsDigest->wLen);
@@ -1909,7 +2412,7 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 
 
         //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -1917,7 +2420,7 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
     }while(FALSE);
 
     //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
  
 /// @cond hidden
 	#undef DATA_STREAM_APDU_INDATA_LEN
@@ -1943,8 +2446,10 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 * Notes:
 * - Application on security chip must be opened using #CmdLib_OpenApplication before using this API.
 * - Values of #eKeyUsage_d can be logically 'ORed' and passed to \ref sKeyPairOption_d.eKeyUsage.
+* - With #eStorePrivKeyOnly, the object write handler of the instance, if any, is invoked with the OID before the command.
 * - If the memory buffers in #sOutKeyPair_d is not sufficient to store the generated keys,#CMD_LIB_INSUFFICIENT_MEMORY is returned. Refer OPTIGA_Trust_X_SolutionReferenceManual_v1.x.pdf for more details.
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PpsKeyPairOption Pointer to #sKeyPairOption_d to provide input for key pair generation
 * \param[in,out] PpsOutKeyPair Pointer to #sOutKeyPair_d that contains generated key pair
 *
@@ -1955,7 +2460,7 @@ int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d *
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair)
+int32_t CmdLib_GenerateKeyPair(optiga_comms_t* PpsOptigaComms, const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
 	uint16_t wWritePosition = LEN_APDUHEADER;
@@ -2007,7 +2512,7 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 
 		wCalApduLen += ((wAlgoLen * bMultiplier) + 2);
 		//Allocating Heap memory 
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+		INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
 
 		//Set the pointer to the response buffer
 		sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
@@ -2040,8 +2545,18 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 		sApduData.bCmd = CMD_GENERATE_KEY_PAIR;
 		sApduData.bParam = (uint8_t)PpsKeyPairOption->eAlgId;
 
-		//Transmit data
-		i4Status = TransceiveAPDU(&sApduData,TRUE);
+		//Transmit data, a key stored in a key object changes its data and metadata
+		if((eStorePrivKeyOnly == PpsKeyPairOption->eKeyExport) && (NULL != PpsOptigaComms))
+		{
+			CmdLib_AcquireComms(PpsOptigaComms);
+			CmdLib_NotifyObjectWrite(PpsOptigaComms, PpsKeyPairOption->wOIDPrivKey);
+			i4Status = TransceiveAPDUVectorHeld(PpsOptigaComms,&sApduData,NULL,NULL,TRUE);
+			CmdLib_ReleaseComms(PpsOptigaComms);
+		}
+		else
+		{
+			i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
+		}
 		if(CMD_LIB_OK != i4Status)
 		{
 			break;
@@ -2068,7 +2583,7 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 	}while(FALSE);
 
 	//Free the allocated memory for buffer
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+	FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
 /// @cond hidden
 	#undef TAG_PUBLIC_KEY
@@ -2097,6 +2612,7 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 * - If the memory buffer in PpsSignature is not sufficient to store the generated signature,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
 
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PpsCalcSign Pointer to #sCalcSignOptions_d to provide input for signature generation
 * \param[in,out] PpsSignature Pointer to #sbBlob_d that contains generated signature
 *
@@ -2107,7 +2623,7 @@ int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyP
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature)
+int32_t CmdLib_CalculateSign(optiga_comms_t* PpsOptigaComms, const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
 	uint16_t wWritePosition = LEN_APDUHEADER;
@@ -2136,14 +2652,14 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 		
         //Calculate the size of memory to be allocated
         wCalApduLen = LEN_APDUHEADER + (TX_LEN > SIGNATURE_LEN ? TX_LEN : SIGNATURE_LEN);
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsOptigaComms->max_comms_buffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
         //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
 
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
@@ -2168,7 +2684,7 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
         sApduData.bParam = (uint8_t)PpsCalcSign->eSignScheme;
 
         //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -2186,7 +2702,7 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
     }while(FALSE);
 
     //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
 
 /// @cond hidden
@@ -2218,6 +2734,7 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 * - If the memory buffer in PpsSecret is not sufficient to store the calculated secret,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
 
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PpsCalcSSec Pointer to #sCalcSSecOptions_d to provide input for shared secret calculation
 * \param[in,out] PpsSecret Pointer to #sbBlob_d that contains calculated shared secret
 *
@@ -2228,7 +2745,7 @@ int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *Pps
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret)
+int32_t CmdLib_CalculateSharedSecret(optiga_comms_t* PpsOptigaComms, const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
 	uint16_t wWritePosition = LEN_APDUHEADER;
@@ -2278,14 +2795,14 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
         }
 
 		//Check max comms buffer size
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsOptigaComms->max_comms_buffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
         //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
 
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
@@ -2331,7 +2848,7 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
         sApduData.bParam = (uint8_t)PpsCalcSSec->eKeyAgreementType;
 
         //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -2352,7 +2869,7 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
     }while(FALSE);
 
     //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
     /// @cond hidden
 	#undef CALCSSEC_APDU_LEN
@@ -2388,6 +2905,7 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
 * - If the memory buffer in PpsKey is not sufficient to store the derived key,#CMD_LIB_INSUFFICIENT_MEMORY is returned.
 
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PpsDeriveKey	Pointer to #sDeriveKeyOptions_d to provide input for session key generation
 * \param[in,out] PpsKey		Pointer to #sbBlob_d that contains the derived key
 *
@@ -2398,7 +2916,7 @@ int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlo
 * \retval  #CMD_DEV_EXEC_ERROR
 * \retval  #CMD_DEV_ERROR
 */
-int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey)
+int32_t CmdLib_DeriveKey(optiga_comms_t* PpsOptigaComms, const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey)
 {
 	int32_t i4Status = (int32_t)CMD_LIB_ERROR;
 	uint16_t wWritePosition = LEN_APDUHEADER;
@@ -2448,14 +2966,14 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
         }
 
         //Check max comms buffer size
-        if((wMaxCommsBuffer) < wCalApduLen)
+        if((PpsOptigaComms->max_comms_buffer) < wCalApduLen)
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
         }
 
         //Allocating Heap memory 
-        INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
+        INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,wCalApduLen);
 
         //Set the pointer to the response buffer
         sApduData.prgbRespBuffer = sApduData.prgbAPDUBuffer;
@@ -2501,7 +3019,7 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
         sApduData.bParam = (uint8_t)PpsDeriveKey->eKDM;
 
         //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -2522,7 +3040,7 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
     }while(FALSE);
 
     //Free the allocated memory for buffer
-    FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
+    FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
 
     /// @cond hidden
 	#undef DERIVEKEY_APDU_LEN
@@ -2562,6 +3080,7 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
 *
 *   The psBlobInBuffer pointer which is member of sProcMsgData_d should be set to NULL
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in,out] PpsGMsgVector Pointer to DTLS Handshake Message parameters
 *
 * \retval  #CMD_LIB_OK
@@ -2571,26 +3090,18 @@ int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKe
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector)
+int32_t CmdLib_GetMessage(optiga_comms_t* PpsOptigaComms, const sProcMsgData_d *PpsGMsgVector)
 {  
-///@cond hidden
-#define STACK_ALLOC
-///@endcond
-
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
     uint8_t bFragSeq ;
     uint16_t wRespLen;
     sbBlob_d sBlobMessage;
 	
+    sApduData.prgbAPDUBuffer = NULL;
     do
     {	
-//To use stack memory for APDU buffer, define STACK_ALLOC locally else heap memory is used
-#ifdef STACK_ALLOC
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer,MAX_APDU_BUFF_LEN);
-#else
-		INIT_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer,MAX_APDU_BUFF_LEN);
-#endif
+		INIT_APDUBUFFER(sApduData.prgbAPDUBuffer,MAX_APDU_BUFF_LEN);
         
         //NULL checks
         if((NULL == PpsGMsgVector) || (NULL == PpsGMsgVector->psCallBack) || 
@@ -2656,7 +3167,7 @@ int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector)
                 Utility_SetUint16 (&sApduData.prgbAPDUBuffer[OFFSET_TAG_DATA],PpsGMsgVector->puMsgParams->sMsgParamCert_d.wCertOID);
             }		
             //Transmit data
-            i4Status = TransceiveAPDU(&sApduData,TRUE);
+            i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
             if(CMD_LIB_OK != i4Status)
             {
                 break;
@@ -2703,12 +3214,8 @@ int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector)
         //The response pointer should be updated for each loop and check for buffer overflow
     }while(FALSE);
 
-    //Free the allocated memory for buffer
-#ifndef STACK_ALLOC
-	FREE_HEAP_APDUBUFFER(sApduData.prgbAPDUBuffer);
-#else
-	#undef STACK_ALLOC
-#endif
+    //Return the buffer
+	FREE_APDUBUFFER(sApduData.prgbAPDUBuffer);
     
     return i4Status;
 }
@@ -2729,6 +3236,7 @@ int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector)
 *
 *	The puMsgParams and psCallBack pointer which is member of sProcMsgData_d should be set to NULL
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PpsPMsgVector Pointer to DTLS Handshake Message parameters
 *
 * \retval  #CMD_LIB_OK
@@ -2738,7 +3246,7 @@ int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector)
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */
-int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
+int32_t CmdLib_PutMessage(optiga_comms_t* PpsOptigaComms, const sProcMsgData_d *PpsPMsgVector)
 {
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
@@ -2777,9 +3285,9 @@ int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
             break;
         }
 
-        //Length of data + OverHeadLen should not to be more than wMaxCommsBuffer
+        //Length of data + OverHeadLen should not to be more than PpsOptigaComms->max_comms_buffer
         //Currently, chaining is not supported by Command library and security chip.Hence, this length check is performed.
-        if(PpsPMsgVector->psBlobInBuffer->wLen > (wMaxCommsBuffer) )
+        if(PpsPMsgVector->psBlobInBuffer->wLen > (PpsOptigaComms->max_comms_buffer) )
         {
             i4Status = (int32_t)CMD_LIB_INSUFFICIENT_MEMORY;
             break;
@@ -2812,7 +3320,7 @@ int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
 
         sApduData.wResponseLength = PpsPMsgVector->psBlobInBuffer->wLen;
         //Transmit data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -2827,6 +3335,7 @@ int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
 * Closes the DTLS session as indicated by the Session OID.<br>
 *
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in] PwSessionRefId session OID to be closed
 *
 * \retval  #CMD_LIB_OK
@@ -2834,7 +3343,7 @@ int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector)
 * \retval  #CMD_LIB_INVALID_SESSIONID
 * \retval  #CMD_LIB_INSUFFICIENT_MEMORY
 */
-int32_t CmdLib_CloseSession(uint16_t PwSessionRefId)
+int32_t CmdLib_CloseSession(optiga_comms_t* PpsOptigaComms, uint16_t PwSessionRefId)
 {
 /// @cond hidden
 #define CLOSE_SESSION_APDU_BUF_LEN    6
@@ -2842,10 +3351,11 @@ int32_t CmdLib_CloseSession(uint16_t PwSessionRefId)
 
     int32_t i4Status = (int32_t)CMD_LIB_ERROR;
     sApduData_d sApduData;
+    uint8_t rgbAPDUBuffer[CLOSE_SESSION_APDU_BUF_LEN];
 
     do
     {
-		INIT_STACK_APDUBUFFER(sApduData.prgbAPDUBuffer,CLOSE_SESSION_APDU_BUF_LEN);
+		sApduData.prgbAPDUBuffer = rgbAPDUBuffer;
 
         //Verify the session id 
         if((SESSION_ID_LOWER_VALUE > PwSessionRefId) ||
@@ -2872,7 +3382,7 @@ int32_t CmdLib_CloseSession(uint16_t PwSessionRefId)
 		sApduData.wResponseLength = CLOSE_SESSION_APDU_BUF_LEN;
 
         //Transmit the Data
-        i4Status = TransceiveAPDU(&sApduData,TRUE);
+        i4Status = TransceiveAPDU(PpsOptigaComms,&sApduData,TRUE);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -2911,6 +3421,7 @@ int32_t CmdLib_CloseSession(uint16_t PwSessionRefId)
 *
 * - Currently,the security chip supports only 0xE100 as session key OID.
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in,out] PpsEncVector Pointer to structure containing Plaintext and Ciphertext 
 *
 * \retval  #CMD_LIB_OK
@@ -2921,9 +3432,9 @@ int32_t CmdLib_CloseSession(uint16_t PwSessionRefId)
 * \retval  #CMD_DEV_ERROR
 * \retval  #CMD_LIB_NULL_PARAM
 */ 
-int32_t CmdLib_Encrypt(sProcCryptoData_d *PpsEncVector)
+int32_t CmdLib_Encrypt(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsEncVector)
 {
-	return CmdLib_EncDecHelper(PpsEncVector,CMD_ENCDATA,PARAM_ENC_DATA);
+	return CmdLib_EncDecHelper(PpsOptigaComms,PpsEncVector,CMD_ENCDATA,PARAM_ENC_DATA);
 }
 
 /**
@@ -2951,6 +3462,7 @@ int32_t CmdLib_Encrypt(sProcCryptoData_d *PpsEncVector)
 *
 * - Currently,the security chip supports only 0xE100 as session key OID.
 *
+* \param[in,out] PpsOptigaComms Pointer to the optiga comms instance of the OPTIGA
 * \param[in,out] PpsDecVector Pointer to structure containing Ciphertext and Plaintext
 *
 * \retval  #CMD_LIB_OK
@@ -2962,9 +3474,9 @@ int32_t CmdLib_Encrypt(sProcCryptoData_d *PpsEncVector)
 * \retval  #CMD_LIB_DECRYPT_FAILURE
 * \retval  #CMD_LIB_NULL_PARAM
 */ 
-int32_t CmdLib_Decrypt(sProcCryptoData_d *PpsDecVector)
+int32_t CmdLib_Decrypt(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsDecVector)
 {
-	return CmdLib_EncDecHelper(PpsDecVector,CMD_DECDATA,PARAM_DEC_DATA);
+	return CmdLib_EncDecHelper(PpsOptigaComms,PpsDecVector,CMD_DECDATA,PARAM_DEC_DATA);
 }
 #endif /* MODULE_ENABLE_DTLS_MUTUAL_AUTH*/
 
@@ -74,6 +74,9 @@ void ifx_i2c_tl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event,
 /// Performs initialization
 static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* ifx_i2c_context);
 
+/// Takes the frame buffers from the frame arena and limits the frame size to the arena
+static host_lib_status_t ifx_i2c_setup_frame_buffers(ifx_i2c_context_t* p_ctx);
+
 //lint --e{526} suppress "This API is defined in ifx_i2c_physical_layer. Since it is a low level API, 
 //to avoid exposing, header file is not included "
 extern host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8_t slave_address, uint8_t storage_type);
@@ -102,10 +105,12 @@ extern host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx
  * - The following parameters in #ifx_i2c_context_t must be initialized with appropriate values <br>
  *   - <b>slave address</b> : Address of I2C slave
  *   - <b>frame_size</b> : Frame size in bytes.Minimum supported value is 16 bytes.<br> 
- *              - It is recommended not to use a value greater than the slave's frame size.
- *              - The user specified frame size is written to I2C slave's frame size register.
+ *              - Set to 0 to request the largest frame size the frame arena holds.
+ *                A value greater than the frame arena holds is reduced to it.
+ *              - The requested frame size is written to I2C slave's frame size register.
  *                The frame size register is read back from I2C slave.
- *                This frame value is used by the ifx-i2c protocol even if it is not equal to the user specified value.
+ *                This frame value is used by the ifx-i2c protocol even if it is not equal to the requested value,
+ *                and is stored in frame_size.
  *
  *   - <b>frequency</b> : Frequency/speed of I2C master in KHz.
  *              - This must be lowest of the maximum frequency supported by the devices (master/slave) connected on the bus.
@@ -118,10 +123,19 @@ extern host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx
  *   - <b>upper_layer_ctx</b> : Context of upper layer.
  *   - <b>p_slave_vdd_pin</b> : GPIO pin for VDD. If not set, cold reset is not done. 
  *   - <b>p_slave_reset_pin</b> : GPIO pin for Reset. If not set, warm reset is not done.
+ *   - <b>p_frame_arena</b>, <b>frame_arena_size</b> : Memory for the frame buffers, must stay valid until
+ *              #ifx_i2c_close(). #IFX_I2C_FRAME_ARENA_SIZE gives the size for a frame size.
+ *   - <b>warm_open</b> : Set to TRUE to reuse the frame size and frequency negotiated by a previous open.
+ *              - No reset is done and the negotiation is skipped. The slave's frame size is read back and the 
+ *                frame counters are re-synchronized with the first frame.
+ *              - If the frame size read back differs, the full negotiation is done. If the slave does not respond,
+ *                the full reset and negotiation sequence is done. In both cases warm_open is set to FALSE.
  *
  *<b>Notes:</b>
  * - The values of registers MAX_SCL_FREQU and DATA_REG_LEN, read from slave are not validated.
- * - At present, only single instance of #ifx_i2c_context_t is supported.
+ * - Multiple instances of #ifx_i2c_context_t are supported, one per OPTIGA. Each instance must use its own
+ *   pal i2c context and gpio contexts, and the instances may be driven concurrently.
+ *   The linux and sim ports support multiple instances, the esp32, nrf5x, xmc and libusb ports a single one.
  *
  *<br>
  *
@@ -135,11 +149,13 @@ host_lib_status_t ifx_i2c_open(ifx_i2c_context_t *p_ctx)
     host_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
     
     //If api status is not busy, proceed
-    if ((IFX_I2C_STATUS_BUSY != p_ctx->status))
+    if ((IFX_I2C_STATUS_BUSY != p_ctx->status) &&
+        (IFX_I2C_STACK_SUCCESS == ifx_i2c_setup_frame_buffers(p_ctx)))
     {
         p_ctx->p_pal_i2c_ctx->upper_layer_ctx = p_ctx;      
         p_ctx->reset_type = (uint8_t)IFX_I2C_COLD_RESET;
-        p_ctx->reset_state = IFX_I2C_STATE_RESET_PIN_LOW;
+        // Warm open starts directly with the initialization of the protocol stack
+        p_ctx->reset_state = (TRUE == p_ctx->warm_open)?IFX_I2C_STATE_RESET_INIT:IFX_I2C_STATE_RESET_PIN_LOW;
         p_ctx->do_pal_init = TRUE;
         p_ctx->state = IFX_I2C_STATE_UNINIT;
 
@@ -192,6 +208,7 @@ host_lib_status_t ifx_i2c_reset(ifx_i2c_context_t *p_ctx, ifx_i2c_reset_type_t r
         p_ctx->reset_type = (uint8_t)reset_type;
         p_ctx->reset_state = IFX_I2C_STATE_RESET_PIN_LOW;
         p_ctx->do_pal_init = FALSE;
+        p_ctx->warm_open = FALSE;
 
         api_status = ifx_i2c_init(p_ctx);
         if(IFX_I2C_STACK_SUCCESS == api_status)
@@ -258,6 +275,62 @@ host_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t *p_ctx,const uint8_t* p_d
     return api_status;
 }
 
+/**
+ * Sends a command and receives a response for the command, both scattered over several buffers.
+ * <br>
+ *
+ *<b>Pre Conditions:</b>
+ * - IFX I2C protocol stack must be initialized.<br>
+ *
+ *<b>API Details:</b>
+ * - Same as #ifx_i2c_transceive(), but the command is the concatenation of the transmit segments and the
+ *   response is stored in the receive segments in order.<br>
+ * - The transport layer frames the command directly from the transmit segments and copies the response
+ *   directly into the receive segments, no contiguous copy of either is made.<br>
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The input #ifx_i2c_context_t p_ctx must not be NULL.
+ * - The segments and the buffers they point to must remain valid until the transceive is completed.
+ *
+ *<b>Notes:</b>
+ * - The actual number of bytes received is stored in p_rx_buffer_len.<br>
+ * - If the response is longer than the sum of the receive segment lengths then
+ *   #IFX_I2C_STACK_MEM_ERROR error is returned.
+ *
+ * \param[in,out] p_ctx             Pointer to #ifx_i2c_context_t
+ * \param[in]     p_tx_vector       Segments of the command
+ * \param[in]     tx_count          Number of segments in p_tx_vector
+ * \param[in]     p_rx_vector       Segments of the receive buffer
+ * \param[in]     rx_count          Number of segments in p_rx_vector
+ * \param[out]    p_rx_buffer_len   Number of bytes received
+ *
+ * \retval  #IFX_I2C_STACK_SUCCESS 
+ * \retval  #IFX_I2C_STACK_ERROR
+ * \retval  #IFX_I2C_STACK_MEM_ERROR
+ */
+host_lib_status_t ifx_i2c_transceive_vector(ifx_i2c_context_t *p_ctx,
+                                            const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                            const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                            uint16_t* p_rx_buffer_len)
+{
+    host_lib_status_t api_status = (int32_t)IFX_I2C_STACK_ERROR;
+    // Proceed, if not busy and in idle state
+    if ((IFX_I2C_STATE_IDLE == p_ctx->state) && (IFX_I2C_STATUS_BUSY != p_ctx->status) &&
+        (NULL != p_rx_vector) && (0 != rx_count))
+    { 
+        p_ctx->p_upper_layer_rx_buffer = p_rx_vector[0].prgbStream;
+        p_ctx->p_upper_layer_rx_buffer_len = p_rx_buffer_len;
+        api_status = ifx_i2c_tl_transceive_vector(p_ctx, p_tx_vector, tx_count, p_rx_vector, rx_count,
+                                                  p_rx_buffer_len);
+        if (IFX_I2C_STACK_SUCCESS == api_status)
+        {
+            p_ctx->status = IFX_I2C_STATUS_BUSY;
+        }
+    }
+    return api_status;
+}
+
 
 /**
  * Closes the IFX I2C protocol stack for a given context.
@@ -295,6 +368,13 @@ host_lib_status_t ifx_i2c_close(ifx_i2c_context_t *p_ctx)
         // Also power off the device
         pal_gpio_set_low(p_ctx->p_slave_vdd_pin);
         pal_gpio_set_low(p_ctx->p_slave_reset_pin);
+#ifdef PAL_GPIO_HAS_IRQ
+        if (p_ctx->pl.irq_enabled)
+        {
+            pal_gpio_unregister_irq(p_ctx->p_slave_irq_pin);
+            p_ctx->pl.irq_enabled = FALSE;
+        }
+#endif
         
         ifx_i2c_tl_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS,NULL,0);
         p_ctx->state = IFX_I2C_STATE_UNINIT;
@@ -351,11 +431,17 @@ host_lib_status_t ifx_i2c_set_slave_address(ifx_i2c_context_t *p_ctx, uint8_t sl
 //lint --e{715} suppress "This is ignored as ifx_i2c_event_handler_t handler function prototype requires this argument"
 void ifx_i2c_tl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event, const uint8_t* p_data, uint16_t data_len)
 {
-    // If there is no upper layer handler, don't do anything and return
-    if (NULL != p_ctx->upper_layer_event_handler)
+    // If the warm open failed, retry with the full reset and negotiation sequence
+    if ((IFX_I2C_STATE_UNINIT == p_ctx->state) && (IFX_I2C_STACK_SUCCESS != event) && (TRUE == p_ctx->warm_open))
     {
-        p_ctx->upper_layer_event_handler(p_ctx->p_upper_layer_ctx,event);
+        p_ctx->warm_open = FALSE;
+        p_ctx->reset_state = IFX_I2C_STATE_RESET_PIN_LOW;
+        if (IFX_I2C_STACK_SUCCESS == ifx_i2c_init(p_ctx))
+        {
+            return;
+        }
     }
+    // Update the state before the handler wakes up the caller, which may start the next request right away
     p_ctx->status = IFX_I2C_STATUS_NOT_BUSY;
     switch(p_ctx->state)
     {
@@ -368,8 +454,37 @@ void ifx_i2c_tl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status_t event,
         default:
             break;
     }
+    // If there is no upper layer handler, don't do anything and return
+    if (NULL != p_ctx->upper_layer_event_handler)
+    {
+        p_ctx->upper_layer_event_handler(p_ctx->p_upper_layer_ctx,event);
+    }
 }
 
+static host_lib_status_t ifx_i2c_setup_frame_buffers(ifx_i2c_context_t* p_ctx)
+{
+    uint16_t max_frame_size;
+
+    if ((NULL == p_ctx->p_frame_arena) ||
+        (p_ctx->frame_arena_size < IFX_I2C_FRAME_ARENA_SIZE(DL_MIN_FRAME_SIZE)))
+    {
+        return IFX_I2C_STACK_ERROR;
+    }
+    max_frame_size = (p_ctx->frame_arena_size - 1) / 3;
+
+    // Physical layer buffer holds a frame and the register address
+    p_ctx->pl.buffer = p_ctx->p_frame_arena;
+    p_ctx->tx_frame_buffer = p_ctx->pl.buffer + max_frame_size + 1;
+    p_ctx->rx_frame_buffer = p_ctx->tx_frame_buffer + max_frame_size;
+
+    if ((0 == p_ctx->frame_size) || (p_ctx->frame_size > max_frame_size))
+    {
+        // The frame size negotiated before does not fit, negotiate again
+        p_ctx->warm_open = FALSE;
+        p_ctx->frame_size = max_frame_size;
+    }
+    return IFX_I2C_STACK_SUCCESS;
+}
 
 static host_lib_status_t ifx_i2c_init(ifx_i2c_context_t* p_ifx_i2c_context)
 {    
@@ -49,6 +49,9 @@
 * DATA STRUCTURES
 ***********************************************************************************************************************/
 
+/** @brief Frame buffers of the default IFX I2C context */
+static uint8_t ifx_i2c_frame_arena_0[IFX_I2C_FRAME_ARENA_SIZE(DL_MAX_FRAME_SIZE)];
+
 /** @brief This is IFX I2C context. Only one context is supported per slave.*/
 //lint --e{785} suppress "Only required fields are initialized, the rest are handled by consumer of this structure"
 ifx_i2c_context_t ifx_i2c_context_0 =
@@ -57,18 +60,22 @@ ifx_i2c_context_t ifx_i2c_context_0 =
     0x30,
     /// i2c-master frequency
     400,
-    /// IFX-I2C frame size
-#if (DL_MAX_FRAME_SIZE >= 0x0115)
-    0x0115,
-#else
-	DL_MAX_FRAME_SIZE,
-#endif
+    /// IFX-I2C frame size, negotiated up to the size of the frame arena
+    0,
     /// Vdd pin
     &optiga_vdd_0,
     /// Reset pin
     &optiga_reset_0,
     /// optiga pal i2c context
     &optiga_pal_i2c_context_0,
+    /// Warm open
+    FALSE,
+    /// Frame arena
+    ifx_i2c_frame_arena_0,
+    /// Size of the frame arena
+    sizeof(ifx_i2c_frame_arena_0),
+    /// Response pin, the I2C_STATE register is polled
+    NULL,
 };
 
 /***********************************************************************************************************************
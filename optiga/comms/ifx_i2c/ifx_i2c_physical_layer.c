@@ -66,6 +66,7 @@
 #define PL_ACTION_WRITE_REGISTER        (0x02)
 #define PL_I2C_CMD_WRITE                (0x01)
 #define PL_I2C_CMD_READ                 (0x02)
+#define PL_I2C_CMD_WRITE_READ           (0x03)
 
 // Physical Layer high level interface constants
 #define PL_ACTION_WRITE_FRAME           (0x01)
@@ -89,6 +90,9 @@
 #define PL_INIT_GET_STATUS_REG          (0x99)
 #define PL_INIT_DONE                    (0xAA)
 #define PL_INIT_SET_FREQ_DEFAULT        (0xBB)
+#define PL_INIT_WARM_SET_FREQ           (0xCC)
+#define PL_INIT_WARM_GET_DATA_REG_LEN   (0xDD)
+#define PL_INIT_WARM_VERIFY_DATA_REG    (0xEE)
 
 //Physical layer soft reset states
 #define PL_RESET_INIT                   (0xA1)
@@ -106,6 +110,23 @@
 // Physical Layer Base Address Register mask
 #define PL_REG_I2C_BASE_ADDRESS_MASK     (0x7F)
 
+// Frame fields used to identify the command being sent for the latency model
+#define PL_FRAME_FCTR_OFFSET            (0)
+#define PL_FRAME_PCTR_OFFSET            (3)
+#define PL_FRAME_COMMAND_OFFSET         (4)
+#define PL_FRAME_FCTR_CONTROL_FRAME     (0x80)
+#define PL_FRAME_PCTR_CHAIN_MASK        (0x07)
+#define PL_FRAME_PCTR_CHAIN_NO          (0x00)
+#define PL_FRAME_PCTR_CHAIN_FIRST       (0x01)
+#define PL_FRAME_PCTR_CHAIN_LAST        (0x04)
+
+// Latency model constants
+#define PL_LATENCY_NONE                 (0xFF)
+// Weight of a new observation is 1/2^PL_LATENCY_WEIGHT_SHIFT
+#define PL_LATENCY_WEIGHT_SHIFT         (2)
+// First poll is done 1/2^PL_LATENCY_EARLY_SHIFT ahead of the expected latency
+#define PL_LATENCY_EARLY_SHIFT          (3)
+
 // Setup debug log statements
 #if IFX_I2C_LOG_PL == 1
 #include "common/Log_api.h"
@@ -123,8 +144,6 @@
 * GLOBAL
 ***********************************************************************************************************************/
 
-static host_lib_status_t pal_event_status;
-
 /***********************************************************************************************************************
 * LOCAL ROUTINES
 ***********************************************************************************************************************/
@@ -150,6 +169,16 @@ static void ifx_i2c_pl_guard_time_callback(void *p_ctx);
 static void ifx_i2c_pl_pal_event_handler(void *p_ctx, host_lib_status_t event);
 /// Physical layer low level event handler for set slave address
 static void ifx_i2c_pl_pal_slave_addr_event_handler(void *p_input_ctx, host_lib_status_t event);
+/// Physical Layer latency model, identifies the command of the frame being sent
+static void ifx_i2c_pl_latency_classify(ifx_i2c_context_t *p_ctx);
+/// Physical Layer latency model, learns from the response to the command in flight
+static void ifx_i2c_pl_latency_update(ifx_i2c_context_t *p_ctx);
+/// Physical Layer high level interface function, schedules the next status register poll
+static void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t *p_ctx);
+
+#ifdef PAL_GPIO_HAS_IRQ
+static void ifx_i2c_pl_irq_handler(void *p_ctx);
+#endif
   
 /// @endcond
 /***********************************************************************************************************************
@@ -162,10 +191,24 @@ host_lib_status_t ifx_i2c_pl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 	        
     p_ctx->pl.upper_layer_event_handler = handler;
     p_ctx->pl.frame_state = PL_STATE_UNINIT;
-    p_ctx->pl.negotiate_state = PL_INIT_SET_FREQ_DEFAULT;
+    p_ctx->pl.negotiate_state = (TRUE == p_ctx->warm_open)?PL_INIT_WARM_SET_FREQ:PL_INIT_SET_FREQ_DEFAULT;
     p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->slave_address;
     p_ctx->p_pal_i2c_ctx->upper_layer_event_handler = ifx_i2c_pl_pal_event_handler;
     p_ctx->pl.retry_counter = PL_POLLING_MAX_CNT;
+    p_ctx->pl.latency_index = PL_LATENCY_NONE;
+    p_ctx->pl.latency_last_fragment = FALSE;
+    p_ctx->pl.latency_pending = FALSE;
+    p_ctx->pl.irq_enabled = FALSE;
+    p_ctx->pl.irq_armed = FALSE;
+    p_ctx->pl.irq_pending = FALSE;
+#ifdef PAL_GPIO_HAS_IRQ
+    // Without the response pin or if it can not report edges, the status register is polled
+    if ((NULL != p_ctx->p_slave_irq_pin) &&
+        (PAL_STATUS_SUCCESS == pal_gpio_register_irq(p_ctx->p_slave_irq_pin, ifx_i2c_pl_irq_handler, (void *)p_ctx)))
+    {
+        p_ctx->pl.irq_enabled = TRUE;
+    }
+#endif
 	
 	if(TRUE == p_ctx->do_pal_init)
     {
@@ -206,6 +249,7 @@ host_lib_status_t ifx_i2c_pl_send_frame(ifx_i2c_context_t *p_ctx,uint8_t* p_fram
     // Store reference to frame for sending it later
     p_ctx->pl.p_tx_frame   = p_frame;
     p_ctx->pl.tx_frame_len = frame_len;
+    ifx_i2c_pl_latency_classify(p_ctx);
 
     ifx_i2c_pl_frame_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS);
     return IFX_I2C_STACK_SUCCESS;
@@ -220,6 +264,7 @@ host_lib_status_t ifx_i2c_pl_receive_frame(ifx_i2c_context_t *p_ctx)
         return IFX_I2C_STACK_ERROR;
     }
     p_ctx->pl.frame_action = PL_ACTION_READ_FRAME;
+    p_ctx->pl.poll_interval_us = PL_POLLING_INVERVAL_US;
 
     ifx_i2c_pl_frame_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS);
     return IFX_I2C_STACK_SUCCESS;
@@ -258,12 +303,12 @@ host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8
 
     while(p_ctx->pl.retry_counter)
     {
-        pal_event_status = PAL_WRITE_INIT_STATUS;
+        p_ctx->pl.pal_event_status = PAL_WRITE_INIT_STATUS;
 
         //lint --e{534} suppress "Return value is not required to be checked"
         pal_i2c_write(p_ctx->p_pal_i2c_ctx,p_ctx->pl.buffer, p_ctx->pl.buffer_tx_len);
-        while(PAL_WRITE_INIT_STATUS == pal_event_status){};
-        if(PAL_I2C_EVENT_SUCCESS == pal_event_status)
+        while(PAL_WRITE_INIT_STATUS == p_ctx->pl.pal_event_status){};
+        if(PAL_I2C_EVENT_SUCCESS == p_ctx->pl.pal_event_status)
         {
             break;
         }
@@ -271,7 +316,7 @@ host_lib_status_t ifx_i2c_pl_write_slave_address(ifx_i2c_context_t *p_ctx, uint8
         pal_os_timer_delay_in_milliseconds(PL_POLLING_INVERVAL_US);
     }
 
-    if(PAL_I2C_EVENT_SUCCESS == pal_event_status)
+    if(PAL_I2C_EVENT_SUCCESS == p_ctx->pl.pal_event_status)
     {
         p_ctx->p_pal_i2c_ctx->slave_address = p_ctx->pl.buffer[ADDRESS_OFFSET];
         if(PL_REG_BASE_ADDR_VOLATILE != persistent)
@@ -297,6 +342,12 @@ static void ifx_i2c_pl_read_register(ifx_i2c_context_t *p_ctx,uint8_t reg_addr,
 {
     LOG_PL("[IFX-PL]: Read register %x len %d\n", reg_addr, reg_len);
 
+    // The status read observes all frames signalled by the response pin so far
+    if (PL_REG_I2C_STATE == reg_addr)
+    {
+        p_ctx->pl.irq_pending = FALSE;
+    }
+
     // Prepare transmit buffer to write register address
     p_ctx->pl.buffer[0]     = reg_addr;
     p_ctx->pl.buffer_tx_len = 1;
@@ -305,10 +356,20 @@ static void ifx_i2c_pl_read_register(ifx_i2c_context_t *p_ctx,uint8_t reg_addr,
     p_ctx->pl.buffer_rx_len   = reg_len;
     p_ctx->pl.register_action = PL_ACTION_READ_REGISTER;
     p_ctx->pl.retry_counter   = PL_POLLING_MAX_CNT;
+#ifdef PAL_I2C_HAS_WRITE_READ
+    // Address write and read in one bus transaction, the guard time in between is not needed
+    p_ctx->pl.register_address = reg_addr;
+    p_ctx->pl.i2c_cmd          = PL_I2C_CMD_WRITE_READ;
+
+    //lint --e{534} suppress "Return value is not required to be checked"
+    pal_i2c_write_read(p_ctx->p_pal_i2c_ctx, &p_ctx->pl.register_address, 1,
+                       p_ctx->pl.buffer, p_ctx->pl.buffer_rx_len);
+#else
     p_ctx->pl.i2c_cmd         = PL_I2C_CMD_WRITE;
 
     //lint --e{534} suppress "Return value is not required to be checked"
     pal_i2c_write(p_ctx->p_pal_i2c_ctx,p_ctx->pl.buffer, p_ctx->pl.buffer_tx_len);
+#endif
 }
 
 
@@ -333,6 +394,7 @@ static void ifx_i2c_pl_write_register(ifx_i2c_context_t *p_ctx,uint8_t reg_addr,
 static void ifx_i2c_pl_status_poll_callback(void *p_ctx)
 {
     LOG_PL("[IFX-PL]: Status poll Timer elapsed  -> Read STATUS register\n");
+    ((ifx_i2c_context_t*)p_ctx)->pl.irq_armed = FALSE;
     ifx_i2c_pl_read_register((ifx_i2c_context_t*)p_ctx,PL_REG_I2C_STATE, PL_REG_LEN_I2C_STATE);
 }
 
@@ -514,6 +576,50 @@ static void ifx_i2c_pl_negotiation_event_handler(void *p_input_ctx)
 				continue_negotiation = TRUE;
             }
             break;
+            // Warm open: set the frequency negotiated before at master
+            case PL_INIT_WARM_SET_FREQ:
+            {
+                event = ifx_i2c_pl_set_bit_rate(p_input_ctx, p_ctx->frequency);
+                if(IFX_I2C_STACK_SUCCESS == event)
+                {
+                    p_ctx->pl.negotiate_state = PL_INIT_WARM_GET_DATA_REG_LEN;
+                    continue_negotiation = TRUE;
+                }
+                else if (IFX_I2C_STACK_ERROR == event)
+                {
+                    p_ctx->pl.negotiate_state = PL_INIT_DONE;
+                    p_buffer = NULL;
+                    buffer_len = 0;
+                }
+            }
+            break;
+            // Warm open: read the frame length, this also probes that the slave is responsive
+            case PL_INIT_WARM_GET_DATA_REG_LEN:
+            {
+                p_ctx->pl.negotiate_state = PL_INIT_WARM_VERIFY_DATA_REG;
+                ifx_i2c_pl_read_register(p_ctx,PL_REG_DATA_REG_LEN,PL_REG_LEN_DATA_REG_LEN);
+            }
+            break;
+            // Warm open: use the previous settings if the slave still has the same frame length, otherwise negotiate
+            case PL_INIT_WARM_VERIFY_DATA_REG:
+            {
+                slave_frame_len = (p_ctx->pl.buffer[0] << 8) | p_ctx->pl.buffer[1];
+                if(p_ctx->frame_size == slave_frame_len)
+                {
+                    p_ctx->pl.negotiate_state = PL_INIT_DONE;
+                    event = IFX_I2C_STACK_SUCCESS;
+                }
+                else
+                {
+                    LOG_PL("[IFX-PL]: Frame length changed since warm open settings, negotiate\n");
+                    p_ctx->warm_open = FALSE;
+                    p_ctx->pl.negotiate_state = PL_INIT_SET_FREQ_DEFAULT;
+                }
+                p_buffer = NULL;
+                buffer_len = 0;
+                continue_negotiation = TRUE;
+            }
+            break;
             case PL_INIT_DONE:
             {   
                 if(IFX_I2C_STACK_SUCCESS == event)
@@ -578,21 +684,17 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
                     frame_size = (p_ctx->pl.buffer[2] << 8) | p_ctx->pl.buffer[3];
                     if ((frame_size > 0) && (frame_size <= p_ctx->frame_size))
                     {
+                        // A frame longer than a control frame is the response to the command in flight
+                        if (frame_size > DL_HEADER_SIZE)
+                        {
+                            ifx_i2c_pl_latency_update(p_ctx);
+                        }
                         p_ctx->pl.frame_state = PL_STATE_RXTX;
                         ifx_i2c_pl_read_register(p_ctx,PL_REG_DATA, frame_size);
                     }
                     else
                     {
-                        // Continue polling STATUS register if retry limit is not reached
-                        if ((pal_os_timer_get_time_in_milliseconds() - p_ctx->dl.frame_start_time) < p_ctx->dl.data_poll_timeout)
-                        {
-                            pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, PL_DATA_POLLING_INVERVAL_US);
-                        }
-                        else
-                        {
-                            p_ctx->pl.frame_state = PL_STATE_READY;
-                            p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_ERROR, 0, 0);
-                        }
+                        ifx_i2c_pl_schedule_status_poll(p_ctx);
                     }
                 }
                 // Write frame is slave is not busy
@@ -605,16 +707,7 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
                 // Continue checking the slave status register
                 else
                 {
-                    // Continue polling STATUS register if retry limit is not reached
-                    if ((pal_os_timer_get_time_in_milliseconds() - p_ctx->dl.frame_start_time) < p_ctx->dl.data_poll_timeout)
-                    {
-                        pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, PL_DATA_POLLING_INVERVAL_US);
-                    }
-                    else
-                    {
-                        p_ctx->pl.frame_state = PL_STATE_READY;
-                        p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_ERROR, 0, 0);
-                    }
+                    ifx_i2c_pl_schedule_status_poll(p_ctx);
                 }
             }
             break;
@@ -622,6 +715,12 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
             case PL_STATE_RXTX:
             {
                 // Writing/reading of frame to/from DATA register complete
+                if (p_ctx->pl.frame_action == PL_ACTION_WRITE_FRAME)
+                {
+                    // Command execution starts once its last fragment is written
+                    p_ctx->pl.latency_pending = p_ctx->pl.latency_last_fragment;
+                    p_ctx->pl.command_sent_time_us = pal_os_timer_get_time_in_microseconds();
+                }
                 p_ctx->pl.frame_state = PL_STATE_READY;
                 p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS, p_ctx->pl.buffer, p_ctx->pl.buffer_rx_len);
             }
@@ -632,6 +731,167 @@ static void ifx_i2c_pl_frame_event_handler(ifx_i2c_context_t *p_ctx,host_lib_sta
     }
 }
 
+static void ifx_i2c_pl_latency_classify(ifx_i2c_context_t *p_ctx)
+{
+    const uint8_t* p_frame = p_ctx->pl.p_tx_frame;
+    uint8_t chaining;
+    uint8_t index;
+
+    p_ctx->pl.latency_last_fragment = FALSE;
+    // Only data frames carrying a packet fragment start or complete a command
+    if ((p_frame[PL_FRAME_FCTR_OFFSET] & PL_FRAME_FCTR_CONTROL_FRAME) ||
+        (p_ctx->pl.tx_frame_len <= DL_HEADER_SIZE + 1))
+    {
+        return;
+    }
+    chaining = p_frame[PL_FRAME_PCTR_OFFSET] & PL_FRAME_PCTR_CHAIN_MASK;
+
+    if ((PL_FRAME_PCTR_CHAIN_NO == chaining) || (PL_FRAME_PCTR_CHAIN_FIRST == chaining))
+    {
+        for (index = 0; index < PL_LATENCY_MODEL_SIZE; index++)
+        {
+            if ((p_ctx->pl.latency_model[index].samples) &&
+                (p_ctx->pl.latency_model[index].command == p_frame[PL_FRAME_COMMAND_OFFSET]))
+            {
+                break;
+            }
+        }
+        if (PL_LATENCY_MODEL_SIZE == index)
+        {
+            // Command not seen before, replace the oldest entry
+            index = p_ctx->pl.latency_next;
+            p_ctx->pl.latency_next = (p_ctx->pl.latency_next + 1) % PL_LATENCY_MODEL_SIZE;
+            p_ctx->pl.latency_model[index].command = p_frame[PL_FRAME_COMMAND_OFFSET];
+            p_ctx->pl.latency_model[index].samples = 0;
+            p_ctx->pl.latency_model[index].expected_us = 0;
+            p_ctx->pl.latency_model[index].polls = 0;
+        }
+        p_ctx->pl.latency_index = index;
+    }
+
+    if ((PL_LATENCY_NONE != p_ctx->pl.latency_index) &&
+        ((PL_FRAME_PCTR_CHAIN_NO == chaining) || (PL_FRAME_PCTR_CHAIN_LAST == chaining)))
+    {
+        p_ctx->pl.latency_last_fragment = TRUE;
+    }
+}
+
+static void ifx_i2c_pl_latency_update(ifx_i2c_context_t *p_ctx)
+{
+    ifx_i2c_pl_latency_t* p_latency;
+    uint32_t observed_us;
+
+    if (FALSE == p_ctx->pl.latency_pending)
+    {
+        return;
+    }
+    p_ctx->pl.latency_pending = FALSE;
+
+    p_latency = &p_ctx->pl.latency_model[p_ctx->pl.latency_index];
+    observed_us = (uint32_t)(pal_os_timer_get_time_in_microseconds() - p_ctx->pl.command_sent_time_us);
+    if (0 == p_latency->samples)
+    {
+        p_latency->expected_us = observed_us;
+    }
+    else
+    {
+        // Exponentially weighted moving average of the observed latencies
+        p_latency->expected_us = p_latency->expected_us - (p_latency->expected_us >> PL_LATENCY_WEIGHT_SHIFT)
+                                 + (observed_us >> PL_LATENCY_WEIGHT_SHIFT);
+    }
+    p_latency->samples++;
+}
+
+static void ifx_i2c_pl_schedule_status_poll(ifx_i2c_context_t *p_ctx)
+{
+    ifx_i2c_pl_latency_t* p_latency;
+    uint64_t now_us = pal_os_timer_get_time_in_microseconds();
+    uint64_t elapsed_us = now_us - p_ctx->dl.frame_start_time_us;
+    uint32_t since_sent_us;
+    uint32_t target_us;
+    uint32_t poll_delay_us = PL_DATA_POLLING_INVERVAL_US;
+
+    // Continue polling STATUS register if retry limit is not reached
+    if (elapsed_us >= p_ctx->dl.data_poll_timeout_us)
+    {
+        p_ctx->pl.frame_state = PL_STATE_READY;
+        p_ctx->pl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_ERROR, 0, 0);
+        return;
+    }
+    p_ctx->pl.status_polls++;
+
+#ifdef PAL_GPIO_HAS_IRQ
+    // With the response pin the status is read once an edge signals a frame, the slow poll only covers a
+    // missed edge. An edge since the last status read may already signal the frame awaited.
+    if ((p_ctx->pl.irq_enabled) && (p_ctx->pl.frame_action == PL_ACTION_READ_FRAME))
+    {
+        if (p_ctx->pl.irq_pending)
+        {
+            p_ctx->pl.irq_polls++;
+            poll_delay_us = PL_GUARD_TIME_INTERVAL_US;
+        }
+        else
+        {
+            p_ctx->pl.irq_armed = TRUE;
+            poll_delay_us = PL_IRQ_FALLBACK_POLL_US;
+        }
+        if (poll_delay_us > p_ctx->dl.data_poll_timeout_us - elapsed_us)
+        {
+            poll_delay_us = (uint32_t)(p_ctx->dl.data_poll_timeout_us - elapsed_us);
+        }
+        pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, poll_delay_us);
+        return;
+    }
+#endif
+
+    // While waiting for the response to a command with known latency, poll once shortly before the
+    // expected completion and back off from PL_POLLING_INVERVAL_US to PL_DATA_POLLING_INVERVAL_US afterwards.
+    // The acknowledge of the command itself is polled at the default interval.
+    if ((p_ctx->pl.latency_pending) && (p_ctx->dl.action_rx_only) &&
+        (p_ctx->pl.latency_model[p_ctx->pl.latency_index].samples))
+    {
+        p_latency = &p_ctx->pl.latency_model[p_ctx->pl.latency_index];
+        p_latency->polls++;
+
+        // Polling slightly early lets the learnt latency also adapt downwards
+        since_sent_us = (uint32_t)(now_us - p_ctx->pl.command_sent_time_us);
+        target_us = p_latency->expected_us - (p_latency->expected_us >> PL_LATENCY_EARLY_SHIFT);
+        if (since_sent_us < target_us)
+        {
+            poll_delay_us = target_us - since_sent_us;
+        }
+        else
+        {
+            poll_delay_us = p_ctx->pl.poll_interval_us;
+            p_ctx->pl.poll_interval_us = (poll_delay_us * 2 < PL_DATA_POLLING_INVERVAL_US)?
+                                          (poll_delay_us * 2):PL_DATA_POLLING_INVERVAL_US;
+        }
+
+        if (poll_delay_us > p_ctx->dl.data_poll_timeout_us - elapsed_us)
+        {
+            poll_delay_us = (uint32_t)(p_ctx->dl.data_poll_timeout_us - elapsed_us);
+        }
+    }
+    pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, (void *)p_ctx, poll_delay_us);
+}
+
+#ifdef PAL_GPIO_HAS_IRQ
+static void ifx_i2c_pl_irq_handler(void *p_ctx)
+{
+    ifx_i2c_context_t* p_local_ctx = (ifx_i2c_context_t *)p_ctx;
+
+    p_local_ctx->pl.irq_pending = TRUE;
+    if (p_local_ctx->pl.irq_armed)
+    {
+        LOG_PL("[IFX-PL]: Response pin -> Read STATUS register\n");
+        // Replaces the fallback poll, only one callback is pending per context
+        p_local_ctx->pl.irq_armed = FALSE;
+        p_local_ctx->pl.irq_polls++;
+        pal_os_event_register_callback_oneshot(ifx_i2c_pl_status_poll_callback, p_ctx, PL_GUARD_TIME_INTERVAL_US);
+    }
+}
+#endif
+
 static void ifx_i2c_pal_poll_callback(void *p_ctx)
 {
     ifx_i2c_context_t* p_local_ctx = (ifx_i2c_context_t *)p_ctx;
@@ -647,6 +907,15 @@ static void ifx_i2c_pal_poll_callback(void *p_ctx)
         //lint --e{534} suppress "Return value is not required to be checked"
         pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
     }
+#ifdef PAL_I2C_HAS_WRITE_READ
+    else if (p_local_ctx->pl.i2c_cmd == PL_I2C_CMD_WRITE_READ)
+    {
+        LOG_PL("[IFX-PL]: Poll Timer elapsed  -> Restart Read Register -> Start TX RX\n");
+        //lint --e{534} suppress "Return value is not required to be checked"
+        pal_i2c_write_read(p_local_ctx->p_pal_i2c_ctx, &p_local_ctx->pl.register_address, 1,
+                           p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
+    }
+#endif
 }
 
 
@@ -662,7 +931,7 @@ static void ifx_i2c_pl_guard_time_callback(void *p_ctx)
 			//lint --e{534} suppress "Return value is not required to be checked"
             pal_i2c_read(p_local_ctx->p_pal_i2c_ctx,p_local_ctx->pl.buffer, p_local_ctx->pl.buffer_rx_len);
     	}
-    	else if (p_local_ctx->pl.i2c_cmd == PL_I2C_CMD_READ)
+    	else if ((p_local_ctx->pl.i2c_cmd == PL_I2C_CMD_READ) || (p_local_ctx->pl.i2c_cmd == PL_I2C_CMD_WRITE_READ))
     	{
     		LOG_PL("[IFX-PL]: GT done -> REG is read\n");
     		ifx_i2c_pl_frame_event_handler(p_local_ctx,IFX_I2C_STACK_SUCCESS);
@@ -748,10 +1017,8 @@ static void ifx_i2c_pl_soft_reset(ifx_i2c_context_t *p_ctx)
 	}    
 }
 
-//lint --e{715} suppress "This is used for synchromous implementation, hence p_ctx not used"
-//lint --e{818} suppress "This is ignored as upper layer handler function prototype requires this argument"
 static void ifx_i2c_pl_pal_slave_addr_event_handler(void *p_ctx, host_lib_status_t event)
 {
-    pal_event_status = event;
+    ((ifx_i2c_context_t*)p_ctx)->pl.pal_event_status = event;
 }
 
@@ -99,6 +99,11 @@ _STATIC_H host_lib_status_t ifx_i2c_tl_send_chaining_error(ifx_i2c_context_t *p_
 _STATIC_H uint8_t ifx_i2c_tl_calculate_pctr(const ifx_i2c_context_t *p_ctx);
 /// Checks if chaining error occured based on current and previous pctr
 _STATIC_H host_lib_status_t ifx_i2c_tl_check_chaining_error(uint8_t current_chaning, uint8_t previous_chaining);
+/// Copies between a packet scattered over segments and a contiguous buffer
+_STATIC_H void ifx_i2c_tl_copy_vector(ifx_i2c_context_t *p_ctx, const sbBlob_d* p_vector, uint8_t count,
+                                      uint16_t offset, uint8_t* p_data, uint16_t length, uint8_t to_vector);
+/// Copies a received fragment to the receive buffer
+_STATIC_H host_lib_status_t ifx_i2c_tl_receive_fragment(ifx_i2c_context_t *p_ctx, const uint8_t* p_data, uint16_t data_len);
 /// @endcond
 /***********************************************************************************************************************
 * API PROTOTYPES
@@ -118,7 +123,6 @@ host_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 
     p_ctx->tl.upper_layer_event_handler = handler;
     p_ctx->tl.state                     = TL_STATE_IDLE;
-    p_ctx->tl.max_packet_length = p_ctx->frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
 
     return IFX_I2C_STACK_SUCCESS;
 }
@@ -126,28 +130,65 @@ host_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 
 host_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx,uint8_t* p_packet, uint16_t packet_len,
                                uint8_t* p_recv_packet, uint16_t* recv_packet_len)
+{
+    // Check function arguments
+    if ((NULL == p_packet) || (NULL == recv_packet_len) || (p_ctx->tl.state != TL_STATE_IDLE))
+    {
+        return IFX_I2C_STACK_ERROR;
+    }
+    p_ctx->tl.tx_segment.prgbStream = p_packet;
+    p_ctx->tl.tx_segment.wLen = packet_len;
+    p_ctx->tl.rx_segment.prgbStream = p_recv_packet;
+    p_ctx->tl.rx_segment.wLen = *recv_packet_len;
+    return ifx_i2c_tl_transceive_vector(p_ctx, &p_ctx->tl.tx_segment, 1, &p_ctx->tl.rx_segment, 1, recv_packet_len);
+}
+
+host_lib_status_t ifx_i2c_tl_transceive_vector(ifx_i2c_context_t *p_ctx,
+                                               const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                               const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                               uint16_t* recv_packet_len)
 {
     host_lib_status_t status = IFX_I2C_STACK_ERROR;
-    LOG_TL("[IFX-TL]: Transceive txlen %d\n", packet_len);
+    uint32_t packet_len = 0;
+    uint32_t recv_buffer_size = 0;
+    uint8_t index;
 
     do
     {
         // Check function arguments
-        if (p_packet == NULL || packet_len == 0 )
+        if ((NULL == p_tx_vector) || (NULL == p_rx_vector) || (NULL == recv_packet_len))
+        {
+            break;
+        }
+        for (index = 0; index < tx_count; index++)
+        {
+            packet_len += p_tx_vector[index].wLen;
+        }
+        for (index = 0; index < rx_count; index++)
+        {
+            recv_buffer_size += p_rx_vector[index].wLen;
+        }
+        if ((0 == packet_len) || (packet_len > 0xFFFF) || (recv_buffer_size > 0xFFFF))
         {
             break;
-        }   
+        }
+        LOG_TL("[IFX-TL]: Transceive txlen %d\n", packet_len);
         // Transport Layer must be idle
         if (p_ctx->tl.state != TL_STATE_IDLE)
         {
             break;
         }    
         p_ctx->tl.state = TL_STATE_TX;
-        p_ctx->tl.api_start_time = pal_os_timer_get_time_in_milliseconds();    
-        p_ctx->tl.p_actual_packet = p_packet;
-        p_ctx->tl.actual_packet_length = packet_len;
+        // Frame size is known once the negotiation started by the init is done
+        p_ctx->tl.max_packet_length = p_ctx->frame_size - (DL_HEADER_SIZE + TL_HEADER_SIZE);
+        p_ctx->tl.api_start_time_us = pal_os_timer_get_time_in_microseconds();    
+        p_ctx->tl.p_tx_vector = p_tx_vector;
+        p_ctx->tl.tx_vector_count = tx_count;
+        p_ctx->tl.actual_packet_length = (uint16_t)packet_len;
         p_ctx->tl.packet_offset = 0; 
-        p_ctx->tl.p_recv_packet_buffer = p_recv_packet;
+        p_ctx->tl.p_rx_vector = p_rx_vector;
+        p_ctx->tl.rx_vector_count = rx_count;
+        p_ctx->tl.recv_packet_buffer_size = (uint16_t)recv_buffer_size;
         p_ctx->tl.p_recv_packet_buffer_length = recv_packet_len;
         p_ctx->tl.total_recv_length = 0;
         p_ctx->tl.chaining_error_count = 0;
@@ -216,12 +257,61 @@ _STATIC_H host_lib_status_t ifx_i2c_tl_send_next_fragment(ifx_i2c_context_t *p_c
     // Assign the pctr 
     p_ctx->tx_frame_buffer[IFX_I2C_TL_HEADER_OFFSET] = pctr;
     //copy the data
-    memcpy(p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET+1,p_ctx->tl.p_actual_packet + p_ctx->tl.packet_offset,tl_fragment_size);
+    ifx_i2c_tl_copy_vector(p_ctx, p_ctx->tl.p_tx_vector, p_ctx->tl.tx_vector_count, p_ctx->tl.packet_offset,
+                           p_ctx->tx_frame_buffer+IFX_I2C_TL_HEADER_OFFSET+1, tl_fragment_size, FALSE);
     p_ctx->tl.packet_offset += tl_fragment_size;
     //send the fragment to dl layer
     return ifx_i2c_dl_send_frame(p_ctx,tl_fragment_size+1);
 }
 
+_STATIC_H void ifx_i2c_tl_copy_vector(ifx_i2c_context_t *p_ctx, const sbBlob_d* p_vector, uint8_t count,
+                                      uint16_t offset, uint8_t* p_data, uint16_t length, uint8_t to_vector)
+{
+    uint16_t chunk;
+
+    p_ctx->tl.bytes_copied += length;
+    // Skip the segments before offset, then copy segment by segment
+    for (; (count > 0) && (length > 0); count--, p_vector++)
+    {
+        if (offset >= p_vector->wLen)
+        {
+            offset -= p_vector->wLen;
+            continue;
+        }
+        chunk = p_vector->wLen - offset;
+        if (chunk > length)
+        {
+            chunk = length;
+        }
+        if (TRUE == to_vector)
+        {
+            memcpy(p_vector->prgbStream + offset, p_data, chunk);
+        }
+        else
+        {
+            memcpy(p_data, p_vector->prgbStream + offset, chunk);
+        }
+        p_data += chunk;
+        length -= chunk;
+        offset = 0;
+    }
+}
+
+_STATIC_H host_lib_status_t ifx_i2c_tl_receive_fragment(ifx_i2c_context_t *p_ctx, const uint8_t* p_data, uint16_t data_len)
+{
+    // Check for possible receive buffer overflow
+    if ((p_ctx->tl.total_recv_length + data_len - 1) > p_ctx->tl.recv_packet_buffer_size)
+    {
+        return IFX_I2C_STACK_MEM_ERROR;
+    }
+    // Copy frame payload to transport layer receive buffer
+    //lint --e{605} suppress "The frame payload is only read"
+    ifx_i2c_tl_copy_vector(p_ctx, p_ctx->tl.p_rx_vector, p_ctx->tl.rx_vector_count, p_ctx->tl.total_recv_length,
+                           (uint8_t*)p_data + 1, data_len - 1, TRUE);
+    p_ctx->tl.total_recv_length += (data_len - 1);
+    return IFX_I2C_STACK_SUCCESS;
+}
+
 _STATIC_H host_lib_status_t ifx_i2c_tl_send_chaining_error(ifx_i2c_context_t *p_ctx)
 {
     uint16_t tl_fragment_size = 1;
@@ -374,14 +464,18 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                     {
                         LOG_TL("[IFX-TL]: Rx : No chain/Last chain received, Inform UL\n");
 
+                        if (IFX_I2C_STACK_SUCCESS != ifx_i2c_tl_receive_fragment(p_ctx, p_data, data_len))
+                        {
+                            LOG_TL("[IFX-TL]: Rx : Buffer overflow\n");
+                            p_ctx->tl.error_event = IFX_I2C_STACK_MEM_ERROR;
+                            p_ctx->tl.state = TL_STATE_ERROR;
+                            break;
+                        }
                         exit_machine = FALSE;
-                        // Copy frame payload to transport layer receive buffer
-                        memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                        p_ctx->tl.total_recv_length += (data_len - 1);
                         // Inform upper layer that a packet has arrived
                         p_ctx->tl.state = TL_STATE_IDLE;
                         *p_ctx->tl.p_recv_packet_buffer_length = p_ctx->tl.total_recv_length;
-                        p_ctx->tl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS, p_ctx->tl.p_recv_packet_buffer, *p_ctx->tl.p_recv_packet_buffer_length);
+                        p_ctx->tl.upper_layer_event_handler(p_ctx,IFX_I2C_STACK_SUCCESS, p_ctx->tl.p_rx_vector[0].prgbStream, *p_ctx->tl.p_recv_packet_buffer_length);
                     }
                     else
                     {
@@ -408,22 +502,19 @@ _STATIC_H void ifx_i2c_dl_event_handler(ifx_i2c_context_t* p_ctx,host_lib_status
                     p_ctx->tl.state = TL_STATE_CHAINING_ERROR;
                     break;
                 }
-                // Check for possible receive buffer overflow
-                if ((p_ctx->tl.total_recv_length + data_len - 1) > (*p_ctx->tl.p_recv_packet_buffer_length))
+                if(NULL == p_data)
+                {
+                    p_ctx->tl.state = TL_STATE_ERROR;
+                    break;
+                }                
+                // Copy frame payload to transport layer receive buffer, if it fits
+                if (IFX_I2C_STACK_SUCCESS != ifx_i2c_tl_receive_fragment(p_ctx, p_data, data_len))
                 {
                     LOG_TL("[IFX-TL]: Chain : Buffer overflow\n");
 					p_ctx->tl.error_event = IFX_I2C_STACK_MEM_ERROR;
 					p_ctx->tl.state = TL_STATE_RX;
 					break;
                 }
-                if(NULL == p_data)
-                {
-                    p_ctx->tl.state = TL_STATE_ERROR;
-                    break;
-                }                
-                // Copy frame payload to transport layer receive buffer
-                memcpy(p_ctx->tl.p_recv_packet_buffer + p_ctx->tl.total_recv_length, p_data + 1, data_len - 1);
-                p_ctx->tl.total_recv_length += (data_len - 1);
 
                 p_ctx->tl.previous_chaining = pctr;
                 LOG_TL("[IFX-TL]: Chain : Continue  in receive mode\n");
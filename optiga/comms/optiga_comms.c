@@ -35,6 +35,9 @@
  *********************************************************************************************************************/
 #include "optiga/comms/optiga_comms.h"
 #include "optiga/ifx_i2c/ifx_i2c.h"
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+#include "optiga/pal/pal_os_event.h"
+#endif
 /// @cond hidden
 /**********************************************************************************************************************
  * MACROS
@@ -93,6 +96,7 @@ host_lib_status_t optiga_comms_open(optiga_comms_t *p_ctx)
     {
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        p_ctx->reset_count++;
         status = ifx_i2c_open((ifx_i2c_context_t*)(p_ctx->comms_ctx)); 
         if (IFX_I2C_STACK_SUCCESS != status)
         {
@@ -136,6 +140,7 @@ host_lib_status_t optiga_comms_reset(optiga_comms_t *p_ctx,uint8_t reset_type)
     {
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        p_ctx->reset_count++;
         status = ifx_i2c_reset((ifx_i2c_context_t*)(p_ctx->comms_ctx),(ifx_i2c_reset_type_t)reset_type); 
         if (IFX_I2C_STACK_SUCCESS != status)
         {
@@ -201,6 +206,61 @@ host_lib_status_t optiga_comms_transceive(optiga_comms_t *p_ctx,const uint8_t* p
     return status;
 }
 
+/**
+ * Sends a command to OPTIGA and receives a response, both scattered over several buffers.<br>
+ *
+ *
+ *<b>Pre Conditions:</b>
+ * - Communication channel must be established with OPTIGA.<br>
+ *
+ *<b>API Details:</b>
+ * - Same as #optiga_comms_transceive(), the command is the concatenation of the transmit segments
+ *   and the response is stored in the receive segments in order.<br>
+ * - The segments are framed and filled directly, e.g. an APDU header and the caller's payload are sent
+ *   without assembling the APDU in a separate buffer first.<br>
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The same as for #optiga_comms_transceive().<br>
+ * - The segments and the buffers they point to must remain valid until the transceive is completed.<br>
+ *
+ *<b>Notes:</b>
+ * - The actual number of bytes received is stored in p_buffer_len.<br>
+ * - If the receive segments are insufficient to copy the response bytes then
+ *   #IFX_I2C_STACK_MEM_ERROR error is returned.
+ *
+ *
+ * \param[in,out] p_ctx             Pointer to #optiga_comms_t
+ * \param[in]     p_tx_vector       Segments of the command
+ * \param[in]     tx_count          Number of segments in p_tx_vector
+ * \param[in]     p_rx_vector       Segments of the receive buffer
+ * \param[in]     rx_count          Number of segments in p_rx_vector
+ * \param[out]    p_buffer_len      Number of bytes received
+ *
+ * \retval  #OPTIGA_COMMS_SUCCESS
+ * \retval  #OPTIGA_COMMS_ERROR
+ * \retval  #IFX_I2C_STACK_MEM_ERROR
+ */
+host_lib_status_t optiga_comms_transceive_vector(optiga_comms_t *p_ctx,
+                                                 const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                                 const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                                 uint16_t* p_buffer_len)
+{
+    host_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        status = ifx_i2c_transceive_vector((ifx_i2c_context_t*)(p_ctx->comms_ctx), p_tx_vector, tx_count,
+                                           p_rx_vector, rx_count, p_buffer_len);
+        if (IFX_I2C_STACK_SUCCESS != status)
+        {
+            p_ctx->state = OPTIGA_COMMS_FREE;
+        }
+    }
+    return status;
+}
+
 /**
  * Closes the communication with OPTIGA.<br>
  *
@@ -237,6 +297,146 @@ host_lib_status_t optiga_comms_close(optiga_comms_t *p_ctx)
     return status;
 }
 
+/**
+ * Gets the communication parameters to be saved for a warm open.<br>
+ *
+ *<b>Pre Conditions:</b>
+ * - Communication channel must be established with OPTIGA and the maximum communication buffer size must be read,
+ *   as done by #optiga_util_open_application.<br>
+ *
+ *<b>API Details:</b>
+ * - Copies the negotiated frame size, frequency, slave address and the maximum communication buffer size 
+ *   to p_cache.<br>
+ *<br>
+ *
+ * \param[in]     p_ctx             Pointer to #optiga_comms_t
+ * \param[in,out] p_cache           Pointer to #optiga_comms_warm_cache_t
+ *
+ * \retval  #OPTIGA_COMMS_SUCCESS
+ * \retval  #OPTIGA_COMMS_ERROR
+ */
+host_lib_status_t optiga_comms_get_warm_cache(const optiga_comms_t *p_ctx, optiga_comms_warm_cache_t *p_cache)
+{
+    host_lib_status_t status = OPTIGA_COMMS_ERROR;
+    const ifx_i2c_context_t* p_ifx_i2c_ctx;
+
+    if ((NULL != p_ctx) && (NULL != p_cache) && (0 != p_ctx->max_comms_buffer))
+    {
+        p_ifx_i2c_ctx = (const ifx_i2c_context_t*)(p_ctx->comms_ctx);
+        p_cache->version = OPTIGA_COMMS_WARM_CACHE_VERSION;
+        p_cache->frequency = p_ifx_i2c_ctx->frequency;
+        p_cache->frame_size = p_ifx_i2c_ctx->frame_size;
+        p_cache->max_comms_buffer = p_ctx->max_comms_buffer;
+        p_cache->slave_address = p_ifx_i2c_ctx->slave_address;
+        status = OPTIGA_COMMS_SUCCESS;
+    }
+    return status;
+}
+
+/**
+ * Requests a warm open with previously saved communication parameters.<br>
+ *
+ *<b>Pre Conditions:</b>
+ * - Communication channel must not be established.<br>
+ *
+ *<b>API Details:</b>
+ * - Validates p_cache against the configured slave address and frequency. The cached frame size must fit
+ *   the configured frame size, or the frame arena if the frame size is 0.<br>
+ * - Sets the frame size and the maximum communication buffer size from p_cache and requests a warm open.
+ *   The next #optiga_comms_open skips the reset and the negotiation, see #ifx_i2c_open.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - If the warm open falls back to the full sequence, the warm_open flag of the #ifx_i2c_context_t is cleared.
+ *   The maximum communication buffer size is kept, it is a property of the OPTIGA product at the saved
+ *   slave address.<br>
+ *
+ * \param[in,out] p_ctx             Pointer to #optiga_comms_t
+ * \param[in]     p_cache           Pointer to #optiga_comms_warm_cache_t
+ *
+ * \retval  #OPTIGA_COMMS_SUCCESS
+ * \retval  #OPTIGA_COMMS_ERROR
+ */
+host_lib_status_t optiga_comms_set_warm_cache(optiga_comms_t *p_ctx, const optiga_comms_warm_cache_t *p_cache)
+{
+    host_lib_status_t status = OPTIGA_COMMS_ERROR;
+    ifx_i2c_context_t* p_ifx_i2c_ctx;
+    uint16_t max_frame_size;
+
+    if ((NULL != p_ctx) && (NULL != p_cache) && (OPTIGA_COMMS_INUSE != p_ctx->state))
+    {
+        p_ifx_i2c_ctx = (ifx_i2c_context_t*)(p_ctx->comms_ctx);
+        // Largest frame the frame arena holds, as taken by ifx_i2c_open. A frame size of 0 requests this size
+        max_frame_size = (p_ifx_i2c_ctx->frame_arena_size < IFX_I2C_FRAME_ARENA_SIZE(DL_MIN_FRAME_SIZE))?
+                         0:(uint16_t)((p_ifx_i2c_ctx->frame_arena_size - 1) / 3);
+        if ((0 != p_ifx_i2c_ctx->frame_size) && (p_ifx_i2c_ctx->frame_size < max_frame_size))
+        {
+            max_frame_size = p_ifx_i2c_ctx->frame_size;
+        }
+        // Settings of another device or configuration are not reused
+        if ((OPTIGA_COMMS_WARM_CACHE_VERSION == p_cache->version) &&
+            (p_ifx_i2c_ctx->slave_address == p_cache->slave_address) &&
+            (p_ifx_i2c_ctx->frequency == p_cache->frequency) &&
+            (DL_MIN_FRAME_SIZE <= p_cache->frame_size) && (max_frame_size >= p_cache->frame_size) &&
+            (0 != p_cache->max_comms_buffer))
+        {
+            p_ifx_i2c_ctx->frame_size = p_cache->frame_size;
+            p_ifx_i2c_ctx->warm_open = TRUE;
+            p_ctx->max_comms_buffer = p_cache->max_comms_buffer;
+            status = OPTIGA_COMMS_SUCCESS;
+        }
+    }
+    return status;
+}
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+/**
+ * Takes over the event processing from the platform, for applications running their own event loop.<br>
+ *
+ *<b>Pre Conditions:</b>
+ * - None. Must be invoked before any #optiga_comms_t instance is opened.<br>
+ *
+ *<b>API Details:</b>
+ * - The platform stops scheduling the ifx i2c protocol timers on its own. The returned handle becomes
+ *   readable once a timer expires, the application then invokes #optiga_process_events.<br>
+ * - The application adds the handle to its poll/epoll set, or uses #optiga_get_next_deadline_us as timeout.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - #optiga_comms_transceive completes asynchronously, hence a single thread drives transactions on
+ *   several #optiga_comms_t instances alongside its other handles.<br>
+ * - The blocking util and crypt APIs remain usable, they process the events while waiting.<br>
+ *
+ * \retval  Handle to be polled for readability
+ * \retval  -1 if the platform does not support it or already started processing the events itself
+ */
+int32_t optiga_get_event_fd(void)
+{
+    return pal_os_event_get_handle();
+}
+
+/**
+ * Gets the time left until the earliest protocol timer of any instance expires.<br>
+ *
+ * \retval  Time in microseconds, 0 if #optiga_process_events is to be invoked right away
+ * \retval  #PAL_OS_EVENT_NO_TIMEOUT if no timer is pending
+ */
+uint32_t optiga_get_next_deadline_us(void)
+{
+    return pal_os_event_get_next_timeout_us();
+}
+
+/**
+ * Runs the expired protocol timers, which advances the physical, data link and transport layer
+ * state machines. Completed transactions invoke their upper layer handlers from here.<br>
+ * Returns without blocking if nothing is due.<br>
+ */
+void optiga_process_events(void)
+{
+    pal_os_event_process();
+}
+#endif
+
 /// @cond hidden
 static host_lib_status_t check_optiga_comms_state(optiga_comms_t *p_ctx)
 {
@@ -253,8 +453,9 @@ static host_lib_status_t check_optiga_comms_state(optiga_comms_t *p_ctx)
 static void ifx_i2c_event_handler(void* upper_layer_ctx, host_lib_status_t event)
 {
     void* ctx = ((optiga_comms_t*)upper_layer_ctx)->upper_layer_ctx;
-    ((optiga_comms_t*)upper_layer_ctx)->upper_layer_handler(ctx,event);
+    // Free before the handler wakes up the caller, which may start the next transaction right away
     ((optiga_comms_t*)upper_layer_ctx)->state = OPTIGA_COMMS_FREE;
+    ((optiga_comms_t*)upper_layer_ctx)->upper_layer_handler(ctx,event);
 }
 
 /// @endcond
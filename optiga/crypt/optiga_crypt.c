@@ -30,9 +30,9 @@
 */
 
 #include "optiga/optiga_crypt.h"
-#include "optiga/pal/pal_os_lock.h"
 
-optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
+optiga_lib_status_t optiga_crypt_random(optiga_comms_t * p_comms,
+                                        optiga_rng_types_t rng_type,
                                         uint8_t * random_data,
                                         uint16_t random_data_length)
 {
@@ -48,9 +48,7 @@ optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
     rand_response.wBufferLength = random_data_length;
     rand_response.wRespLength   = 0;
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_GetRandom(&rand_options,&rand_response);
-    pal_os_lock_release();
+    return_value = CmdLib_GetRandom(p_comms,&rand_options,&rand_response);
 
     if (CMD_LIB_OK != return_value)
     {
@@ -59,7 +57,8 @@ optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
     return OPTIGA_LIB_SUCCESS;
 }
 
-optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx)
+optiga_lib_status_t optiga_crypt_hash_start(optiga_comms_t * p_comms,
+                                            optiga_hash_context_t * hash_ctx)
 {
     optiga_lib_status_t return_value;
     uint8_t rgbDataStream[1];
@@ -76,9 +75,7 @@ optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx)
     hash_options.sContextInfo.dwContextLen   = hash_ctx->context_buffer_length;
     hash_options.sContextInfo.eContextAction = eExport;
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_CalcHash(&hash_options);
-    pal_os_lock_release();
+    return_value = CmdLib_CalcHash(p_comms,&hash_options);
 
     if (CMD_LIB_OK != return_value)
     {
@@ -87,7 +84,8 @@ optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx)
     return OPTIGA_LIB_SUCCESS;
 }
 
-optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
+optiga_lib_status_t optiga_crypt_hash_update(optiga_comms_t * p_comms,
+                                             optiga_hash_context_t * hash_ctx,
                                              uint8_t source_of_data_to_hash,
                                              void * data_to_hash)
 {
@@ -126,7 +124,7 @@ optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
     hash_options.sContextInfo.dwContextLen   = hash_ctx->context_buffer_length;
     hash_options.sContextInfo.eContextAction = eImportExport;
 
-    max_comms_buffer = CmdLib_GetMaxCommsBufferSize();
+    max_comms_buffer = CmdLib_GetMaxCommsBufferSize(p_comms);
 
     remaining_comm_bfr_sz_basic = max_comms_buffer - CALC_HASH_FIXED_OVERHEAD_SIZE;
     remaining_comm_bfr_sz_with_import_export = max_comms_buffer -(CALC_HASH_FIXED_OVERHEAD_SIZE +   \
@@ -168,9 +166,7 @@ optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
 
     while (1)
     {   
-        while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-        return_value = CmdLib_CalcHash(&hash_options);
-        pal_os_lock_release();
+        return_value = CmdLib_CalcHash(p_comms,&hash_options);
 
         if (CMD_LIB_OK != return_value)
         {
@@ -210,7 +206,8 @@ optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
     return return_value;
 }
 
-optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
+optiga_lib_status_t optiga_crypt_hash_finalize(optiga_comms_t * p_comms,
+                                               optiga_hash_context_t * hash_ctx,
                                                uint8_t * hash_output)
 {
     optiga_lib_status_t return_value;
@@ -233,9 +230,7 @@ optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
 		hash_options.sOutHash.wBufferLength  = 32;
 	}
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_CalcHash(&hash_options);
-    pal_os_lock_release();
+    return_value = CmdLib_CalcHash(p_comms,&hash_options);
     
     if (CMD_LIB_OK != return_value)
     {
@@ -244,7 +239,8 @@ optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
     return OPTIGA_LIB_SUCCESS;
 }
 
-optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_id,
+optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_comms_t * p_comms,
+                                                      optiga_ecc_curve_t curve_id,
                                                       uint8_t key_usage,
                                                       bool_t export_private_key,
                                                       void * private_key,
@@ -279,9 +275,7 @@ optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_i
 
 
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_GenerateKeyPair(&keypair_options,&public_key_out);
-    pal_os_lock_release();
+    return_value = CmdLib_GenerateKeyPair(p_comms,&keypair_options,&public_key_out);
 
     if (CMD_LIB_OK != return_value)
     {     
@@ -292,7 +286,8 @@ optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_i
     return OPTIGA_LIB_SUCCESS;
 }
 
-optiga_lib_status_t optiga_crypt_ecdsa_sign (uint8_t * digest,
+optiga_lib_status_t optiga_crypt_ecdsa_sign (optiga_comms_t * p_comms,
+                                             uint8_t * digest,
                                              uint8_t digest_length,
                                              optiga_key_id_t private_key,
                                              uint8_t * signature,
@@ -311,9 +306,7 @@ optiga_lib_status_t optiga_crypt_ecdsa_sign (uint8_t * digest,
     sign.prgbStream = signature;
     sign.wLen       =  *signature_length;
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_CalculateSign(&sign_options,&sign);
-    pal_os_lock_release();
+    return_value = CmdLib_CalculateSign(p_comms,&sign_options,&sign);
 
     if (CMD_LIB_OK != return_value)
     {
@@ -323,7 +316,8 @@ optiga_lib_status_t optiga_crypt_ecdsa_sign (uint8_t * digest,
     return OPTIGA_LIB_SUCCESS;
 }
 
-optiga_lib_status_t optiga_crypt_ecdsa_verify (uint8_t * digest,
+optiga_lib_status_t optiga_crypt_ecdsa_verify (optiga_comms_t * p_comms,
+                                               uint8_t * digest,
                                                uint8_t digest_length,
                                                uint8_t * signature,
                                                uint16_t signature_length,
@@ -355,9 +349,7 @@ optiga_lib_status_t optiga_crypt_ecdsa_verify (uint8_t * digest,
     sign.prgbStream = signature;
     sign.wLen       = signature_length;
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_VerifySign(&verifysign_options, &dgst, &sign);
-    pal_os_lock_release();
+    return_value = CmdLib_VerifySign(p_comms,&verifysign_options, &dgst, &sign);
 
     if(CMD_LIB_OK == return_value)
     {
@@ -367,7 +359,8 @@ optiga_lib_status_t optiga_crypt_ecdsa_verify (uint8_t * digest,
     return return_value;
 }
 
-optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
+optiga_lib_status_t optiga_crypt_ecdh(optiga_comms_t * p_comms,
+                                      optiga_key_id_t private_key,
                                       public_key_from_host_t * public_key,
                                       bool_t export_to_host,
                                       uint8_t * shared_secret)
@@ -396,9 +389,7 @@ optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
         shared_secret_options.wOIDSharedSecret = *((uint16_t *)shared_secret);
     }
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_CalculateSharedSecret(&shared_secret_options, &sharedsecret);
-    pal_os_lock_release();
+    return_value = CmdLib_CalculateSharedSecret(p_comms,&shared_secret_options, &sharedsecret);
 
     if(CMD_LIB_OK == return_value)
     {
@@ -409,7 +400,8 @@ optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
 }
 
 
-optiga_lib_status_t optiga_crypt_tls_prf_sha256(uint16_t secret,
+optiga_lib_status_t optiga_crypt_tls_prf_sha256(optiga_comms_t * p_comms,
+                                                uint16_t secret,
                                                 uint8_t * label,
                                                 uint16_t label_length,
                                                 uint8_t * seed,
@@ -445,9 +437,7 @@ optiga_lib_status_t optiga_crypt_tls_prf_sha256(uint16_t secret,
 		derivekey_options.wOIDDerivedKey = *((uint16_t *)derived_key);
     }
 
-    while (pal_os_lock_acquire() != OPTIGA_LIB_SUCCESS);
-    return_value = CmdLib_DeriveKey(&derivekey_options, &derivekey_output_buffer);
-    pal_os_lock_release();
+    return_value = CmdLib_DeriveKey(p_comms,&derivekey_options, &derivekey_output_buffer);
 
     if(CMD_LIB_OK == return_value)
     {
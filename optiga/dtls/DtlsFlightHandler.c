@@ -695,6 +695,7 @@ _STATIC_H int32_t DtlsHS_SInit_MessageNode(sMsgInfo_d* PpsMsgNode, const sMsgLyr
     sMessageLayer.psConfigRL = PpsMessageLayer->psConfigRL;
     sMessageLayer.wMaxPmtu = PpsMessageLayer->wMaxPmtu;
     sMessageLayer.wSessionID = PpsMessageLayer->wSessionID;
+    sMessageLayer.psOptigaComms = PpsMessageLayer->psOptigaComms;
     
     do
     {
@@ -1319,6 +1320,7 @@ _STATIC_H int32_t DtlsHS_SendFlightToOptiga(sMsgInfo_d *PpsMessageList, const sM
         sMessageLayer.psConfigRL = PpsMessageLayer->psConfigRL;
         sMessageLayer.wMaxPmtu = PpsMessageLayer->wMaxPmtu;
         sMessageLayer.wSessionID = PpsMessageLayer->wSessionID;
+        sMessageLayer.psOptigaComms = PpsMessageLayer->psOptigaComms;
 
         while(NULL != PpsMessageList)
         {
@@ -142,7 +142,7 @@ _STATIC_H void DtlsHS_FreeFlightNode(uint8_t PbFlightID, sFlightDetails_d** Ppps
 /**
  * \brief Receives a handshake messages from the server.<br>
  */
-_STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFlightDetails_d** PppsRFlightHead,  sMsgLyr_d* PpsMessageLayer, uint8_t PbFlightTimeout,uint32_t PdwBasetime);
+_STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFlightDetails_d** PppsRFlightHead,  sMsgLyr_d* PpsMessageLayer, uint8_t PbFlightTimeout,uint64_t PqwBasetime);
 
 /**
  * \brief Frees flight node.<br>
@@ -475,12 +475,12 @@ _STATIC_H void DtlsHS_FreeFlightNode(uint8_t PbFlightID, sFlightDetails_d** Ppps
  * \param[in]	    PppsRFlightHead			    Flight head node for the receive message
  * \param[in,out]	PpsMessageLayer			    Pointer to structure containing information required for Message Layer
  * \param[in]	    PbFlightTimeout			    Flight timeout value
- * \param[in]	    PdwBasetime			        Time at which State changed to receive mode
+ * \param[in]	    PqwBasetime			        Time at which State changed to receive mode, in microseconds
  *
  * \retval 		#OCP_HL_OK		Successful Execution
  * \retval 		#OCP_HL_ERROR	Failure Execution
  */
-_STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFlightDetails_d** PppsRFlightHead,  sMsgLyr_d* PpsMessageLayer, uint8_t PbFlightTimeout,uint32_t PdwBasetime)
+_STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFlightDetails_d** PppsRFlightHead,  sMsgLyr_d* PpsMessageLayer, uint8_t PbFlightTimeout,uint64_t PqwBasetime)
 {
     int32_t i4Status = (int32_t)OCP_HL_OK;
     int32_t i4Alert ;
@@ -646,7 +646,7 @@ _STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFligh
             }
             
             //If timeout expired return timeout error and exit if flight status is not efreceived
-            if(!TIMEELAPSED(PdwBasetime, PbFlightTimeout) && (((*PppsRFlightHead)->sFlightStats.bFlightState < (uint8_t)efReceived) || ((*PppsRFlightHead)->sFlightStats.bFlightState == (uint8_t)efReReceive)
+            if(!TIMEELAPSED(PqwBasetime, PbFlightTimeout) && (((*PppsRFlightHead)->sFlightStats.bFlightState < (uint8_t)efReceived) || ((*PppsRFlightHead)->sFlightStats.bFlightState == (uint8_t)efReReceive)
                 || ((*PppsRFlightHead)->sFlightStats.bFlightState == (uint8_t)efProcessed)))
             {
                 i4Status = (int32_t)OCP_HL_TIMEOUT;
@@ -654,7 +654,7 @@ _STATIC_H int32_t DtlsHS_ReceiveFlightMessage(uint8_t* PpbLastProcFlight, sFligh
             } 
             
             //Dynamically setting the UDP timeout
-            PpsMessageLayer->psConfigRL->sRL.psConfigTL->sTL.wTimeout = (uint16_t)((PbFlightTimeout*1000) - (uint32_t)(pal_os_timer_get_time_in_milliseconds() - PdwBasetime));
+            PpsMessageLayer->psConfigRL->sRL.psConfigTL->sTL.wTimeout = (uint16_t)((((uint64_t)PbFlightTimeout*1000000) - (pal_os_timer_get_time_in_microseconds() - PqwBasetime))/1000);
             
         //If multiple record is received in a single datagram loop back and receive other records
         }while(0 != B_MULTIPLERECORD);
@@ -1036,7 +1036,7 @@ _STATIC_H int32_t DtlsHS_SFlightProcess(uint8_t *PpbLastProcFlight, sFlightDetai
 _STATIC_H int32_t DtlsHS_RFlightProcess(uint8_t* PpbLastProcFlight, sFlightDetails_d** PppsRFlightHead,  sMsgLyr_d* PpsMessageLayer, uint8_t PbFlightTimeout)
 {
     int32_t i4Status = (int32_t)OCP_HL_ERROR;
-    uint32_t dwBasetime;
+    uint64_t qwBasetime;
     
     do
     {
@@ -1049,14 +1049,14 @@ _STATIC_H int32_t DtlsHS_RFlightProcess(uint8_t* PpbLastProcFlight, sFlightDetai
         }
 #endif
         //Start value for the Flight timeout 
-        dwBasetime = (uint32_t)pal_os_timer_get_time_in_milliseconds();
+        qwBasetime = pal_os_timer_get_time_in_microseconds();
         
         do
         {
-            i4Status = DtlsHS_ReceiveFlightMessage(PpbLastProcFlight, PppsRFlightHead, PpsMessageLayer, PbFlightTimeout, dwBasetime);
+            i4Status = DtlsHS_ReceiveFlightMessage(PpbLastProcFlight, PppsRFlightHead, PpsMessageLayer, PbFlightTimeout, qwBasetime);
             
             //If timeout expired and complete flight is not received then return timeout error and come out of loop
-            if((!TIMEELAPSED(dwBasetime, PbFlightTimeout) || ((int32_t)OCP_HL_TIMEOUT == i4Status)) &&    \
+            if((!TIMEELAPSED(qwBasetime, PbFlightTimeout) || ((int32_t)OCP_HL_TIMEOUT == i4Status)) &&    \
                   ((int32_t)OCP_HL_OK != i4Status) && (((*PppsRFlightHead)->sFlightStats.bFlightState < (uint8_t)efReceived) ||
                   ((*PppsRFlightHead)->sFlightStats.bFlightState == (uint8_t)efReReceive) || ((*PppsRFlightHead)->sFlightStats.bFlightState == (uint8_t)efProcessed)))
             {
@@ -1356,6 +1356,7 @@ int32_t DtlsHS_Handshake(sHandshake_d* PphHandshake)
     sMessageLayer.wMaxPmtu = PphHandshake->wMaxPmtu;
     sMessageLayer.wOIDDevCertificate = PphHandshake->wOIDDevCertificate;
     sMessageLayer.pfGetUnixTIme = PphHandshake->pfGetUnixTIme;
+    sMessageLayer.psOptigaComms = PphHandshake->psOptigaComms;
     sMessageLayer.eFlight = eFlight0;
     sMessageLayer.dwRMsgSeqNum = 0xFFFFFFFF;
     sMessageLayer.sTLMsg.prgbStream = (uint8_t*)OCP_MALLOC(TLBUFFER_SIZE);
@@ -122,7 +122,7 @@ int32_t HWCL_Encrypt(const sCL_d* PpsCL, const sbBlob_d* PpsBlobPlainText,sbBlob
         sProcCryptoData.sOutData.wBufferLength = PpsBlobCipherText->wLen;
 
         //Invoke the encrypt command API from the command library
-        i4Status = CmdLib_Encrypt(&sProcCryptoData);
+        i4Status = CmdLib_Encrypt(PpsCL->psOptigaComms,&sProcCryptoData);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -192,7 +192,7 @@ int32_t HWCL_Decrypt(const sCL_d* PpsCL,const sbBlob_d* PpsBlobCipherText,sbBlob
         LOG_TRANSPORTMSG("Encrypted Data sent to OPTIGA",eInfo);
         
         //Invoke the Decrypt command API from the command library
-        i4Status = CmdLib_Decrypt(&sProcCryptoData);
+        i4Status = CmdLib_Decrypt(PpsCL->psOptigaComms,&sProcCryptoData);
         if(CMD_LIB_OK != i4Status)
         {
             LOG_TRANSPORTDBVAL(i4Status,eInfo);
@@ -186,7 +186,7 @@ int32_t MsgLayer_FormMessage(eMsgType_d eMsgType,const sMessageLayer_d* PpsMessa
 			break;
 		}
         //Get the Message using Get Message command from the Security Chip
-        i4Status =  CmdLib_GetMessage(&sGMsgVector);
+        i4Status =  CmdLib_GetMessage(PpsMessageLayer->psOptigaComms,&sGMsgVector);
         if(CMD_LIB_OK != i4Status)
         {
             LOG_TRANSPORTDBVAL(i4Status,eInfo);
@@ -243,7 +243,7 @@ int32_t MsgLayer_ProcessMessage(eMsgType_d eMsgType,const sMessageLayer_d* PpsMe
         sPMsgVector.psCallBack = NULL;
 
         //Invoke the Put Message command API from the command library to send the message to Security Chip to Process
-        i4Status = CmdLib_PutMessage(&sPMsgVector);
+        i4Status = CmdLib_PutMessage(PpsMessageLayer->psOptigaComms,&sPMsgVector);
         if(CMD_LIB_OK != i4Status)
         {
             LOG_TRANSPORTDBVAL(i4Status,eInfo);
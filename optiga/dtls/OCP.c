@@ -361,7 +361,7 @@ _STATIC_H Void CloseSession(hdl_t PhAppOCPCtx, bool_t PfFatalError, uint16_t PwS
             SEND_ALERT(&psCntx->sConfigRL,(int32_t) OCP_RL_ERROR);
         }
         //Close the DTLS session on Security Chip
-        CmdLib_CloseSession(PwSessionId);
+        CmdLib_CloseSession(psCntx->sHandshake.psOptigaComms,PwSessionId);
     }
     //Disconnect from the server via transport layer
     S_CONFIGURATION_TL->pfDisconnect(&S_CONFIGURATION_TL->sTL);
@@ -388,7 +388,7 @@ _STATIC_H Void CloseSession(hdl_t PhAppOCPCtx, bool_t PfFatalError, uint16_t PwS
  *<b>Pre Conditions:</b>
  * - Communication with the security chip is up and running. <br>
  *   #optiga_comms_open() must be successfully executed.<br>
- * - The optiga comms context for command library is registered using #CmdLib_SetOptigaCommsContext().
+ * - The optiga comms instance of the security chip is provided in sAppOCPConfig_d.psOptigaComms.
  *
  *<b>API Details:</b>
  * - Checks for an available session OID.
@@ -438,7 +438,7 @@ int32_t OCP_Init(const sAppOCPConfig_d* PpsAppOCPConfig,hdl_t* PphAppOCPCtx)
     do
     {
         //NULL check for input parameters
-        if((NULL == PpsAppOCPConfig) || (NULL == PphAppOCPCtx))
+        if((NULL == PpsAppOCPConfig) || (NULL == PphAppOCPCtx) || (NULL == PpsAppOCPConfig->psOptigaComms))
         {
             i4Status =  (int32_t)OCP_LIB_NULL_PARAM;
             break;
@@ -492,7 +492,7 @@ int32_t OCP_Init(const sAppOCPConfig_d* PpsAppOCPConfig,hdl_t* PphAppOCPCtx)
         sOpenApp.eOpenType = eInit;
 
         //Open Application
-        i4Status = CmdLib_OpenApplication(&sOpenApp);
+        i4Status = CmdLib_OpenApplication(PpsAppOCPConfig->psOptigaComms,&sOpenApp);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -512,6 +512,9 @@ int32_t OCP_Init(const sAppOCPConfig_d* PpsAppOCPConfig,hdl_t* PphAppOCPCtx)
         
         //Assign the callback function to get unix time
         psAppOCPCntx->sHandshake.pfGetUnixTIme = PpsAppOCPConfig->pfGetUnixTIme;
+
+        //Assign the optiga comms instance of the security chip
+        psAppOCPCntx->sHandshake.psOptigaComms = PpsAppOCPConfig->psOptigaComms;
         
         //Assign the record layer configuration pointer to the handshake layer
         psAppOCPCntx->sHandshake.psConfigRL = &psAppOCPCntx->sConfigRL;
@@ -554,6 +557,9 @@ int32_t OCP_Init(const sAppOCPConfig_d* PpsAppOCPConfig,hdl_t* PphAppOCPCtx)
         //Assign the logger pointer for Transport layer
         psAppOCPCntx->sConfigRL.sRL.psConfigCL->sCL.sLogger.pHdl = PpsAppOCPConfig->sLogger.pHdl;
         psAppOCPCntx->sConfigRL.sRL.psConfigCL->sCL.sLogger.phfWriter = PpsAppOCPConfig->sLogger.phfWriter;
+
+        //Assign the optiga comms instance for Crypto layer
+        psAppOCPCntx->sConfigRL.sRL.psConfigCL->sCL.psOptigaComms = PpsAppOCPConfig->psOptigaComms;
                 
         //Initialize all the modules
         //Init for logger
@@ -705,7 +711,7 @@ int32_t OCP_Connect(const hdl_t PhAppOCPCtx)
         sAuthScheme.wSessionKeyId = PS_CNTX->sHandshake.wSessionOID;
         
         //Set the AuthScheme
-        i4Status = CmdLib_SetAuthScheme(&sAuthScheme);
+        i4Status = CmdLib_SetAuthScheme(PS_CNTX->sHandshake.psOptigaComms,&sAuthScheme);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -943,7 +949,7 @@ int32_t OCP_Receive(const hdl_t PhAppOCPCtx, uint8_t* PprgbData, uint16_t* PpwLe
 	int32_t i4Status = (int32_t)OCP_LIB_ERROR;
     sbBlob_d sAppData;
     int32_t i4Alert;
-    uint32_t dwStarttime;
+    uint64_t qwStarttime;
     
 /// @cond hidden
 #define PS_CNTX ((sAppOCPCtx_d*)PhAppOCPCtx)
@@ -1015,7 +1021,7 @@ int32_t OCP_Receive(const hdl_t PhAppOCPCtx, uint8_t* PprgbData, uint16_t* PpwLe
         PS_CNTX->sConfigRL.sRL.psConfigTL->sTL.wTimeout = PwTimeout;
 
         //Start value for the Flight timeout 
-        dwStarttime = pal_os_timer_get_time_in_milliseconds();
+        qwStarttime = pal_os_timer_get_time_in_microseconds();
 
         do
         {
@@ -1080,14 +1086,14 @@ int32_t OCP_Receive(const hdl_t PhAppOCPCtx, uint8_t* PprgbData, uint16_t* PpwLe
                 }
             }
             
-            if((uint32_t)(pal_os_timer_get_time_in_milliseconds() - dwStarttime) > (uint32_t)PwTimeout)
+            if((pal_os_timer_get_time_in_microseconds() - qwStarttime) > ((uint64_t)PwTimeout*1000))
             {
                 i4Status = (int32_t)OCP_LIB_TIMEOUT;
                 break;
             }
             
             //Dynamically setting the UDP timeout
-            PS_CNTX->sConfigRL.sRL.psConfigTL->sTL.wTimeout = (uint16_t)(PwTimeout - (uint16_t)(pal_os_timer_get_time_in_milliseconds() - dwStarttime));
+            PS_CNTX->sConfigRL.sRL.psConfigTL->sTL.wTimeout = (uint16_t)(PwTimeout - (uint16_t)((pal_os_timer_get_time_in_microseconds() - qwStarttime)/1000));
         }while(TRUE);
 
                 
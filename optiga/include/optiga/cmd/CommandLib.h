@@ -152,11 +152,8 @@ typedef struct sOpenApp_d
 /**
  * \brief Opens the Security Chip Application.
  */
-LIBRARY_EXPORTS int32_t CmdLib_OpenApplication(const sOpenApp_d* PpsOpenApp);
+LIBRARY_EXPORTS int32_t CmdLib_OpenApplication(optiga_comms_t* PpsOptigaComms, const sOpenApp_d* PpsOpenApp);
 
-/// @cond hidden
-LIBRARY_EXPORTS void CmdLib_SetOptigaCommsContext(const optiga_comms_t *p_input_optiga_comms);
-/// @endcond 
 /****************************************************************************
  *
  * Definitions related to GetDataObject and SetDataObject commands.
@@ -230,22 +227,78 @@ typedef struct sSetData_d
     eWriteOption_d   eWriteOption;
 }sSetData_d;
 
+/**
+ * \brief Callback to get the next chunk of data of a stream. Returns 0 when exactly PwLength bytes are copied to PprgbChunk.
+ */
+typedef int32_t (*pFGetChunk)(void* PpCtx, uint8_t* PprgbChunk, uint16_t PwLength);
+
+/**
+ * \brief Callback to report the total number of bytes of a stream written so far.
+ */
+typedef void (*pFWriteProgress)(void* PpCtx, uint16_t PwWritten);
+
+/**
+ * \brief Structure to specify the source of the data written by #CmdLib_SetDataObjectStream.
+ */
+typedef struct sDataStream_d
+{
+    ///Callback to get the next chunk of data
+    pFGetChunk pfGetChunk;
+
+    ///Callback to report the progress, can be NULL
+    pFWriteProgress pfProgress;
+
+    ///Context passed to the callbacks
+    void* pCtx;
+
+    ///Buffer holding two chunks of data
+    uint8_t* prgbBuffer;
+
+    ///Length of the buffer, at least two chunks of #CMD_LIB_STREAM_MIN_CHUNK bytes or twice the data length if smaller
+    uint16_t wBufferLength;
+}sDataStream_d;
+
 
 #ifdef MODULE_ENABLE_READ_WRITE
+/**
+ * \brief Acquires the optiga comms instance for a batch of InBatch commands. 
+ */
+LIBRARY_EXPORTS int32_t CmdLib_BeginBatch(optiga_comms_t* PpsOptigaComms);
+
+/**
+ * \brief Releases the optiga comms instance acquired using #CmdLib_BeginBatch. 
+ */
+LIBRARY_EXPORTS void CmdLib_EndBatch(optiga_comms_t* PpsOptigaComms);
+
 /**
  * \brief Reads the specified data object by issuing GetDataObject command. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_GetDataObject(const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse);
+LIBRARY_EXPORTS int32_t CmdLib_GetDataObject(optiga_comms_t* PpsOptigaComms, const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse);
+
+/**
+ * \brief Reads the specified data object by issuing GetDataObject command, within #CmdLib_BeginBatch and #CmdLib_EndBatch. 
+ */
+LIBRARY_EXPORTS int32_t CmdLib_GetDataObjectInBatch(optiga_comms_t* PpsOptigaComms, const sGetData_d *PpsGDVector, sCmdResponse_d *PpsResponse);
 
 /**
  * \brief Writes to the specified data object by issuing SetDataObject command. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_SetDataObject(const sSetData_d *PpsSDVector);
+LIBRARY_EXPORTS int32_t CmdLib_SetDataObject(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector);
+
+/**
+ * \brief Writes to the specified data object by issuing SetDataObject command, within #CmdLib_BeginBatch and #CmdLib_EndBatch. 
+ */
+LIBRARY_EXPORTS int32_t CmdLib_SetDataObjectInBatch(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector);
+
+/**
+ * \brief Writes to the specified data object by issuing SetDataObject command, with the data read chunk by chunk from a stream. 
+ */
+LIBRARY_EXPORTS int32_t CmdLib_SetDataObjectStream(optiga_comms_t* PpsOptigaComms, const sSetData_d *PpsSDVector, const sDataStream_d *PpsStream);
 
 /**
  * \brief Reads maximum communication buffer size supported by the security chip. 
  */
-LIBRARY_EXPORTS uint16_t CmdLib_GetMaxCommsBufferSize(Void);
+LIBRARY_EXPORTS uint16_t CmdLib_GetMaxCommsBufferSize(const optiga_comms_t* PpsOptigaComms);
 
 #endif
 /****************************************************************************
@@ -331,17 +384,17 @@ typedef struct sRngOptions_d
 /**
  * \brief  Gets the signature generated by Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_GetSignature(const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsResponse);
+LIBRARY_EXPORTS int32_t CmdLib_GetSignature(optiga_comms_t* PpsOptigaComms, const sAuthMsg_d *PpsAuthMsg, sCmdResponse_d *PpsResponse);
 
 /**
  * \brief Gets the true random bytes generated by Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_GetRandom(const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse);
+LIBRARY_EXPORTS int32_t CmdLib_GetRandom(optiga_comms_t* PpsOptigaComms, const sRngOptions_d *PpsRng, sCmdResponse_d *PpsResponse);
 
 /**
  * \brief Sets the Authentication Scheme by issuing SetAuthScheme command to Security Chip. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_SetAuthScheme(const sAuthScheme_d *PpsAuthVector);
+LIBRARY_EXPORTS int32_t CmdLib_SetAuthScheme(optiga_comms_t* PpsOptigaComms, const sAuthScheme_d *PpsAuthVector);
 
 /**
  * \brief Enumeration to specify Hashing algorithm.
@@ -676,32 +729,32 @@ typedef struct sDeriveKeyOptions_d
 /**
  * \brief Calculates the hash on input data by issuing CalcHash command to Security Chip. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_CalcHash(sCalcHash_d* PpsCalcHash);
+LIBRARY_EXPORTS int32_t CmdLib_CalcHash(optiga_comms_t* PpsOptigaComms, sCalcHash_d* PpsCalcHash);
 
 /**
  * \brief Verify the signature on digest by issuing VerifySign command to Security Chip. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_VerifySign(const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature);
+LIBRARY_EXPORTS int32_t CmdLib_VerifySign(optiga_comms_t* PpsOptigaComms, const sVerifyOption_d* PpsVerifySign,const sbBlob_d * PpsDigest,const sbBlob_d * PpsSignature);
 
 /**
  * \brief Generate a key pair by issuing GenKeyPair command to Security Chip. 
  */
-LIBRARY_EXPORTS int32_t CmdLib_GenerateKeyPair(const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair);
+LIBRARY_EXPORTS int32_t CmdLib_GenerateKeyPair(optiga_comms_t* PpsOptigaComms, const sKeyPairOption_d* PpsKeyPairOption,sOutKeyPair_d* PpsOutKeyPair);
 
 /**
  * \brief  Calculate signature on a digest by issuing CalcSign command to the Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_CalculateSign(const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature);
+LIBRARY_EXPORTS int32_t CmdLib_CalculateSign(optiga_comms_t* PpsOptigaComms, const sCalcSignOptions_d *PpsCalcSign,sbBlob_d *PpsSignature);
 
 /**
  * \brief  Calculate shared secret by issuing CalcSSec command to the Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_CalculateSharedSecret(const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret);
+LIBRARY_EXPORTS int32_t CmdLib_CalculateSharedSecret(optiga_comms_t* PpsOptigaComms, const sCalcSSecOptions_d *PpsCalcSSec,sbBlob_d *PpsSecret);
 
 /**
  * \brief  Derive session key by issuing DeriveKey command to the Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey);
+LIBRARY_EXPORTS int32_t CmdLib_DeriveKey(optiga_comms_t* PpsOptigaComms, const sDeriveKeyOptions_d *PpsDeriveKey,sbBlob_d *PpsKey);
 #endif/*MODULE_ENABLE_TOOLBOX*/
 
 /****************************************************************************
@@ -713,6 +766,14 @@ LIBRARY_EXPORTS int32_t CmdLib_DeriveKey(const sDeriveKeyOptions_d *PpsDeriveKey
 ///Length of APDU header     
 #define LEN_APDUHEADER              0x04
 
+///Size of the APDU buffer provided in #optiga_comms_t, required if USE_CMDLIB_WITHOUT_HEAP is defined
+#define CMD_LIB_APDU_BUFFER_SIZE    1558
+
+#ifndef CMD_LIB_STREAM_MIN_CHUNK
+///Smallest chunk of #CmdLib_SetDataObjectStream, each chunk costs a command
+#define CMD_LIB_STREAM_MIN_CHUNK    128
+#endif
+
 ///Number of bytes in Session ID field
 #define BYTES_SESSIONID				0x02
 
@@ -851,27 +912,27 @@ typedef struct sProcCryptoData_d
 /**
  * \brief Generates Uplink message by issuing ProcUpLink command to Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_GetMessage(const sProcMsgData_d *PpsGMsgVector);
+LIBRARY_EXPORTS int32_t CmdLib_GetMessage(optiga_comms_t* PpsOptigaComms, const sProcMsgData_d *PpsGMsgVector);
 
 /**
  * \brief Process Authentication message by issuing ProcDownLink command to Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_PutMessage(const sProcMsgData_d *PpsPMsgVector);
+LIBRARY_EXPORTS int32_t CmdLib_PutMessage(optiga_comms_t* PpsOptigaComms, const sProcMsgData_d *PpsPMsgVector);
 
 /**
  * \brief Encrypts data by issuing ProcUpLink command to Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_Encrypt(sProcCryptoData_d *PpsEncVector);
+LIBRARY_EXPORTS int32_t CmdLib_Encrypt(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsEncVector);
 
 /**
  * \brief Decrypts data by issuing ProcDownLink command to Security Chip.
  */
-LIBRARY_EXPORTS int32_t CmdLib_Decrypt(sProcCryptoData_d *PpsDecVector);
+LIBRARY_EXPORTS int32_t CmdLib_Decrypt(optiga_comms_t* PpsOptigaComms, sProcCryptoData_d *PpsDecVector);
 
 /**
  * \brief Closes the Security Chip session as indicated by the Session Reference Id.
  */
-LIBRARY_EXPORTS int32_t CmdLib_CloseSession(uint16_t PwSessionRefId);
+LIBRARY_EXPORTS int32_t CmdLib_CloseSession(optiga_comms_t* PpsOptigaComms, uint16_t PwSessionRefId);
 #endif /* MODULE_ENABLE_DTLS_MUTUAL_AUTH*/
 #endif //_CMD_LIB_H_
 
@@ -47,11 +47,19 @@
 #define OPTIGA_COMMS_ERROR          0x0001
 /// Busy, doing operation
 #define OPTIGA_COMMS_BUSY           0x0002
+/// Response does not fit into the receive buffer, the value of IFX_I2C_STACK_MEM_ERROR
+#define OPTIGA_COMMS_MEM_ERROR      0x0003
+
+/// Layout version of #optiga_comms_warm_cache_t
+#define OPTIGA_COMMS_WARM_CACHE_VERSION     0x0001
 
 /**********************************************************************************************************************
  * DATA STRUCTURES
  *********************************************************************************************************************/
 
+/** @brief Handler called before the data or metadata of a data object is written, see optiga_comms_t */
+typedef void (*object_write_handler_t)(void* p_ctx, uint16_t optiga_oid);
+
 /** @brief optiga comms structure */
 typedef struct optiga_comms
 {
@@ -63,10 +71,47 @@ typedef struct optiga_comms
     app_event_handler_t upper_layer_handler; 
     /// Optiga comms state
     uint8_t state;
+    /// Maximum communication buffer size of the OPTIGA, read by the command library. 0 if not yet read
+    uint16_t max_comms_buffer;
+    /// Status of the ongoing transaction, as reported to the command library
+    volatile uint32_t comms_status;
+    /// Set while the command library performs a transaction with this instance
+    volatile uint32_t in_use;
+    /// APDU buffer of the command library, allocated at the first use unless provided by the application
+    uint8_t* p_apdu_buffer;
+    /// Size of p_apdu_buffer, at least #CMD_LIB_APDU_BUFFER_SIZE and the maximum communication buffer size
+    uint16_t apdu_buffer_size;
+    /// Set while a command of the command library uses p_apdu_buffer
+    volatile uint32_t apdu_buffer_in_use;
+    /// Number of heap allocations of the command library for this instance
+    uint32_t apdu_buffer_allocations;
+    /// Number of opens and resets of the OPTIGA, data cached by upper layers is invalid once it changes
+    uint32_t reset_count;
+    /// Cache of the util module, see #optiga_util_enable_cache
+    void* p_util_cache;
+    /// Called with this instance by #CmdLib_SetDataObject, #CmdLib_SetDataObjectStream and #CmdLib_GenerateKeyPair
+    /// before they change an object, the instance is held until the command is done.
+    /// Set by #optiga_util_enable_cache, NULL if not used
+    object_write_handler_t object_write_handler;
 }optiga_comms_t;
 
 extern optiga_comms_t optiga_comms;
 
+/** @brief Communication parameters of an OPTIGA, saved after an open and reused by a warm open */
+typedef struct optiga_comms_warm_cache
+{
+    /// Layout version, #OPTIGA_COMMS_WARM_CACHE_VERSION
+    uint16_t version;
+    /// Frequency of the I2C master in KHz
+    uint16_t frequency;
+    /// Frame size negotiated with the OPTIGA
+    uint16_t frame_size;
+    /// Maximum communication buffer size of the OPTIGA
+    uint16_t max_comms_buffer;
+    /// I2C slave address
+    uint8_t slave_address;
+}optiga_comms_warm_cache_t;
+
 /**********************************************************************************************************************
  * API Prototypes
  *********************************************************************************************************************/
@@ -91,11 +136,48 @@ LIBRARY_EXPORTS host_lib_status_t optiga_comms_transceive(optiga_comms_t *p_ctx,
                                                           const uint16_t* p_data_length,
                                                           uint8_t* p_buffer, uint16_t* p_buffer_len);
 
+/**
+ * \brief   Sends and receives the APDU, both scattered over several buffers.
+ */
+LIBRARY_EXPORTS host_lib_status_t optiga_comms_transceive_vector(optiga_comms_t *p_ctx,
+                                                                 const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                                                 const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                                                 uint16_t* p_buffer_len);
+
 /**
  * \brief   Closes the communication channel with OPTIGA.
  */
 LIBRARY_EXPORTS host_lib_status_t optiga_comms_close(optiga_comms_t *p_ctx);
 
+/**
+ * \brief   Gets the communication parameters to be saved for a warm open.
+ */
+LIBRARY_EXPORTS host_lib_status_t optiga_comms_get_warm_cache(const optiga_comms_t *p_ctx,
+                                                              optiga_comms_warm_cache_t *p_cache);
+
+/**
+ * \brief   Requests a warm open with previously saved communication parameters.
+ */
+LIBRARY_EXPORTS host_lib_status_t optiga_comms_set_warm_cache(optiga_comms_t *p_ctx,
+                                                              const optiga_comms_warm_cache_t *p_cache);
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+/**
+ * \brief   Takes over the event processing of all OPTIGA instances and returns a handle to poll for readability.
+ */
+LIBRARY_EXPORTS int32_t optiga_get_event_fd(void);
+
+/**
+ * \brief   Gets the time in microseconds until #optiga_process_events has to be invoked at the latest.
+ */
+LIBRARY_EXPORTS uint32_t optiga_get_next_deadline_us(void);
+
+/**
+ * \brief   Advances the protocol state machines of all OPTIGA instances without blocking.
+ */
+LIBRARY_EXPORTS void optiga_process_events(void);
+#endif
+
 /**
 * @}
 */
@@ -281,6 +281,8 @@ typedef struct sMsgLyr_d
     sbBlob_d sTLMsg;
     ///Flight received
     eFlight_d eFlight;
+    ///Optiga comms instance of the security chip
+    optiga_comms_t* psOptigaComms;
 } sMsgLyr_d;
 
 
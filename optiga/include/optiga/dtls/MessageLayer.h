@@ -87,8 +87,8 @@
 ///Over head length for command library
 #define OVERHEAD_LEN                        21                     //APDU (4) + Message header len(12) + Tag enconding len(5)
 
-//Macro to validate the time out
-#define TIMEELAPSED(bStartTime,bTimeout)    (((uint32_t)(pal_os_timer_get_time_in_milliseconds() - bStartTime) < (uint32_t)(bTimeout*1000))?TRUE:FALSE)
+//Macro to validate the time out, start time in microseconds and timeout in seconds
+#define TIMEELAPSED(qwStartTime,bTimeout)   (((pal_os_timer_get_time_in_microseconds() - (qwStartTime)) < ((uint64_t)(bTimeout)*1000000))?TRUE:FALSE)
 /// @endcond
 
 /****************************************************************************
@@ -126,6 +126,8 @@ typedef struct sMessageLayer_d
     uint16_t  wOIDDevCertificate;
     ///Callback function pointer to get unixtime
     fGetUnixTime_d pfGetUnixTIme;
+    ///Optiga comms instance of the security chip
+    optiga_comms_t* psOptigaComms;
 } sMessageLayer_d;
 
 /**
@@ -143,6 +143,8 @@ typedef struct sHandshake_d
 	uint16_t wOIDDevPrivKey;
     ///Callback function pointer to get unixtime
     fGetUnixTime_d pfGetUnixTIme;
+    ///Optiga comms instance of the security chip
+    optiga_comms_t* psOptigaComms;
 }sHandshake_d;
 
  
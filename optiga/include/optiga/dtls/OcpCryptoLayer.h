@@ -37,6 +37,7 @@
 #include "optiga/common/Datatypes.h"
 #include "optiga/common/Logger.h"
 #include "optiga/dtls/OcpCommonIncludes.h"
+#include "optiga/comms/optiga_comms.h"
 
 /****************************************************************************
  *
@@ -72,6 +73,9 @@ typedef struct sCL_d
 
     //Pointer to Logger
     sLogger_d sLogger;
+
+    ///Optiga comms instance of the security chip
+    optiga_comms_t* psOptigaComms;
 }sCL_d;
 
 
@@ -84,6 +84,14 @@ host_lib_status_t ifx_i2c_reset(ifx_i2c_context_t *p_ctx, ifx_i2c_reset_type_t r
 host_lib_status_t ifx_i2c_transceive(ifx_i2c_context_t *p_ctx,const uint8_t* p_data, const uint16_t* p_data_length, 
                           uint8_t* p_buffer, uint16_t* p_buffer_len);
 
+/**
+ * \brief   Sends a command and receives a response, both scattered over several buffers.
+ */
+host_lib_status_t ifx_i2c_transceive_vector(ifx_i2c_context_t *p_ctx,
+                                            const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                            const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                            uint16_t* p_buffer_len);
+
 /**
  * \brief   Closes the IFX I2C protocol stack for a given context.
  */
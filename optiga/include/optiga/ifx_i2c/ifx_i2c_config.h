@@ -41,6 +41,7 @@ extern "C" {
 **********************************************************************************************************************/
 // Protocol Stack Includes
 #include <stdint.h>
+#include "optiga/common/Datatypes.h"
 #include "optiga/pal/pal_i2c.h"
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/pal/pal_os_timer.h"
@@ -60,11 +61,21 @@ extern "C" {
 #define PL_DATA_POLLING_INVERVAL_US (5000)
 /** @brief Physical Layer: guard time interval in microseconds */
 #define PL_GUARD_TIME_INTERVAL_US   (50)
+/** @brief Physical Layer: status register polling interval while waiting for the response pin, in microseconds */
+#ifndef PL_IRQ_FALLBACK_POLL_US
+#define PL_IRQ_FALLBACK_POLL_US     (20000)
+#endif
+/** @brief Physical Layer: number of APDU commands for which the response latency is learnt */
+#ifndef PL_LATENCY_MODEL_SIZE
+#define PL_LATENCY_MODEL_SIZE       (8)
+#endif
 
-/** @brief Data link layer: maximum frame size */
+/** @brief Data link layer: frame size of the default frame arena, the frame size is negotiated up to this size */
 #ifndef DL_MAX_FRAME_SIZE
 #define DL_MAX_FRAME_SIZE           (300)
 #endif
+/** @brief Data link layer: minimum frame size */
+#define DL_MIN_FRAME_SIZE           (16)
 /** @brief Data link layer: header size */
 #define DL_HEADER_SIZE              (5)
 /** @brief Data link layer: maximum number of retries in case of transmission error */
@@ -72,6 +83,21 @@ extern "C" {
 /** @brief Data link layer: Trans timeout in milliseconds*/
 #define PL_TRANS_TIMEOUT_MS         (10)
 
+/** @brief Data link layer: CRC calculated bit by bit. Smallest code size */
+#define IFX_I2C_DL_CRC_BITWISE      (0)
+/** @brief Data link layer: CRC calculated byte by byte using a 256 entry table (512 bytes) */
+#define IFX_I2C_DL_CRC_TABLE        (1)
+/** @brief Data link layer: CRC calculated 8 bytes at a time using eight 256 entry tables (4 KB) */
+#define IFX_I2C_DL_CRC_SLICE_BY_8   (2)
+/** @brief Data link layer: CRC calculation used for frames (#IFX_I2C_DL_CRC_BITWISE, #IFX_I2C_DL_CRC_TABLE or #IFX_I2C_DL_CRC_SLICE_BY_8) */
+#ifndef IFX_I2C_DL_CRC_BACKEND
+#define IFX_I2C_DL_CRC_BACKEND      (IFX_I2C_DL_CRC_TABLE)
+#endif
+/** @brief Data link layer: received data frames are copied to the receive buffer while the CRC is calculated (1) or after the check (0) */
+#ifndef IFX_I2C_DL_CRC_FUSED_COPY
+#define IFX_I2C_DL_CRC_FUSED_COPY   (1)
+#endif
+
 /** @brief Transport layer: Maximum exit timeout in seconds */
 #define TL_MAX_EXIT_TIMEOUT         (6)
 
@@ -95,6 +121,8 @@ extern "C" {
 #define IFX_I2C_DL_HEADER_OFFSET    (0)
 /** @brief Offset of Transport header in tx_frame_buffer */
 #define IFX_I2C_TL_HEADER_OFFSET    (IFX_I2C_DL_HEADER_OFFSET+3)
+/** @brief Size of the frame arena for frames up to frame_size: physical layer buffer, tx and rx frame buffer */
+#define IFX_I2C_FRAME_ARENA_SIZE(frame_size)    ((3 * (frame_size)) + 1)
 
 /** @brief Protocol Stack debug switch for physical layer (set to 0 or 1) */
 #define IFX_I2C_LOG_PL              0
@@ -125,13 +153,26 @@ typedef struct ifx_i2c_context ifx_i2c_context_t;
 /** @brief Event handler function prototype */
 typedef void (*ifx_i2c_event_handler_t)(struct ifx_i2c_context* ctx, host_lib_status_t event, const uint8_t* data, uint16_t data_len);
 
+/** @brief Physical layer: learnt response latency of an APDU command */
+typedef struct ifx_i2c_pl_latency
+{
+    /// APDU command code
+    uint8_t  command;
+    /// Number of responses observed, 0 if the entry is unused
+    uint32_t samples;
+    /// Expected time from sending the command until its response is ready, in microseconds
+    uint32_t expected_us;
+    /// Number of status register polls done while waiting for responses to this command
+    uint32_t polls;
+} ifx_i2c_pl_latency_t;
+
 /** @brief Physical layer structure */
 typedef struct ifx_i2c_pl
 {    
     // Physical Layer low level interface variables
     
-    /// Physical layer buffer
-    uint8_t buffer[DL_MAX_FRAME_SIZE+1];
+    /// Physical layer buffer of frame size + 1 bytes, taken from the frame arena
+    uint8_t* buffer;
     /// Tx length
     uint16_t buffer_tx_len;
     /// Rx length
@@ -140,6 +181,8 @@ typedef struct ifx_i2c_pl
     uint8_t  register_action;
     /// i2c read/i2c write
     uint8_t  i2c_cmd;
+    /// Register read by a combined write-read, kept for the retries as buffer receives the content
+    uint8_t  register_address;
     /// Retry counter
     uint16_t retry_counter;
     
@@ -162,6 +205,38 @@ typedef struct ifx_i2c_pl
     uint8_t   negotiate_state;
     /// Soft reset requested
     uint8_t   request_soft_reset;
+    /// Status of the synchronous pal i2c request (write slave address)
+    volatile host_lib_status_t pal_event_status;
+
+    // Physical Layer response latency model. Kept across open/close, can be read by the application
+
+    /// Learnt response latency per APDU command
+    ifx_i2c_pl_latency_t latency_model[PL_LATENCY_MODEL_SIZE];
+    /// Entry of latency_model used by the command being sent
+    uint8_t   latency_index;
+    /// Entry of latency_model replaced next when a new command is seen
+    uint8_t   latency_next;
+    /// Set if the frame being sent completes a command
+    uint8_t   latency_last_fragment;
+    /// Set while the response to a completely sent command is awaited
+    uint8_t   latency_pending;
+    /// Time at which the command was completely sent, in microseconds
+    uint64_t  command_sent_time_us;
+    /// Status register polling interval used once the expected latency has elapsed, in microseconds
+    uint32_t  poll_interval_us;
+    /// Total number of status register polls while waiting for frames
+    uint32_t  status_polls;
+
+    // Physical Layer response pin, see ifx_i2c_context_t.p_slave_irq_pin
+
+    /// Edges of the response pin are reported
+    uint8_t   irq_enabled;
+    /// A status poll is scheduled only as fallback, an edge of the response pin starts it at once
+    uint8_t   irq_armed;
+    /// An edge was reported since the last status register read started
+    uint8_t   irq_pending;
+    /// Total number of status register polls started by an edge of the response pin
+    uint32_t  irq_polls;
 } ifx_i2c_pl_t;
 
 /** @brief Datalink layer structure */
@@ -183,8 +258,10 @@ typedef struct ifx_i2c_dl
     uint8_t error;
     /// Resynced
     uint8_t resynced;
-    /// Timeout value
-    uint32_t data_poll_timeout;
+    /// Re-synchronize the frame counters before sending the next frame
+    uint8_t resync_pending;
+    /// Time allowed for the frame, in microseconds
+    uint32_t data_poll_timeout_us;
     /// Transmit buffer size
     uint16_t tx_buffer_size;
     /// Receive buffer size
@@ -193,8 +270,8 @@ typedef struct ifx_i2c_dl
     uint8_t* p_tx_frame_buffer;
     /// Pointer to main receive buffers
     uint8_t* p_rx_frame_buffer;
-    ///Start time of sending frame
-    uint32_t frame_start_time;
+    ///Start time of sending frame, in microseconds
+    uint64_t frame_start_time_us;
     // Upper layer Event handler
     ifx_i2c_event_handler_t upper_layer_event_handler;
 } ifx_i2c_dl_t;
@@ -206,8 +283,10 @@ typedef struct ifx_i2c_tl
     
     /// Transport layer state
     uint8_t  state;
-    /// Pointer to packet provided by user
-    uint8_t* p_actual_packet;
+    /// Segments of the packet provided by user, see #ifx_i2c_transceive_vector
+    const sbBlob_d* p_tx_vector;
+    /// Number of segments in p_tx_vector
+    uint8_t tx_vector_count;
     /// Total received data
     uint16_t total_recv_length;
     /// Actual length of user provided packet
@@ -216,12 +295,22 @@ typedef struct ifx_i2c_tl
     uint16_t packet_offset;
     /// Maximum length of packet at transport layer
     uint16_t max_packet_length;
-    /// Pointer to user provided receive buffer
-    uint8_t* p_recv_packet_buffer;
-    /// Length of receive buffer
+    /// Segments of the user provided receive buffer
+    const sbBlob_d* p_rx_vector;
+    /// Number of segments in p_rx_vector
+    uint8_t rx_vector_count;
+    /// Size of the receive buffer, sum of the lengths of the segments in p_rx_vector
+    uint16_t recv_packet_buffer_size;
+    /// Length of the received packet
     uint16_t* p_recv_packet_buffer_length;
-    /// Start time of the transport layer API
-    uint32_t api_start_time;
+    /// Segment of the packet passed to #ifx_i2c_tl_transceive
+    sbBlob_d tx_segment;
+    /// Segment of the receive buffer passed to #ifx_i2c_tl_transceive
+    sbBlob_d rx_segment;
+    /// Bytes copied between the user buffers and the frame buffers, never cleared by the stack
+    uint32_t bytes_copied;
+    /// Start time of the transport layer API, in microseconds
+    uint64_t api_start_time_us;
 	///Chaining error coutn from slave
 	uint8_t chaining_error_count;
 	///Chaining error count for master
@@ -244,7 +333,7 @@ typedef struct ifx_i2c_context
     uint8_t slave_address;
     /// Frequency of i2c master
     uint16_t frequency;
-    /// Data link layer frame size
+    /// Data link layer frame size requested at open, 0 for the largest the frame arena holds. Set to the negotiated size
     uint16_t frame_size;
     /// Pointer to pal gpio context for vdd
     pal_gpio_t* p_slave_vdd_pin;
@@ -252,6 +341,15 @@ typedef struct ifx_i2c_context
     pal_gpio_t* p_slave_reset_pin;  
     /// Pointer to pal i2c context
     pal_i2c_t* p_pal_i2c_ctx;
+    /// Open without reset and negotiation, reusing frame_size and frequency negotiated before. Cleared on fallback
+    uint8_t warm_open;
+    /// Memory for the frame buffers, of #IFX_I2C_FRAME_ARENA_SIZE for the largest frame size to be negotiated
+    uint8_t* p_frame_arena;
+    /// Size of the frame arena in bytes
+    uint16_t frame_arena_size;
+    /// Pointer to pal gpio context of the pin signalling a response, NULL to poll the I2C_STATE register only.
+    /// Used with #PAL_GPIO_HAS_IRQ
+    pal_gpio_t* p_slave_irq_pin;
      
     /// Upper layer event handler
     app_event_handler_t upper_layer_event_handler;
@@ -281,10 +379,10 @@ typedef struct ifx_i2c_context
     /// Physical layer context
     ifx_i2c_pl_t pl;
     
-    /// IFX I2C tx frame of max length
-    uint8_t tx_frame_buffer[DL_MAX_FRAME_SIZE];
-    /// IFX I2C rx frame of max length
-    uint8_t rx_frame_buffer[DL_MAX_FRAME_SIZE];
+    /// IFX I2C tx frame of max length, taken from the frame arena
+    uint8_t* tx_frame_buffer;
+    /// IFX I2C rx frame of max length, taken from the frame arena
+    uint8_t* rx_frame_buffer;
        
 } ifx_i2c_context_t;
 
@@ -292,7 +390,7 @@ typedef struct ifx_i2c_context
 * GLOBAL
 ***********************************************************************************************************************/
 
-/** @brief IFX I2C Instance */
+/** @brief Default IFX I2C Instance. Further instances are defined the same way, one per OPTIGA */
 extern ifx_i2c_context_t ifx_i2c_context_0;
 
 /***********************************************************************************************************************
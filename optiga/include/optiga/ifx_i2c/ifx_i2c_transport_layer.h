@@ -89,6 +89,28 @@ host_lib_status_t ifx_i2c_tl_init(ifx_i2c_context_t *p_ctx,ifx_i2c_event_handler
 host_lib_status_t ifx_i2c_tl_transceive(ifx_i2c_context_t *p_ctx,uint8_t* p_packet, uint16_t packet_len,
                                uint8_t* p_recv_packet, uint16_t* recv_packet_len);
 
+/**
+ * @brief Function to transmit and receive a packet scattered over several buffers.
+ *
+ * Same as @ref ifx_i2c_tl_transceive, the fragments are copied from the transmit segments into the
+ * frame buffer and from the frame buffer into the receive segments in order, without assembling the
+ * packet first. The segments must remain valid until the event is propagated.
+ *
+ * @param[in,out] p_ctx     Pointer to ifx i2c context.
+ * @param[in] p_tx_vector          Segments of the packet.
+ * @param[in] tx_count             Number of segments in p_tx_vector.
+ * @param[in] p_rx_vector          Segments of the receive buffer.
+ * @param[in] rx_count             Number of segments in p_rx_vector.
+ * @param[out] recv_packet_len     Length of the received packet.
+ *
+ * @retval  IFX_I2C_STACK_SUCCESS If function was successful.
+ * @retval  IFX_I2C_STACK_ERROR If the module is busy.
+ */
+host_lib_status_t ifx_i2c_tl_transceive_vector(ifx_i2c_context_t *p_ctx,
+                                               const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                               const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                               uint16_t* recv_packet_len);
+
 /**
  * @}
  **/
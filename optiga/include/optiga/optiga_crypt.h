@@ -204,6 +204,7 @@ typedef struct key_from_opitga
  * - The maximum value of the <b>random_data_length</b> parameter is size of buffer <b>random_data</b>.
  *   In case the value is greater than buffer size, memory corruption can occur.<br>
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]      rng_type               Type of random data generator.
  *                                        - The input must be from #optiga_rng_type.
  *                                        - Argument check for rng_type is not done since OPTIGA will provide an error for invalid rng_type.
@@ -217,7 +218,8 @@ typedef struct key_from_opitga
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
+optiga_lib_status_t optiga_crypt_random(optiga_comms_t * p_comms,
+                                        optiga_rng_types_t rng_type,
                                         uint8_t * random_data,
                                         uint16_t random_data_length);
 
@@ -242,6 +244,7 @@ optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
  *  - User must save the output hash context for further usage as OPTIGA does not store it internally.<br>
  *
  *<br>
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[inout]   hash_ctx     Pointer to #optiga_hash_context_t to store the hash context from OPTIGA
  *                              - The input <b>hash_algo</b> in  <b>hash_ctx</b> must be from #optiga_hash_type.
  *
@@ -250,7 +253,8 @@ optiga_lib_status_t optiga_crypt_random(optiga_rng_types_t rng_type,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx);
+optiga_lib_status_t optiga_crypt_hash_start(optiga_comms_t * p_comms,
+                                            optiga_hash_context_t * hash_ctx);
 
 
  /**
@@ -274,6 +278,7 @@ optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx);
  *  - User must save the output hash context for further usage as OPTIGA does not store it internally.<br>
  *
  *<br>
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]   hash_ctx                  Pointer to #optiga_hash_context_t containing hash context from OPTIGA, must not be NULL
  * \param[in]   source_of_data_to_hash    Data from host / Data in optiga. Must be one of the below
  *                                        - #OPTIGA_CRYPT_HOST_DATA,if source of data is from Host.
@@ -285,7 +290,8 @@ optiga_lib_status_t optiga_crypt_hash_start(optiga_hash_context_t * hash_ctx);
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
+optiga_lib_status_t optiga_crypt_hash_update(optiga_comms_t * p_comms,
+                                             optiga_hash_context_t * hash_ctx,
                                              uint8_t source_of_data_to_hash,
                                              void * data_to_hash);
 
@@ -310,6 +316,7 @@ optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
  *  - User must save the output hash context for further usage as OPTIGA does not store it internally.<br>
  *
  *<br>
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]   hash_ctx         Pointer to #optiga_hash_context_t containing hash context from OPTIGA, must not be NULL
  * \param[inout]   hash_output   Output Hash
  *
@@ -318,7 +325,8 @@ optiga_lib_status_t optiga_crypt_hash_update(optiga_hash_context_t * hash_ctx,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE     Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
+optiga_lib_status_t optiga_crypt_hash_finalize(optiga_comms_t * p_comms,
+                                               optiga_hash_context_t * hash_ctx,
                                                uint8_t * hash_output);
 
 
@@ -343,6 +351,7 @@ optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
 
  * - Error codes from lower layers will be returned as it is.<br>
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]   curve_id                 ECC curve id.
  * \param[in]   key_usage                Key usage defined by #optiga_key_usage_t.
  *                                       - Values from #optiga_key_usage can be logically ORed and passed.<br>
@@ -361,7 +370,8 @@ optiga_lib_status_t optiga_crypt_hash_finalize(optiga_hash_context_t * hash_ctx,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_id,
+optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_comms_t * p_comms,
+                                                      optiga_ecc_curve_t curve_id,
                                                       uint8_t key_usage,
                                                       bool_t export_private_key,
                                                       void * private_key,
@@ -388,6 +398,7 @@ optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_i
 
  * - Error codes from lower layers will be returned as it is.<br>
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]   digest               Digest on which signature is generated.
  * \param[in]   digest_length        Length of the input digest.
  * \param[in]   private_key          Private key OID to generate signature.
@@ -400,7 +411,8 @@ optiga_lib_status_t optiga_crypt_ecc_generate_keypair(optiga_ecc_curve_t curve_i
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_ecdsa_sign(uint8_t * digest,
+optiga_lib_status_t optiga_crypt_ecdsa_sign(optiga_comms_t * p_comms,
+                                            uint8_t * digest,
                                             uint8_t digest_length,
                                             optiga_key_id_t private_key,
                                             uint8_t * signature,
@@ -421,6 +433,7 @@ optiga_lib_status_t optiga_crypt_ecdsa_sign(uint8_t * digest,
  *<b>Notes:</b>
  * - Error codes from lower layers will be returned as it is to the application.<br>
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]   digest                 Pointer to a given digest buffer, must not be NULL.
  * \param[in]   digest_length          Length of digest
  * \param[in]   signature              Pointer to a given signature buffer, must not be NULL.
@@ -437,7 +450,8 @@ optiga_lib_status_t optiga_crypt_ecdsa_sign(uint8_t * digest,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_ecdsa_verify(uint8_t * digest,
+optiga_lib_status_t optiga_crypt_ecdsa_verify(optiga_comms_t * p_comms,
+                                              uint8_t * digest,
                                               uint8_t digest_length,
                                               uint8_t * signature,
                                               uint16_t signature_length,
@@ -465,6 +479,7 @@ optiga_lib_status_t optiga_crypt_ecdsa_verify(uint8_t * digest,
  * - If the user provides <b>private_key</b> as session based and <b>export_to_host</b> as FALSE,<br>
  *   then the shared secret generated will overwrite the private key stored in the session object ID
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]      private_key            Object ID of the private key stored in OPTIGA.<br>
  *                                        - Possible values are from the #optiga_key_id_t <br>
  *                                        - Argument check for private_key is not done since OPTIGA will provide an error for invalid private_key.
@@ -480,7 +495,8 @@ optiga_lib_status_t optiga_crypt_ecdsa_verify(uint8_t * digest,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
+optiga_lib_status_t optiga_crypt_ecdh(optiga_comms_t * p_comms,
+                                      optiga_key_id_t private_key,
                                       public_key_from_host_t * public_key,
                                       bool_t export_to_host,
                                       uint8_t * shared_secret);
@@ -504,6 +520,7 @@ optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
  * - At present, the minimum length of the output derived key is 16.
  * - Error codes from lower layers will be returned as it is to the application.<br>
  *
+ * \param[in]      p_comms                Pointer to the optiga comms instance of the OPTIGA, opened using #optiga_util_open_application.
  * \param[in]      secret                 Object ID of the secret stored in OPTIGA.
  *                                        - #OPTIGA_KEY_ID_SESSION_BASED from #optiga_key_id_t, indicates the secret is available.
  *                                          in the session context acquired by the instance.
@@ -523,7 +540,8 @@ optiga_lib_status_t optiga_crypt_ecdh(optiga_key_id_t private_key,
  * \retval  #OPTIGA_CRYPT_ERROR_INSTANCE_IN_USE             Same instance with ongoing request servicing is used
  * \retval  #OPTIGA_DEVICE_ERROR                            Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_crypt_tls_prf_sha256(uint16_t secret,
+optiga_lib_status_t optiga_crypt_tls_prf_sha256(optiga_comms_t * p_comms,
+                                                uint16_t secret,
                                                 uint8_t * label,
                                                 uint16_t label_length,
                                                 uint8_t * seed,
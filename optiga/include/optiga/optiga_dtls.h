@@ -176,6 +176,9 @@ typedef struct sConfigOCP_d
 
 	///Private key OID
 	uint16_t wOIDDevPrivKey;
+
+	///Optiga comms instance of the security chip, opened using #optiga_util_open_application
+	optiga_comms_t* psOptigaComms;
 }sAppOCPConfig_d;
 
 /**
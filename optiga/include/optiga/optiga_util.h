@@ -71,6 +71,28 @@ extern "C" {
 #define OPTIGA_UTIL_WRITE_ONLY      (0x00)
 /// Option to erase and write the data object
 #define OPTIGA_UTIL_ERASE_AND_WRITE (0x40)
+/// Option to only write the bytes of the data object which differ from the data to write
+#define OPTIGA_UTIL_WRITE_DIFFERENTIAL (0x01)
+
+#ifndef OPTIGA_UTIL_WRITE_DIFF_MAX_GAP
+/// Unchanged bytes between two changed ranges written along instead of issuing another SetDataObject command
+#define OPTIGA_UTIL_WRITE_DIFF_MAX_GAP (64)
+#endif
+
+/// Maximum length of the metadata of a data object, including the TLV header
+#define OPTIGA_UTIL_METADATA_MAX_LEN (0x1C)
+
+#ifndef OPTIGA_UTIL_AC_MAX_TERMS
+/// Maximum number of alternatives of a compiled access condition, as many as fit in the metadata
+#define OPTIGA_UTIL_AC_MAX_TERMS (6)
+#endif
+
+/// Data object is not cached
+#define OPTIGA_UTIL_OBJECT_EMPTY            (0x00)
+/// Data object is cached until it is written, OPTIGA is reset or the cache is invalidated
+#define OPTIGA_UTIL_OBJECT_CACHED           (0x01)
+/// Data object can never be changed and remains cached over resets of OPTIGA
+#define OPTIGA_UTIL_OBJECT_CACHED_FOREVER   (0x02)
 
 
 /**
@@ -131,6 +153,165 @@ typedef enum eOID_d
 	eERROR_CODES = 0xF1C2
 } eOID_d;
 
+/**
+ * \brief  One read of #optiga_util_read_data_batch
+ */
+typedef struct optiga_util_read_entry
+{
+    /// OID of data object
+    uint16_t optiga_oid;
+    /// Offset from within data object
+    uint16_t offset;
+    /// Buffer to which data is read
+    uint8_t * buffer;
+    /// Length of data to be read, updated with actual data length retrieved or 0 on error
+    uint16_t bytes_to_read;
+    /// Result of the read, #OPTIGA_LIB_SUCCESS or #OPTIGA_LIB_ERROR
+    optiga_lib_status_t status;
+} optiga_util_read_entry_t;
+
+/**
+ * \brief  One alternative of a compiled access condition, satisfied if both life cycle states are within their range
+ */
+typedef struct optiga_util_ac_term
+{
+    /// Lowest life cycle state of the application
+    uint8_t lcsa_min;
+    /// Highest life cycle state of the application
+    uint8_t lcsa_max;
+    /// Lowest global life cycle state
+    uint8_t lcsg_min;
+    /// Highest global life cycle state
+    uint8_t lcsg_max;
+} optiga_util_ac_term_t;
+
+/**
+ * \brief  Metadata of one data object compiled for the checks of optiga_util
+ *
+ * The life cycle state of the data object is resolved when compiling, the access condition
+ * depends only on the life cycle states of the application and global.
+ */
+typedef struct optiga_util_compiled_metadata
+{
+    /// Alternatives of the read access condition, never satisfied if there is none
+    optiga_util_ac_term_t read_ac[OPTIGA_UTIL_AC_MAX_TERMS];
+    /// Number of alternatives in read_ac
+    uint8_t read_ac_count;
+    /// Set if the read access condition has more alternatives than #OPTIGA_UTIL_AC_MAX_TERMS, it is then checked
+    /// by OPTIGA only
+    uint8_t read_ac_overflow;
+    /// Set if the change access condition is never
+    uint8_t change_never;
+    /// Set if the used size is present
+    uint8_t used_size_present;
+    /// Used size of the data object
+    uint16_t used_size;
+} optiga_util_compiled_metadata_t;
+
+/**
+ * \brief  Metadata of one data object in #optiga_util_cache_t
+ */
+typedef struct optiga_util_metadata_entry
+{
+    /// OID of data object, 0 if the entry is unused
+    uint16_t optiga_oid;
+    /// Metadata in TLV format as read from OPTIGA
+    uint8_t metadata[OPTIGA_UTIL_METADATA_MAX_LEN];
+    /// Metadata compiled when it was read
+    optiga_util_compiled_metadata_t compiled;
+} optiga_util_metadata_entry_t;
+
+/**
+ * \brief  Data of one data object in #optiga_util_cache_t
+ */
+typedef struct optiga_util_object_entry
+{
+    /// OID of data object, set by the application
+    uint16_t optiga_oid;
+    /// Buffer for the data, set by the application
+    uint8_t * buffer;
+    /// Size of buffer, set by the application. Data beyond it is always read from OPTIGA
+    uint16_t buffer_size;
+    /// Set by the application to read the data object in #optiga_util_prefetch_cache
+    uint8_t prefetch;
+    /// State of the entry, OPTIGA_UTIL_OBJECT_EMPTY, OPTIGA_UTIL_OBJECT_CACHED or OPTIGA_UTIL_OBJECT_CACHED_FOREVER
+    uint8_t state;
+    /// Length of the cached data
+    uint16_t length;
+    /// Set if the cached data is the whole data object
+    uint8_t complete;
+} optiga_util_object_entry_t;
+
+/**
+ * \brief  Host side cache of an optiga comms instance, enabled using #optiga_util_enable_cache
+ *
+ * The storage is provided by the application, the cache does no heap allocation.
+ */
+typedef struct optiga_util_cache
+{
+    /// Entries to cache metadata, provided by the application
+    optiga_util_metadata_entry_t * p_metadata_entries;
+    /// Number of entries in p_metadata_entries, 0 to cache only the life cycle states
+    uint16_t metadata_entry_count;
+    /// Entry replaced at the next metadata miss, once all entries are used
+    uint16_t metadata_next_entry;
+    /// Entries to cache data, one per data object, provided by the application
+    optiga_util_object_entry_t * p_object_entries;
+    /// Number of entries in p_object_entries
+    uint16_t object_entry_count;
+    /// Set by the application to call #optiga_util_prefetch_cache at the end of #optiga_util_open_application
+    uint8_t prefetch_on_open;
+    /// Life cycle state of the application, valid if lcs_valid is TRUE
+    uint8_t lcsa;
+    /// Global life cycle state, valid if lcs_valid is TRUE
+    uint8_t lcsg;
+    /// Set once lcsa and lcsg are read
+    uint8_t lcs_valid;
+    /// reset_count of the optiga comms instance the cached values were read with
+    uint32_t reset_count;
+    /// Reads of the life cycle states answered from the cache
+    uint32_t lcs_hits;
+    /// Reads of the life cycle states from OPTIGA
+    uint32_t lcs_misses;
+    /// Metadata reads answered from the cache
+    uint32_t metadata_hits;
+    /// Metadata reads from OPTIGA
+    uint32_t metadata_misses;
+    /// Data reads of cached data objects answered from the cache
+    uint32_t object_hits;
+    /// Data reads of cached data objects from OPTIGA, including the reads filling the cache
+    uint32_t object_misses;
+    /// Invalidations of the whole cache, explicit or after a reset of OPTIGA
+    uint32_t invalidations;
+} optiga_util_cache_t;
+
+/**
+ * \brief  Reads the next length bytes of a stream to p_chunk, returns 0 on success
+ */
+typedef int32_t (*optiga_util_stream_read_t)(void * p_ctx, uint8_t * p_chunk, uint16_t length);
+
+/**
+ * \brief  Reports the total number of bytes of a stream written so far
+ */
+typedef void (*optiga_util_stream_progress_t)(void * p_ctx, uint16_t bytes_written);
+
+/**
+ * \brief  Source of the data written by #optiga_util_write_data_stream
+ */
+typedef struct optiga_util_stream
+{
+    /// Callback reading the next chunk of data
+    optiga_util_stream_read_t read;
+    /// Callback reporting the progress, can be NULL
+    optiga_util_stream_progress_t progress;
+    /// Context passed to the callbacks
+    void * p_ctx;
+    /// Buffer for two chunks of data, provided by the application
+    uint8_t * buffer;
+    /// Size of buffer, at least 2 * #CMD_LIB_STREAM_MIN_CHUNK bytes or 2 * bytes_to_write if smaller
+    uint16_t buffer_size;
+} optiga_util_stream_t;
+
 /**
  * @brief Initializes the communication with optiga.
  *
@@ -175,6 +356,36 @@ typedef enum eOID_d
  */
 optiga_lib_status_t optiga_util_open_application(optiga_comms_t* p_comms);
 
+#ifdef PAL_OS_HAS_DATASTORE
+/**
+ * @brief Opens the application on optiga, reusing the communication parameters saved by a previous open.
+ *
+ *<b>Pre Conditions:</b>
+ * - Same as #optiga_util_open_application.<br>
+ *
+ *<b>API Details:</b>
+ * - Reads the parameters saved in the host side datastore and requests a warm open using #optiga_comms_set_warm_cache.
+ *   The reset, the frame size and frequency negotiation and the read of the maximum communication buffer size 
+ *   are skipped.<br>
+ * - Invokes #optiga_util_open_application. It falls back to the full sequence if the OPTIGA does not match 
+ *   the saved parameters.<br>
+ * - Saves the parameters in use to the datastore, if they changed.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - If the datastore is empty or its content does not match the configuration of p_comms, a full open is done.<br>
+ * - Each OPTIGA instance must use its own datastore id.<br>
+ *
+ * \param[in]      p_comms          Pointer to the communication parameters initialised before
+ * \param[in]      datastore_id     Host side datastore holding the parameters, e.g. #PAL_OS_DATASTORE_ID_WARM_CACHE
+ *
+ * \retval  #OPTIGA_LIB_SUCCESS                                Successful invocation of optiga cmd module
+ * \retval  #OPTIGA_LIB_ERROR								   Error during function execurition
+ * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
+ */
+optiga_lib_status_t optiga_util_open_application_warm(optiga_comms_t* p_comms, uint16_t datastore_id);
+#endif
+
 /**
  * @brief Reads data from optiga.
  *
@@ -194,6 +405,7 @@ optiga_lib_status_t optiga_util_open_application(optiga_comms_t* p_comms);
  * - <b>*bytes_to_read</b> parameter is set to 0, in case any errors occurs while retrieving the data. initially contains the value of the user provided data length to be read. When the data is successfully retrieved, this value is updated with actual data length retrieved.<br>
  *      In case of any errors, the value is set to 0.<br>
  *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
  * \param[in]      optiga_oid       OID of data object
  *                                  - It should be a valid data object, otherwise OPTIGA returns an error.<br>
  * \param[in]      offset           Offset from within data object
@@ -206,11 +418,103 @@ optiga_lib_status_t optiga_util_open_application(optiga_comms_t* p_comms);
  * \retval  #OPTIGA_UTIL_ERROR_INVALID_INPUT                   Wrong Input arguments provided
  * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_util_read_data(uint16_t optiga_oid,
+optiga_lib_status_t optiga_util_read_data(optiga_comms_t * p_comms,
+                                          uint16_t optiga_oid,
                                           uint16_t offset,
                                           uint8_t * buffer,
                                           uint16_t * bytes_to_read);
 
+/**
+ * @brief Reads data of several data objects from optiga, acquiring the optiga comms instance once.
+ *
+ * Retrieves the requested data of all entries, as #optiga_util_read_data does for each of them.<br>
+ *
+ *
+ *<b>Pre Conditions:</b>
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ *<b>API Details:</b>
+ * - Acquires the optiga comms instance once and issues the GetDataObject commands of all entries one after
+ *   the other.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - Only the lock acquisitions of the instance are saved. OPTIGA executes one command at a time, hence the
+ *   commands are not pipelined and the bus transfers and execution time are those of sequential reads.<br>
+ * - All entries are read, an error of one entry does not stop the reads of the following entries.<br>
+ * - The result of each read is returned in the status of the entry and <b>bytes_to_read</b> is set to 0 on error.<br>
+ * - Other users of the same optiga comms instance wait until all entries are read.<br>
+ *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
+ * \param[in,out]  entries          Valid pointer to the entries to read
+ * \param[in]      count            Number of entries
+ *
+ * \retval  #OPTIGA_LIB_SUCCESS                                All entries are read successfully
+ * \retval  #OPTIGA_LIB_ERROR                                  Wrong input arguments provided or at least one entry failed
+ */
+optiga_lib_status_t optiga_util_read_data_batch(optiga_comms_t * p_comms,
+                                                optiga_util_read_entry_t * entries,
+                                                uint16_t count);
+
+/**
+ * @brief Enables the host side cache of an optiga comms instance.
+ *
+ * Caches the life cycle states LcsA and LcsG and the metadata of data objects read by #optiga_util_read_metadata.<br>
+ * Caches the data of the data objects configured in p_object_entries read by #optiga_util_read_data
+ * and #optiga_util_read_data_batch.<br>
+ *
+ *<b>API Details:</b>
+ * - Clears the provided cache and attaches it to the optiga comms instance.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - The cache is kept coherent with the writes of data and metadata done on the optiga comms instance using
+ *   #CmdLib_SetDataObject and #CmdLib_SetDataObjectStream, which includes #optiga_util_write_data and
+ *   #optiga_util_write_metadata, and with the keys stored by #CmdLib_GenerateKeyPair. The cached values of a data
+ *   object are dropped before it is written. The cache is invalidated by an open or a reset of OPTIGA.<br>
+ * - At the first read of a configured data object, the data object is read up to the size of its buffer.
+ *   If the change access condition of the data object is never, it remains cached over resets of OPTIGA.<br>
+ * - Changes made by other means, e.g. by a different host, require a call to #optiga_util_invalidate_cache.
+ *   Hence data objects changed by OPTIGA itself, e.g. the security event counter, must not be configured.
+ *   Likewise the metadata of such objects, e.g. the used size of a monotonic counter, and of objects changed by
+ *   other commands is only correct after an invalidation.<br>
+ * - The cache must remain valid until it is detached by calling this API with NULL.<br>
+ *
+ * \param[in,out]  p_comms          Pointer to the optiga comms instance
+ * \param[in,out]  p_cache          Pointer to the cache, NULL to disable the cache
+ *
+ * \retval  #OPTIGA_LIB_SUCCESS                                Successful invocation
+ * \retval  #OPTIGA_LIB_ERROR                                  Wrong input arguments provided
+ */
+optiga_lib_status_t optiga_util_enable_cache(optiga_comms_t * p_comms,
+                                             optiga_util_cache_t * p_cache);
+
+/**
+ * @brief Invalidates the host side cache of an optiga comms instance.
+ *
+ * The values are read again from OPTIGA at the next use. Statistics are kept.<br>
+ *
+ * \param[in,out]  p_comms          Pointer to the optiga comms instance
+ */
+void optiga_util_invalidate_cache(optiga_comms_t * p_comms);
+
+/**
+ * @brief Reads the data objects to prefetch into the host side cache.
+ *
+ * Reads all configured data objects with the prefetch flag set which are not yet cached.<br>
+ *
+ *<b>Notes:</b>
+ * - Called at the end of #optiga_util_open_application if prefetch_on_open is set in the cache.
+ *   Otherwise the application may call it from a low priority task after the open,
+ *   other users of the optiga comms instance wait until a data object is read.<br>
+ *
+ * \param[in,out]  p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
+ *
+ * \retval  #OPTIGA_LIB_SUCCESS                                All data objects to prefetch are cached
+ * \retval  #OPTIGA_LIB_ERROR                                  Cache not enabled or at least one data object failed
+ */
+optiga_lib_status_t optiga_util_prefetch_cache(optiga_comms_t * p_comms);
+
 /**
  * @brief Reads metadata of a data object from optiga.
  *
@@ -221,6 +525,7 @@ optiga_lib_status_t optiga_util_read_data(uint16_t optiga_oid,
  *
  *<b>API Details:</b>
  * - Invokes #optiga_cmd_get_data_object API, based on the input arguments to read the metadata from the data object.<br>
+ * - With #optiga_util_enable_cache, the life cycle states and the metadata are read from the cache if present.<br>
  *<br>
  *
  *<b>Notes:</b>
@@ -228,6 +533,7 @@ optiga_lib_status_t optiga_util_read_data(uint16_t optiga_oid,
  * - The metadata returned will be in TLV format.<br>
  * - The maximum value of the <b>*bytes_to_read</b> parameter is size of buffer <b>p_buffer</b>. In case the value is greater than buffer size, memory corruption can occur.<br>
  *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
  * \param[in]      optiga_oid      OID of data object
  *                                - It should be a valid data object, otherwise OPTIGA returns an error.<br>
  * \param[in,out]  buffer          Valid pointer to the buffer to which metadata is read
@@ -239,7 +545,8 @@ optiga_lib_status_t optiga_util_read_data(uint16_t optiga_oid,
  * \retval  #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE                 Same instance with ongoing request servicing used
  * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_util_read_metadata(uint16_t optiga_oid,
+optiga_lib_status_t optiga_util_read_metadata(optiga_comms_t * p_comms,
+                                              uint16_t optiga_oid,
                                               uint8_t * buffer,
                                               uint16_t * bytes_to_read);
 
@@ -258,11 +565,19 @@ optiga_lib_status_t optiga_util_read_metadata(uint16_t optiga_oid,
  *<b>Notes:</b>
  * - Error codes from lower layers will be returned as it is.<br>
  * - The maximum value of the <b>bytes_to_write parameter</b> is size of buffer <b>p_buffer</b>. In case the value is greater than buffer size, incorrect values can get written into the data object in OPTIGA.<br>
- * - In case the write_type provided is other than <b>erase and write(0x00)</b> or <b>write only(0x40)</b>, the function returns #OPTIGA_UTIL_ERROR.<br>
- *
+ * - In case the write_type provided is other than <b>erase and write(0x00)</b>, <b>write only(0x40)</b> or
+ *   <b>differential(0x01)</b>, the function returns #OPTIGA_UTIL_ERROR.<br>
+ * - A differential write has the effect of a write only. If the data object is configured in the cache enabled
+ *   using #optiga_util_enable_cache, the data to write is compared with the cached data and only the changed ranges
+ *   are written. Ranges separated by up to #OPTIGA_UTIL_WRITE_DIFF_MAX_GAP unchanged bytes are written by one
+ *   command, nothing is written if the data is unchanged. Without the data object in the cache, or if the cached data
+ *   does not cover the range, all the data is written as with a write only.<br>
+ *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
  * \param[in]      optiga_oid     OID of data object
  *                                - It should be a valid data object, otherwise OPTIGA returns an error.<br>
- * \param[in]      write_type     Type of the write operation. Can be OPTIGA_UTIL_ERASE_AND_WRITE or OPTIGA_UTIL_WRITE_ONLY
+ * \param[in]      write_type     Type of the write operation. Can be OPTIGA_UTIL_ERASE_AND_WRITE, OPTIGA_UTIL_WRITE_ONLY
+ *                                or OPTIGA_UTIL_WRITE_DIFFERENTIAL
  * \param[in]      offset         Offset from within data object
  *                                - It must be valid offset from within data object, otherwise OPTIGA returns an error.<br>
  * \param[in,out]  buffer         Valid pointer to the buffer with user data to write
@@ -274,12 +589,59 @@ optiga_lib_status_t optiga_util_read_metadata(uint16_t optiga_oid,
  * \retval  #OPTIGA_CMD_ERROR_MEMORY_INSUFFICIENT              Length of the buffer to copy the metadata is less than actual length of metadata
  * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid,
+optiga_lib_status_t optiga_util_write_data(optiga_comms_t * p_comms,
+                                           uint16_t optiga_oid,
 										   uint8_t write_type,
                                            uint16_t offset,
                                            uint8_t * buffer,
                                            uint16_t bytes_to_write);
 
+/**
+ * @brief Writes data read from a stream to optiga.
+ *
+ * Writes the data read chunk by chunk from the user provided stream into the specified data object.<br>
+ *
+ *<b>Pre Conditions:</b>
+ * - The application on OPTIGA must be opened using #optiga_util_open_application before using this API.<br>
+ *
+ *<b>API Details:</b>
+ * - Invokes #CmdLib_SetDataObjectStream to write the data to the data object.<br>
+ *<br>
+ *
+ *<b>Notes:</b>
+ * - Error codes from lower layers will be returned as it is.<br>
+ * - The buffer of the stream holds two chunks of up to (maximum communication buffer size - 8) bytes.
+ *   The next chunk is read while the current chunk is written, so the memory used does not depend on bytes_to_write.<br>
+ * - A buffer smaller than 2 * #CMD_LIB_STREAM_MIN_CHUNK bytes, and than 2 * bytes_to_write, is rejected with
+ *   #CMD_LIB_INSUFFICIENT_MEMORY.<br>
+ * - The callbacks are called with the instance acquired and must not use p_comms.<br>
+ * - For data from a file descriptor, the read callback can call read() until length bytes are read.
+ *   Data in memory, including an mmap'ed file, is written without copy using #optiga_util_write_data.<br>
+ * - In case the write_type provided is other than <b>erase and write(0x00)</b> or <b>write only(0x40)</b>,
+ *   the function returns #OPTIGA_UTIL_ERROR_INVALID_INPUT.<br>
+ *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
+ * \param[in]      optiga_oid     OID of data object
+ *                                - It should be a valid data object, otherwise OPTIGA returns an error.<br>
+ * \param[in]      write_type     Type of the write operation. Can be OPTIGA_UTIL_ERASE_AND_WRITE or OPTIGA_UTIL_WRITE_ONLY
+ * \param[in]      offset         Offset from within data object
+ *                                - It must be valid offset from within data object, otherwise OPTIGA returns an error.<br>
+ * \param[in]      p_stream       Valid pointer to the stream providing the data to write
+ * \param[in]      bytes_to_write Length of data to be written
+ *
+ * \retval  #OPTIGA_UTIL_SUCCESS                               Successful invocation of optiga cmd module
+ * \retval  #OPTIGA_UTIL_ERROR_INVALID_INPUT                   Wrong Input arguments provided
+ * \retval  #OPTIGA_LIB_ERROR                                  Invalid stream provided
+ * \retval  #CMD_LIB_ERROR                                     Read callback failed
+ * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
+ */
+optiga_lib_status_t optiga_util_write_data_stream(optiga_comms_t * p_comms,
+                                                  uint16_t optiga_oid,
+                                                  uint8_t write_type,
+                                                  uint16_t offset,
+                                                  const optiga_util_stream_t * p_stream,
+                                                  uint16_t bytes_to_write);
+
 /**
  * @brief Writes metadata for the user provided data object.
  *
@@ -298,6 +660,7 @@ optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid,
  *   In case the value is greater than buffer size, incorrect values can get written into the meta data of the data object in OPTIGA.<br>
  * - The metadata to be written must be in TLV format <br>
  *
+ * \param[in]      p_comms          Pointer to the optiga comms instance, opened using #optiga_util_open_application
  * \param[in]      optiga_oid     OID of data object
  *                                - It should be a valid data object, otherwise OPTIGA returns an error.<br>
  * \param[in,out]  buffer         Valid pointer to the buffer with metadata to write
@@ -308,7 +671,8 @@ optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid,
  * \retval  #OPTIGA_UTIL_ERROR_INSTANCE_IN_USE                 Same instance with ongoing request servicing used
  * \retval  #OPTIGA_DEVICE_ERROR                               Command execution failure in OPTIGA and the LSB indicates the error code.(Refer Solution Reference Manual)
  */
-optiga_lib_status_t optiga_util_write_metadata(uint16_t optiga_oid,
+optiga_lib_status_t optiga_util_write_metadata(optiga_comms_t * p_comms,
+                                               uint16_t optiga_oid,
                                                uint8_t * buffer,
                                                uint8_t bytes_to_write);
 #ifdef __cplusplus
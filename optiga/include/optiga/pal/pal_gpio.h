@@ -38,6 +38,7 @@
  *********************************************************************************************************************/
  
 #include "optiga/pal/pal.h"
+#include "optiga/pal/pal_os_event.h"
 
 /**********************************************************************************************************************
  * MACROS
@@ -81,6 +82,25 @@ void pal_gpio_set_high(const pal_gpio_t* p_gpio_context);
  */
 void pal_gpio_set_low(const pal_gpio_t* p_gpio_context);
 
+#ifdef PAL_GPIO_HAS_IRQ
+/**
+ * \brief Calls a handler on each rising edge of the gpio input pin.
+ *
+ * The handler runs in the context of the pal os event callbacks, as if registered using
+ * #pal_os_event_register_callback_oneshot with no delay. Edges occurring before it ran are reported once.
+ * Registering again replaces the handler.
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Edges are reported
+ * \retval  #PAL_STATUS_FAILURE  The pin can not report edges, the caller has to poll
+ */
+pal_status_t pal_gpio_register_irq(const pal_gpio_t* p_gpio_context, register_callback handler, void* p_handler_ctx);
+
+/**
+ * \brief Stops calling the handler registered using #pal_gpio_register_irq.
+ */
+void pal_gpio_unregister_irq(const pal_gpio_t* p_gpio_context);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -94,6 +94,16 @@ pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context, uint8_t* p_data , uint16_t
  */
 pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context, uint8_t* p_data , uint16_t length);
 
+#ifdef PAL_I2C_HAS_WRITE_READ
+/**
+ * @brief Writes to and then reads from I2C bus in one transaction, with a repeated start in between.
+ *
+ * Completion is reported to the upper layer handler like for #pal_i2c_read.
+ */
+pal_status_t pal_i2c_write_read(pal_i2c_t* p_i2c_context, uint8_t* p_tx_data, uint16_t tx_length,
+                                uint8_t* p_rx_data, uint16_t rx_length);
+#endif
+
 /**
  * @brief De-initializes the I2C master.
  */
@@ -0,0 +1,86 @@
+/**
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+*
+* \file
+*
+* \brief This file implements the prototype declarations of pal os datastore functionalities.
+*        Ports providing a datastore are built with PAL_OS_HAS_DATASTORE defined.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_OS_DATASTORE_H_
+#define _PAL_OS_DATASTORE_H_
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include "pal.h"
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+
+/// Datastore holding the parameters of OPTIGA instance 0 reused by a warm open. Further instances use the following ids
+#define PAL_OS_DATASTORE_ID_WARM_CACHE      (0x1000)
+
+/**********************************************************************************************************************
+ * ENUMS
+ *********************************************************************************************************************/
+
+
+/**********************************************************************************************************************
+ * DATA STRUCTURES
+ *********************************************************************************************************************/
+
+
+/**********************************************************************************************************************
+ * API Prototypes
+ *********************************************************************************************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Writes the data to the host side datastore, replacing its previous content.
+ */
+pal_status_t pal_os_datastore_write(uint16_t datastore_id, const uint8_t * p_buffer, uint16_t length);
+
+/**
+ * \brief Reads the data from the host side datastore. On input p_length holds the size of p_buffer,
+ *        on output the number of bytes read.
+ */
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, uint8_t * p_buffer, uint16_t * p_length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _PAL_OS_DATASTORE_H_ */
+
+/**
+* @}
+*/
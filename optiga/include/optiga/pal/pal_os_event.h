@@ -31,6 +31,11 @@
  * MACROS
  *********************************************************************************************************************/
 
+/*
+ * Ports implementing pal_os_event_wait and pal_os_event_notify (linux, libusb and sim) are built with
+ * PAL_OS_HAS_EVENT_WAIT defined, callers then sleep on the comms status instead of spinning.
+ */
+
 
 /**********************************************************************************************************************
  * ENUMS
@@ -57,6 +62,51 @@ pal_status_t pal_os_event_init(void);
  */
 void pal_os_event_register_callback_oneshot(register_callback callback, void* callback_args, uint32_t time_us);
 
+#ifdef PAL_OS_HAS_EVENT_WAIT
+/**
+ * @brief Blocks the caller until the value at p_status differs from busy_value.
+ *
+ * The platform puts the calling thread to sleep instead of spinning. Spurious wake ups are allowed,
+ * the value is re-checked before returning.
+ */
+void pal_os_event_wait(volatile uint32_t* p_status, uint32_t busy_value);
+
+/**
+ * @brief Stores new_value at p_status and wakes up every caller blocked in #pal_os_event_wait on it.
+ *
+ * Must be safe to call from the context in which the ifx i2c event handlers are invoked.
+ */
+void pal_os_event_notify(volatile uint32_t* p_status, uint32_t new_value);
+#endif
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+/// Returned by #pal_os_event_get_next_timeout_us if no callback is pending
+#define PAL_OS_EVENT_NO_TIMEOUT     (0xFFFFFFFFUL)
+
+/**
+ * @brief Hands the scheduling of the callbacks over to the caller and returns a pollable handle.
+ *
+ * Once the handle is taken the platform does not run the callbacks on its own anymore. The handle becomes
+ * readable when a callback is due, the caller then invokes #pal_os_event_process. Must be called before
+ * the first callback is registered.
+ *
+ * @retval  Handle (e.g. a file descriptor) to be watched for readability, -1 if not supported or too late
+ */
+int32_t pal_os_event_get_handle(void);
+
+/**
+ * @brief Time in microseconds until the earliest pending callback is due.
+ *
+ * @retval  0 if a callback is due, #PAL_OS_EVENT_NO_TIMEOUT if none is pending
+ */
+uint32_t pal_os_event_get_next_timeout_us(void);
+
+/**
+ * @brief Runs the callbacks which are due and returns without blocking.
+ */
+void pal_os_event_process(void);
+#endif
+
 
 
 #endif //_PAL_OS_EVENT_H_
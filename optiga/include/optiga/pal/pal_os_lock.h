@@ -39,6 +39,11 @@ extern "C" {
 
 #include "pal.h"
 
+/*
+ * Ports implementing pal_os_lock_acquire_flag and pal_os_lock_release_flag (linux, libusb and sim) are built with
+ * PAL_OS_HAS_LOCK_FLAG defined, the command library then waits for the OPTIGA in the queue of the platform.
+ */
+
 /**
  * @brief   Acquires a lock.
  *
@@ -47,6 +52,10 @@ extern "C" {
  *
  *<b>API Details:</b>
  * - Acquires the lock.<br>
+ * - Depending on the platform, blocks until the lock is released or fails if it is taken.
+ *   The caller repeats the call until #PAL_STATUS_SUCCESS is returned.<br>
+ * - A blocking port (e.g. linux) never fails, hence the lock must not be acquired where waiting for its
+ *   holder would deadlock, e.g. from a callback which the holder waits for.<br>
  *<br>
  *
  *
@@ -67,6 +76,39 @@ pal_status_t pal_os_lock_acquire(void);
  */
 void pal_os_lock_release(void);
 
+#ifdef PAL_OS_HAS_LOCK_FLAG
+/**
+ * @brief   Acquires an in use flag.
+ *
+ *<b>Pre-conditions:</b>
+ * None.<br>
+ *
+ *<b>API Details:</b>
+ * - Sets the flag if it is cleared, otherwise blocks until the flag is handed over by #pal_os_lock_release_flag.<br>
+ * - The waiters of a flag are served in the same order as the waiters of the lock.<br>
+ *<br>
+ *
+ * \param[in,out] p_flag   Flag, shared by all users of the guarded resource
+ *
+ */
+pal_status_t pal_os_lock_acquire_flag(volatile uint32_t * p_flag);
+
+/**
+ * @brief   Releases an in use flag.
+ *
+ *<b>Pre-conditions:</b>
+ * The flag is acquired by #pal_os_lock_acquire_flag.<br>
+ *
+ *<b>API Details:</b>
+ * - Hands the flag over to the next waiter, or clears it if there is none.<br>
+ *<br>
+ *
+ * \param[in,out] p_flag   Flag, shared by all users of the guarded resource
+ *
+ */
+void pal_os_lock_release_flag(volatile uint32_t * p_flag);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -72,6 +72,14 @@ extern "C" {
  */
 uint32_t pal_os_timer_get_time_in_milliseconds(void);
 
+/**
+ * @brief Gets the time of a monotonic clock in microseconds
+ *
+ * The clock is not affected by changes of the wall clock time and does not wrap during the lifetime of the
+ * device. The protocol timeouts are measured with this clock.
+ */
+uint64_t pal_os_timer_get_time_in_microseconds(void);
+
 /**
  * @brief Waits or delay until the supplied milliseconds
  */
@@ -38,7 +38,16 @@
  *********************************************************************************************************************/
 #ifdef MODULE_ENABLE_DTLS_MUTUAL_AUTH
 
-#ifndef WIN32
+/// Linux uses the BSD socket API, unless the lwIP unix port is selected explicitly
+#if defined(__linux__) && !defined(PAL_SOCKET_LWIP)
+    #define PAL_SOCKET_POSIX
+#endif
+
+#if defined(PAL_SOCKET_POSIX)
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include "optiga/common/Datatypes.h"
+#elif !defined(WIN32)
     #include "optiga/common/Datatypes.h"
 	#include "udp.h"
     #include "inet.h"
@@ -54,7 +63,9 @@
 /**********************************************************************************************************************
  * MACROS
  *********************************************************************************************************************/
-#ifndef WIN32 
+#if defined(PAL_SOCKET_POSIX)
+    #define IPAddressParse(pzIpAddress, psIPAddress)      (E_COMMS_SUCCESS == pal_socket_assign_ip_address(pzIpAddress, psIPAddress))
+#elif !defined(WIN32)
     #define IPAddressParse(pzIpAddress, psIPAddress)      (inet_aton(pzIpAddress, psIPAddress))
 #else
     #define IPAddressParse(pzIpAddress, psIPAddress)      (1)
@@ -69,7 +80,7 @@
  * DATA STRUCTURES
  *********************************************************************************************************************/
 
-#ifndef WIN32  
+#if !defined(WIN32) && !defined(PAL_SOCKET_POSIX)
 /**
  * \brief Pointer type definition of pal socket receive event callback
  */
@@ -92,7 +103,34 @@ typedef enum eRecvMode_d
 /**
  * \brief This structure contains socket communication data
  */
-#ifndef WIN32
+#if defined(PAL_SOCKET_POSIX)
+
+/// Datagrams received ahead and sends held back by the POSIX socket layer, private to pal_socket.c
+struct pal_socket_batch;
+
+typedef struct pal_socket 
+{
+    ///IPv4 or IPv6 address of the peer, the port is taken from wPort
+    struct sockaddr_storage sIPAddress;
+
+    ///Non-blocking UDP socket, -1 when not created
+    int32_t iSocketHdl;
+
+    ///Receive ring and send queue, allocated by pal_socket_init
+    struct pal_socket_batch* psBatch;
+
+    ///Port for UDP communication
+    uint16_t wPort;
+
+    ///Transport Layer Timeout
+    uint16_t wTimeout;
+
+    ///Enumeration to indicate Blocking or Non blocking
+    uint8_t bMode;
+
+} pal_socket_t;
+
+#elif !defined(WIN32)
 
 typedef struct pal_socket 
 {
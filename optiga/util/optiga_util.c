@@ -29,10 +29,15 @@
 * @{
 */
 
+#include <string.h>
 #include "optiga/optiga_util.h"
 #include "optiga/comms/optiga_comms.h"
 #include "optiga/cmd/CommandLib.h"
 #include "optiga/pal/pal_os_timer.h"
+#include "optiga/pal/pal_os_event.h"
+#ifdef PAL_OS_HAS_DATASTORE
+#include "optiga/pal/pal_os_datastore.h"
+#endif
 
 ///Length of metadata
 #define LENGTH_METADATA             0x1C
@@ -73,12 +78,6 @@
 ///TLV position for Value
 #define POS_VAL                     0x02
 
-///Already Found
-#define VALUE_TAG_FOUND             0x9B
-
-///Length of R and S vector
-#define VALUE_TAG_NOTFOUND          0x31
-
 ///ASN Tag for sequence
 #define ASN_TAG_SEQUENCE          	0x30
 
@@ -102,22 +101,6 @@ typedef enum eObjectId_d
     eLCSA = 0xF1C0
 }eObjectId_d;
 
-/**
- * \brief Structure to specify general purpose data object parameters for read
- */
-typedef struct sACVector_d
-{
-    ///OID of data object
-    uint8_t bLcsA;
-
-    uint8_t bLcsG;
-
-    uint8_t bLcsO;
-
-    sbBlob_d *psMetaData;
-
-}sACVector_d;
-
 /**
  * \brief Operators available in simple and complex Access Conditions
  */
@@ -142,6 +125,8 @@ typedef enum eMetaDataTag_d
 {
 	/// Object Life Cycle
     eLCSO =     0xC0,
+	/// Used size of the data object
+    eUSED_SIZE = 0xC5,
 	/// Change AC
     eCHANGE_AC = 0xD0,
 	/// Read AC
@@ -165,329 +150,274 @@ typedef enum eAccessConditionID_d
     eACID_NEV = 0xFF
 } eAccessConditionID_d;
 
-volatile static host_lib_status_t optiga_comms_status;
-
 #ifdef MODULE_ENABLE_READ_WRITE
 /**
  *
- * Implementation to get the metadata tag position.<br>
- * Returns error if metadata is not correct<br>
- * (if duplication of tag, metadata length / Tag length more than max length of metadata).<br> <br>
+ * Adds an alternative to the compiled read access condition, unless it can never be satisfied.<br>
+ * An alternative beyond #OPTIGA_UTIL_AC_MAX_TERMS is not dropped silently, which would deny reads permitted by
+ * OPTIGA, but marks the access condition to be checked by OPTIGA only.<br>
  *
- * PpbPos contains the actual position of the tag if found.<br>
- * PpbPos contains 0xFF if tag not found.This is considering that metatdata length is 28 bytes.
- * The return value in this case is #INT_LIB_OK.<br>
+ * \param[in,out]  PpsCompiled     Pointer to the compiled metadata
+ * \param[in]      PpsTerm         Pointer to the alternative
+ * \param[in]      PbSatisfiable   FALSE if a condition of the alternative can never be satisfied
+ *
+ */
+static void __optiga_util_add_ac_term(optiga_util_compiled_metadata_t* PpsCompiled,
+                                      const optiga_util_ac_term_t* PpsTerm, uint8_t PbSatisfiable)
+{
+    if((TRUE != PbSatisfiable) || (PpsTerm->lcsa_min > PpsTerm->lcsa_max) || (PpsTerm->lcsg_min > PpsTerm->lcsg_max))
+    {
+        return;
+    }
+    if(OPTIGA_UTIL_AC_MAX_TERMS <= PpsCompiled->read_ac_count)
+    {
+        PpsCompiled->read_ac_overflow = TRUE;
+        return;
+    }
+    PpsCompiled->read_ac[PpsCompiled->read_ac_count] = *PpsTerm;
+    PpsCompiled->read_ac_count++;
+}
+
+/**
  *
- * \param[in]  Pprgbmetadata   Pointer to the buffer that contains metadata
- * \param[in]  PbTag           Tag type.
- * \param[in]  PpbPos          Pointer to tag position in metadata
+ * Compiles an access condition into alternatives, each a range of LcsA and LcsG.<br>
+ * The conditions are ANDed within an alternative, the alternatives are separated by OR.<br>
+ * Conditions on LcsO are resolved with the life cycle state of the data object.<br>
+ * An invalid coding ends the access condition and drops the alternative it is part of,
+ * as do bytes beyond the length of the metadata.<br>
+ * ALW and NEV are only valid as the whole access condition.<br>
  *
- * \retval    #INT_LIB_OK      Successful execution
- * \retval    #INT_LIB_ERROR   Failure in execution
+ * \param[in]      PprgbAC       Pointer to the access condition
+ * \param[in]      PwLen         Length of the access condition
+ * \param[in]      PwAvailable   Number of bytes of the access condition within the metadata
+ * \param[in]      PbLcsO        Life cycle state of the data object
+ * \param[in,out]  PpsCompiled   Pointer to the compiled metadata, to which the alternatives are added
  *
  */
-static int32_t __optiga_util_get_tag_position (const uint8_t* Pprgbmetadata, uint8_t PbTag, puint8_t PpbPos)
+static void __optiga_util_compile_ac(const uint8_t* PprgbAC, uint16_t PwLen, uint16_t PwAvailable,
+                                     uint8_t PbLcsO, optiga_util_compiled_metadata_t* PpsCompiled)
 {
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    uint8_t bMetadataSize, bAcLen;
-    uint8_t bTempPos, bAlreadyFound=VALUE_TAG_NOTFOUND;
+    optiga_util_ac_term_t sTerm = {0x00, 0xFF, 0x00, 0xFF};
+    uint8_t bSatisfiable = TRUE;
+    uint16_t wIndex = 0;
+    uint8_t bId, bVal, bMin, bMax;
+
+	// Remaining bytes of the access condition
+    #define REMAINING_BYTES (PwLen - wIndex)
 
     do
     {
-        if (NULL == Pprgbmetadata || NULL == PpbPos)
+        if((1 == PwLen) && (1 <= PwAvailable) && ((uint8_t)eACID_ALW == PprgbAC[0]))
         {
+            __optiga_util_add_ac_term(PpsCompiled, &sTerm, TRUE);
             break;
         }
 
-        bMetadataSize = Pprgbmetadata[OFFSET_TLV_LENGTH];
-
-        *PpbPos = 0xFF;
-
-        if (METADATA_MAX_LEN < (bMetadataSize + METADATA_HEADER_SIZE))
-        {
-            //Metadata Corrupted [Length field in Metadata is more than METADATA_MAX_SIZE]
-            break;
-        }
-
-        bTempPos = METADATA_HEADER_SIZE;
-
-        for(;;)
+        while((REMAINING_BYTES >= 3) && (PwAvailable >= (wIndex + 3)))
         {
-            if (Pprgbmetadata[bTempPos] == PbTag)
+            bId = PprgbAC[wIndex];
+            bVal = PprgbAC[wIndex + 2];
+            if(((uint8_t)eACID_LCSA != bId) && ((uint8_t)eACID_LCSG != bId) && ((uint8_t)eACID_LCSO != bId))
             {
-                if (VALUE_TAG_FOUND == bAlreadyFound)
-                {
-                    i4Status = (int32_t)INT_LIB_ERROR;
-                    break;
-                }
-                i4Status = INT_LIB_OK;
-                *PpbPos = bTempPos;
-                bAlreadyFound = VALUE_TAG_FOUND;
+                break;
             }
 
-            if(0xFF == Pprgbmetadata[bTempPos])
+            if((uint8_t)eOP_EQUAL == PprgbAC[wIndex + 1])
             {
-                //Length field in Metadata is not correct
-                break;
+                bMin = bVal;
+                bMax = bVal;
             }
-            bAcLen = Pprgbmetadata[bTempPos+1];
-
-            //Is metadata Corrupted?
-            if (METADATA_MAX_LEN <= (bAcLen+bTempPos+1))
+            else if((uint8_t)eOP_GREATER_THAN == PprgbAC[wIndex + 1])
+            {
+                bSatisfiable &= (0xFF != bVal) ? TRUE : FALSE;
+                bMin = bVal + 1;
+                bMax = 0xFF;
+            }
+            else if((uint8_t)eOP_LESS_THAN == PprgbAC[wIndex + 1])
+            {
+                bSatisfiable &= (0x00 != bVal) ? TRUE : FALSE;
+                bMin = 0x00;
+                bMax = bVal - 1;
+            }
+            else
             {
-                //Metadata Corrupted
                 break;
             }
 
-            bTempPos += (bAcLen+2);
+            if((uint8_t)eACID_LCSO == bId)
+            {
+                bSatisfiable &= ((PbLcsO >= bMin) && (PbLcsO <= bMax)) ? TRUE : FALSE;
+            }
+            else if((uint8_t)eACID_LCSG == bId)
+            {
+                sTerm.lcsg_min = (bMin > sTerm.lcsg_min) ? bMin : sTerm.lcsg_min;
+                sTerm.lcsg_max = (bMax < sTerm.lcsg_max) ? bMax : sTerm.lcsg_max;
+            }
+            else
+            {
+                sTerm.lcsa_min = (bMin > sTerm.lcsa_min) ? bMin : sTerm.lcsa_min;
+                sTerm.lcsa_max = (bMax < sTerm.lcsa_max) ? bMax : sTerm.lcsa_max;
+            }
+            wIndex += 3;
 
-            if(bMetadataSize <= (bTempPos-METADATA_HEADER_SIZE))
+            if(wIndex == PwLen)
+            {
+                __optiga_util_add_ac_term(PpsCompiled, &sTerm, bSatisfiable);
+                break;
+            }
+            // for operator
+            if((REMAINING_BYTES < 3) || (PwAvailable <= wIndex) ||
+               (((uint8_t)eOP_AND != PprgbAC[wIndex]) && ((uint8_t)eOP_OR != PprgbAC[wIndex])))
             {
-                i4Status = INT_LIB_OK;
                 break;
             }
+            if((uint8_t)eOP_OR == PprgbAC[wIndex])
+            {
+                __optiga_util_add_ac_term(PpsCompiled, &sTerm, bSatisfiable);
+                sTerm.lcsa_min = 0x00;
+                sTerm.lcsa_max = 0xFF;
+                sTerm.lcsg_min = 0x00;
+                sTerm.lcsg_max = 0xFF;
+                bSatisfiable = TRUE;
+            }
+            wIndex++;
         }
-    } while(0);
+    }while(FALSE);
 
-    return i4Status;
+#undef REMAINING_BYTES
 }
 
 /**
  *
- * Implementation to verify expressions related to LCSA, LCSG, LCSO.<br>
- *
- * \param[in]     PpsACVal             Pointer to the access condition vector
- * \param[in]     PprgbAC              Pointer to the AC expression
- * \param[in,out] PpwVerifyOver        Pointer to verification status
+ * Compiles the metadata of a data object, parsing it once for all the later checks.<br>
+ * Tags found more than once and values beyond the length of the metadata are ignored.<br>
+ * Without a valid read access condition, it is never satisfied. Without LcsO, LcsO is 0.<br>
  *
- * \retval    #INT_LIB_OK       Successful execution
- * \retval    #INT_LIB_ERROR    Failure in execution
+ * \param[in]   PprgbMetadata   Pointer to the metadata in TLV format
+ * \param[out]  PpsCompiled     Pointer to the compiled metadata
  *
  */
-static int32_t __optiga_util_verify_lcsa_lcsg_lcso(const sACVector_d* PpsACVal, const uint8_t* PprgbAC,puint16_t PpwVerifyOver)
+static void __optiga_util_compile_metadata(const uint8_t* PprgbMetadata, optiga_util_compiled_metadata_t* PpsCompiled)
 {
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    uint8_t bVal, bLcs = 0x00;
-    eOperator_d eOp ;
-
-	// Life cycle state of object
-    #define LCS_O_VAL			(PpsACVal->bLcsO)
-	// Life cycle state of application
-    #define LCS_A_VAL			(PpsACVal->bLcsA)
-	// Life cycle state of Global
-    #define LCS_G_VAL			(PpsACVal->bLcsG)
+    static const uint8_t rgbTags[] = {(uint8_t)eLCSO, (uint8_t)eUSED_SIZE, (uint8_t)eCHANGE_AC, (uint8_t)eREAD_AC};
+    uint8_t rgbPos[sizeof(rgbTags)];
+    uint8_t rgbCount[sizeof(rgbTags)];
+    uint8_t bIndex;
+    uint8_t bLcsO = 0x00;
+    uint8_t bAcLen;
+    uint8_t bPos;
+    uint16_t wPos = METADATA_HEADER_SIZE;
+    uint16_t wEnd = PprgbMetadata[OFFSET_TLV_LENGTH] + METADATA_HEADER_SIZE;
+
+    // Position of the tag if found exactly once
+    #define TAG_POS(bTag)  ((1 == rgbCount[bTag]) ? rgbPos[bTag] : PARSE_FAILURE)
+    // Index of the tags in rgbTags
+    #define INDEX_LCSO      0
+    #define INDEX_USED_SIZE 1
+    #define INDEX_CHANGE_AC 2
+    #define INDEX_READ_AC   3
+
+    memset(PpsCompiled, 0x00, sizeof(*PpsCompiled));
+    memset(rgbPos, PARSE_FAILURE, sizeof(rgbPos));
+    memset(rgbCount, 0x00, sizeof(rgbCount));
 
     do
     {
-        if((NULL == PpwVerifyOver)
-            || (NULL == PpsACVal) || (NULL == PprgbAC))
+        if (METADATA_MAX_LEN < wEnd)
         {
+            //Metadata Corrupted [Length field in Metadata is more than METADATA_MAX_SIZE]
             break;
         }
 
-        bLcs = LCS_A_VAL;
-        if ((uint8_t)eACID_LCSG == *PprgbAC)
+        while(wPos < wEnd)
         {
-            bLcs = LCS_G_VAL;
-        }
-        else if((uint8_t)eACID_LCSO == *PprgbAC)
-        {
-            bLcs = LCS_O_VAL;
+            for(bIndex = 0; bIndex < sizeof(rgbTags); bIndex++)
+            {
+                if(rgbTags[bIndex] == PprgbMetadata[wPos])
+                {
+                    rgbPos[bIndex] = (uint8_t)wPos;
+                    rgbCount[bIndex]++;
+                }
+            }
+            if((0xFF == PprgbMetadata[wPos]) || (wEnd <= (wPos + 1)))
+            {
+                //Length field in Metadata is not correct
+                break;
+            }
+            bAcLen = PprgbMetadata[wPos + 1];
+            //Is metadata Corrupted?
+            if (METADATA_MAX_LEN <= (bAcLen + wPos + 1))
+            {
+                break;
+            }
+            wPos += (bAcLen + 2);
         }
 
-        eOp = (eOperator_d)(*(PprgbAC+1));
-        bVal = *(PprgbAC+2);
-
-        if(eOp == eOP_GREATER_THAN)
+        bPos = TAG_POS(INDEX_LCSO);
+        if((PARSE_FAILURE != bPos) && (wEnd > (bPos + POS_VAL)))
         {
-            if(bLcs > bVal)
-            {
-                i4Status = INT_LIB_OK;
-            }
+            bLcsO = PprgbMetadata[bPos + POS_VAL];
         }
-        else if(eOp == eOP_LESS_THAN)
+        bPos = TAG_POS(INDEX_USED_SIZE);
+        if((PARSE_FAILURE != bPos) && (wEnd >= (bPos + POS_VAL + 2)) && (0x02 == PprgbMetadata[bPos + POS_LEN]))
         {
-            if(bLcs < bVal)
-            {
-                i4Status = INT_LIB_OK;
-            }
+            PpsCompiled->used_size_present = TRUE;
+            PpsCompiled->used_size = (uint16_t)((PprgbMetadata[bPos + POS_VAL] << BITS_PER_BYTE) |
+                                                PprgbMetadata[bPos + POS_VAL + 1]);
         }
-        else if(eOp == eOP_EQUAL)
+        bPos = TAG_POS(INDEX_CHANGE_AC);
+        if((PARSE_FAILURE != bPos) && (wEnd > (bPos + POS_VAL)) && (0x01 == PprgbMetadata[bPos + POS_LEN]) &&
+           ((uint8_t)eACID_NEV == PprgbMetadata[bPos + POS_VAL]))
         {
-            if(bLcs == bVal)
-            {
-                i4Status = INT_LIB_OK;
-            }
+            PpsCompiled->change_never = TRUE;
         }
-        else
+        bPos = TAG_POS(INDEX_READ_AC);
+        if((PARSE_FAILURE != bPos) && (wEnd >= (bPos + POS_VAL)))
         {
-            i4Status = (int32_t)INT_LIB_ERROR;
-            *PpwVerifyOver = TRUE;
-            break;
+            __optiga_util_compile_ac(PprgbMetadata + bPos + POS_VAL, PprgbMetadata[bPos + POS_LEN],
+                                     wEnd - (bPos + POS_VAL), bLcsO, PpsCompiled);
         }
-    } while(0);
-    return i4Status;
-#undef LCS_O_VAL
-#undef LCS_A_VAL
-#undef LCS_G_VAL
+    }while(FALSE);
+
+#undef TAG_POS
+#undef INDEX_LCSO
+#undef INDEX_USED_SIZE
+#undef INDEX_CHANGE_AC
+#undef INDEX_READ_AC
 }
 
 /**
  *
- * Implementation to validate the access conditions.<br>
+ * Checks the compiled read access condition of a data object.<br>
+ * An access condition with more alternatives than compiled is satisfied here, the read is then checked by OPTIGA.<br>
  *
- * \param[in]  PpsACVal   Pointer to the buffer that contains metadata
+ * \param[in]  PpsCompiled   Pointer to the compiled metadata
+ * \param[in]  PbLcsA        Life cycle state of the application
+ * \param[in]  PbLcsG        Global life cycle state
  *
- * \retval    #INT_LIB_OK       Successful execution
- * \retval    #INT_LIB_ERROR    Failure in execution
+ * \retval    #INT_LIB_OK       Read access condition satisfied
+ * \retval    #INT_LIB_ERROR    Read access condition not satisfied
  *
  */
-static int32_t __optiga_util_check_ac(const sACVector_d *PpsACVal)
+static int32_t __optiga_util_check_ac(const optiga_util_compiled_metadata_t* PpsCompiled, uint8_t PbLcsA, uint8_t PbLcsG)
 {
-    int32_t i4Status = (int32_t)INT_LIB_ERROR;
-    int32_t i4StatusCurr = (int32_t)INT_LIB_ERROR;
-    int32_t i4StatusPrev = (int32_t)INT_LIB_OK;
-    uint16_t wIndex = 0, wLen, wIDCount = 0;
-    uint16_t wVerificationOver = 0;
-    uint8_t bComplexAcOP = 0x00;
-    puint8_t prgbAccessCode;
+    uint8_t bIndex;
+    const optiga_util_ac_term_t* psTerm;
 
-	// Remaining bytes of the access condition
-    #define REMAINING_BYTES (wLen - wIndex)
-
-    do
+    if(TRUE == PpsCompiled->read_ac_overflow)
     {
-        if((NULL == PpsACVal) || (NULL == PpsACVal->psMetaData)
-                    || (NULL == PpsACVal->psMetaData->prgbStream))
-        {
-            break;
-        }
-
-        wLen = PpsACVal->psMetaData->wLen;
-        prgbAccessCode = PpsACVal->psMetaData->prgbStream;
-
-        while(wIndex < wLen)
-        {
-            switch((eAccessConditionID_d)*(prgbAccessCode+wIndex))
-            {
-                case  eACID_ALW:
-                case  eACID_NEV:
-                    if((REMAINING_BYTES > 1) || (wIDCount > 0))
-                    {
-                        wVerificationOver = TRUE;
-                        break;
-                    }
-                    i4StatusCurr = INT_LIB_OK;
-                    if((uint8_t)eACID_NEV == *(prgbAccessCode+wIndex))
-                    {
-                        i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    }
-                    wIndex++;
-                    wIDCount++;
-                    break;
-
-                case  eACID_LCSO:
-                case  eACID_LCSA:
-                case  eACID_LCSG:
-                    //including access id
-                    if(REMAINING_BYTES < 3)
-                    {
-                        //because of invalid access coding
-                        wVerificationOver = TRUE;
-                        break;
-                    }
-
-                    i4StatusCurr = __optiga_util_verify_lcsa_lcsg_lcso(PpsACVal, prgbAccessCode+wIndex, &wVerificationOver);
-                    if(TRUE == wVerificationOver)
-                    {
-                        //because of invalid access coding
-                        break;
-                    }
-
-                    wIndex+=3;
-                    wIDCount++;
-                    break;
-
-                default:
-                    //because of invalid access coding
-                    i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    wVerificationOver = TRUE;
-                    break;
-            }//switch
-
-            if(wVerificationOver)
-            {
-                break;
-            }
-
-            if(bComplexAcOP == (uint8_t)eOP_AND)
-            {
-                if(i4StatusCurr != i4StatusPrev)
-                {
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                }
-            }
-
-            if(wIndex == wLen)
-            {
-                break;
-            }
-
-            // for operator
-            if(REMAINING_BYTES < 3)
-            {
-                i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                //wVerificationOver = TRUE;
-                break;
-            }
-
-            bComplexAcOP = *(prgbAccessCode+wIndex);
-            switch(bComplexAcOP)
-            {
-                case  eOP_AND:
-                    i4StatusPrev = i4StatusCurr;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    break;
-
-                case  eOP_OR:
-                    i4StatusPrev = INT_LIB_OK;
-                    if(i4StatusCurr == INT_LIB_OK)
-                    {
-                        //Note: further validation not required
-                        //because the metadata itself is protected by checksum
-                        wVerificationOver = TRUE;
-                    }
-                    break;
-
-                default:
-                    //because of invalid access coding
-					i4StatusPrev = (int32_t)INT_LIB_ERROR;
-                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
-                    wVerificationOver = TRUE;
-                    break;
-            }//switch
-
-            if(wVerificationOver)
-            {
-                break;
-            }
-
-            wIndex++;
-            wIDCount++; //indication of complex AC
-        }//while
-
-        if((i4StatusPrev == INT_LIB_OK) &&
-        (i4StatusCurr == INT_LIB_OK))
+        return INT_LIB_OK;
+    }
+    for(bIndex = 0; bIndex < PpsCompiled->read_ac_count; bIndex++)
+    {
+        psTerm = &PpsCompiled->read_ac[bIndex];
+        if((PbLcsA >= psTerm->lcsa_min) && (PbLcsA <= psTerm->lcsa_max) &&
+           (PbLcsG >= psTerm->lcsg_min) && (PbLcsG <= psTerm->lcsg_max))
         {
-            i4Status = INT_LIB_OK;
+            return INT_LIB_OK;
         }
-
-    }while(0);
-
-    return i4Status;
-#undef REMAINING_BYTES
+    }
+    return (int32_t)INT_LIB_ERROR;
 }
 
 
@@ -495,7 +425,9 @@ static int32_t __optiga_util_check_ac(const sACVector_d *PpsACVal)
 /**
  *
  * Reads either LcsA or LcsG based on request.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
  *
+ * \param[in]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
  * \param[in]  PeLcsType   ObjectId of LcsA or LcsG
  * \param[in,out]  PpbValue    Pointer for returning life cycle state.
  *
@@ -503,7 +435,7 @@ static int32_t __optiga_util_check_ac(const sACVector_d *PpsACVal)
  * \retval    #INT_LIB_ERROR    Failure in execution
  *
  */
-static int32_t __optiga_util_read_lcsa_lcsg(eObjectId_d PeLcsType,uint8_t *PpbValue)
+static int32_t __optiga_util_read_lcsa_lcsg(optiga_comms_t* PpsOptigaComms,eObjectId_d PeLcsType,uint8_t *PpbValue)
 {
     int32_t i4Status  = (int32_t)INT_LIB_ERROR;
     sGetData_d sGDVector;
@@ -524,7 +456,7 @@ static int32_t __optiga_util_read_lcsa_lcsg(eObjectId_d PeLcsType,uint8_t *PpbVa
         sResponse.wBufferLength = 1;
         sResponse.wRespLength = 0;
 
-        i4Status = CmdLib_GetDataObject(&sGDVector,&sResponse);
+        i4Status = CmdLib_GetDataObjectInBatch(PpsOptigaComms,&sGDVector,&sResponse);
         if(CMD_LIB_OK != i4Status)
         {
             break;
@@ -543,241 +475,975 @@ static int32_t __optiga_util_read_lcsa_lcsg(eObjectId_d PeLcsType,uint8_t *PpbVa
 
 /**
  *
- * Verifies the requested access condition in the metadata.<br>
+ * Marks all the entries of the cache as unused.<br>
  *
- * \param[in]  PeMetaDataTag     Type of access condition
- * \param[in]  PpsACVal         Pointer to metadata.
- *
- * \retval    #INT_LIB_OK       Successful execution
- * \retval    #INT_LIB_ERROR    Failure in execution
+ * \param[in,out]  PpsCache          Pointer to the cache
+ * \param[in]      PbKeepImmutable   TRUE to keep the data objects which can never be changed
  *
  */
-static int32_t __optiga_util_verify_ac(eMetaDataTag_d PeMetaDataTag, sACVector_d *PpsACVal)
+static void __optiga_util_clear_cache(optiga_util_cache_t* PpsCache, uint8_t PbKeepImmutable)
 {
-    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
-    uint8_t bTagLocation = 0;
-    do
-    {
-        if((NULL == PpsACVal)||(NULL == PpsACVal->psMetaData)||
-            (NULL == PpsACVal->psMetaData->prgbStream))
-        {
-            i4Status = (int32_t)INT_LIB_NULL_PARAM;
-            break;
-        }
+    uint16_t wIndex;
 
-        //get tag position of lcsO and read lcsO.
-        //LCO may not be found for all object.It is not an error
-        i4Status = __optiga_util_get_tag_position(PpsACVal->psMetaData->prgbStream,(uint8_t)eLCSO,&bTagLocation);
-        if(INT_LIB_OK == i4Status && bTagLocation != PARSE_FAILURE)
-        {
-            //get the LcsO value from TLV
-            PpsACVal->bLcsO = (PpsACVal->psMetaData->prgbStream)[bTagLocation+2];
-        }
-        else
-        {
-            //LcsO not present
-            PpsACVal->bLcsO = 0x00;
-        }
-        //reset tag location
-        bTagLocation = 0;
-        //get tag position
-        i4Status = __optiga_util_get_tag_position(PpsACVal->psMetaData->prgbStream,(uint8_t)PeMetaDataTag,&bTagLocation);
-        if((INT_LIB_OK != i4Status) || (PARSE_FAILURE == bTagLocation))
+    for(wIndex = 0; wIndex < PpsCache->metadata_entry_count; wIndex++)
+    {
+        PpsCache->p_metadata_entries[wIndex].optiga_oid = 0;
+    }
+    for(wIndex = 0; wIndex < PpsCache->object_entry_count; wIndex++)
+    {
+        if((FALSE == PbKeepImmutable) ||
+           (OPTIGA_UTIL_OBJECT_CACHED_FOREVER != PpsCache->p_object_entries[wIndex].state))
         {
-			i4Status = (int32_t)INT_LIB_ERROR;
-            break;
+            PpsCache->p_object_entries[wIndex].state = OPTIGA_UTIL_OBJECT_EMPTY;
         }
-        //check access condition
-        PpsACVal->psMetaData->wLen = *(PpsACVal->psMetaData->prgbStream + (bTagLocation+POS_LEN));
-        PpsACVal->psMetaData->prgbStream += (bTagLocation+POS_VAL);
-
-        i4Status = __optiga_util_check_ac(PpsACVal);
-    }while(FALSE);
-
-    return i4Status;
-}
-
-static void __optiga_util_comms_event_handler(void* upper_layer_ctx, host_lib_status_t event)
-{
-	optiga_comms_status = event;
+    }
+    PpsCache->metadata_next_entry = 0;
+    PpsCache->lcs_valid = FALSE;
 }
 
-optiga_lib_status_t optiga_util_open_application(optiga_comms_t* p_comms)
+/**
+ *
+ * Gets the cache of the optiga comms instance, cleared if OPTIGA was opened or reset since it was filled.<br>
+ * Data objects which can never be changed are kept.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
+ *
+ * \retval    Pointer to the cache, NULL if the cache is not enabled
+ *
+ */
+static optiga_util_cache_t* __optiga_util_get_cache(const optiga_comms_t* PpsOptigaComms)
 {
-	optiga_lib_status_t status = OPTIGA_LIB_ERROR;
-	sOpenApp_d sOpenApp;
-
-	do {
-		// OPTIGA Initialisation phase
-		//Invoke optiga_comms_open to initialize the IFX I2C Protocol and security chip
-		optiga_comms_status = OPTIGA_COMMS_BUSY;
-		p_comms->upper_layer_handler = __optiga_util_comms_event_handler;
-		status = optiga_comms_open(p_comms);
-		if(E_COMMS_SUCCESS != status)
-		{
-			status = OPTIGA_LIB_ERROR;
-			break;
-		}
-
-		//Wait until IFX I2C initialization is complete
-		while(optiga_comms_status == OPTIGA_COMMS_BUSY)
-		{
-			pal_os_timer_delay_in_milliseconds(1);
-		}
-
-		if((OPTIGA_COMMS_SUCCESS != status) || (optiga_comms_status == OPTIGA_COMMS_ERROR))
-		{
-			status = OPTIGA_LIB_ERROR;
-			break;
-		}
-		
-		//Set OPTIGA comms context in Command library before invoking the use case APIs or command library APIs
-		//This context will be used by command libary to communicate with OPTIGA using IFX I2C Protocol.
-		CmdLib_SetOptigaCommsContext(p_comms);
+    optiga_util_cache_t* psCache = (optiga_util_cache_t*)PpsOptigaComms->p_util_cache;
 
-		//Open the application in Security Chip
-		sOpenApp.eOpenType = eInit;
-		status = CmdLib_OpenApplication(&sOpenApp);
-		if(CMD_LIB_OK == status)
-		{
-			status = OPTIGA_LIB_SUCCESS;
-		}
-	} while(FALSE);
-
-	return status;
+    if((NULL != psCache) && (psCache->reset_count != PpsOptigaComms->reset_count))
+    {
+        __optiga_util_clear_cache(psCache, TRUE);
+        psCache->reset_count = PpsOptigaComms->reset_count;
+        psCache->invalidations++;
+    }
+    return psCache;
 }
 
-optiga_lib_status_t optiga_util_read_data(uint16_t optiga_oid, uint16_t offset,
-                                          uint8_t * p_buffer, uint16_t* buffer_size)
+/**
+ *
+ * Finds the cached metadata of a data object.<br>
+ *
+ * \param[in]  PpsCache    Pointer to the cache
+ * \param[in]  PwOid       OID of data object
+ *
+ * \retval    Pointer to the entry, NULL if the metadata is not cached
+ *
+ */
+static optiga_util_metadata_entry_t* __optiga_util_find_metadata(const optiga_util_cache_t* PpsCache, uint16_t PwOid)
 {
-    //lint --e{818} suppress "PpsGPData is out parameter"
-    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
-    sGetData_d cmd_params;
-    sCmdResponse_d cmd_resp;
+    uint16_t wIndex;
 
-    do
+    for(wIndex = 0; wIndex < PpsCache->metadata_entry_count; wIndex++)
     {
-        if((NULL == p_buffer) || (NULL == buffer_size) || (0 == *buffer_size))
+        if(PwOid == PpsCache->p_metadata_entries[wIndex].optiga_oid)
         {
-            status = (int32_t)OPTIGA_LIB_ERROR;
-            break;
+            return &PpsCache->p_metadata_entries[wIndex];
         }
+    }
+    return NULL;
+}
 
-        //If access condition satisfied, get the data
-        cmd_params.wOID = optiga_oid;
-        cmd_params.wLength = *buffer_size;
-        cmd_params.wOffset = offset;
-        cmd_params.eDataOrMdata = eDATA;
-
-        cmd_resp.prgbBuffer = p_buffer;
-        cmd_resp.wBufferLength = *buffer_size;
-        cmd_resp.wRespLength = 0;
-
-        status = CmdLib_GetDataObject(&cmd_params,&cmd_resp);
+/**
+ *
+ * Finds the entry of a data object configured for caching its data.<br>
+ *
+ * \param[in]  PpsCache    Pointer to the cache
+ * \param[in]  PwOid       OID of data object
+ *
+ * \retval    Pointer to the entry, NULL if the data object is not configured
+ *
+ */
+static optiga_util_object_entry_t* __optiga_util_find_object(const optiga_util_cache_t* PpsCache, uint16_t PwOid)
+{
+    uint16_t wIndex;
 
-        if(CMD_LIB_OK != status)
+    for(wIndex = 0; wIndex < PpsCache->object_entry_count; wIndex++)
+    {
+        if(PwOid == PpsCache->p_object_entries[wIndex].optiga_oid)
         {
-            status = (int32_t)OPTIGA_LIB_ERROR;
-            break;
+            return &PpsCache->p_object_entries[wIndex];
         }
-        *buffer_size = cmd_resp.wRespLength;
-	    status = OPTIGA_LIB_SUCCESS;
-    }while(FALSE);
-
-    return status;
+    }
+    return NULL;
 }
 
-optiga_lib_status_t optiga_util_read_metadata(uint16_t optiga_oid, uint8_t * p_buffer, uint16_t* buffer_size)
+/**
+ *
+ * Stores the metadata of a data object in the cache, in an unused entry or else in place of the oldest entry.<br>
+ *
+ * \param[in,out]  PpsCache      Pointer to the cache
+ * \param[in]      PwOid         OID of data object
+ * \param[in]      PprgbMetadata Metadata in TLV format
+ * \param[in]      PwLen         Length of the metadata
+ * \param[in]      PpsCompiled   Pointer to the compiled metadata
+ *
+ */
+static void __optiga_util_store_metadata(optiga_util_cache_t* PpsCache, uint16_t PwOid,
+                                         const uint8_t* PprgbMetadata, uint16_t PwLen,
+                                         const optiga_util_compiled_metadata_t* PpsCompiled)
 {
-    //lint --e{818} suppress "PpsGPData is out parameter"
-    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
-    sGetData_d cmd_params;
-    sCmdResponse_d cmd_resp;
-    uint16_t buffer_limit = *buffer_size;
-    sbBlob_d meta_data = {LENGTH_METADATA, p_buffer};
-    sACVector_d ac_vector;
+    optiga_util_metadata_entry_t* psEntry;
 
-    do
+    if((0 == PpsCache->metadata_entry_count) || (OPTIGA_UTIL_METADATA_MAX_LEN < PwLen))
     {
-        if((NULL == p_buffer) || (NULL == buffer_size) || (0 == *buffer_size))
-        {
-            status = (int32_t)OPTIGA_LIB_ERROR;
-            break;
-        }
-
-		//Read lcsA
-		status = __optiga_util_read_lcsa_lcsg(eLCSA,&(ac_vector.bLcsA));
-		if(INT_LIB_OK != status)
-		{
-		   break;
-		}
+        return;
+    }
 
-		//Read lcsG
-		status = __optiga_util_read_lcsa_lcsg(eLCSG,&(ac_vector.bLcsG));
-		if(INT_LIB_OK != status)
+    psEntry = __optiga_util_find_metadata(PpsCache, 0);
+    if(NULL == psEntry)
+    {
+        psEntry = &PpsCache->p_metadata_entries[PpsCache->metadata_next_entry];
+        PpsCache->metadata_next_entry = (PpsCache->metadata_next_entry + 1) % PpsCache->metadata_entry_count;
+    }
+    memset(psEntry->metadata, 0x00, sizeof(psEntry->metadata));
+    memcpy(psEntry->metadata, PprgbMetadata, PwLen);
+    psEntry->compiled = *PpsCompiled;
+    psEntry->optiga_oid = PwOid;
+}
+
+/**
+ *
+ * Removes the cached values of a data object after it was written.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsCache        Pointer to the cache
+ * \param[in]      PwOid           OID of data object
+ * \param[in]      PbKeepData      TRUE if the cached data is updated by the caller
+ *
+ */
+static void __optiga_util_invalidate_oid_in_batch(optiga_util_cache_t* PpsCache, uint16_t PwOid, uint8_t PbKeepData)
+{
+    optiga_util_metadata_entry_t* psEntry;
+    optiga_util_object_entry_t* psObject;
+
+    if(((uint16_t)eLCSA == PwOid) || ((uint16_t)eLCSG == PwOid))
+    {
+        PpsCache->lcs_valid = FALSE;
+    }
+    //Metadata also changes with the data, e.g. the used size
+    psEntry = __optiga_util_find_metadata(PpsCache, PwOid);
+    if(NULL != psEntry)
+    {
+        psEntry->optiga_oid = 0;
+    }
+    psObject = __optiga_util_find_object(PpsCache, PwOid);
+    if((NULL != psObject) && (FALSE == PbKeepData))
+    {
+        psObject->state = OPTIGA_UTIL_OBJECT_EMPTY;
+    }
+}
+
+/**
+ *
+ * Removes the cached values of a data object before it is written by #CmdLib_SetDataObject,
+ * #CmdLib_SetDataObjectStream or #CmdLib_GenerateKeyPair, also a failed write may change the data object.<br>
+ * Invoked by the command library with the optiga comms instance held until the write is done, hence
+ * the data object is not cached again before it is written.<br>
+ *
+ * \param[in,out]  PpCtx           Pointer to the optiga comms instance of the OPTIGA
+ * \param[in]      PwOid           OID of data object
+ *
+ */
+static void __optiga_util_object_write_handler(void* PpCtx, uint16_t PwOid)
+{
+    optiga_util_cache_t* psCache = __optiga_util_get_cache((optiga_comms_t*)PpCtx);
+
+    if(NULL != psCache)
+    {
+        __optiga_util_invalidate_oid_in_batch(psCache, PwOid, FALSE);
+    }
+}
+
+/**
+ *
+ * Reads the metadata of a data object and checks its read access condition, using the cache if enabled.<br>
+ * The metadata is compiled once when read from OPTIGA, the cache keeps it compiled.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in]      p_comms        Pointer to the optiga comms instance of the OPTIGA
+ * \param[in]      optiga_oid     OID of data object
+ * \param[in,out]  p_buffer       Buffer to which metadata is read
+ * \param[in,out]  buffer_size    Size of p_buffer, updated with the metadata length
+ * \param[out]     p_compiled     Pointer to which the compiled metadata is returned, can be NULL
+ *
+ * \retval    #OPTIGA_LIB_SUCCESS       Successful execution
+ * \retval    #OPTIGA_LIB_ERROR         Failure in execution
+ * \retval    #INT_LIB_INVALID_RESPONSE Invalid metadata read
+ * \retval    #INT_LIB_INVALID_AC       Read access condition not satisfied
+ *
+ */
+static int32_t __optiga_util_read_metadata_in_batch(optiga_comms_t * p_comms, uint16_t optiga_oid,
+                                                    uint8_t * p_buffer, uint16_t* buffer_size,
+                                                    optiga_util_compiled_metadata_t * p_compiled)
+{
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+    sGetData_d cmd_params;
+    sCmdResponse_d cmd_resp;
+    uint16_t buffer_limit = *buffer_size;
+    uint8_t lcsa;
+    uint8_t lcsg;
+    optiga_util_compiled_metadata_t compiled;
+    const optiga_util_compiled_metadata_t * p_checked = &compiled;
+    optiga_util_cache_t * p_cache = __optiga_util_get_cache(p_comms);
+    optiga_util_metadata_entry_t * p_entry;
+
+    do
+    {
+        if((NULL != p_cache) && (TRUE == p_cache->lcs_valid))
+        {
+            lcsa = p_cache->lcsa;
+            lcsg = p_cache->lcsg;
+            p_cache->lcs_hits++;
+        }
+        else
+        {
+            //Read lcsA
+            status = __optiga_util_read_lcsa_lcsg(p_comms,eLCSA,&(lcsa));
+            if(INT_LIB_OK != status)
+            {
+                break;
+            }
+
+            //Read lcsG
+            status = __optiga_util_read_lcsa_lcsg(p_comms,eLCSG,&(lcsg));
+            if(INT_LIB_OK != status)
+            {
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                break;
+            }
+
+            if(NULL != p_cache)
+            {
+                p_cache->lcsa = lcsa;
+                p_cache->lcsg = lcsg;
+                p_cache->lcs_valid = TRUE;
+                p_cache->lcs_misses++;
+            }
+        }
+
+        //check if OID is for lcsA or lcaG
+        if((uint16_t)eLCSA == optiga_oid)
+        {
+            //return the read value
+            *p_buffer = lcsa;
+            *buffer_size = 0x01;
+            status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+        if((uint16_t)eLCSG == optiga_oid)
+        {
+            //return the read value
+            *p_buffer = lcsg;
+            *buffer_size = 0x01;
+            status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+
+        p_entry = (NULL != p_cache) ? __optiga_util_find_metadata(p_cache, optiga_oid) : NULL;
+        if(NULL != p_entry)
+        {
+            //Metadata from the cache, as if it was read from OPTIGA
+            cmd_resp.wRespLength = p_entry->metadata[POS_LEN] + POS_VAL;
+            if(cmd_resp.wRespLength > buffer_limit)
+            {
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                break;
+            }
+            memcpy(p_buffer, p_entry->metadata, cmd_resp.wRespLength);
+            p_checked = &p_entry->compiled;
+            p_cache->metadata_hits++;
+        }
+        else
+        {
+            //Get metadata of oid
+            cmd_params.wOID = optiga_oid;
+            cmd_params.wLength = LENGTH_METADATA;
+            cmd_params.wOffset = 0;
+            cmd_params.eDataOrMdata = eMETA_DATA;
+
+            cmd_resp.prgbBuffer = p_buffer;
+            cmd_resp.wBufferLength = buffer_limit;
+            cmd_resp.wRespLength = 0;
+
+            status = CmdLib_GetDataObjectInBatch(p_comms,&cmd_params,&cmd_resp);
+            if(CMD_LIB_OK != status)
+            {
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                break;
+            }
+            if(NULL != p_cache)
+            {
+                p_cache->metadata_misses++;
+            }
+        }
+        //Check the length
+        *buffer_size = *(p_buffer + POS_LEN);
+        if((*buffer_size != (cmd_resp.wRespLength-POS_VAL)))
+        {
+            status = (int32_t)INT_LIB_INVALID_RESPONSE;
+            break;
+        }
+        if(NULL == p_entry)
+        {
+            __optiga_util_compile_metadata(p_buffer, &compiled);
+        }
+        if((NULL != p_cache) && (NULL == p_entry))
+        {
+            __optiga_util_store_metadata(p_cache, optiga_oid, p_buffer, cmd_resp.wRespLength, &compiled);
+        }
+        if(NULL != p_compiled)
+        {
+            *p_compiled = *p_checked;
+        }
+        //Check read access condition
+        status = __optiga_util_check_ac(p_checked, lcsa, lcsg);
+        if(INT_LIB_OK != status)
+        {
+            status = (int32_t)INT_LIB_INVALID_AC;
+            break;
+        }
+        status = OPTIGA_LIB_SUCCESS;
+    }while(FALSE);
+
+    return status;
+}
+
+/**
+ *
+ * Reads a data object configured for caching into its entry, up to the size of the buffer of the entry.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
+ * \param[in,out]  PpsCache        Pointer to the cache
+ * \param[in,out]  PpsEntry        Pointer to the entry of the data object
+ *
+ * \retval    #CMD_LIB_OK       Successful execution
+ * \retval    Error codes of #CmdLib_GetDataObjectInBatch
+ *
+ */
+static int32_t __optiga_util_fill_object(optiga_comms_t* PpsOptigaComms, optiga_util_cache_t* PpsCache,
+                                         optiga_util_object_entry_t* PpsEntry)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sGetData_d sGDVector;
+    sCmdResponse_d sResponse;
+    uint8_t rgbMetadata[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint16_t wMetadataLen = sizeof(rgbMetadata);
+    optiga_util_compiled_metadata_t sCompiled;
+
+    do
+    {
+        PpsCache->object_misses++;
+
+        sGDVector.wOID = PpsEntry->optiga_oid;
+        sGDVector.wLength = PpsEntry->buffer_size;
+        sGDVector.wOffset = 0;
+        sGDVector.eDataOrMdata = eDATA;
+
+        sResponse.prgbBuffer = PpsEntry->buffer;
+        sResponse.wBufferLength = PpsEntry->buffer_size;
+        sResponse.wRespLength = 0;
+
+        i4Status = CmdLib_GetDataObjectInBatch(PpsOptigaComms,&sGDVector,&sResponse);
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        PpsEntry->length = sResponse.wRespLength;
+        PpsEntry->state = OPTIGA_UTIL_OBJECT_CACHED;
+        //A read shorter than the buffer ended at the end of the data object
+        PpsEntry->complete = (PpsEntry->length < PpsEntry->buffer_size) ? TRUE : FALSE;
+
+        memset(rgbMetadata, 0x00, sizeof(rgbMetadata));
+        if(OPTIGA_LIB_SUCCESS != __optiga_util_read_metadata_in_batch(PpsOptigaComms, PpsEntry->optiga_oid,
+                                                                      rgbMetadata, &wMetadataLen, &sCompiled))
+        {
+            break;
+        }
+        //Data objects with the change access condition never are kept over resets
+        if(TRUE == sCompiled.change_never)
+        {
+            PpsEntry->state = OPTIGA_UTIL_OBJECT_CACHED_FOREVER;
+        }
+        //A data object exactly as large as the buffer is complete as well
+        if((TRUE == sCompiled.used_size_present) && (PpsEntry->length == sCompiled.used_size))
+        {
+            PpsEntry->complete = TRUE;
+        }
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ *
+ * Reads data of a data object, from the cache if the data object is configured for caching.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
+ * \param[in]      PwOid           OID of data object
+ * \param[in]      PwOffset        Offset from within data object
+ * \param[in,out]  PprgbBuffer     Buffer to which data is read
+ * \param[in,out]  PpwLength       Length of data to be read, updated with actual data length retrieved
+ *
+ * \retval    #CMD_LIB_OK       Successful execution
+ * \retval    Error codes of #CmdLib_GetDataObjectInBatch
+ *
+ */
+static int32_t __optiga_util_read_data_in_batch(optiga_comms_t* PpsOptigaComms, uint16_t PwOid, uint16_t PwOffset,
+                                                uint8_t* PprgbBuffer, uint16_t* PpwLength)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_ERROR;
+    sGetData_d sGDVector;
+    sCmdResponse_d sResponse;
+    optiga_util_cache_t* psCache = __optiga_util_get_cache(PpsOptigaComms);
+    optiga_util_object_entry_t* psEntry = NULL;
+    uint8_t bFilled = FALSE;
+    uint16_t wCopyLen;
+
+    do
+    {
+        if(NULL != psCache)
+        {
+            psEntry = __optiga_util_find_object(psCache, PwOid);
+        }
+        if(NULL != psEntry)
+        {
+            if(OPTIGA_UTIL_OBJECT_EMPTY == psEntry->state)
+            {
+                //An error is returned by the read from OPTIGA below
+                //lint --e{534} suppress "Return value is not required to be checked"
+                __optiga_util_fill_object(PpsOptigaComms, psCache, psEntry);
+                bFilled = TRUE;
+            }
+            //Served from the cache if the data is cached up to the requested length or the object is fully cached
+            if((OPTIGA_UTIL_OBJECT_EMPTY != psEntry->state) && (PwOffset < psEntry->length) &&
+               (((uint32_t)PwOffset + *PpwLength <= psEntry->length) || (TRUE == psEntry->complete)))
+            {
+                wCopyLen = psEntry->length - PwOffset;
+                if(wCopyLen > *PpwLength)
+                {
+                    wCopyLen = *PpwLength;
+                }
+                memcpy(PprgbBuffer, psEntry->buffer + PwOffset, wCopyLen);
+                *PpwLength = wCopyLen;
+                if(FALSE == bFilled)
+                {
+                    psCache->object_hits++;
+                }
+                i4Status = (int32_t)CMD_LIB_OK;
+                break;
+            }
+            if(FALSE == bFilled)
+            {
+                psCache->object_misses++;
+            }
+        }
+
+        sGDVector.wOID = PwOid;
+        sGDVector.wLength = *PpwLength;
+        sGDVector.wOffset = PwOffset;
+        sGDVector.eDataOrMdata = eDATA;
+
+        sResponse.prgbBuffer = PprgbBuffer;
+        sResponse.wBufferLength = *PpwLength;
+        sResponse.wRespLength = 0;
+
+        i4Status = CmdLib_GetDataObjectInBatch(PpsOptigaComms,&sGDVector,&sResponse);
+        if(CMD_LIB_OK != i4Status)
+        {
+            break;
+        }
+        *PpwLength = sResponse.wRespLength;
+    }while(FALSE);
+
+    return i4Status;
+}
+
+/**
+ *
+ * Writes a changed range of a data object found by #__optiga_util_write_data_differential.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
+ * \param[in]      PwOid           OID of data object
+ * \param[in]      PwOffset        Offset of the range from within data object
+ * \param[in]      PprgbData       Data of the range
+ * \param[in]      PwLength        Length of the range
+ *
+ * \retval    #CMD_LIB_OK       Successful execution
+ * \retval    Error codes of #CmdLib_SetDataObjectInBatch
+ *
+ */
+static int32_t __optiga_util_write_range(optiga_comms_t* PpsOptigaComms, uint16_t PwOid, uint16_t PwOffset,
+                                         uint8_t* PprgbData, uint16_t PwLength)
+{
+    sSetData_d sSDVector;
+
+    sSDVector.wOID = PwOid;
+    sSDVector.wOffset = PwOffset;
+    sSDVector.wLength = PwLength;
+    sSDVector.prgbData = PprgbData;
+    sSDVector.eDataOrMdata = eDATA;
+    sSDVector.eWriteOption = eWRITE;
+
+    return CmdLib_SetDataObjectInBatch(PpsOptigaComms,&sSDVector);
+}
+
+/**
+ *
+ * Writes only the bytes of a data object which differ from the current data.<br>
+ * The current data is taken from the cache, if the data object is configured for caching and the cached data
+ * covers the range to write. Otherwise the whole range is written, as reading the current data from OPTIGA
+ * costs as much bus time as writing it.
+ * Bytes beyond the end of a completely cached data object are written.
+ * Changed ranges separated by up to #OPTIGA_UTIL_WRITE_DIFF_MAX_GAP unchanged bytes are written together.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsOptigaComms  Pointer to the optiga comms instance of the OPTIGA
+ * \param[in]      PwOid           OID of data object
+ * \param[in]      PwOffset        Offset from within data object
+ * \param[in]      PprgbData       Data to write
+ * \param[in]      PwLength        Length of data to write
+ *
+ * \retval    #CMD_LIB_OK       Successful execution
+ * \retval    Error codes of #CmdLib_SetDataObjectInBatch
+ *
+ */
+static int32_t __optiga_util_write_data_differential(optiga_comms_t* PpsOptigaComms, uint16_t PwOid, uint16_t PwOffset,
+                                                     uint8_t* PprgbData, uint16_t PwLength)
+{
+    int32_t i4Status = (int32_t)CMD_LIB_OK;
+    optiga_util_cache_t* psCache = __optiga_util_get_cache(PpsOptigaComms);
+    optiga_util_object_entry_t* psEntry = NULL;
+    uint16_t wAvailable = 0;
+    uint16_t wIndex;
+    uint16_t wRangeStart = 0;
+    uint16_t wRangeEnd = 0;
+    uint8_t bRangeOpen = FALSE;
+
+    if(NULL != psCache)
+    {
+        psEntry = __optiga_util_find_object(psCache, PwOid);
+    }
+    if((NULL != psEntry) && (OPTIGA_UTIL_OBJECT_EMPTY == psEntry->state) &&
+       (CMD_LIB_OK != __optiga_util_fill_object(PpsOptigaComms, psCache, psEntry)))
+    {
+        psEntry = NULL;
+    }
+    if((NULL == psEntry) || (((uint32_t)PwOffset + PwLength > psEntry->length) && (FALSE == psEntry->complete)))
+    {
+        return __optiga_util_write_range(PpsOptigaComms, PwOid, PwOffset, PprgbData, PwLength);
+    }
+
+    if(PwOffset < psEntry->length)
+    {
+        wAvailable = psEntry->length - PwOffset;
+    }
+    for(wIndex = 0; wIndex < PwLength; wIndex++)
+    {
+        if((wIndex < wAvailable) && (psEntry->buffer[PwOffset + wIndex] == PprgbData[wIndex]))
+        {
+            continue;
+        }
+        //A changed byte far from the open range starts a new range
+        if((TRUE == bRangeOpen) && ((wIndex - wRangeEnd) > OPTIGA_UTIL_WRITE_DIFF_MAX_GAP))
+        {
+            i4Status = __optiga_util_write_range(PpsOptigaComms, PwOid, PwOffset + wRangeStart,
+                                                 PprgbData + wRangeStart, wRangeEnd - wRangeStart);
+            if(CMD_LIB_OK != i4Status)
+            {
+                break;
+            }
+            bRangeOpen = FALSE;
+        }
+        if(FALSE == bRangeOpen)
+        {
+            wRangeStart = wIndex;
+            bRangeOpen = TRUE;
+        }
+        wRangeEnd = wIndex + 1;
+    }
+
+    if((CMD_LIB_OK == i4Status) && (TRUE == bRangeOpen))
+    {
+        i4Status = __optiga_util_write_range(PpsOptigaComms, PwOid, PwOffset + wRangeStart,
+                                             PprgbData + wRangeStart, wRangeEnd - wRangeStart);
+    }
+
+    return i4Status;
+}
+
+/**
+ *
+ * Updates the cached data of a data object after a successful write only, or removes it if not possible.<br>
+ * The optiga comms instance must be acquired using #CmdLib_BeginBatch.<br>
+ *
+ * \param[in,out]  PpsCache        Pointer to the cache
+ * \param[in]      PwOid           OID of data object
+ * \param[in]      PwOffset        Offset from within data object
+ * \param[in]      PprgbData       Data written
+ * \param[in]      PwLength        Length of data written
+ *
+ */
+static void __optiga_util_update_object(optiga_util_cache_t* PpsCache, uint16_t PwOid, uint16_t PwOffset,
+                                        const uint8_t* PprgbData, uint16_t PwLength)
+{
+    optiga_util_object_entry_t* psEntry = __optiga_util_find_object(PpsCache, PwOid);
+    uint32_t dwEnd = (uint32_t)PwOffset + PwLength;
+
+    __optiga_util_invalidate_oid_in_batch(PpsCache, PwOid, TRUE);
+    if((NULL == psEntry) || (OPTIGA_UTIL_OBJECT_EMPTY == psEntry->state))
+    {
+        return;
+    }
+    //Data written beyond the cached data leaves a hole in the cache
+    if(PwOffset > psEntry->length)
+    {
+        psEntry->state = OPTIGA_UTIL_OBJECT_EMPTY;
+        return;
+    }
+    if(dwEnd > psEntry->buffer_size)
+    {
+        dwEnd = psEntry->buffer_size;
+        psEntry->complete = FALSE;
+    }
+    if(dwEnd > PwOffset)
+    {
+        memcpy(psEntry->buffer + PwOffset, PprgbData, (uint16_t)(dwEnd - PwOffset));
+    }
+    if(dwEnd > psEntry->length)
+    {
+        psEntry->length = (uint16_t)dwEnd;
+    }
+}
+
+static void __optiga_util_comms_event_handler(void* upper_layer_ctx, host_lib_status_t event)
+{
+#ifdef PAL_OS_HAS_EVENT_WAIT
+	pal_os_event_notify(&((optiga_comms_t*)upper_layer_ctx)->comms_status, (uint32_t)event);
+#else
+	((optiga_comms_t*)upper_layer_ctx)->comms_status = event;
+#endif
+}
+
+optiga_lib_status_t optiga_util_open_application(optiga_comms_t* p_comms)
+{
+	optiga_lib_status_t status = OPTIGA_LIB_ERROR;
+	sOpenApp_d sOpenApp;
+
+	do {
+		// OPTIGA Initialisation phase
+		//Invoke optiga_comms_open to initialize the IFX I2C Protocol and security chip
+		p_comms->comms_status = OPTIGA_COMMS_BUSY;
+		p_comms->upper_layer_handler = __optiga_util_comms_event_handler;
+		p_comms->upper_layer_ctx = p_comms;
+		status = optiga_comms_open(p_comms);
+		if(E_COMMS_SUCCESS != status)
 		{
-        	        status = (int32_t)OPTIGA_LIB_ERROR;
+			status = OPTIGA_LIB_ERROR;
 			break;
 		}
 
-		//check if OID is for lcsA or lcaG
-		if((uint16_t)eLCSA == optiga_oid)
+		//Wait until IFX I2C initialization is complete
+#ifdef PAL_OS_HAS_EVENT_WAIT
+		pal_os_event_wait(&p_comms->comms_status, OPTIGA_COMMS_BUSY);
+#else
+		while(p_comms->comms_status == OPTIGA_COMMS_BUSY)
 		{
-			//return the read value
-			*p_buffer = ac_vector.bLcsA;
-			*buffer_size = 0x01;
-			break;
+			pal_os_timer_delay_in_milliseconds(1);
 		}
-		if((uint16_t)eLCSG == optiga_oid)
+#endif
+
+		if((OPTIGA_COMMS_SUCCESS != status) || (p_comms->comms_status == OPTIGA_COMMS_ERROR))
 		{
-			//return the read value
-			*p_buffer = ac_vector.bLcsG;
-			*buffer_size = 0x01;
+			status = OPTIGA_LIB_ERROR;
 			break;
 		}
 
-		//Get metadata of oid
-		cmd_params.wOID = optiga_oid;
-		cmd_params.wLength = LENGTH_METADATA;
-		cmd_params.wOffset = 0;
-		cmd_params.eDataOrMdata = eMETA_DATA;
-
-		cmd_resp.prgbBuffer = p_buffer;
-		cmd_resp.wBufferLength = buffer_limit;
-		cmd_resp.wRespLength = 0;
 
-		status = CmdLib_GetDataObject(&cmd_params,&cmd_resp);
+		//Open the application in Security Chip
+		sOpenApp.eOpenType = eInit;
+		status = CmdLib_OpenApplication(p_comms,&sOpenApp);
 		if(CMD_LIB_OK != status)
 		{
-			status = (int32_t)OPTIGA_LIB_ERROR;
 			break;
 		}
-		//Check the length
-		*buffer_size = *(cmd_resp.prgbBuffer + POS_LEN );
-		if((*buffer_size != (cmd_resp.wRespLength-POS_VAL)))
+		status = OPTIGA_LIB_SUCCESS;
+
+		//Failure to prefetch is not an error of the open, the data objects are read at the first use
+		if((NULL != p_comms->p_util_cache) && (TRUE == ((optiga_util_cache_t*)p_comms->p_util_cache)->prefetch_on_open))
 		{
-			status = (int32_t)INT_LIB_INVALID_RESPONSE;
-			break;
+			//lint --e{534} suppress "Return value is not required to be checked"
+			optiga_util_prefetch_cache(p_comms);
 		}
-		//Check read access condition
-		ac_vector.psMetaData = &meta_data;
-		status = __optiga_util_verify_ac(eREAD_AC,&ac_vector);
-		if(INT_LIB_OK != status)
+	} while(FALSE);
+
+	return status;
+}
+
+#ifdef PAL_OS_HAS_DATASTORE
+optiga_lib_status_t optiga_util_open_application_warm(optiga_comms_t* p_comms, uint16_t datastore_id)
+{
+	optiga_lib_status_t status = OPTIGA_LIB_ERROR;
+	optiga_comms_warm_cache_t saved_cache;
+	optiga_comms_warm_cache_t cache;
+	uint16_t length = sizeof(saved_cache);
+
+	do {
+		// Without matching saved parameters, the full open sequence is done
+		if((PAL_STATUS_SUCCESS != pal_os_datastore_read(datastore_id, (uint8_t*)&saved_cache, &length)) ||
+		   (sizeof(saved_cache) != length) ||
+		   (OPTIGA_COMMS_SUCCESS != optiga_comms_set_warm_cache(p_comms, &saved_cache)))
+		{
+			memset(&saved_cache, 0x00, sizeof(saved_cache));
+		}
+
+		status = optiga_util_open_application(p_comms);
+		if(OPTIGA_LIB_SUCCESS != status)
 		{
-			status = (int32_t)INT_LIB_INVALID_AC;
 			break;
 		}
-		status = OPTIGA_LIB_SUCCESS;
 
+		// Save the parameters for the next warm open, failure to save is not an error of the open
+		memset(&cache, 0x00, sizeof(cache));
+		if((OPTIGA_COMMS_SUCCESS == optiga_comms_get_warm_cache(p_comms, &cache)) &&
+		   (0 != memcmp(&cache, &saved_cache, sizeof(cache))))
+		{
+			//lint --e{534} suppress "Return value is not required to be checked"
+			pal_os_datastore_write(datastore_id, (const uint8_t*)&cache, sizeof(cache));
+		}
+	} while(FALSE);
+
+	return status;
+}
+#endif
+
+optiga_lib_status_t optiga_util_read_data(optiga_comms_t * p_comms, uint16_t optiga_oid, uint16_t offset,
+                                          uint8_t * p_buffer, uint16_t* buffer_size)
+{
+    //lint --e{818} suppress "PpsGPData is out parameter"
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+
+    do
+    {
+        if((NULL == p_buffer) || (NULL == buffer_size) || (0 == *buffer_size))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+        status = __optiga_util_read_data_in_batch(p_comms,optiga_oid,offset,p_buffer,buffer_size);
+        CmdLib_EndBatch(p_comms);
+
+        if(CMD_LIB_OK != status)
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+	    status = OPTIGA_LIB_SUCCESS;
     }while(FALSE);
 
     return status;
+}
+
+optiga_lib_status_t optiga_util_read_data_batch(optiga_comms_t * p_comms, optiga_util_read_entry_t * entries,
+                                                uint16_t count)
+{
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+    uint16_t index;
 
+    do
+    {
+        if((NULL == entries) || (0 == count))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        status = OPTIGA_LIB_SUCCESS;
+        for(index = 0; index < count; index++)
+        {
+            entries[index].status = OPTIGA_LIB_ERROR;
+            if((NULL == entries[index].buffer) || (0 == entries[index].bytes_to_read))
+            {
+                entries[index].bytes_to_read = 0;
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                continue;
+            }
+
+            if(CMD_LIB_OK != __optiga_util_read_data_in_batch(p_comms,entries[index].optiga_oid,entries[index].offset,
+                                                              entries[index].buffer,&entries[index].bytes_to_read))
+            {
+                entries[index].bytes_to_read = 0;
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                continue;
+            }
+            entries[index].status = OPTIGA_LIB_SUCCESS;
+        }
+
+        CmdLib_EndBatch(p_comms);
+    }while(FALSE);
+
+    return status;
 }
 
-optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid, uint8_t write_type, uint16_t offset, uint8_t * p_buffer, uint16_t buffer_size)
+optiga_lib_status_t optiga_util_enable_cache(optiga_comms_t * p_comms, optiga_util_cache_t * p_cache)
 {
     int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+    optiga_util_cache_t config;
+    uint16_t index;
+
+    do
+    {
+        if((NULL != p_cache) &&
+           (((NULL == p_cache->p_metadata_entries) && (0 != p_cache->metadata_entry_count)) ||
+            ((NULL == p_cache->p_object_entries) && (0 != p_cache->object_entry_count))))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+        for(index = 0; (NULL != p_cache) && (index < p_cache->object_entry_count); index++)
+        {
+            if((NULL == p_cache->p_object_entries[index].buffer) || (0 == p_cache->p_object_entries[index].buffer_size))
+            {
+                break;
+            }
+        }
+        if((NULL != p_cache) && (index < p_cache->object_entry_count))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        if(NULL != p_cache)
+        {
+            //Keep the configuration set by the application, clear the rest
+            config = *p_cache;
+            memset(p_cache, 0x00, sizeof(*p_cache));
+            p_cache->p_metadata_entries = config.p_metadata_entries;
+            p_cache->metadata_entry_count = config.metadata_entry_count;
+            p_cache->p_object_entries = config.p_object_entries;
+            p_cache->object_entry_count = config.object_entry_count;
+            p_cache->prefetch_on_open = config.prefetch_on_open;
+            __optiga_util_clear_cache(p_cache, FALSE);
+            p_cache->reset_count = p_comms->reset_count;
+        }
+        p_comms->p_util_cache = p_cache;
+        p_comms->object_write_handler = (NULL != p_cache) ? __optiga_util_object_write_handler : NULL;
+
+        CmdLib_EndBatch(p_comms);
+        status = OPTIGA_LIB_SUCCESS;
+    }while(FALSE);
+
+    return status;
+}
+
+void optiga_util_invalidate_cache(optiga_comms_t * p_comms)
+{
+    optiga_util_cache_t * p_cache;
+
+    if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+    {
+        return;
+    }
+
+    p_cache = (optiga_util_cache_t *)p_comms->p_util_cache;
+    if(NULL != p_cache)
+    {
+        __optiga_util_clear_cache(p_cache, FALSE);
+        p_cache->invalidations++;
+    }
+
+    CmdLib_EndBatch(p_comms);
+}
+
+optiga_lib_status_t optiga_util_prefetch_cache(optiga_comms_t * p_comms)
+{
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+    optiga_util_cache_t * p_cache;
+    uint16_t index;
+
+    do
+    {
+        if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        p_cache = __optiga_util_get_cache(p_comms);
+        status = (NULL != p_cache) ? (int32_t)OPTIGA_LIB_SUCCESS : (int32_t)OPTIGA_LIB_ERROR;
+        for(index = 0; (NULL != p_cache) && (index < p_cache->object_entry_count); index++)
+        {
+            if((TRUE == p_cache->p_object_entries[index].prefetch) &&
+               (OPTIGA_UTIL_OBJECT_EMPTY == p_cache->p_object_entries[index].state) &&
+               (CMD_LIB_OK != __optiga_util_fill_object(p_comms, p_cache, &p_cache->p_object_entries[index])))
+            {
+                status = (int32_t)OPTIGA_LIB_ERROR;
+            }
+        }
+
+        CmdLib_EndBatch(p_comms);
+    }while(FALSE);
+
+    return status;
+}
+
+optiga_lib_status_t optiga_util_read_metadata(optiga_comms_t * p_comms, uint16_t optiga_oid, uint8_t * p_buffer, uint16_t* buffer_size)
+{
+    //lint --e{818} suppress "PpsGPData is out parameter"
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+
+    do
+    {
+        if((NULL == p_buffer) || (NULL == buffer_size) || (0 == *buffer_size))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+
+        //The life cycle states, the metadata and the cache are consistent as long as the instance is held
+        if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+        {
+            status = (int32_t)OPTIGA_LIB_ERROR;
+            break;
+        }
+        status = __optiga_util_read_metadata_in_batch(p_comms, optiga_oid, p_buffer, buffer_size, NULL);
+        CmdLib_EndBatch(p_comms);
+    }while(FALSE);
+
+    return status;
+
+}
+
+optiga_lib_status_t optiga_util_write_data(optiga_comms_t * p_comms, uint16_t optiga_oid, uint8_t write_type, uint16_t offset, uint8_t * p_buffer, uint16_t buffer_size)
+{
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+    optiga_util_cache_t * p_cache;
 
     sSetData_d sd_params;
 
@@ -788,12 +1454,41 @@ optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid, uint8_t write_ty
             break;
         }
 
-        if ((OPTIGA_UTIL_WRITE_ONLY != write_type) && (OPTIGA_UTIL_ERASE_AND_WRITE != write_type))
+        if ((OPTIGA_UTIL_WRITE_ONLY != write_type) && (OPTIGA_UTIL_ERASE_AND_WRITE != write_type) &&
+            (OPTIGA_UTIL_WRITE_DIFFERENTIAL != write_type))
         {
         	status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
             break;
         }
 
+        if (OPTIGA_UTIL_WRITE_DIFFERENTIAL == write_type)
+        {
+            //The comparison and the writes are not interleaved with other users of the instance
+            if(CMD_LIB_OK != CmdLib_BeginBatch(p_comms))
+            {
+                status = (int32_t)OPTIGA_LIB_ERROR;
+                break;
+            }
+            status = __optiga_util_write_data_differential(p_comms, optiga_oid, offset, p_buffer, buffer_size);
+            p_cache = __optiga_util_get_cache(p_comms);
+            if((NULL != p_cache) && (CMD_LIB_OK == status))
+            {
+                __optiga_util_update_object(p_cache, optiga_oid, offset, p_buffer, buffer_size);
+            }
+            else if(NULL != p_cache)
+            {
+                //Also a failed write may have changed the data object
+                __optiga_util_invalidate_oid_in_batch(p_cache, optiga_oid, FALSE);
+            }
+            CmdLib_EndBatch(p_comms);
+            if(CMD_LIB_OK != status)
+            {
+                break;
+            }
+            status = OPTIGA_LIB_SUCCESS;
+            break;
+        }
+
         //If access condition satisfied, set the data
         sd_params.wOID = optiga_oid;
         sd_params.wOffset = offset;
@@ -805,7 +1500,54 @@ optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid, uint8_t write_ty
         sd_params.prgbData = p_buffer;
         sd_params.wLength = buffer_size;
 
-        status = CmdLib_SetDataObject(&sd_params);
+        status = CmdLib_SetDataObject(p_comms,&sd_params);
+        if(CMD_LIB_OK != status)
+        {
+            break;
+        }
+        status = OPTIGA_LIB_SUCCESS;
+    }while(FALSE);
+    return status;
+}
+
+optiga_lib_status_t optiga_util_write_data_stream(optiga_comms_t * p_comms, uint16_t optiga_oid, uint8_t write_type, uint16_t offset, const optiga_util_stream_t * p_stream, uint16_t bytes_to_write)
+{
+    int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
+
+    sSetData_d sd_params;
+    sDataStream_d stream;
+
+    do
+    {
+        if((NULL == p_stream) || (NULL == p_stream->read) || (NULL == p_stream->buffer) || (0x00 == bytes_to_write))
+        {
+            break;
+        }
+
+        if ((OPTIGA_UTIL_WRITE_ONLY != write_type) && (OPTIGA_UTIL_ERASE_AND_WRITE != write_type))
+        {
+        	status = OPTIGA_UTIL_ERROR_INVALID_INPUT;
+            break;
+        }
+
+        sd_params.wOID = optiga_oid;
+        sd_params.wOffset = offset;
+        sd_params.eDataOrMdata = eDATA;
+        if (OPTIGA_UTIL_ERASE_AND_WRITE == write_type)
+        	sd_params.eWriteOption = eERASE_AND_WRITE;
+        else
+        	sd_params.eWriteOption = eWRITE;
+        //The data is taken from the stream
+        sd_params.prgbData = NULL;
+        sd_params.wLength = bytes_to_write;
+
+        stream.pfGetChunk = p_stream->read;
+        stream.pfProgress = p_stream->progress;
+        stream.pCtx = p_stream->p_ctx;
+        stream.prgbBuffer = p_stream->buffer;
+        stream.wBufferLength = p_stream->buffer_size;
+
+        status = CmdLib_SetDataObjectStream(p_comms, &sd_params, &stream);
         if(CMD_LIB_OK != status)
         {
             break;
@@ -815,7 +1557,7 @@ optiga_lib_status_t optiga_util_write_data(uint16_t optiga_oid, uint8_t write_ty
     return status;
 }
 
-optiga_lib_status_t optiga_util_write_metadata(uint16_t optiga_oid, uint8_t * p_buffer, uint8_t buffer_size)
+optiga_lib_status_t optiga_util_write_metadata(optiga_comms_t * p_comms, uint16_t optiga_oid, uint8_t * p_buffer, uint8_t buffer_size)
 {
 
     int32_t status  = (int32_t)OPTIGA_LIB_ERROR;
@@ -831,7 +1573,7 @@ optiga_lib_status_t optiga_util_write_metadata(uint16_t optiga_oid, uint8_t * p_
     sd_params.prgbData = p_buffer;
     sd_params.wLength = buffer_size;
 
-    status = CmdLib_SetDataObject(&sd_params);
+    status = CmdLib_SetDataObject(p_comms,&sd_params);
     if(CMD_LIB_OK != status)
     {
         return  OPTIGA_LIB_ERROR;
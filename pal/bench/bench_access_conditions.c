@@ -0,0 +1,745 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_access_conditions.c
+*
+* \brief   Compares the read access condition check on the compiled metadata with the parser it replaced.
+*
+* The parser which evaluated the metadata TLV on every check is kept below as it was, with the prefix
+* bench_parse. The driver includes optiga_util.c to reach the static functions compiling and checking the
+* metadata. Both are fed with 200000 generated metadata sets with LcsO, sizes and change, read and execute
+* access conditions, then with 200000 sets mutated at random, and checked for 20 pairs of LcsA and LcsG each.
+* The parser reads bytes beyond the metadata length, whatever follows in the buffer. Checks whose result
+* changes with these bytes are skipped and counted. Sets whose read access condition has more alternatives than
+* OPTIGA_UTIL_AC_MAX_TERMS are left to OPTIGA by the compiled check and counted, build with e.g.
+* -DOPTIGA_UTIL_AC_MAX_TERMS=2 to see them. Finally the time per check of both, and the time to compile a metadata
+* set, are measured on the valid sets.
+*
+* Build from the root of the repository as described in README.md, with the sources of optiga/util left out of
+* CORE and SIM set to the sources of pal/sim:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Iexternals/mbedtls-2.12.0/include $CORE $SIM
+*     pal/bench/bench_access_conditions.c build/mbedtls/libmbedtls.a -lpthread -o bench_access_conditions
+* ./bench_access_conditions
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../../optiga/util/optiga_util.c"
+
+///Already Found
+#define BENCH_TAG_FOUND             0x9B
+///Not yet found
+#define BENCH_TAG_NOTFOUND          0x31
+
+/// Metadata sets per run
+#define BENCH_SETS                  (200000)
+/// Pairs of LcsA and LcsG checked per set
+#define BENCH_PAIRS                 (20)
+/// Metadata sets timed
+#define BENCH_TIMED_SETS            (20000)
+/// Repetitions of the timing
+#define BENCH_TIMED_ROUNDS          (5)
+
+/**
+ * \brief Access condition vector of the parser
+ */
+typedef struct bench_ac_vector
+{
+    ///Life cycle state of the application
+    uint8_t bLcsA;
+    ///Global life cycle state
+    uint8_t bLcsG;
+    ///Life cycle state of the object
+    uint8_t bLcsO;
+    ///Metadata
+    sbBlob_d *psMetaData;
+} bench_ac_vector_t;
+
+/**
+ *
+ * Implementation to get the metadata tag position.<br>
+ * Returns error if metadata is not correct<br>
+ * (if duplication of tag, metadata length / Tag length more than max length of metadata).<br> <br>
+ *
+ * PpbPos contains the actual position of the tag if found.<br>
+ * PpbPos contains 0xFF if tag not found.This is considering that metatdata length is 28 bytes.
+ * The return value in this case is #INT_LIB_OK.<br>
+ *
+ * \param[in]  Pprgbmetadata   Pointer to the buffer that contains metadata
+ * \param[in]  PbTag           Tag type.
+ * \param[in]  PpbPos          Pointer to tag position in metadata
+ *
+ * \retval    #INT_LIB_OK      Successful execution
+ * \retval    #INT_LIB_ERROR   Failure in execution
+ *
+ */
+static int32_t bench_parse_get_tag_position (const uint8_t* Pprgbmetadata, uint8_t PbTag, puint8_t PpbPos)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    uint8_t bMetadataSize, bAcLen;
+    uint8_t bTempPos, bAlreadyFound=BENCH_TAG_NOTFOUND;
+
+    do
+    {
+        if (NULL == Pprgbmetadata || NULL == PpbPos)
+        {
+            break;
+        }
+
+        bMetadataSize = Pprgbmetadata[OFFSET_TLV_LENGTH];
+
+        *PpbPos = 0xFF;
+
+        if (METADATA_MAX_LEN < (bMetadataSize + METADATA_HEADER_SIZE))
+        {
+            //Metadata Corrupted [Length field in Metadata is more than METADATA_MAX_SIZE]
+            break;
+        }
+
+        bTempPos = METADATA_HEADER_SIZE;
+
+        for(;;)
+        {
+            if (Pprgbmetadata[bTempPos] == PbTag)
+            {
+                if (BENCH_TAG_FOUND == bAlreadyFound)
+                {
+                    i4Status = (int32_t)INT_LIB_ERROR;
+                    break;
+                }
+                i4Status = INT_LIB_OK;
+                *PpbPos = bTempPos;
+                bAlreadyFound = BENCH_TAG_FOUND;
+            }
+
+            if(0xFF == Pprgbmetadata[bTempPos])
+            {
+                //Length field in Metadata is not correct
+                break;
+            }
+            bAcLen = Pprgbmetadata[bTempPos+1];
+
+            //Is metadata Corrupted?
+            if (METADATA_MAX_LEN <= (bAcLen+bTempPos+1))
+            {
+                //Metadata Corrupted
+                break;
+            }
+
+            bTempPos += (bAcLen+2);
+
+            if(bMetadataSize <= (bTempPos-METADATA_HEADER_SIZE))
+            {
+                i4Status = INT_LIB_OK;
+                break;
+            }
+        }
+    } while(0);
+
+    return i4Status;
+}
+
+/**
+ *
+ * Implementation to verify expressions related to LCSA, LCSG, LCSO.<br>
+ *
+ * \param[in]     PpsACVal             Pointer to the access condition vector
+ * \param[in]     PprgbAC              Pointer to the AC expression
+ * \param[in,out] PpwVerifyOver        Pointer to verification status
+ *
+ * \retval    #INT_LIB_OK       Successful execution
+ * \retval    #INT_LIB_ERROR    Failure in execution
+ *
+ */
+static int32_t bench_parse_verify_lcsa_lcsg_lcso(const bench_ac_vector_t* PpsACVal, const uint8_t* PprgbAC,puint16_t PpwVerifyOver)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    uint8_t bVal, bLcs = 0x00;
+    eOperator_d eOp ;
+
+	// Life cycle state of object
+    #define LCS_O_VAL			(PpsACVal->bLcsO)
+	// Life cycle state of application
+    #define LCS_A_VAL			(PpsACVal->bLcsA)
+	// Life cycle state of Global
+    #define LCS_G_VAL			(PpsACVal->bLcsG)
+
+    do
+    {
+        if((NULL == PpwVerifyOver)
+            || (NULL == PpsACVal) || (NULL == PprgbAC))
+        {
+            break;
+        }
+
+        bLcs = LCS_A_VAL;
+        if ((uint8_t)eACID_LCSG == *PprgbAC)
+        {
+            bLcs = LCS_G_VAL;
+        }
+        else if((uint8_t)eACID_LCSO == *PprgbAC)
+        {
+            bLcs = LCS_O_VAL;
+        }
+
+        eOp = (eOperator_d)(*(PprgbAC+1));
+        bVal = *(PprgbAC+2);
+
+        if(eOp == eOP_GREATER_THAN)
+        {
+            if(bLcs > bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else if(eOp == eOP_LESS_THAN)
+        {
+            if(bLcs < bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else if(eOp == eOP_EQUAL)
+        {
+            if(bLcs == bVal)
+            {
+                i4Status = INT_LIB_OK;
+            }
+        }
+        else
+        {
+            i4Status = (int32_t)INT_LIB_ERROR;
+            *PpwVerifyOver = TRUE;
+            break;
+        }
+    } while(0);
+    return i4Status;
+#undef LCS_O_VAL
+#undef LCS_A_VAL
+#undef LCS_G_VAL
+}
+
+/**
+ *
+ * Implementation to validate the access conditions.<br>
+ *
+ * \param[in]  PpsACVal   Pointer to the buffer that contains metadata
+ *
+ * \retval    #INT_LIB_OK       Successful execution
+ * \retval    #INT_LIB_ERROR    Failure in execution
+ *
+ */
+static int32_t bench_parse_check_ac(const bench_ac_vector_t *PpsACVal)
+{
+    int32_t i4Status = (int32_t)INT_LIB_ERROR;
+    int32_t i4StatusCurr = (int32_t)INT_LIB_ERROR;
+    int32_t i4StatusPrev = (int32_t)INT_LIB_OK;
+    uint16_t wIndex = 0, wLen, wIDCount = 0;
+    uint16_t wVerificationOver = 0;
+    uint8_t bComplexAcOP = 0x00;
+    puint8_t prgbAccessCode;
+
+	// Remaining bytes of the access condition
+    #define REMAINING_BYTES (wLen - wIndex)
+
+    do
+    {
+        if((NULL == PpsACVal) || (NULL == PpsACVal->psMetaData)
+                    || (NULL == PpsACVal->psMetaData->prgbStream))
+        {
+            break;
+        }
+
+        wLen = PpsACVal->psMetaData->wLen;
+        prgbAccessCode = PpsACVal->psMetaData->prgbStream;
+
+        while(wIndex < wLen)
+        {
+            switch((eAccessConditionID_d)*(prgbAccessCode+wIndex))
+            {
+                case  eACID_ALW:
+                case  eACID_NEV:
+                    if((REMAINING_BYTES > 1) || (wIDCount > 0))
+                    {
+                        wVerificationOver = TRUE;
+                        break;
+                    }
+                    i4StatusCurr = INT_LIB_OK;
+                    if((uint8_t)eACID_NEV == *(prgbAccessCode+wIndex))
+                    {
+                        i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    }
+                    wIndex++;
+                    wIDCount++;
+                    break;
+
+                case  eACID_LCSO:
+                case  eACID_LCSA:
+                case  eACID_LCSG:
+                    //including access id
+                    if(REMAINING_BYTES < 3)
+                    {
+                        //because of invalid access coding
+                        wVerificationOver = TRUE;
+                        break;
+                    }
+
+                    i4StatusCurr = bench_parse_verify_lcsa_lcsg_lcso(PpsACVal, prgbAccessCode+wIndex, &wVerificationOver);
+                    if(TRUE == wVerificationOver)
+                    {
+                        //because of invalid access coding
+                        break;
+                    }
+
+                    wIndex+=3;
+                    wIDCount++;
+                    break;
+
+                default:
+                    //because of invalid access coding
+                    i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    wVerificationOver = TRUE;
+                    break;
+            }//switch
+
+            if(wVerificationOver)
+            {
+                break;
+            }
+
+            if(bComplexAcOP == (uint8_t)eOP_AND)
+            {
+                if(i4StatusCurr != i4StatusPrev)
+                {
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                }
+            }
+
+            if(wIndex == wLen)
+            {
+                break;
+            }
+
+            // for operator
+            if(REMAINING_BYTES < 3)
+            {
+                i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                //wVerificationOver = TRUE;
+                break;
+            }
+
+            bComplexAcOP = *(prgbAccessCode+wIndex);
+            switch(bComplexAcOP)
+            {
+                case  eOP_AND:
+                    i4StatusPrev = i4StatusCurr;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    break;
+
+                case  eOP_OR:
+                    i4StatusPrev = INT_LIB_OK;
+                    if(i4StatusCurr == INT_LIB_OK)
+                    {
+                        //Note: further validation not required
+                        //because the metadata itself is protected by checksum
+                        wVerificationOver = TRUE;
+                    }
+                    break;
+
+                default:
+                    //because of invalid access coding
+					i4StatusPrev = (int32_t)INT_LIB_ERROR;
+                    i4StatusCurr = (int32_t)INT_LIB_ERROR;
+                    wVerificationOver = TRUE;
+                    break;
+            }//switch
+
+            if(wVerificationOver)
+            {
+                break;
+            }
+
+            wIndex++;
+            wIDCount++; //indication of complex AC
+        }//while
+
+        if((i4StatusPrev == INT_LIB_OK) &&
+        (i4StatusCurr == INT_LIB_OK))
+        {
+            i4Status = INT_LIB_OK;
+        }
+
+    }while(0);
+
+    return i4Status;
+#undef REMAINING_BYTES
+}
+/**
+ *
+ * Verifies the requested access condition in the metadata.<br>
+ *
+ * \param[in]  PeMetaDataTag     Type of access condition
+ * \param[in]  PpsACVal         Pointer to metadata.
+ *
+ * \retval    #INT_LIB_OK       Successful execution
+ * \retval    #INT_LIB_ERROR    Failure in execution
+ *
+ */
+static int32_t bench_parse_verify_ac(eMetaDataTag_d PeMetaDataTag, bench_ac_vector_t *PpsACVal)
+{
+    int32_t i4Status  = (int32_t)INT_LIB_ERROR;
+    uint8_t bTagLocation = 0;
+    do
+    {
+        if((NULL == PpsACVal)||(NULL == PpsACVal->psMetaData)||
+            (NULL == PpsACVal->psMetaData->prgbStream))
+        {
+            i4Status = (int32_t)INT_LIB_NULL_PARAM;
+            break;
+        }
+
+        //get tag position of lcsO and read lcsO.
+        //LCO may not be found for all object.It is not an error
+        i4Status = bench_parse_get_tag_position(PpsACVal->psMetaData->prgbStream,(uint8_t)eLCSO,&bTagLocation);
+        if(INT_LIB_OK == i4Status && bTagLocation != PARSE_FAILURE)
+        {
+            //get the LcsO value from TLV
+            PpsACVal->bLcsO = (PpsACVal->psMetaData->prgbStream)[bTagLocation+2];
+        }
+        else
+        {
+            //LcsO not present
+            PpsACVal->bLcsO = 0x00;
+        }
+        //reset tag location
+        bTagLocation = 0;
+        //get tag position
+        i4Status = bench_parse_get_tag_position(PpsACVal->psMetaData->prgbStream,(uint8_t)PeMetaDataTag,&bTagLocation);
+        if((INT_LIB_OK != i4Status) || (PARSE_FAILURE == bTagLocation))
+        {
+			i4Status = (int32_t)INT_LIB_ERROR;
+            break;
+        }
+        //check access condition
+        PpsACVal->psMetaData->wLen = *(PpsACVal->psMetaData->prgbStream + (bTagLocation+POS_LEN));
+        PpsACVal->psMetaData->prgbStream += (bTagLocation+POS_VAL);
+
+        i4Status = bench_parse_check_ac(PpsACVal);
+    }while(FALSE);
+
+    return i4Status;
+}
+
+static uint32_t bench_random_state = 12345;
+static const uint8_t bench_lcs[] = {0x01, 0x03, 0x07, 0x0F};
+
+// The parser may read beyond the metadata, hence the rows are larger
+static uint8_t bench_timed_sets[BENCH_TIMED_SETS][64];
+static optiga_util_compiled_metadata_t bench_compiled[BENCH_TIMED_SETS];
+volatile int32_t bench_sink;
+
+static uint32_t bench_random(void)
+{
+    bench_random_state ^= bench_random_state << 13;
+    bench_random_state ^= bench_random_state >> 17;
+    bench_random_state ^= bench_random_state << 5;
+    return bench_random_state;
+}
+
+// Writes an access condition of at most max bytes, returns its length
+static uint8_t bench_make_ac(uint8_t * p_ac, uint8_t max)
+{
+    static const uint8_t identifier[] = {eACID_LCSA, eACID_LCSO, eACID_LCSG};
+    uint8_t groups = (uint8_t)(1 + (bench_random() % 3));
+    uint8_t length = 0;
+    uint8_t terms;
+    uint8_t group;
+    uint8_t term;
+
+    if ((0 == (bench_random() % 4)) || (max < 3))
+    {
+        p_ac[0] = (bench_random() % 3) ? eACID_ALW : eACID_NEV;
+        return 1;
+    }
+    for (group = 0; group < groups; group++)
+    {
+        terms = (uint8_t)(1 + (bench_random() % 2));
+        for (term = 0; term < terms; term++)
+        {
+            if ((length + 3 + (length ? 1 : 0)) > max)
+            {
+                return length;
+            }
+            if (length)
+            {
+                p_ac[length++] = (0 == term) ? eOP_OR : eOP_AND;
+            }
+            p_ac[length++] = identifier[bench_random() % 3];
+            p_ac[length++] = (uint8_t)(eOP_EQUAL + (bench_random() % 3));
+            p_ac[length++] = bench_lcs[bench_random() % 4];
+        }
+    }
+    return length;
+}
+
+// Writes metadata with optional LcsO, maximum size, used size and access conditions, mutated on request
+static void bench_make_metadata(uint8_t * p_metadata, uint8_t mutate)
+{
+    static const uint8_t ac_tag[] = {eCHANGE_AC, eREAD_AC, 0xD3};
+    static const uint8_t mutation[] = {eLCSO, eREAD_AC, eACID_NEV, eOP_AND, eOP_OR, eACID_LCSA, eACID_ALW};
+    uint8_t length = METADATA_HEADER_SIZE;
+    uint8_t mutations;
+    uint8_t index;
+
+    memset(p_metadata, 0x00, LENGTH_METADATA);
+    p_metadata[0] = 0x20;
+    if (bench_random() % 2)
+    {
+        p_metadata[length++] = eLCSO;
+        p_metadata[length++] = 0x01;
+        p_metadata[length++] = bench_lcs[bench_random() % 4];
+    }
+    if (bench_random() % 2)
+    {
+        p_metadata[length++] = 0xC4;
+        p_metadata[length++] = 0x02;
+        p_metadata[length++] = 0x06;
+        p_metadata[length++] = 0x40;
+    }
+    if (bench_random() % 2)
+    {
+        p_metadata[length++] = eUSED_SIZE;
+        p_metadata[length++] = 0x02;
+        p_metadata[length++] = (uint8_t)bench_random();
+        p_metadata[length++] = (uint8_t)bench_random();
+    }
+    // The read access condition is always present
+    for (index = 0; index < sizeof(ac_tag); index++)
+    {
+        if (((LENGTH_METADATA - length) < 3) || ((eREAD_AC != ac_tag[index]) && (bench_random() % 2)))
+        {
+            continue;
+        }
+        p_metadata[length] = ac_tag[index];
+        p_metadata[length + 1] = bench_make_ac(&p_metadata[length + 2], (uint8_t)(LENGTH_METADATA - length - 2));
+        length += (uint8_t)(2 + p_metadata[length + 1]);
+    }
+    p_metadata[OFFSET_TLV_LENGTH] = (uint8_t)(length - METADATA_HEADER_SIZE);
+
+    if (mutate)
+    {
+        mutations = (uint8_t)(1 + (bench_random() % 3));
+        while (mutations--)
+        {
+            switch (bench_random() % 4)
+            {
+                case 0:
+                    p_metadata[bench_random() % LENGTH_METADATA] = (uint8_t)bench_random();
+                    break;
+                case 1:
+                    p_metadata[OFFSET_TLV_LENGTH] = (uint8_t)(bench_random() % 30);
+                    break;
+                case 2:
+                    p_metadata[2 + (bench_random() % 26)] = mutation[bench_random() % sizeof(mutation)];
+                    break;
+                default:
+                    p_metadata[OFFSET_TLV_LENGTH] = (uint8_t)(bench_random() % (p_metadata[OFFSET_TLV_LENGTH] + 1));
+                    break;
+            }
+        }
+    }
+}
+
+// Checks the read access condition with the parser, the bytes after the metadata set to padding
+static uint8_t bench_parse(const uint8_t * p_metadata, uint8_t padding, uint8_t lcsa, uint8_t lcsg)
+{
+    uint8_t buffer[300];
+    uint16_t length = p_metadata[OFFSET_TLV_LENGTH] + METADATA_HEADER_SIZE;
+    sbBlob_d blob = {LENGTH_METADATA, buffer};
+    bench_ac_vector_t vector = {lcsa, lcsg, 0, &blob};
+
+    memset(buffer, padding, sizeof(buffer));
+    memcpy(buffer, p_metadata, (length < LENGTH_METADATA) ? length : LENGTH_METADATA);
+    return (INT_LIB_OK == bench_parse_verify_ac(eREAD_AC, &vector)) ? TRUE : FALSE;
+}
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec;
+}
+
+static void bench_compare(uint8_t mutate)
+{
+    uint8_t metadata[LENGTH_METADATA];
+    // Compiled from a buffer with bytes after the metadata, as read from OPTIGA into a larger buffer
+    uint8_t buffer[64];
+    optiga_util_compiled_metadata_t compiled;
+    uint32_t checks = 0;
+    uint32_t allowed = 0;
+    uint32_t mismatches = 0;
+    uint32_t skipped = 0;
+    uint32_t looser = 0;
+    uint32_t overflows = 0;
+    uint32_t set;
+    uint8_t pair;
+    uint8_t lcsa;
+    uint8_t lcsg;
+    uint8_t parsed;
+    uint8_t parsed_padded;
+    uint8_t checked;
+
+    for (set = 0; set < BENCH_SETS; set++)
+    {
+        bench_make_metadata(metadata, mutate);
+        memset(buffer, 0xA5, sizeof(buffer));
+        memcpy(buffer, metadata, LENGTH_METADATA);
+        __optiga_util_compile_metadata(buffer, &compiled);
+        if (compiled.read_ac_overflow)
+        {
+            // More alternatives than compiled, the checks are left to OPTIGA
+            overflows++;
+            continue;
+        }
+        for (pair = 0; pair < BENCH_PAIRS; pair++)
+        {
+            // All combinations of the usual states, then random states
+            lcsa = (pair < 16) ? bench_lcs[pair % 4] : (uint8_t)bench_random();
+            lcsg = (pair < 16) ? bench_lcs[pair / 4] : (uint8_t)bench_random();
+            parsed = bench_parse(metadata, 0x00, lcsa, lcsg);
+            parsed_padded = bench_parse(metadata, 0xFF, lcsa, lcsg);
+            checked = (INT_LIB_OK == __optiga_util_check_ac(&compiled, lcsa, lcsg)) ? TRUE : FALSE;
+            checks++;
+            allowed += checked;
+            if (parsed != parsed_padded)
+            {
+                skipped++;
+                if (checked && !(parsed && parsed_padded))
+                {
+                    looser++;
+                }
+            }
+            else if (parsed != checked)
+            {
+                mismatches++;
+            }
+        }
+    }
+    printf("%s metadata: %u checks, %u allowed, %u mismatches, %u skipped as they depend on bytes beyond the "
+           "metadata, %u of these allowed by the compiled check only, %u sets left to OPTIGA\n",
+           mutate ? "mutated" : "valid  ", checks, allowed, mismatches, skipped, looser, overflows);
+}
+
+static void bench_timing(void)
+{
+    sbBlob_d blob;
+    bench_ac_vector_t vector;
+    uint64_t start_ns;
+    uint64_t parse_ns;
+    uint64_t compile_ns;
+    uint64_t check_ns;
+    uint32_t set;
+    uint8_t round;
+    uint8_t pair;
+    double checks = (double)BENCH_TIMED_ROUNDS * BENCH_TIMED_SETS * 16;
+
+    for (set = 0; set < BENCH_TIMED_SETS; set++)
+    {
+        bench_make_metadata(bench_timed_sets[set], FALSE);
+    }
+
+    start_ns = bench_time_ns();
+    for (round = 0; round < BENCH_TIMED_ROUNDS; round++)
+    {
+        for (set = 0; set < BENCH_TIMED_SETS; set++)
+        {
+            for (pair = 0; pair < 16; pair++)
+            {
+                // The parser advances the blob to the access condition
+                blob.wLen = LENGTH_METADATA;
+                blob.prgbStream = bench_timed_sets[set];
+                vector.bLcsA = bench_lcs[pair % 4];
+                vector.bLcsG = bench_lcs[pair / 4];
+                vector.psMetaData = &blob;
+                bench_sink += bench_parse_verify_ac(eREAD_AC, &vector);
+            }
+        }
+    }
+    parse_ns = bench_time_ns() - start_ns;
+
+    start_ns = bench_time_ns();
+    for (round = 0; round < BENCH_TIMED_ROUNDS; round++)
+    {
+        for (set = 0; set < BENCH_TIMED_SETS; set++)
+        {
+            __optiga_util_compile_metadata(bench_timed_sets[set], &bench_compiled[set]);
+        }
+    }
+    compile_ns = bench_time_ns() - start_ns;
+
+    start_ns = bench_time_ns();
+    for (round = 0; round < BENCH_TIMED_ROUNDS; round++)
+    {
+        for (set = 0; set < BENCH_TIMED_SETS; set++)
+        {
+            for (pair = 0; pair < 16; pair++)
+            {
+                bench_sink += __optiga_util_check_ac(&bench_compiled[set], bench_lcs[pair % 4], bench_lcs[pair / 4]);
+            }
+        }
+    }
+    check_ns = bench_time_ns() - start_ns;
+
+    printf("parse per check  %6.1f ns per check\n", (double)parse_ns / checks);
+    printf("compile          %6.1f ns per metadata\n", (double)compile_ns / ((double)BENCH_TIMED_ROUNDS * BENCH_TIMED_SETS));
+    printf("compiled check   %6.1f ns per check\n", (double)check_ns / checks);
+    printf("compiled size    %u bytes, metadata cache entry %u bytes\n",
+           (unsigned int)sizeof(optiga_util_compiled_metadata_t), (unsigned int)sizeof(optiga_util_metadata_entry_t));
+}
+
+int main(void)
+{
+    bench_compare(FALSE);
+    bench_compare(TRUE);
+    bench_timing();
+    return 0;
+}
+
+/**
+* @}
+*/
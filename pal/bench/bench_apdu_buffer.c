@@ -0,0 +1,142 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_apdu_buffer.c
+*
+* \brief   Reports the heap allocations of the APDU buffer of the command library.
+*
+* The driver runs random number generation, reads of the UID and the device certificate, writes of 1500 bytes
+* to E0E1 and ECDSA signs on the simulated OPTIGA and reports the APDUs executed and
+* optiga_comms_t.apdu_buffer_allocations. The command library allocates the buffer of an instance once and reuses
+* it for every command. With the mode "provided", the application sets optiga_comms_t.p_apdu_buffer before the
+* open and no allocation is made.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_apdu_buffer [heap|provided] [calls]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+/// Length of the data written to E0E1
+#define BENCH_WRITE_LENGTH      (1500)
+
+/// APDU buffer of the mode "provided"
+static uint8_t bench_apdu_buffer[CMD_LIB_APDU_BUFFER_SIZE];
+
+// Runs one call of each command, returns the number of failed calls
+static uint32_t bench_calls(void)
+{
+    static uint8_t buffer[1728];
+    uint8_t digest[32] = {0};
+    uint16_t length;
+    uint32_t failed = 0;
+
+    if (OPTIGA_LIB_SUCCESS != optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, buffer, 32))
+    {
+        failed++;
+    }
+    length = sizeof(buffer);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, 0xE0C2, 0, buffer, &length))
+    {
+        failed++;
+    }
+    length = sizeof(buffer);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, 0xE0E0, 0, buffer, &length))
+    {
+        failed++;
+    }
+    memset(buffer, 0x5A, BENCH_WRITE_LENGTH);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_write_data(&optiga_comms, 0xE0E1, OPTIGA_UTIL_ERASE_AND_WRITE, 0,
+                                                     buffer, BENCH_WRITE_LENGTH))
+    {
+        failed++;
+    }
+    length = 80;
+    if (OPTIGA_LIB_SUCCESS != optiga_crypt_ecdsa_sign(&optiga_comms, digest, sizeof(digest),
+                                                      OPTIGA_KEY_STORE_ID_E0F0, buffer, &length))
+    {
+        failed++;
+    }
+    return failed;
+}
+
+int main(int argc, char ** argv)
+{
+    const char * mode = (argc > 1) ? argv[1] : "heap";
+    uint32_t calls = (argc > 2) ? (uint32_t)atoi(argv[2]) : 100;
+    uint32_t apdus;
+    uint32_t failed = 0;
+    uint32_t count;
+
+    if ((0 != strcmp(mode, "heap")) && (0 != strcmp(mode, "provided")))
+    {
+        printf("mode heap or provided\n");
+        return 1;
+    }
+    if (0 == calls)
+    {
+        printf("at least 1 call\n");
+        return 1;
+    }
+    pal_sim_set_virtual_time(TRUE);
+    if (0 == strcmp(mode, "provided"))
+    {
+        optiga_comms.p_apdu_buffer = bench_apdu_buffer;
+        optiga_comms.apdu_buffer_size = sizeof(bench_apdu_buffer);
+    }
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    printf("%-8s open: %u APDUs, %u allocations\n", mode, bench_apdus(), optiga_comms.apdu_buffer_allocations);
+
+    apdus = bench_apdus();
+    for (count = 0; count < calls; count++)
+    {
+        failed += bench_calls();
+    }
+    apdus = bench_apdus() - apdus;
+    printf("%-8s %u APDUs: %u allocations in total, buffer of %u bytes, failed %u\n", mode, apdus,
+           optiga_comms.apdu_buffer_allocations, optiga_comms.apdu_buffer_size, failed);
+    return 0;
+}
+
+/**
+* @}
+*/
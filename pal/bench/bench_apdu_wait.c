@@ -0,0 +1,127 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_apdu_wait.c
+*
+* \brief   Measures the CPU time per APDU of the command library waiting for optiga comms.
+*
+* The driver generates random numbers with #optiga_crypt_random, one GetRandom APDU each, on the simulated
+* OPTIGA in real time. The pal os event and lock of pal/linux are linked in place of the ones of the simulation,
+* so the ifx i2c stack runs in the event thread while the application thread waits in the command library as on
+* a Linux host. Built with #PAL_OS_HAS_EVENT_WAIT, the command library sleeps in #pal_os_event_wait until the
+* event handler of optiga comms is invoked, without it the comms status is spun on.
+*
+* Reported are the wall time per APDU, the CPU time per APDU of the waiting thread and of the process, which
+* includes the event thread running the stack and the simulated OPTIGA.
+*
+* Build as described in README.md, with SIM set to the sources of pal/sim except pal_os_event.c and
+* pal_os_lock.c, once with DEFS and once with PAL_OS_HAS_EVENT_WAIT removed from DEFS:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Ipal/linux -Iexternals/mbedtls-2.12.0/include $CORE $SIM
+*     pal/linux/pal_os_event.c pal/linux/pal_os_lock.c pal/bench/bench_common.c pal/bench/bench_apdu_wait.c
+*     build/mbedtls/libmbedtls.a -lpthread -o bench_apdu_wait
+* ./bench_apdu_wait [apdus]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+/// Length of the random number of an APDU
+#define BENCH_RANDOM_LENGTH     (32)
+
+// CPU time of the calling thread in microseconds
+static uint64_t bench_thread_cpu_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+int main(int argc, char ** argv)
+{
+    uint8_t random[BENCH_RANDOM_LENGTH];
+    uint32_t requested = (argc > 1) ? (uint32_t)atoi(argv[1]) : 500;
+    uint32_t apdus;
+    uint32_t errors = 0;
+    uint32_t count;
+    uint64_t start_us;
+    uint64_t wall_us;
+    uint64_t thread_cpu_us;
+    uint64_t cpu_us;
+
+    if (0 == requested)
+    {
+        printf("at least 1 APDU\n");
+        return 1;
+    }
+    pal_sim_set_virtual_time(FALSE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    apdus = bench_apdus();
+    thread_cpu_us = bench_thread_cpu_us();
+    cpu_us = bench_cpu_us();
+    start_us = bench_time_us();
+    for (count = 0; count < requested; count++)
+    {
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, random, sizeof(random)))
+        {
+            errors++;
+        }
+    }
+    wall_us = bench_time_us() - start_us;
+    cpu_us = bench_cpu_us() - cpu_us;
+    thread_cpu_us = bench_thread_cpu_us() - thread_cpu_us;
+    apdus = bench_apdus() - apdus;
+
+#ifdef PAL_OS_HAS_EVENT_WAIT
+    printf("wait  ");
+#else
+    printf("spin  ");
+#endif
+    printf("%u APDUs  wall %7.1f us/APDU  waiting thread cpu %7.1f us/APDU  process cpu %7.1f us/APDU  errors %u\n",
+           apdus, (double)wall_us / requested, (double)thread_cpu_us / requested, (double)cpu_us / requested,
+           errors);
+    return 0;
+}
+
+/**
+* @}
+*/
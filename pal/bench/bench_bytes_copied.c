@@ -0,0 +1,111 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_bytes_copied.c
+*
+* \brief   Reports the bytes copied by the host library per #optiga_util_read_data and #optiga_util_write_data call.
+*
+* The transport layer counts the bytes it copies between the caller buffers and the frame buffers in
+* ifx_i2c_context_t.tl.bytes_copied. Since the scatter-gather transceive this is the only copy of the data on the
+* way between the caller and the frame. Before, the command library copied the payload once more between the
+* caller buffer and its APDU buffer, which the transport layer then copied as it does now. The bytes copied
+* before the change are therefore the counted bytes plus the payload, and are printed next to the counted ones.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_bytes_copied
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+
+/// Data object written and read
+#define BENCH_OID               (0xE0E1)
+/// Largest payload
+#define BENCH_MAX_LENGTH        (1500)
+
+/// Payload lengths
+static const uint16_t bench_lengths[] = {27, 256, 1024, BENCH_MAX_LENGTH};
+
+static uint8_t bench_data[BENCH_MAX_LENGTH];
+
+static void bench_print(const char * p_name, uint16_t length, uint32_t copied, optiga_lib_status_t status)
+{
+    printf("%-5s %4u bytes: copied %5u (%.2f per byte), before %5u (%.2f per byte)%s\n", p_name, length,
+           copied, (double)copied / length, copied + length, (double)(copied + length) / length,
+           (OPTIGA_LIB_SUCCESS == status) ? "" : ", failed");
+}
+
+int main(void)
+{
+    uint8_t buffer[BENCH_MAX_LENGTH];
+    optiga_lib_status_t status;
+    uint32_t copied;
+    uint16_t length;
+    uint16_t index;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    for (index = 0; index < sizeof(bench_data); index++)
+    {
+        bench_data[index] = (uint8_t)((index * 11) + 3);
+    }
+
+    for (index = 0; index < sizeof(bench_lengths) / sizeof(bench_lengths[0]); index++)
+    {
+        copied = ifx_i2c_context_0.tl.bytes_copied;
+        status = optiga_util_write_data(&optiga_comms, BENCH_OID, OPTIGA_UTIL_ERASE_AND_WRITE, 0, bench_data,
+                                        bench_lengths[index]);
+        bench_print("write", bench_lengths[index], ifx_i2c_context_0.tl.bytes_copied - copied, status);
+
+        length = sizeof(buffer);
+        copied = ifx_i2c_context_0.tl.bytes_copied;
+        status = optiga_util_read_data(&optiga_comms, BENCH_OID, 0, buffer, &length);
+        if ((OPTIGA_LIB_SUCCESS == status) &&
+            ((bench_lengths[index] != length) || (0 != memcmp(buffer, bench_data, length))))
+        {
+            status = OPTIGA_LIB_ERROR;
+        }
+        bench_print("read", bench_lengths[index], ifx_i2c_context_0.tl.bytes_copied - copied, status);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,74 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_common.h
+*
+* \brief   This file provides the fixture shared by the benchmark drivers.
+*
+* bench_common.c defines the optiga comms instance of the drivers on #ifx_i2c_context_0 and the clocks. Built
+* with BENCH_LINUX_PAL, the helpers reading the statistics of the simulated OPTIGA are left out, so that a driver
+* can run on the Linux PAL.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _BENCH_COMMON_H_
+#define _BENCH_COMMON_H_
+
+#include "optiga/comms/optiga_comms.h"
+#include "optiga/ifx_i2c/ifx_i2c_config.h"
+#ifndef BENCH_LINUX_PAL
+#include "pal_sim.h"
+#endif
+
+#ifndef BENCH_LINUX_PAL
+/// The simulated OPTIGA behind #ifx_i2c_context_0
+extern pal_sim_t optiga_sim_0;
+
+/**
+ * \brief Returns the number of commands executed by the simulated OPTIGA so far.
+ */
+uint32_t bench_apdus(void);
+#endif
+
+/**
+ * \brief Returns the time of the monotonic clock in microseconds.
+ */
+uint64_t bench_time_us(void);
+
+/**
+ * \brief Returns the user and system CPU time of the process in microseconds.
+ */
+uint64_t bench_cpu_us(void);
+
+#endif /* _BENCH_COMMON_H_ */
+
+/**
+* @}
+*/
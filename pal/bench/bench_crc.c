@@ -0,0 +1,130 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_crc.c
+*
+* \brief   Measures the frame CRC of the data link layer with the backend selected by IFX_I2C_DL_CRC_BACKEND.
+*
+* The driver includes ifx_i2c_data_link_layer.c to reach #ifx_i2c_dl_calc_crc. It calculates the CRC over
+* buffers of the smallest and largest frame size and sizes in between, and reports the best time of several
+* rounds in nanoseconds per byte. The CRC of a fixed pattern is printed as well, it is the same for all backends.
+*
+* Build from the root of the repository as described in README.md, once per backend, with the data link layer
+* left out of CORE and SIM set to the sources of pal/sim:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -DIFX_I2C_DL_CRC_BACKEND=IFX_I2C_DL_CRC_SLICE_BY_8 -Ioptiga/include -Ipal/sim
+*     -Iexternals/mbedtls-2.12.0/include $CORE $SIM pal/bench/bench_crc.c build/mbedtls/libmbedtls.a
+*     -lpthread -o bench_crc
+* ./bench_crc [rounds]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "../../optiga/comms/ifx_i2c/ifx_i2c_data_link_layer.c"
+
+/// Bytes run through the CRC per buffer size and round
+#define BENCH_BYTES         (8UL * 1024 * 1024)
+
+/// Buffer sizes, from the smallest to the largest frame
+static const uint16_t bench_sizes[] = {DL_MIN_FRAME_SIZE, 64, 128, 256, DL_MAX_FRAME_SIZE};
+
+static const char * const bench_backend_name[] = {"bitwise", "table", "slice-by-8"};
+
+/// Keeps the CRC calculations from being optimized out
+static volatile uint16_t bench_sink;
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000) + (uint64_t)now.tv_nsec;
+}
+
+int main(int argc, char ** argv)
+{
+    static uint8_t buffer[DL_MAX_FRAME_SIZE];
+    uint32_t rounds = (argc > 1) ? (uint32_t)atoi(argv[1]) : 5;
+    uint32_t size_index;
+    uint32_t round;
+    uint32_t count;
+    uint32_t iterations;
+    uint64_t start_ns;
+    uint64_t best_ns;
+    uint64_t delta_ns;
+    uint16_t crc;
+    uint16_t index;
+
+    if (0 == rounds)
+    {
+        printf("at least 1 round\n");
+        return 1;
+    }
+    for (index = 0; index < sizeof(buffer); index++)
+    {
+        buffer[index] = (uint8_t)((index * 37) + 11);
+    }
+
+    printf("backend %s, CRC of the %u byte pattern 0x%04X\n", bench_backend_name[IFX_I2C_DL_CRC_BACKEND],
+           DL_MAX_FRAME_SIZE, ifx_i2c_dl_calc_crc(buffer, sizeof(buffer), NULL));
+    for (size_index = 0; size_index < sizeof(bench_sizes) / sizeof(bench_sizes[0]); size_index++)
+    {
+        iterations = BENCH_BYTES / bench_sizes[size_index];
+        best_ns = 0;
+        for (round = 0; round < rounds; round++)
+        {
+            crc = 0;
+            start_ns = bench_now_ns();
+            for (count = 0; count < iterations; count++)
+            {
+                // Chains the calculations, so that they can not overlap
+                buffer[0] = (uint8_t)crc;
+                crc = ifx_i2c_dl_calc_crc(buffer, bench_sizes[size_index], NULL);
+            }
+            delta_ns = bench_now_ns() - start_ns;
+            bench_sink = crc;
+            if ((0 == best_ns) || (delta_ns < best_ns))
+            {
+                best_ns = delta_ns;
+            }
+        }
+        printf("  %4u bytes  %6.3f ns/byte  %7.1f ns/frame  %7.1f MB/s\n", bench_sizes[size_index],
+               (double)best_ns / ((double)iterations * bench_sizes[size_index]), (double)best_ns / iterations,
+               ((double)iterations * bench_sizes[size_index] * 1000) / (double)best_ns);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,533 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_dtls_socket.c
+*
+* \brief   Runs the Linux UDP socket PAL against the DTLS server of the vendored mbedTLS on the loopback interface.
+*
+* The server runs in a thread of the driver, with the EC test certificate of mbedTLS. On the client side the
+* DTLS handshake is done by the OPTIGA firmware, which the simulated OPTIGA does not implement, hence the driver
+* sends the records the firmware produces itself: a ClientHello, the ClientHello with the cookie of the
+* HelloVerifyRequest, and a fatal alert once the server flight up to ServerHelloDone is received. The ClientHello
+* is resent when the server flight does not arrive within the timeout. This is done over IPv4 and IPv6. The
+* server rebinds its socket after the HelloVerifyRequest, so the first ClientHello with the cookie is mostly
+* lost and one resend per handshake is expected.
+*
+* Two more checks follow: the CPU time of a receive timeout without traffic, and a handshake flight of seven
+* records sent between two PAL sockets, which is expected to go out with one sendmmsg() and to be read back in
+* order with one recvmmsg(). The system calls are counted with the GNU linker option --wrap.
+*
+* Build from the root of the repository, with mbedTLS built as described in README.md:
+* \code
+* gcc -O2 -std=gnu99 -DMODULE_ENABLE_DTLS_MUTUAL_AUTH -Ioptiga/include -Iexternals/mbedtls-2.12.0/include
+*     pal/linux/pal_socket.c pal/linux/pal_os_timer.c pal/bench/bench_dtls_socket.c build/mbedtls/libmbedtls.a
+*     -Wl,--wrap=recvmmsg,--wrap=sendmmsg,--wrap=poll -lpthread -o bench_dtls_socket
+* ./bench_dtls_socket [rounds]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include "optiga/pal/pal_socket.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "mbedtls/net_sockets.h"
+#include "mbedtls/ssl.h"
+#include "mbedtls/ssl_cookie.h"
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/certs.h"
+#include "mbedtls/timing.h"
+
+/// Port of the DTLS server
+#define BENCH_SERVER_PORT       (4433)
+/// Port of the receive timeout check, nothing is sent to it
+#define BENCH_SILENT_PORT       (4499)
+/// Port of the flight check
+#define BENCH_FLIGHT_PORT       (4500)
+/// Number of records of the flight check
+#define BENCH_FLIGHT_RECORDS    (7)
+/// Resends of the ClientHello before a handshake is given up
+#define BENCH_MAX_RESENDS       (5)
+
+// DTLS record and handshake layout
+#define BENCH_RECORD_HEADER     (13)
+#define BENCH_HANDSHAKE_HEADER  (12)
+#define BENCH_CONTENT_ALERT     (0x15)
+#define BENCH_CONTENT_HANDSHAKE (0x16)
+#define BENCH_HELLO_VERIFY      (0x03)
+#define BENCH_SERVER_HELLO_DONE (0x0E)
+
+/// Calls of the batched socket functions, counted by the wrappers
+static uint32_t bench_recvmmsg_calls;
+static uint32_t bench_sendmmsg_calls;
+static uint32_t bench_poll_calls;
+
+int __real_recvmmsg(int fd, struct mmsghdr * p_msg, unsigned int count, int flags, struct timespec * p_timeout);
+int __real_sendmmsg(int fd, struct mmsghdr * p_msg, unsigned int count, int flags);
+int __real_poll(struct pollfd * p_fds, nfds_t count, int timeout);
+
+int __wrap_recvmmsg(int fd, struct mmsghdr * p_msg, unsigned int count, int flags, struct timespec * p_timeout)
+{
+    int received = __real_recvmmsg(fd, p_msg, count, flags, p_timeout);
+
+    if (received > 0)
+    {
+        bench_recvmmsg_calls++;
+    }
+    return received;
+}
+
+int __wrap_sendmmsg(int fd, struct mmsghdr * p_msg, unsigned int count, int flags)
+{
+    bench_sendmmsg_calls++;
+    return __real_sendmmsg(fd, p_msg, count, flags);
+}
+
+int __wrap_poll(struct pollfd * p_fds, nfds_t count, int timeout)
+{
+    bench_poll_calls++;
+    return __real_poll(p_fds, count, timeout);
+}
+
+/// DTLS server of the vendored mbedTLS
+typedef struct bench_server
+{
+    /// Address to bind to
+    const char * p_address;
+    /// Number of handshakes to serve
+    uint32_t rounds;
+    /// Set once the server is bound, cleared on failure
+    volatile uint32_t ready;
+    /// Set once the server failed or finished
+    volatile uint32_t done;
+    pthread_t thread;
+} bench_server_t;
+
+static uint64_t bench_cpu_us(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    return ((uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000) +
+           (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+static int bench_entropy(void * p_ctx, unsigned char * p_output, size_t length)
+{
+    (void)p_ctx;
+    while (length--)
+    {
+        p_output[length] = (unsigned char)rand();
+    }
+    return 0;
+}
+
+static void * bench_server_run(void * p_arg)
+{
+    bench_server_t * p_server = (bench_server_t *)p_arg;
+    mbedtls_net_context listener;
+    mbedtls_net_context client;
+    mbedtls_ssl_context ssl;
+    mbedtls_ssl_config config;
+    mbedtls_ssl_cookie_ctx cookie;
+    mbedtls_ctr_drbg_context drbg;
+    mbedtls_x509_crt certificate;
+    mbedtls_pk_context key;
+    mbedtls_timing_delay_context timer;
+    unsigned char client_ip[16];
+    size_t client_ip_length;
+    uint32_t round;
+    int status;
+
+    mbedtls_net_init(&listener);
+    mbedtls_net_init(&client);
+    mbedtls_ssl_init(&ssl);
+    mbedtls_ssl_config_init(&config);
+    mbedtls_ssl_cookie_init(&cookie);
+    mbedtls_ctr_drbg_init(&drbg);
+    mbedtls_x509_crt_init(&certificate);
+    mbedtls_pk_init(&key);
+
+    do
+    {
+        if ((0 != mbedtls_ctr_drbg_seed(&drbg, bench_entropy, NULL, NULL, 0)) ||
+            (0 != mbedtls_x509_crt_parse(&certificate, (const unsigned char *)mbedtls_test_srv_crt_ec,
+                                         mbedtls_test_srv_crt_ec_len)) ||
+            (0 != mbedtls_pk_parse_key(&key, (const unsigned char *)mbedtls_test_srv_key_ec,
+                                       mbedtls_test_srv_key_ec_len, NULL, 0)) ||
+            (0 != mbedtls_net_bind(&listener, p_server->p_address, "4433", MBEDTLS_NET_PROTO_UDP)) ||
+            (0 != mbedtls_ssl_config_defaults(&config, MBEDTLS_SSL_IS_SERVER, MBEDTLS_SSL_TRANSPORT_DATAGRAM,
+                                              MBEDTLS_SSL_PRESET_DEFAULT)))
+        {
+            break;
+        }
+        mbedtls_ssl_conf_rng(&config, mbedtls_ctr_drbg_random, &drbg);
+        mbedtls_ssl_conf_authmode(&config, MBEDTLS_SSL_VERIFY_OPTIONAL);
+        if ((0 != mbedtls_ssl_conf_own_cert(&config, &certificate, &key)) ||
+            (0 != mbedtls_ssl_cookie_setup(&cookie, mbedtls_ctr_drbg_random, &drbg)))
+        {
+            break;
+        }
+        mbedtls_ssl_conf_dtls_cookies(&config, mbedtls_ssl_cookie_write, mbedtls_ssl_cookie_check, &cookie);
+        if (0 != mbedtls_ssl_setup(&ssl, &config))
+        {
+            break;
+        }
+        mbedtls_ssl_set_timer_cb(&ssl, &timer, mbedtls_timing_set_delay, mbedtls_timing_get_delay);
+        p_server->ready = TRUE;
+
+        // Every handshake ends with the alert of the client, or with a new ClientHello after the cookie exchange
+        for (round = 0; round < (2 * p_server->rounds); round++)
+        {
+            mbedtls_net_free(&client);
+            mbedtls_ssl_session_reset(&ssl);
+            if (0 != mbedtls_net_accept(&listener, &client, client_ip, sizeof(client_ip), &client_ip_length))
+            {
+                break;
+            }
+            mbedtls_ssl_set_client_transport_id(&ssl, client_ip, client_ip_length);
+            mbedtls_ssl_set_bio(&ssl, &client, mbedtls_net_send, mbedtls_net_recv, mbedtls_net_recv_timeout);
+            do
+            {
+                status = mbedtls_ssl_handshake(&ssl);
+            } while ((MBEDTLS_ERR_SSL_WANT_READ == status) || (MBEDTLS_ERR_SSL_WANT_WRITE == status));
+        }
+    } while (FALSE);
+
+    mbedtls_net_free(&client);
+    mbedtls_net_free(&listener);
+    mbedtls_ssl_free(&ssl);
+    mbedtls_ssl_config_free(&config);
+    mbedtls_ssl_cookie_free(&cookie);
+    mbedtls_x509_crt_free(&certificate);
+    mbedtls_pk_free(&key);
+    mbedtls_ctr_drbg_free(&drbg);
+    p_server->done = TRUE;
+    return NULL;
+}
+
+// Builds a DTLS 1.2 record of the given content type and sequence number around p_body
+static uint32_t bench_record(uint8_t * p_record, uint8_t content_type, uint64_t sequence,
+                             const uint8_t * p_body, uint32_t length)
+{
+    uint32_t offset = 0;
+    int8_t shift;
+
+    p_record[offset++] = content_type;
+    p_record[offset++] = 0xFE;
+    p_record[offset++] = 0xFD;
+    // Epoch 0
+    p_record[offset++] = 0x00;
+    p_record[offset++] = 0x00;
+    for (shift = 40; shift >= 0; shift -= 8)
+    {
+        p_record[offset++] = (uint8_t)(sequence >> shift);
+    }
+    p_record[offset++] = (uint8_t)(length >> 8);
+    p_record[offset++] = (uint8_t)length;
+    memcpy(&p_record[offset], p_body, length);
+    return offset + length;
+}
+
+// Builds the record of a ClientHello offering TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8 on NIST P256, as the OPTIGA does
+static uint32_t bench_client_hello(uint8_t * p_record, uint64_t sequence, uint8_t message_sequence,
+                                   const uint8_t * p_cookie, uint8_t cookie_length)
+{
+    static const uint8_t suites_and_extensions[] =
+    {
+        // Cipher suites TLS_ECDHE_ECDSA_WITH_AES_128_CCM_8 and TLS_ECDHE_ECDSA_WITH_AES_128_GCM_SHA256
+        0x00, 0x04, 0xC0, 0xAE, 0xC0, 0x2B,
+        // Null compression
+        0x01, 0x00,
+        // Supported curves secp256r1, point formats uncompressed, signature algorithm ecdsa_secp256r1_sha256
+        0x00, 0x16,
+        0x00, 0x0A, 0x00, 0x04, 0x00, 0x02, 0x00, 0x17,
+        0x00, 0x0B, 0x00, 0x02, 0x01, 0x00,
+        0x00, 0x0D, 0x00, 0x04, 0x00, 0x02, 0x04, 0x03
+    };
+    uint8_t message[BENCH_HANDSHAKE_HEADER + 2 + 32 + 1 + 1 + 255 + sizeof(suites_and_extensions)];
+    uint8_t * p_body = &message[BENCH_HANDSHAKE_HEADER];
+    uint32_t length = 0;
+    uint32_t index;
+
+    p_body[length++] = 0xFE;
+    p_body[length++] = 0xFD;
+    for (index = 0; index < 32; index++)
+    {
+        p_body[length++] = (uint8_t)index;
+    }
+    // No session id
+    p_body[length++] = 0x00;
+    p_body[length++] = cookie_length;
+    memcpy(&p_body[length], p_cookie, cookie_length);
+    length += cookie_length;
+    memcpy(&p_body[length], suites_and_extensions, sizeof(suites_and_extensions));
+    length += sizeof(suites_and_extensions);
+
+    // Handshake header of an unfragmented ClientHello
+    memset(message, 0x00, BENCH_HANDSHAKE_HEADER);
+    message[0] = 0x01;
+    message[2] = (uint8_t)(length >> 8);
+    message[3] = (uint8_t)length;
+    message[5] = message_sequence;
+    message[10] = (uint8_t)(length >> 8);
+    message[11] = (uint8_t)length;
+    return bench_record(p_record, BENCH_CONTENT_HANDSHAKE, sequence, message, BENCH_HANDSHAKE_HEADER + length);
+}
+
+// Does one handshake up to ServerHelloDone, returns the number of server datagrams or 0 on failure
+static uint32_t bench_handshake(const char * p_address, uint32_t * p_resends)
+{
+    static const uint8_t alert[] = {0x02, 0x28};
+    pal_socket_t socket;
+    uint8_t record[512];
+    uint8_t datagram[1500];
+    uint8_t cookie[255];
+    uint8_t cookie_length;
+    uint32_t length;
+    uint32_t offset;
+    uint32_t datagrams = 0;
+    uint32_t resends = 0;
+    uint64_t sequence = 0;
+    uint8_t done = FALSE;
+    int32_t status;
+
+    socket.wPort = BENCH_SERVER_PORT;
+    socket.wTimeout = 2000;
+    socket.bMode = eNonBlock;
+    if ((E_COMMS_SUCCESS != pal_socket_assign_ip_address(p_address, &socket.sIPAddress)) ||
+        (E_COMMS_SUCCESS != pal_socket_init(&socket)))
+    {
+        return 0;
+    }
+
+    do
+    {
+        if (E_COMMS_SUCCESS != pal_socket_connect(&socket, BENCH_SERVER_PORT))
+        {
+            break;
+        }
+        length = sizeof(datagram);
+        if ((E_COMMS_SUCCESS != pal_socket_send(&socket, record, bench_client_hello(record, sequence++, 0, NULL, 0))) ||
+            (E_COMMS_SUCCESS != pal_socket_listen(&socket, datagram, &length)) ||
+            (length < BENCH_RECORD_HEADER + BENCH_HANDSHAKE_HEADER + 3) ||
+            (BENCH_HELLO_VERIFY != datagram[BENCH_RECORD_HEADER]))
+        {
+            break;
+        }
+        offset = BENCH_RECORD_HEADER + BENCH_HANDSHAKE_HEADER + 2;
+        cookie_length = datagram[offset];
+        if (offset + 1 + cookie_length > length)
+        {
+            break;
+        }
+        memcpy(cookie, &datagram[offset + 1], cookie_length);
+
+        socket.wTimeout = 400;
+        status = pal_socket_send(&socket, record, bench_client_hello(record, sequence++, 1, cookie, cookie_length));
+        while ((E_COMMS_SUCCESS == status) && (!done))
+        {
+            length = sizeof(datagram);
+            status = pal_socket_listen(&socket, datagram, &length);
+            if (((int32_t)E_COMMS_UDP_NO_DATA_RECEIVED == status) && (resends < BENCH_MAX_RESENDS))
+            {
+                resends++;
+                status = pal_socket_send(&socket, record,
+                                         bench_client_hello(record, sequence++, 1, cookie, cookie_length));
+                continue;
+            }
+            if (E_COMMS_SUCCESS != status)
+            {
+                break;
+            }
+            datagrams++;
+            for (offset = 0; offset + BENCH_RECORD_HEADER < length;
+                 offset += BENCH_RECORD_HEADER + ((datagram[offset + 11] << 8) | datagram[offset + 12]))
+            {
+                if ((BENCH_CONTENT_HANDSHAKE == datagram[offset]) &&
+                    (BENCH_SERVER_HELLO_DONE == datagram[offset + BENCH_RECORD_HEADER]))
+                {
+                    done = TRUE;
+                }
+            }
+        }
+        if (done)
+        {
+            // Ends the handshake at the server, which would otherwise wait for the client flight
+            (void)pal_socket_send(&socket, record,
+                                  bench_record(record, BENCH_CONTENT_ALERT, sequence++, alert, sizeof(alert)));
+            length = 0;
+            (void)pal_socket_listen(&socket, datagram, &length);
+        }
+    } while (FALSE);
+
+    pal_socket_close(&socket);
+    *p_resends += resends;
+    return done ? datagrams : 0;
+}
+
+static void bench_server_handshakes(const char * p_address, uint32_t rounds)
+{
+    bench_server_t server = {p_address, rounds, FALSE, FALSE, 0};
+    uint32_t recvmmsg_calls = bench_recvmmsg_calls;
+    uint32_t sendmmsg_calls = bench_sendmmsg_calls;
+    uint32_t poll_calls = bench_poll_calls;
+    uint32_t completed = 0;
+    uint32_t datagrams = 0;
+    uint32_t resends = 0;
+    uint32_t received;
+    uint32_t round;
+
+    pthread_create(&server.thread, NULL, bench_server_run, &server);
+    while ((!server.ready) && (!server.done))
+    {
+        pal_os_timer_delay_in_milliseconds(1);
+    }
+    if (!server.ready)
+    {
+        printf("%-10s server could not be started\n", p_address);
+        pthread_join(server.thread, NULL);
+        return;
+    }
+
+    for (round = 0; round < rounds; round++)
+    {
+        received = bench_handshake(p_address, &resends);
+        if (0 != received)
+        {
+            completed++;
+            datagrams += received;
+        }
+    }
+    pthread_join(server.thread, NULL);
+
+    printf("%-10s %u of %u handshakes, %u server datagrams, recvmmsg %u, sendmmsg %u, poll %u, resends %u\n",
+           p_address, completed, rounds, datagrams, bench_recvmmsg_calls - recvmmsg_calls,
+           bench_sendmmsg_calls - sendmmsg_calls, bench_poll_calls - poll_calls, resends);
+}
+
+static void bench_timeout(void)
+{
+    pal_socket_t socket;
+    uint8_t datagram[100];
+    uint32_t length = sizeof(datagram);
+    uint32_t start_ms;
+    uint64_t cpu_us;
+    int32_t status;
+
+    socket.wPort = BENCH_SILENT_PORT;
+    socket.wTimeout = 300;
+    socket.bMode = eNonBlock;
+    if ((E_COMMS_SUCCESS != pal_socket_assign_ip_address("127.0.0.1", &socket.sIPAddress)) ||
+        (E_COMMS_SUCCESS != pal_socket_init(&socket)) ||
+        (E_COMMS_SUCCESS != pal_socket_connect(&socket, BENCH_SILENT_PORT)))
+    {
+        printf("timeout    socket failed\n");
+        return;
+    }
+    cpu_us = bench_cpu_us();
+    start_ms = pal_os_timer_get_time_in_milliseconds();
+    status = pal_socket_listen(&socket, datagram, &length);
+    printf("timeout    status 0x%08X after %u ms, cpu %llu us\n", (unsigned int)status,
+           pal_os_timer_get_time_in_milliseconds() - start_ms, (unsigned long long)(bench_cpu_us() - cpu_us));
+    pal_socket_close(&socket);
+}
+
+static void bench_flight(void)
+{
+    pal_socket_t server;
+    pal_socket_t client;
+    uint8_t record[BENCH_FLIGHT_RECORDS + 100];
+    uint8_t datagram[1500];
+    uint32_t length;
+    uint32_t recvmmsg_calls;
+    uint32_t sendmmsg_calls;
+    uint32_t in_order = 0;
+    uint8_t index;
+
+    server.wPort = client.wPort = BENCH_FLIGHT_PORT;
+    server.wTimeout = client.wTimeout = 300;
+    server.bMode = client.bMode = eNonBlock;
+    if ((E_COMMS_SUCCESS != pal_socket_assign_ip_address("127.0.0.1", &server.sIPAddress)) ||
+        (E_COMMS_SUCCESS != pal_socket_assign_ip_address("127.0.0.1", &client.sIPAddress)) ||
+        (E_COMMS_SUCCESS != pal_socket_init(&server)) || (E_COMMS_SUCCESS != pal_socket_open(&server, BENCH_FLIGHT_PORT)) ||
+        (E_COMMS_SUCCESS != pal_socket_init(&client)) || (E_COMMS_SUCCESS != pal_socket_connect(&client, BENCH_FLIGHT_PORT)))
+    {
+        printf("flight     sockets failed\n");
+        return;
+    }
+
+    recvmmsg_calls = bench_recvmmsg_calls;
+    sendmmsg_calls = bench_sendmmsg_calls;
+    memset(record, 0x00, sizeof(record));
+    record[0] = BENCH_CONTENT_HANDSHAKE;
+    for (index = 0; index < BENCH_FLIGHT_RECORDS; index++)
+    {
+        record[1] = index;
+        (void)pal_socket_send(&client, record, 100 + index);
+    }
+    // The flight is queued until the client waits for the answer, which times out
+    length = sizeof(datagram);
+    (void)pal_socket_listen(&client, datagram, &length);
+    for (index = 0; index < BENCH_FLIGHT_RECORDS; index++)
+    {
+        length = sizeof(datagram);
+        if ((E_COMMS_SUCCESS == pal_socket_listen(&server, datagram, &length)) &&
+            ((100U + index) == length) && (index == datagram[1]))
+        {
+            in_order++;
+        }
+    }
+    printf("flight     %u records, sendmmsg %u, %u received in order, recvmmsg %u\n", BENCH_FLIGHT_RECORDS,
+           bench_sendmmsg_calls - sendmmsg_calls, in_order, bench_recvmmsg_calls - recvmmsg_calls);
+    pal_socket_close(&server);
+    pal_socket_close(&client);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t rounds = (argc > 1) ? (uint32_t)atoi(argv[1]) : 20;
+
+    bench_server_handshakes("127.0.0.1", rounds);
+    bench_server_handshakes("::1", rounds);
+    bench_timeout();
+    bench_flight();
+    return 0;
+}
+
+/**
+* @}
+*/
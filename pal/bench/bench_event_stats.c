@@ -0,0 +1,143 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_event_stats.c
+*
+* \brief   Reports the statistics of the pal os event thread of the Linux PAL.
+*
+* The driver signs with the key in E0F0 on the simulated OPTIGA in real time, with the pal os event and lock of
+* pal/linux linked in place of the ones of the simulation, so the ifx i2c stack runs its timers in the event
+* thread of #pal_os_event_register_callback_oneshot. After the signs, #pal_os_event_get_stats gives the callbacks
+* run per APDU and their delay after the requested expiry.
+*
+* The driver then registers timers for more callback contexts than the event thread has slots, as done by more
+* ifx i2c instances than PAL_OS_EVENT_MAX_INSTANCES, and reports the callbacks run and dropped.
+*
+* Build as described in README.md, with SIM set to the sources of pal/sim except pal_os_event.c and
+* pal_os_lock.c:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Ipal/linux -Iexternals/mbedtls-2.12.0/include $CORE $SIM
+*     pal/linux/pal_os_event.c pal/linux/pal_os_lock.c pal/bench/bench_common.c pal/bench/bench_event_stats.c
+*     build/mbedtls/libmbedtls.a -lpthread -o bench_event_stats
+* ./bench_event_stats [apdus] [contexts]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "bench_common.h"
+#include "pal_linux.h"
+
+/// Delay of the timers registered for the callback contexts, in microseconds
+#define BENCH_TIMER_US          (2000)
+/// Largest number of callback contexts
+#define BENCH_MAX_CONTEXTS      (64)
+
+/// Number of timer callbacks run
+static volatile uint32_t bench_timer_callbacks;
+
+static void bench_timer_callback(void * p_ctx)
+{
+    (void)p_ctx;
+    __sync_fetch_and_add(&bench_timer_callbacks, 1);
+}
+
+static void bench_print_stats(const char * name, uint32_t apdus)
+{
+    pal_os_event_stats_t stats;
+
+    pal_os_event_get_stats(&stats);
+    printf("%-8s %5u callbacks", name, stats.callbacks);
+    if (0 != apdus)
+    {
+        printf(" (%4.1f per APDU)", (double)stats.callbacks / apdus);
+    }
+    printf("  dropped %u  delay min %u avg %.1f max %u us\n", stats.dropped, stats.min_latency_us,
+           (0 == stats.callbacks) ? 0.0 : (double)stats.total_latency_us / stats.callbacks, stats.max_latency_us);
+}
+
+int main(int argc, char ** argv)
+{
+    static uint8_t contexts[BENCH_MAX_CONTEXTS];
+    uint8_t digest[32] = {0};
+    uint8_t signature[80];
+    uint16_t length;
+    uint32_t requested = (argc > 1) ? (uint32_t)atoi(argv[1]) : 200;
+    uint32_t context_count = (argc > 2) ? (uint32_t)atoi(argv[2]) : 8;
+    uint32_t apdus;
+    uint32_t errors = 0;
+    uint32_t count;
+
+    if ((0 == requested) || (0 == context_count) || (context_count > BENCH_MAX_CONTEXTS))
+    {
+        printf("at least 1 APDU and 1 to %u contexts\n", BENCH_MAX_CONTEXTS);
+        return 1;
+    }
+    pal_sim_set_virtual_time(FALSE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    bench_print_stats("open", 0);
+
+    pal_os_event_reset_stats();
+    apdus = bench_apdus();
+    for (count = 0; count < requested; count++)
+    {
+        length = sizeof(signature);
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_ecdsa_sign(&optiga_comms, digest, sizeof(digest),
+                                                          OPTIGA_KEY_STORE_ID_E0F0, signature, &length))
+        {
+            errors++;
+        }
+    }
+    apdus = bench_apdus() - apdus;
+    bench_print_stats("sign", apdus);
+    printf("sign errors %u\n", errors);
+
+    pal_os_event_reset_stats();
+    for (count = 0; count < context_count; count++)
+    {
+        pal_os_event_register_callback_oneshot(bench_timer_callback, &contexts[count], BENCH_TIMER_US);
+    }
+    pal_os_timer_delay_in_milliseconds(5 * (BENCH_TIMER_US / 1000));
+    bench_print_stats("contexts", 0);
+    printf("%u contexts registered, %u timer callbacks run\n", context_count, bench_timer_callbacks);
+    return 0;
+}
+
+/**
+* @}
+*/
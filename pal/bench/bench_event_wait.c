@@ -0,0 +1,165 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_event_wait.c
+*
+* \brief   Compares the ways the command library waits for the completion of an APDU, on the Linux PAL.
+*
+* The completion is modelled by a pal os event callback which sets the status after the command latency, as
+* the ifx i2c stack does from the event thread. The caller waits for it in one of three ways:
+* - spin: polls the status, as the command library without #PAL_OS_HAS_EVENT_WAIT.
+* - delay: polls the status every millisecond, as the command library with USE_CMDLIB_WITH_RTOS.
+* - wait: sleeps in #pal_os_event_wait.
+* For each, the CPU time of the process and the time from the completion to the return of the wait are
+* reported per APDU.
+*
+* Build from the root of the repository:
+* \code
+* gcc -O2 -std=gnu99 -DPAL_OS_HAS_EVENT_WAIT -DPAL_OS_HAS_EVENT_INIT -Ioptiga/include -Ipal/linux pal/linux/pal_os_event.c pal/linux/pal_os_timer.c
+*     pal/bench/bench_event_wait.c -lpthread -o bench_event_wait
+* ./bench_event_wait [apdus] [latency_us]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "optiga/comms/optiga_comms.h"
+#include "pal_linux.h"
+
+#ifndef PAL_OS_HAS_EVENT_WAIT
+#error "The benchmark compares against pal_os_event_wait, define PAL_OS_HAS_EVENT_WAIT"
+#endif
+
+#define BENCH_MODE_SPIN     (0)
+#define BENCH_MODE_DELAY    (1)
+#define BENCH_MODE_WAIT     (2)
+
+static const char * const bench_mode_name[] = {"spin", "delay", "wait"};
+
+/// Completion status of the modelled APDU
+static volatile uint32_t bench_status;
+/// Time the modelled APDU completed, in microseconds
+static volatile uint64_t bench_completed_us;
+
+static uint64_t bench_now_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000) + ((uint64_t)now.tv_nsec / 1000);
+}
+
+static uint64_t bench_cpu_us(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+    return ((uint64_t)(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000) +
+           (uint64_t)(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+}
+
+// Runs in the event thread, as the event handler of the ifx i2c stack
+static void bench_complete(void * p_ctx)
+{
+    (void)p_ctx;
+    bench_completed_us = bench_now_us();
+    pal_os_event_notify(&bench_status, OPTIGA_COMMS_SUCCESS);
+}
+
+static void bench_run(uint8_t mode, uint32_t apdus, uint32_t latency_us)
+{
+    uint64_t cpu_us = bench_cpu_us();
+    uint64_t start_us = bench_now_us();
+    uint64_t wake_us = 0;
+    uint64_t max_wake_us = 0;
+    uint64_t delta_us;
+    uint32_t count;
+
+    for (count = 0; count < apdus; count++)
+    {
+        bench_status = OPTIGA_COMMS_BUSY;
+        pal_os_event_register_callback_oneshot(bench_complete, NULL, latency_us);
+        switch (mode)
+        {
+            case BENCH_MODE_SPIN:
+                while (OPTIGA_COMMS_BUSY == bench_status)
+                {
+                }
+                break;
+            case BENCH_MODE_DELAY:
+                while (OPTIGA_COMMS_BUSY == bench_status)
+                {
+                    pal_os_timer_delay_in_milliseconds(1);
+                }
+                break;
+            default:
+                pal_os_event_wait(&bench_status, OPTIGA_COMMS_BUSY);
+                break;
+        }
+        delta_us = bench_now_us() - bench_completed_us;
+        wake_us += delta_us;
+        if (delta_us > max_wake_us)
+        {
+            max_wake_us = delta_us;
+        }
+    }
+
+    printf("%-6s %6u APDUs  wall %8.1f us/APDU  cpu %7.1f us/APDU  wake %7.1f us avg %7llu us max\n",
+           bench_mode_name[mode], apdus, (double)(bench_now_us() - start_us) / apdus,
+           (double)(bench_cpu_us() - cpu_us) / apdus, (double)wake_us / apdus, (unsigned long long)max_wake_us);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t apdus = (argc > 1) ? (uint32_t)atoi(argv[1]) : 500;
+    uint32_t latency_us = (argc > 2) ? (uint32_t)atoi(argv[2]) : 2000;
+    uint8_t mode;
+
+    if (PAL_STATUS_SUCCESS != pal_os_event_init())
+    {
+        printf("pal_os_event_init failed\n");
+        return 1;
+    }
+    printf("command latency %u us\n", latency_us);
+    for (mode = BENCH_MODE_SPIN; mode <= BENCH_MODE_WAIT; mode++)
+    {
+        bench_run(mode, apdus, latency_us);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
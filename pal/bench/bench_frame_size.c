@@ -0,0 +1,157 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_frame_size.c
+*
+* \brief   Measures the throughput of certificate sized reads and writes for a range of frame sizes.
+*
+* For each frame size the host state is started over and the OPTIGA is opened with that frame size requested,
+* a size of 0 requests the largest frame of the arena which the OPTIGA limits to its DATA_REG_LEN. Then 1 KB
+* and 1.7 KB are written to 0xE0E1 with #optiga_util_write_data and read back with #optiga_util_read_data.
+* Reported are the bytes per second of the simulated device time and the host CPU time per KB, which includes
+* the simulation. The host time changes with IFX_I2C_DL_CRC_FUSED_COPY, build with -DIFX_I2C_DL_CRC_FUSED_COPY=0
+* to copy the received frames after the CRC check instead of in the same pass.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_frame_size [transfers]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+
+/// Data object written and read
+#define BENCH_OID               (0xE0E1)
+/// Largest transfer
+#define BENCH_MAX_LENGTH        (1700)
+
+/// Requested frame sizes, 0 for the largest
+static const uint16_t bench_frame_sizes[] = {DL_MIN_FRAME_SIZE, 32, 64, 128, 0};
+/// Transfer lengths
+static const uint16_t bench_lengths[] = {1024, BENCH_MAX_LENGTH};
+
+static uint8_t bench_data[BENCH_MAX_LENGTH];
+
+/// Host state before the first open
+static ifx_i2c_context_t bench_initial_context;
+
+// Bytes per second of the simulated device time
+static double bench_rate(uint64_t bytes, uint64_t time_us)
+{
+    return (0 == time_us) ? 0 : ((double)bytes * 1000000) / (double)time_us;
+}
+
+int main(int argc, char ** argv)
+{
+    uint8_t buffer[BENCH_MAX_LENGTH];
+    uint32_t transfers = (argc > 1) ? (uint32_t)atoi(argv[1]) : 20;
+    uint32_t size_index;
+    uint32_t length_index;
+    uint32_t count;
+    uint32_t errors;
+    uint64_t start_us;
+    uint64_t read_us;
+    uint64_t write_us;
+    uint64_t cpu_us;
+    uint64_t bytes;
+    uint16_t length;
+    uint16_t index;
+
+    if (0 == transfers)
+    {
+        printf("at least 1 transfer\n");
+        return 1;
+    }
+    pal_sim_set_virtual_time(TRUE);
+    bench_initial_context = ifx_i2c_context_0;
+    for (index = 0; index < sizeof(bench_data); index++)
+    {
+        bench_data[index] = (uint8_t)((index * 13) + 5);
+    }
+
+    printf("IFX_I2C_DL_CRC_FUSED_COPY %u, %u transfers of each length\n", IFX_I2C_DL_CRC_FUSED_COPY, transfers);
+    for (size_index = 0; size_index < sizeof(bench_frame_sizes) / sizeof(bench_frame_sizes[0]); size_index++)
+    {
+        // Starts over as a new process would, the open resets the OPTIGA and negotiates the frame size
+        ifx_i2c_context_0 = bench_initial_context;
+        ifx_i2c_context_0.frame_size = bench_frame_sizes[size_index];
+        optiga_comms.max_comms_buffer = 0;
+        if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+        {
+            printf("optiga_util_open_application failed\n");
+            return 1;
+        }
+
+        printf("frame %3u:", ifx_i2c_context_0.frame_size);
+        errors = 0;
+        bytes = 0;
+        cpu_us = bench_cpu_us();
+        for (length_index = 0; length_index < sizeof(bench_lengths) / sizeof(bench_lengths[0]); length_index++)
+        {
+            write_us = 0;
+            read_us = 0;
+            for (count = 0; count < transfers; count++)
+            {
+                start_us = pal_sim_get_time_us();
+                if (OPTIGA_LIB_SUCCESS != optiga_util_write_data(&optiga_comms, BENCH_OID, OPTIGA_UTIL_ERASE_AND_WRITE,
+                                                                 0, bench_data, bench_lengths[length_index]))
+                {
+                    errors++;
+                }
+                write_us += pal_sim_get_time_us() - start_us;
+
+                length = sizeof(buffer);
+                start_us = pal_sim_get_time_us();
+                if ((OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, BENCH_OID, 0, buffer, &length)) ||
+                    (bench_lengths[length_index] != length) || (0 != memcmp(buffer, bench_data, length)))
+                {
+                    errors++;
+                }
+                read_us += pal_sim_get_time_us() - start_us;
+            }
+            bytes += 2 * (uint64_t)transfers * bench_lengths[length_index];
+            printf("  %4u B read %6.0f B/s write %6.0f B/s", bench_lengths[length_index],
+                   bench_rate((uint64_t)transfers * bench_lengths[length_index], read_us),
+                   bench_rate((uint64_t)transfers * bench_lengths[length_index], write_us));
+        }
+        cpu_us = bench_cpu_us() - cpu_us;
+        printf("  host %5.1f us/KB  errors %u\n", ((double)cpu_us * 1024) / (double)bytes, errors);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
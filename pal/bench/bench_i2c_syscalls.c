@@ -0,0 +1,118 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_i2c_syscalls.c
+*
+* \brief   Reports the system calls per APDU of the Linux I2C PAL, with and without combined transfers.
+*
+* The driver generates random numbers with #optiga_crypt_random on an OPTIGA attached to the Linux PAL, first
+* with pal_linux_t.combined_transfers set, so that a register address write and the register read are one
+* I2C_RDWR ioctl, then with separate write and read calls. For each, the statistics of the bus give the system
+* calls, the combined transfers, the retried and the failed transfers per APDU, next to the wall time per APDU.
+*
+* Build from the root of the repository, with CORE and DEFS as described in README.md and an OPTIGA on the
+* I2C bus and GPIOs of pal_ifx_i2c_config.c:
+* \code
+* LINUX="pal/linux/pal.c pal/linux/pal_gpio.c pal/linux/pal_i2c.c pal/linux/pal_ifx_i2c_config.c
+*        pal/linux/pal_os_datastore.c pal/linux/pal_os_event.c pal/linux/pal_os_lock.c pal/linux/pal_os_timer.c"
+* gcc -O2 -std=gnu99 $DEFS -DBENCH_LINUX_PAL -Ioptiga/include -Ipal/linux $CORE $LINUX pal/bench/bench_common.c
+*     pal/bench/bench_i2c_syscalls.c -lpthread -o bench_i2c_syscalls
+* ./bench_i2c_syscalls [apdus]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+#include "pal_linux.h"
+
+/// Length of the random number of an APDU
+#define BENCH_RANDOM_LENGTH     (32)
+
+/// The I2C bus of the OPTIGA, defined in pal_ifx_i2c_config.c
+extern pal_linux_t linux_events;
+
+static void bench_run(uint8_t combined, uint32_t requested)
+{
+    uint8_t random[BENCH_RANDOM_LENGTH];
+    uint32_t failed = 0;
+    uint32_t count;
+    uint64_t start_us;
+    uint64_t wall_us;
+
+    linux_events.combined_transfers = combined;
+    linux_events.stats = (pal_linux_i2c_stats_t){0};
+    start_us = bench_time_us();
+    for (count = 0; count < requested; count++)
+    {
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, random, sizeof(random)))
+        {
+            failed++;
+        }
+    }
+    wall_us = bench_time_us() - start_us;
+    printf("%-9s %u APDUs: %5.1f syscalls %5.1f combined %5.2f retries %5.2f errors %7.1f us per APDU, failed %u\n",
+           combined ? "combined" : "separate", requested,
+           (double)linux_events.stats.syscalls / requested, (double)linux_events.stats.combined / requested,
+           (double)linux_events.stats.retries / requested, (double)linux_events.stats.errors / requested,
+           (double)wall_us / requested, failed);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t requested = (argc > 1) ? (uint32_t)atoi(argv[1]) : 500;
+
+    if (0 == requested)
+    {
+        printf("at least 1 APDU\n");
+        return 1;
+    }
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    printf("open: %u syscalls, %u combined, %u retries, %u errors\n", linux_events.stats.syscalls,
+           linux_events.stats.combined, linux_events.stats.retries, linux_events.stats.errors);
+
+#ifndef PAL_I2C_HAS_WRITE_READ
+    printf("PAL_I2C_HAS_WRITE_READ not defined, register reads are never combined\n");
+#endif
+    bench_run(TRUE, requested);
+    bench_run(FALSE, requested);
+    return 0;
+}
+
+/**
+* @}
+*/
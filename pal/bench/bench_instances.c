@@ -0,0 +1,175 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_instances.c
+*
+* \brief   Measures the ECDSA sign throughput of one and two OPTIGAs driven concurrently through their own contexts.
+*
+* A second simulated OPTIGA is set up with its own pal i2c and gpio contexts, ifx i2c context, frame arena and
+* optiga comms instance, as an application using two devices on two buses would. Each thread signs with the key in
+* E0F0 using #optiga_crypt_ecdsa_sign on the instance it is given, the simulated OPTIGAs run in real time.
+* The runs are one thread on one OPTIGA, two threads sharing one OPTIGA, which the command library serializes,
+* and one thread per OPTIGA. Reported are the signs per second of each run and the scaling against the first.
+*
+* The pal os event and lock of pal/linux are linked in place of the ones of the simulation, which are not thread
+* safe. The callbacks of both instances then run in the single event thread, which also sleeps for the simulated
+* bus time of the transfers it issues, so the bus time of the instances does not overlap.
+*
+* Build as described in README.md, with SIM set to the sources of pal/sim except pal_os_event.c and
+* pal_os_lock.c:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Ipal/linux -Iexternals/mbedtls-2.12.0/include $CORE $SIM
+*     pal/linux/pal_os_event.c pal/linux/pal_os_lock.c pal/bench/bench_common.c pal/bench/bench_instances.c
+*     build/mbedtls/libmbedtls.a -lpthread -o bench_instances
+* ./bench_instances [signs]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+/// Threads of a run
+#define BENCH_MAX_THREADS       (2)
+
+/// Second simulated OPTIGA, with its own keys
+static pal_sim_t bench_sim_1 = {.seed = 1};
+static pal_sim_pin_t bench_sim_vdd_1 = {&bench_sim_1, PAL_SIM_PIN_VDD};
+static pal_sim_pin_t bench_sim_reset_1 = {&bench_sim_1, PAL_SIM_PIN_RESET};
+static pal_gpio_t bench_vdd_1 = {(void *)&bench_sim_vdd_1};
+static pal_gpio_t bench_reset_1 = {(void *)&bench_sim_reset_1};
+static pal_i2c_t bench_pal_i2c_1 = {.p_i2c_hw_config = (void *)&bench_sim_1,
+                                    .slave_address = PAL_SIM_DEFAULT_SLAVE_ADDRESS};
+static uint8_t bench_frame_arena_1[IFX_I2C_FRAME_ARENA_SIZE(DL_MAX_FRAME_SIZE)];
+static ifx_i2c_context_t bench_ifx_i2c_context_1;
+static optiga_comms_t bench_comms_1 = {.comms_ctx = (void *)&bench_ifx_i2c_context_1};
+
+/// A signing thread
+typedef struct bench_thread
+{
+    pthread_t thread;
+    /// Instance the thread signs with
+    optiga_comms_t * p_comms;
+    /// Number of signs
+    uint32_t signs;
+    /// Number of failed signs
+    uint32_t errors;
+} bench_thread_t;
+
+static void * bench_signer(void * p_arg)
+{
+    bench_thread_t * p_thread = (bench_thread_t *)p_arg;
+    uint8_t digest[32] = {0};
+    uint8_t signature[80];
+    uint16_t signature_length;
+    uint32_t count;
+
+    for (count = 0; count < p_thread->signs; count++)
+    {
+        digest[0] = (uint8_t)count;
+        signature_length = sizeof(signature);
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_ecdsa_sign(p_thread->p_comms, digest, sizeof(digest),
+                                                          OPTIGA_KEY_STORE_ID_E0F0, signature, &signature_length))
+        {
+            p_thread->errors++;
+        }
+    }
+    return NULL;
+}
+
+// Runs one thread per instance in p_comms and returns the signs per second
+static double bench_run(const char * p_name, optiga_comms_t * const * p_comms, uint32_t threads, uint32_t signs,
+                        double reference)
+{
+    bench_thread_t thread[BENCH_MAX_THREADS] = {{0}};
+    uint64_t start_us = bench_time_us();
+    uint32_t errors = 0;
+    uint32_t index;
+    double rate;
+
+    for (index = 0; index < threads; index++)
+    {
+        thread[index].p_comms = p_comms[index];
+        thread[index].signs = signs;
+        pthread_create(&thread[index].thread, NULL, bench_signer, &thread[index]);
+    }
+    for (index = 0; index < threads; index++)
+    {
+        pthread_join(thread[index].thread, NULL);
+        errors += thread[index].errors;
+    }
+    rate = ((double)threads * signs * 1000000) / (double)(bench_time_us() - start_us);
+    printf("%-28s %4u signs %7.1f signs/s  scaling %.2f  errors %u\n", p_name, threads * signs, rate,
+           (0 == reference) ? 1.0 : rate / reference, errors);
+    return rate;
+}
+
+int main(int argc, char ** argv)
+{
+    optiga_comms_t * const one[BENCH_MAX_THREADS] = {&optiga_comms, NULL};
+    optiga_comms_t * const shared[BENCH_MAX_THREADS] = {&optiga_comms, &optiga_comms};
+    optiga_comms_t * const both[BENCH_MAX_THREADS] = {&optiga_comms, &bench_comms_1};
+    uint32_t signs = (argc > 1) ? (uint32_t)atoi(argv[1]) : 50;
+    double reference;
+
+    if (0 == signs)
+    {
+        printf("at least 1 sign\n");
+        return 1;
+    }
+    // Same configuration as instance 0, on the second bus
+    bench_ifx_i2c_context_1 = ifx_i2c_context_0;
+    bench_ifx_i2c_context_1.p_slave_vdd_pin = &bench_vdd_1;
+    bench_ifx_i2c_context_1.p_slave_reset_pin = &bench_reset_1;
+    bench_ifx_i2c_context_1.p_pal_i2c_ctx = &bench_pal_i2c_1;
+    bench_ifx_i2c_context_1.p_frame_arena = bench_frame_arena_1;
+    bench_ifx_i2c_context_1.frame_arena_size = sizeof(bench_frame_arena_1);
+
+    pal_sim_set_virtual_time(FALSE);
+    if ((OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms)) ||
+        (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&bench_comms_1)))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    reference = bench_run("one OPTIGA, one thread", one, 1, signs, 0);
+    bench_run("one OPTIGA, two threads", shared, 2, signs, reference);
+    bench_run("two OPTIGAs, one thread each", both, 2, signs, reference);
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,159 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_lock.c
+*
+* \brief   Measures threads contending for one OPTIGA through the command library.
+*
+* Each thread reads the coprocessor UID with #optiga_util_read_data. The simulated OPTIGA runs in real time,
+* so a thread holds the OPTIGA for the real duration of its APDU while the others wait in the queue of the
+* Linux pal os lock, see #pal_os_lock_acquire_flag. The lock is linked in place of the one of the simulation,
+* which is safe because only the thread holding the OPTIGA runs its callbacks.
+*
+* Reported are the wall and CPU time of the run, the lock statistics and the mean and longest read per thread.
+* With a second argument, thread 0 waits in #PAL_OS_LOCK_PRIORITY_HIGH.
+*
+* Build as described in README.md, with SIM set to the sources of pal/sim except pal_os_lock.c:
+* \code
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Ipal/linux -Iexternals/mbedtls-2.12.0/include $CORE $SIM
+*     pal/linux/pal_os_lock.c pal/bench/bench_common.c pal/bench/bench_lock.c build/mbedtls/libmbedtls.a
+*     -lpthread -o bench_lock
+* ./bench_lock [threads] [priority]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+#include "pal_linux.h"
+
+/// Number of reads per thread
+#define BENCH_READS         (20)
+/// Largest number of threads
+#define BENCH_MAX_THREADS   (16)
+
+/// A contending thread
+typedef struct bench_thread
+{
+    pthread_t thread;
+    /// Priority class of the thread
+    uint8_t priority;
+    /// Sum of the read times in microseconds
+    uint64_t total_us;
+    /// Longest read in microseconds
+    uint64_t max_us;
+    /// Number of failed reads
+    uint32_t errors;
+} bench_thread_t;
+
+static void * bench_reader(void * p_arg)
+{
+    bench_thread_t * p_thread = (bench_thread_t *)p_arg;
+    uint8_t buffer[32];
+    uint16_t length;
+    uint64_t start_us;
+    uint64_t delta_us;
+    uint32_t count;
+
+    pal_os_lock_set_priority(p_thread->priority);
+    for (count = 0; count < BENCH_READS; count++)
+    {
+        length = sizeof(buffer);
+        start_us = bench_time_us();
+        if (OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, 0xE0C2, 0, buffer, &length))
+        {
+            p_thread->errors++;
+        }
+        delta_us = bench_time_us() - start_us;
+        p_thread->total_us += delta_us;
+        if (delta_us > p_thread->max_us)
+        {
+            p_thread->max_us = delta_us;
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char ** argv)
+{
+    static bench_thread_t threads[BENCH_MAX_THREADS];
+    uint32_t thread_count = (argc > 1) ? (uint32_t)atoi(argv[1]) : 4;
+    pal_os_lock_stats_t stats;
+    uint64_t start_us;
+    uint64_t cpu_us;
+    uint32_t index;
+
+    if ((0 == thread_count) || (thread_count > BENCH_MAX_THREADS))
+    {
+        printf("1 to %u threads\n", BENCH_MAX_THREADS);
+        return 1;
+    }
+    pal_sim_set_virtual_time(FALSE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    pal_os_lock_reset_stats();
+    cpu_us = bench_cpu_us();
+    start_us = bench_time_us();
+    for (index = 0; index < thread_count; index++)
+    {
+        threads[index].priority = ((argc > 2) && (0 == index)) ? PAL_OS_LOCK_PRIORITY_HIGH :
+                                                                  PAL_OS_LOCK_PRIORITY_NORMAL;
+        pthread_create(&threads[index].thread, NULL, bench_reader, &threads[index]);
+    }
+    for (index = 0; index < thread_count; index++)
+    {
+        pthread_join(threads[index].thread, NULL);
+    }
+
+    pal_os_lock_get_stats(&stats);
+    printf("threads %u reads %u wall %.3f s cpu %.3f s\n", thread_count, thread_count * BENCH_READS,
+           (double)(bench_time_us() - start_us) / 1e6, (double)(bench_cpu_us() - cpu_us) / 1e6);
+    printf("lock acquisitions %u contended %u max waiters %u max wait %u us\n", stats.acquisitions,
+           stats.contended, stats.max_waiters, stats.max_wait_us);
+    for (index = 0; index < thread_count; index++)
+    {
+        printf("  thread %2u priority %u mean %6llu us max %6llu us errors %u\n", index, threads[index].priority,
+               (unsigned long long)(threads[index].total_us / BENCH_READS),
+               (unsigned long long)threads[index].max_us, threads[index].errors);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,210 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_metadata_cache.c
+*
+* \brief   Measures an audit of the metadata of all data objects with and without the optiga_util cache, on the
+*          simulated OPTIGA.
+*
+* The audit reads the metadata of every key and data object. It is run without cache, with a cold and a warm
+* cache and with a cache of the life cycle states only, and every result is compared with the first audit
+* without cache. The APDUs, I2C transactions and the device time of each audit are reported.
+*
+* Then the coherence of the cache is checked: the metadata read through the cache after write_metadata, after
+* write_data, which changes the used size, after a write of LcsA, after a metadata write with #CmdLib_SetDataObject
+* and after a key pair generated into E0F1 must equal the metadata read without cache, and a reopen of the
+* application must invalidate the cache.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_metadata_cache
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+/// Metadata entries of the cache, more than objects audited
+#define BENCH_METADATA_ENTRIES  (64)
+
+static const uint16_t bench_oid[] =
+{
+    0xE0C1, 0xE0C2, 0xE0C3, 0xE0C4, 0xE0C5, 0xE0C6, 0xE0E0, 0xE0E1, 0xE0E2, 0xE0E3, 0xE0E8, 0xE0EF, 0xE0F0, 0xE0F1,
+    0xE0F2, 0xE0F3, 0xE100, 0xE101, 0xE102, 0xE103, 0xE120, 0xE121, 0xE122, 0xE123, 0xE140, 0xF1C1, 0xF1D0, 0xF1D1,
+    0xF1D2, 0xF1D3, 0xF1D4, 0xF1D5, 0xF1D6, 0xF1D7, 0xF1D8, 0xF1D9, 0xF1DA, 0xF1DB, 0xF1E0, 0xF1E1
+};
+#define BENCH_OBJECTS   (sizeof(bench_oid) / sizeof(bench_oid[0]))
+
+/// Metadata read by the first audit
+static uint8_t bench_reference[BENCH_OBJECTS][OPTIGA_UTIL_METADATA_MAX_LEN];
+static uint16_t bench_reference_length[BENCH_OBJECTS];
+static optiga_lib_status_t bench_reference_status[BENCH_OBJECTS];
+
+static optiga_util_metadata_entry_t bench_entries[BENCH_METADATA_ENTRIES];
+static optiga_util_cache_t bench_cache;
+
+static void bench_audit(const char * p_name, uint8_t reference)
+{
+    uint8_t metadata[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint16_t length;
+    optiga_lib_status_t status;
+    uint32_t apdus = bench_apdus();
+    uint32_t transactions = optiga_sim_0.stats.transactions;
+    uint64_t start_us = pal_sim_get_time_us();
+    uint32_t mismatches = 0;
+    uint32_t index;
+
+    for (index = 0; index < BENCH_OBJECTS; index++)
+    {
+        length = sizeof(metadata);
+        status = optiga_util_read_metadata(&optiga_comms, bench_oid[index], metadata, &length);
+        if (reference)
+        {
+            memcpy(bench_reference[index], metadata, length);
+            bench_reference_length[index] = length;
+            bench_reference_status[index] = status;
+        }
+        else if ((bench_reference_status[index] != status) || (bench_reference_length[index] != length) ||
+                 (0 != memcmp(bench_reference[index], metadata, length)))
+        {
+            mismatches++;
+        }
+    }
+    printf("%-22s %u objects: %4u APDUs %6u transactions %8llu us, mismatches %u\n", p_name,
+           (unsigned int)BENCH_OBJECTS, bench_apdus() - apdus, optiga_sim_0.stats.transactions - transactions,
+           (unsigned long long)(pal_sim_get_time_us() - start_us), mismatches);
+}
+
+static void bench_enable_cache(uint16_t metadata_entries)
+{
+    memset(&bench_cache, 0x00, sizeof(bench_cache));
+    bench_cache.p_metadata_entries = bench_entries;
+    bench_cache.metadata_entry_count = metadata_entries;
+    (void)optiga_util_enable_cache(&optiga_comms, &bench_cache);
+}
+
+static void bench_fill(void)
+{
+    uint8_t metadata[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint16_t length;
+    uint32_t index;
+
+    for (index = 0; index < BENCH_OBJECTS; index++)
+    {
+        length = sizeof(metadata);
+        (void)optiga_util_read_metadata(&optiga_comms, bench_oid[index], metadata, &length);
+    }
+}
+
+// Compares the metadata read through the cache with the metadata read from OPTIGA
+static void bench_coherence(const char * p_name, uint16_t oid)
+{
+    uint8_t cached[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint8_t read[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint16_t cached_length = sizeof(cached);
+    uint16_t read_length = sizeof(read);
+    optiga_lib_status_t cached_status;
+    optiga_lib_status_t read_status;
+
+    cached_status = optiga_util_read_metadata(&optiga_comms, oid, cached, &cached_length);
+    (void)optiga_util_enable_cache(&optiga_comms, NULL);
+    read_status = optiga_util_read_metadata(&optiga_comms, oid, read, &read_length);
+    // Fills the cache again, so that the next change is made to a cached object
+    bench_enable_cache(BENCH_METADATA_ENTRIES);
+    bench_fill();
+
+    printf("%-22s 0x%04X %s\n", p_name, oid, ((cached_status == read_status) && (cached_length == read_length) &&
+           (0 == memcmp(cached, read, read_length))) ? "coherent" : "STALE");
+}
+
+int main(void)
+{
+    static const uint8_t read_never[] = {0x20, 0x03, 0xD1, 0x01, 0xFF};
+    static const uint8_t lcsa = 0x07;
+    optiga_key_id_t key_oid = OPTIGA_KEY_STORE_ID_E0F1;
+    uint8_t public_key[100];
+    uint16_t public_key_length;
+    sSetData_d set_data;
+    uint32_t invalidations;
+    uint8_t metadata[OPTIGA_UTIL_METADATA_MAX_LEN];
+    uint16_t length;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    bench_audit("no cache", TRUE);
+    bench_audit("no cache, again", FALSE);
+    bench_enable_cache(BENCH_METADATA_ENTRIES);
+    bench_audit("cache, cold", FALSE);
+    bench_audit("cache, warm", FALSE);
+    bench_enable_cache(0);
+    bench_audit("states only, cold", FALSE);
+    bench_audit("states only, warm", FALSE);
+    bench_enable_cache(BENCH_METADATA_ENTRIES);
+    bench_audit("cache, cold", FALSE);
+
+    (void)optiga_util_write_metadata(&optiga_comms, 0xF1D5, (uint8_t *)read_never, sizeof(read_never));
+    bench_coherence("write_metadata", 0xF1D5);
+    (void)optiga_util_write_data(&optiga_comms, 0xF1D0, OPTIGA_UTIL_ERASE_AND_WRITE, 0, (uint8_t *)"hello", 5);
+    bench_coherence("write_data", 0xF1D0);
+    (void)optiga_util_write_data(&optiga_comms, 0xF1C0, OPTIGA_UTIL_ERASE_AND_WRITE, 0, (uint8_t *)&lcsa, 1);
+    bench_coherence("write LcsA", 0xF1C0);
+    set_data.wOID = 0xF1D6;
+    set_data.wOffset = 0;
+    set_data.eDataOrMdata = eMETA_DATA;
+    set_data.eWriteOption = eWRITE;
+    set_data.prgbData = (uint8_t *)read_never;
+    set_data.wLength = sizeof(read_never);
+    (void)CmdLib_SetDataObject(&optiga_comms, &set_data);
+    bench_coherence("CmdLib metadata write", 0xF1D6);
+    public_key_length = sizeof(public_key);
+    (void)optiga_crypt_ecc_generate_keypair(&optiga_comms, OPTIGA_ECC_NIST_P_256, (uint8_t)OPTIGA_KEY_USAGE_SIGN,
+                                            FALSE, &key_oid, public_key, &public_key_length);
+    bench_coherence("generate key pair", 0xE0F1);
+
+    invalidations = bench_cache.invalidations;
+    (void)optiga_util_open_application(&optiga_comms);
+    length = sizeof(metadata);
+    (void)optiga_util_read_metadata(&optiga_comms, 0xF1D1, metadata, &length);
+    printf("reopen                 invalidations %u -> %u\n", invalidations, bench_cache.invalidations);
+    return 0;
+}
+
+/**
+* @}
+*/
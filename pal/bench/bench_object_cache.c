@@ -0,0 +1,209 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_object_cache.c
+*
+* \brief   Measures the data reads of a connection setup with and without the optiga_util object cache, on the
+*          simulated OPTIGA.
+*
+* A connection setup reads the UID, the device certificate in E0E0, the last 50 bytes of it and a 700 byte
+* certificate written to E0E1. The connections are made without cache, with a cache prefetching all four on
+* open, after a reopen, after a write to E0E1 and after a write to E0E1 with #CmdLib_SetDataObject. Every read is
+* compared with the data read before the cache was enabled, and the APDUs, I2C transactions and the device time
+* are reported. The UID and the device certificate never change and are expected to be kept over the reopen, E0E1
+* must be read again after each write.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_object_cache [connections]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+
+/// Largest certificate object
+#define BENCH_CERTIFICATE_MAX   (1728)
+/// Length of the certificate written to E0E1
+#define BENCH_CERTIFICATE_SIZE  (700)
+/// Length of the slice read at the end of the device certificate
+#define BENCH_SLICE_SIZE        (50)
+/// Length of the UID
+#define BENCH_UID_SIZE          (27)
+
+/// Cache entries
+#define BENCH_UID               (0)
+#define BENCH_DEVICE            (1)
+#define BENCH_CERTIFICATE       (2)
+#define BENCH_ENTRIES           (3)
+
+static uint8_t bench_uid[BENCH_UID_SIZE];
+static uint8_t bench_device[BENCH_CERTIFICATE_MAX];
+static uint16_t bench_device_length;
+static uint8_t bench_certificate[BENCH_CERTIFICATE_SIZE];
+
+static uint8_t bench_buffer[BENCH_ENTRIES][BENCH_CERTIFICATE_MAX];
+static optiga_util_metadata_entry_t bench_metadata_entries[8];
+static optiga_util_object_entry_t bench_object_entries[BENCH_ENTRIES];
+static optiga_util_cache_t bench_cache;
+
+// Reads length bytes at offset and compares them with p_expected, returns 1 on a difference
+static uint32_t bench_read(uint16_t oid, uint16_t offset, const uint8_t * p_expected, uint16_t length)
+{
+    uint8_t buffer[BENCH_CERTIFICATE_MAX];
+    uint16_t read_length = sizeof(buffer) - offset;
+
+    if ((OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, oid, offset, buffer, &read_length)) ||
+        (length != read_length) || (0 != memcmp(buffer, p_expected, length)))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static void bench_connections(const char * p_name, uint32_t connections)
+{
+    uint32_t apdus = bench_apdus();
+    uint32_t transactions = optiga_sim_0.stats.transactions;
+    uint64_t start_us = pal_sim_get_time_us();
+    uint16_t slice = bench_device_length - BENCH_SLICE_SIZE;
+    uint32_t errors = 0;
+    uint32_t count;
+
+    for (count = 0; count < connections; count++)
+    {
+        errors += bench_read(0xE0C2, 0, bench_uid, BENCH_UID_SIZE);
+        errors += bench_read(0xE0E0, 0, bench_device, bench_device_length);
+        errors += bench_read(0xE0E0, slice, &bench_device[slice], BENCH_SLICE_SIZE);
+        errors += bench_read(0xE0E1, 0, bench_certificate, BENCH_CERTIFICATE_SIZE);
+    }
+    printf("%-20s %u connections: %5u APDUs %6u transactions %9llu us, errors %u\n", p_name, connections,
+           bench_apdus() - apdus, optiga_sim_0.stats.transactions - transactions,
+           (unsigned long long)(pal_sim_get_time_us() - start_us), errors);
+}
+
+static void bench_states(const char * p_name)
+{
+    printf("%-20s states UID %u, E0E0 %u, E0E1 %u\n", p_name, bench_object_entries[BENCH_UID].state,
+           bench_object_entries[BENCH_DEVICE].state, bench_object_entries[BENCH_CERTIFICATE].state);
+}
+
+int main(int argc, char ** argv)
+{
+    static const uint16_t oid[BENCH_ENTRIES] = {0xE0C2, 0xE0E0, 0xE0E1};
+    uint32_t connections = (argc > 1) ? (uint32_t)atoi(argv[1]) : 100;
+    uint32_t apdus;
+    uint64_t start_us;
+    uint16_t length;
+    uint16_t index;
+    sSetData_d set_data;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    for (index = 0; index < BENCH_CERTIFICATE_SIZE; index++)
+    {
+        bench_certificate[index] = (uint8_t)((index * 7) + 1);
+    }
+    length = BENCH_UID_SIZE;
+    bench_device_length = sizeof(bench_device);
+    if ((OPTIGA_LIB_SUCCESS != optiga_util_write_data(&optiga_comms, 0xE0E1, OPTIGA_UTIL_ERASE_AND_WRITE, 0,
+                                                      bench_certificate, BENCH_CERTIFICATE_SIZE)) ||
+        (OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, 0xE0C2, 0, bench_uid, &length)) ||
+        (OPTIGA_LIB_SUCCESS != optiga_util_read_data(&optiga_comms, 0xE0E0, 0, bench_device, &bench_device_length)) ||
+        (bench_device_length < BENCH_SLICE_SIZE))
+    {
+        printf("the reference data could not be read\n");
+        return 1;
+    }
+
+    bench_connections("no cache", connections);
+
+    bench_cache.p_metadata_entries = bench_metadata_entries;
+    bench_cache.metadata_entry_count = sizeof(bench_metadata_entries) / sizeof(bench_metadata_entries[0]);
+    bench_cache.p_object_entries = bench_object_entries;
+    bench_cache.object_entry_count = BENCH_ENTRIES;
+    bench_cache.prefetch_on_open = TRUE;
+    for (index = 0; index < BENCH_ENTRIES; index++)
+    {
+        bench_object_entries[index].optiga_oid = oid[index];
+        bench_object_entries[index].buffer = bench_buffer[index];
+        bench_object_entries[index].buffer_size = sizeof(bench_buffer[index]);
+        bench_object_entries[index].prefetch = TRUE;
+    }
+    (void)optiga_util_enable_cache(&optiga_comms, &bench_cache);
+    bench_connections("cache", connections);
+    bench_states("cache");
+
+    apdus = bench_apdus();
+    start_us = pal_sim_get_time_us();
+    (void)optiga_util_open_application(&optiga_comms);
+    printf("%-20s %u APDUs %llu us\n", "reopen, prefetch", bench_apdus() - apdus,
+           (unsigned long long)(pal_sim_get_time_us() - start_us));
+    bench_states("reopen");
+    bench_connections("cache after reopen", connections);
+
+    for (index = 0; index < 10; index++)
+    {
+        bench_certificate[index] ^= 0xFF;
+    }
+    (void)optiga_util_write_data(&optiga_comms, 0xE0E1, OPTIGA_UTIL_WRITE_ONLY, 0, bench_certificate, 10);
+    bench_states("write to E0E1");
+    bench_connections("cache after write", connections);
+
+    // Written through the command library, as optiga_crypt or an application would
+    for (index = 0; index < 10; index++)
+    {
+        bench_certificate[index] ^= 0xFF;
+    }
+    set_data.wOID = 0xE0E1;
+    set_data.wOffset = 0;
+    set_data.eDataOrMdata = eDATA;
+    set_data.eWriteOption = eWRITE;
+    set_data.prgbData = bench_certificate;
+    set_data.wLength = 10;
+    (void)CmdLib_SetDataObject(&optiga_comms, &set_data);
+    bench_states("CmdLib write to E0E1");
+    bench_connections("cache after CmdLib", connections);
+
+    printf("object hits %u, misses %u\n", bench_cache.object_hits, bench_cache.object_misses);
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,146 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_polling.c
+*
+* \brief   Measures the status register polls of the physical layer per APDU, on the simulated OPTIGA.
+*
+* Each command class is first run with the latency model of the physical layer cleared before every APDU, so
+* that the status register is polled at the fixed intervals. Then all are run again with the model learnt from
+* the previous APDUs. The status register polls and the time per APDU are reported, followed by the model.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_polling [apdus]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+/// Command classes
+#define BENCH_RANDOM    (0)
+#define BENCH_GET_DATA  (1)
+#define BENCH_SIGN      (2)
+#define BENCH_KEY_PAIR  (3)
+#define BENCH_CLASSES   (4)
+
+static const char * const bench_class_name[BENCH_CLASSES] = {"GetRandom", "GetDataObject", "CalcSign", "GenKeyPair"};
+
+static optiga_lib_status_t bench_apdu(uint8_t command_class)
+{
+    uint8_t buffer[100];
+    uint8_t digest[32];
+    uint16_t length = sizeof(buffer);
+    optiga_key_id_t key_id = OPTIGA_KEY_STORE_ID_E0F1;
+
+    switch (command_class)
+    {
+        case BENCH_RANDOM:
+            return optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, buffer, 32);
+        case BENCH_GET_DATA:
+            return optiga_util_read_data(&optiga_comms, 0xE0C2, 0, buffer, &length);
+        case BENCH_SIGN:
+            memset(digest, 0x5A, sizeof(digest));
+            return optiga_crypt_ecdsa_sign(&optiga_comms, digest, sizeof(digest), OPTIGA_KEY_STORE_ID_E0F0,
+                                           buffer, &length);
+        default:
+            return optiga_crypt_ecc_generate_keypair(&optiga_comms, OPTIGA_ECC_NIST_P_256, OPTIGA_KEY_USAGE_SIGN,
+                                                     FALSE, &key_id, buffer, &length);
+    }
+}
+
+static void bench_run(uint8_t command_class, uint8_t learnt, uint32_t apdus)
+{
+    uint32_t polls = optiga_sim_0.stats.status_polls;
+    uint64_t start_us = pal_sim_get_time_us();
+    uint32_t errors = 0;
+    uint32_t count;
+
+    for (count = 0; count < apdus; count++)
+    {
+        if (!learnt)
+        {
+            memset(ifx_i2c_context_0.pl.latency_model, 0x00, sizeof(ifx_i2c_context_0.pl.latency_model));
+        }
+        if (OPTIGA_LIB_SUCCESS != bench_apdu(command_class))
+        {
+            errors++;
+        }
+    }
+    printf("%-14s %-6s %6.1f polls/APDU %9.1f us/APDU  errors %u\n", bench_class_name[command_class],
+           learnt ? "learnt" : "fixed", (double)(optiga_sim_0.stats.status_polls - polls) / apdus,
+           (double)(pal_sim_get_time_us() - start_us) / apdus, errors);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t apdus = (argc > 1) ? (uint32_t)atoi(argv[1]) : 50;
+    uint8_t command_class;
+    uint8_t index;
+    ifx_i2c_pl_latency_t * p_entry;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    for (command_class = 0; command_class < BENCH_CLASSES; command_class++)
+    {
+        bench_run(command_class, FALSE, apdus);
+    }
+    // The first run of each command learns its latency
+    for (command_class = 0; command_class < BENCH_CLASSES; command_class++)
+    {
+        bench_run(command_class, TRUE, apdus);
+    }
+
+    printf("latency model:\n");
+    for (index = 0; index < PL_LATENCY_MODEL_SIZE; index++)
+    {
+        p_entry = &ifx_i2c_context_0.pl.latency_model[index];
+        if (0 != p_entry->samples)
+        {
+            printf("  command 0x%02X  samples %5u  expected %6u us  polls %6u\n", p_entry->command,
+                   p_entry->samples, p_entry->expected_us, p_entry->polls);
+        }
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,190 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_read_batch.c
+*
+* \brief   Compares sequential optiga_util_read_data calls with optiga_util_read_data_batch, on the simulated OPTIGA.
+*
+* An identity read consists of the UID, a 1500 byte certificate slot, the security event counter, the life
+* cycle state and an OID which does not exist. It is done once with one optiga_util_read_data call per object
+* and once with one optiga_util_read_data_batch call. The I2C transactions, GetDataObject commands, command
+* errors and lock acquisitions per identity read are reported, together with the device time and the host time.
+* As OPTIGA executes one command at a time, the batch is expected to save only lock acquisitions, the transactions,
+* commands and device time being those of the sequential reads. Finally the results of both ways are compared.
+*
+* Build as described in README.md, adding the linker option which counts the lock acquisitions:
+* \code
+* -Wl,--wrap=pal_os_lock_acquire,--wrap=pal_os_lock_acquire_flag
+* ./bench_read_batch [reads]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "optiga/pal/pal_os_lock.h"
+#include "bench_common.h"
+
+/// Objects of an identity read
+#define BENCH_OBJECTS           (5)
+/// Object written with a certificate sized pattern before the reads
+#define BENCH_CERTIFICATE_OID   (0xF1E0)
+#define BENCH_CERTIFICATE_SIZE  (1500)
+/// Command code of GetDataObject without the MSB
+#define BENCH_GET_DATA          (0x01)
+
+static const uint16_t bench_oid[BENCH_OBJECTS] = {0xE0C2, BENCH_CERTIFICATE_OID, 0xE0C5, 0xE0C0, 0x1234};
+static const uint16_t bench_size[BENCH_OBJECTS] = {27, BENCH_CERTIFICATE_SIZE, 1, 1, 4};
+
+static uint8_t bench_sequential[BENCH_OBJECTS][BENCH_CERTIFICATE_SIZE];
+static uint8_t bench_batch[BENCH_OBJECTS][BENCH_CERTIFICATE_SIZE];
+static uint16_t bench_sequential_length[BENCH_OBJECTS];
+
+/// Lock acquisitions, counted by the wrappers
+static uint32_t bench_locks;
+
+pal_status_t __real_pal_os_lock_acquire(void);
+pal_status_t __real_pal_os_lock_acquire_flag(volatile uint32_t * p_flag);
+
+pal_status_t __wrap_pal_os_lock_acquire(void)
+{
+    bench_locks++;
+    return __real_pal_os_lock_acquire();
+}
+
+pal_status_t __wrap_pal_os_lock_acquire_flag(volatile uint32_t * p_flag)
+{
+    bench_locks++;
+    return __real_pal_os_lock_acquire_flag(p_flag);
+}
+
+// Reads the identity objects, returns the number of reads with the expected result
+static uint32_t bench_identity(uint8_t batch)
+{
+    optiga_util_read_entry_t entries[BENCH_OBJECTS];
+    uint32_t expected = 0;
+    uint8_t index;
+
+    for (index = 0; index < BENCH_OBJECTS; index++)
+    {
+        entries[index].optiga_oid = bench_oid[index];
+        entries[index].offset = 0;
+        entries[index].buffer = batch ? bench_batch[index] : bench_sequential[index];
+        entries[index].bytes_to_read = bench_size[index];
+        if (!batch)
+        {
+            entries[index].status = optiga_util_read_data(&optiga_comms, entries[index].optiga_oid, 0,
+                                                          entries[index].buffer, &entries[index].bytes_to_read);
+            bench_sequential_length[index] = entries[index].bytes_to_read;
+        }
+    }
+    if (batch)
+    {
+        (void)optiga_util_read_data_batch(&optiga_comms, entries, BENCH_OBJECTS);
+    }
+
+    for (index = 0; index < BENCH_OBJECTS; index++)
+    {
+        // The last OID does not exist
+        if ((index < (BENCH_OBJECTS - 1)) ? ((OPTIGA_LIB_SUCCESS == entries[index].status) &&
+                                             (bench_size[index] == entries[index].bytes_to_read))
+                                          : (OPTIGA_LIB_SUCCESS != entries[index].status))
+        {
+            expected++;
+        }
+    }
+    return expected;
+}
+
+static void bench_run(uint8_t batch, uint32_t reads)
+{
+    pal_sim_stats_t stats = optiga_sim_0.stats;
+    uint32_t locks = bench_locks;
+    uint64_t device_us = pal_sim_get_time_us();
+    uint64_t host_us = bench_time_us();
+    uint32_t expected = 0;
+    uint32_t count;
+
+    for (count = 0; count < reads; count++)
+    {
+        expected += bench_identity(batch);
+    }
+    printf("%-10s %u/%u as expected, per identity read: %.1f transactions, %.1f GetDataObject, %.1f errors, "
+           "%.1f locks, device %.0f us, host %.1f us\n", batch ? "batch" : "sequential", expected,
+           reads * BENCH_OBJECTS, (double)(optiga_sim_0.stats.transactions - stats.transactions) / reads,
+           (double)(optiga_sim_0.stats.commands[BENCH_GET_DATA] - stats.commands[BENCH_GET_DATA]) / reads,
+           (double)(optiga_sim_0.stats.command_errors - stats.command_errors) / reads,
+           (double)(bench_locks - locks) / reads, (double)(pal_sim_get_time_us() - device_us) / reads,
+           (double)(bench_time_us() - host_us) / reads);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t reads = (argc > 1) ? (uint32_t)atoi(argv[1]) : 200;
+    uint8_t certificate[BENCH_CERTIFICATE_SIZE];
+    uint8_t index;
+    uint16_t offset;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    for (offset = 0; offset < sizeof(certificate); offset++)
+    {
+        certificate[offset] = (uint8_t)(offset * 13);
+    }
+    if (OPTIGA_LIB_SUCCESS != optiga_util_write_data(&optiga_comms, BENCH_CERTIFICATE_OID,
+                                                     OPTIGA_UTIL_ERASE_AND_WRITE, 0, certificate,
+                                                     sizeof(certificate)))
+    {
+        printf("optiga_util_write_data failed\n");
+        return 1;
+    }
+
+    bench_run(FALSE, reads);
+    bench_run(TRUE, reads);
+
+    for (index = 0; index < (BENCH_OBJECTS - 1); index++)
+    {
+        if (0 != memcmp(bench_sequential[index], bench_batch[index], bench_sequential_length[index]))
+        {
+            printf("0x%04X differs\n", bench_oid[index]);
+        }
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
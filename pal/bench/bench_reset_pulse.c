@@ -0,0 +1,156 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_reset_pulse.c
+*
+* \brief   Reports the timing of the reset pulses and interrupt edges of the Linux GPIO PAL.
+*
+* The driver resets an OPTIGA attached to the Linux PAL a number of times with a cold reset, toggling the Vdd
+* and reset pins, and with a warm reset, toggling the reset pin only. After each kind, the statistics of the
+* pins give the level changes written, the longest write and the shortest and longest time the lines were low,
+* to be compared with RESET_LOW_TIME_MSEC. After each reset the application is opened again and a random number
+* generated, to check the OPTIGA came back.
+*
+* If a GPIO line is given, it is used as the response pin of the OPTIGA, see ifx_i2c_context_t.p_slave_irq_pin,
+* and the edges reported by the kernel and handed to the interrupt handler are printed as well.
+*
+* Build as bench_i2c_syscalls.c, with an OPTIGA on the I2C bus and GPIOs of pal_ifx_i2c_config.c, then run:
+* \code
+* ./bench_reset_pulse [resets] [irq_line]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga/ifx_i2c/ifx_i2c.h"
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "bench_common.h"
+#include "pal_linux.h"
+
+/// The Vdd and reset lines of the OPTIGA, defined in pal_ifx_i2c_config.c
+extern pal_linux_gpio_t gpio_pin_vdd;
+extern pal_linux_gpio_t gpio_pin_reset;
+
+/// Response line of the OPTIGA, given on the command line
+static pal_linux_gpio_t bench_gpio_irq = {NULL, 0, -1, {0}, NULL, NULL, 0};
+static pal_gpio_t bench_irq_pin = {(void*)&bench_gpio_irq};
+
+static void bench_print_pin(const char * name, const pal_linux_gpio_t * p_gpio)
+{
+    printf("  %-5s %5u writes, max %5u us per write, %4u pulses low for %5u to %5u us\n", name,
+           p_gpio->stats.writes, p_gpio->stats.max_write_us, p_gpio->stats.pulses,
+           p_gpio->stats.min_low_us, p_gpio->stats.max_low_us);
+}
+
+// Resets the OPTIGA and opens the application again, returns 1 on failure
+static uint32_t bench_reset(uint8_t reset_type)
+{
+    sOpenApp_d open_app = {eInit};
+
+    optiga_comms.comms_status = OPTIGA_COMMS_BUSY;
+    if (OPTIGA_COMMS_SUCCESS != optiga_comms_reset(&optiga_comms, reset_type))
+    {
+        return 1;
+    }
+#ifdef PAL_OS_HAS_EVENT_WAIT
+    pal_os_event_wait(&optiga_comms.comms_status, OPTIGA_COMMS_BUSY);
+#else
+    while (OPTIGA_COMMS_BUSY == optiga_comms.comms_status)
+    {
+        pal_os_timer_delay_in_milliseconds(1);
+    }
+#endif
+    if ((OPTIGA_COMMS_SUCCESS != optiga_comms.comms_status) ||
+        (CMD_LIB_OK != CmdLib_OpenApplication(&optiga_comms, &open_app)))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+static void bench_run(const char * name, uint8_t reset_type, uint32_t resets)
+{
+    uint8_t random[32];
+    uint32_t failed = 0;
+    uint32_t count;
+
+    gpio_pin_vdd.stats = (pal_linux_gpio_stats_t){0};
+    gpio_pin_reset.stats = (pal_linux_gpio_stats_t){0};
+    bench_gpio_irq.stats = (pal_linux_gpio_stats_t){0};
+    for (count = 0; count < resets; count++)
+    {
+        if ((0 != bench_reset(reset_type)) ||
+            (OPTIGA_LIB_SUCCESS != optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, random, sizeof(random))))
+        {
+            failed++;
+        }
+    }
+    printf("%s reset, %u resets, failed %u, low time %u us:\n", name, resets, failed, RESET_LOW_TIME_MSEC);
+    bench_print_pin("vdd", &gpio_pin_vdd);
+    bench_print_pin("reset", &gpio_pin_reset);
+    if (NULL != ifx_i2c_context_0.p_slave_irq_pin)
+    {
+        printf("  irq   %5u edges, %u dispatched to the handler\n", bench_gpio_irq.stats.irq_events,
+               bench_gpio_irq.stats.irq_dispatches);
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t resets = (argc > 1) ? (uint32_t)atoi(argv[1]) : 20;
+
+    if (0 == resets)
+    {
+        printf("at least 1 reset\n");
+        return 1;
+    }
+    if (argc > 2)
+    {
+        bench_gpio_irq.line = (uint32_t)atoi(argv[2]);
+        ifx_i2c_context_0.p_slave_irq_pin = &bench_irq_pin;
+    }
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    bench_run("cold", IFX_I2C_COLD_RESET, resets);
+    bench_run("warm", IFX_I2C_WARM_RESET, resets);
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,161 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_trace.c
+*
+* \brief   Records a session of the simulated OPTIGA with the trace shim of pal/trace and replays it.
+*
+* The session is open_application followed by a number of ECDSA signs with the key in E0F0. Replaying
+* measures the host time per sign of the ifx i2c stack and the command library, and reports the statistics of
+* the shim. The mode "changed" replays with one digest byte changed, which must stop at the first differing
+* write.
+*
+* Build from the root of the repository, with CORE, DEFS and mbedTLS as described in README.md and SIM set to
+* the sources of pal/sim:
+* \code
+* WRAP="-Wl,--wrap=pal_i2c_init,--wrap=pal_i2c_deinit,--wrap=pal_i2c_set_bitrate,--wrap=pal_i2c_write,
+*       --wrap=pal_i2c_read,--wrap=pal_i2c_write_read,--wrap=pal_gpio_set_high,--wrap=pal_gpio_set_low,
+*       --wrap=pal_os_event_register_callback_oneshot,--wrap=pal_os_timer_delay_in_milliseconds"
+* gcc -O2 -std=gnu99 $DEFS -Ioptiga/include -Ipal/sim -Ipal/trace
+*     -Iexternals/mbedtls-2.12.0/include $CORE $SIM pal/trace/pal_trace.c pal/bench/bench_common.c
+*     pal/bench/bench_trace.c build/mbedtls/libmbedtls.a -lpthread $WRAP -o bench_trace
+* ./bench_trace record session.trc 1000
+* ./bench_trace replay session.trc 1000
+* ./bench_trace changed session.trc 1000
+* \endcode
+*
+* To replay with the Linux PAL instead, build with -DBENCH_LINUX_PAL, -Ipal/linux in place of -Ipal/sim
+* and the sources of pal/linux except pal_socket.c in place of $SIM, without mbedTLS. No hardware is needed.
+* The driver then takes the event handle, so that the callbacks run from #pal_os_event_wait as required by
+* pal_trace.h. Recording needs the simulated OPTIGA.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "optiga/pal/pal_os_event.h"
+#include "pal_trace.h"
+#include "bench_common.h"
+
+/// Default number of signs of a session
+#define BENCH_TRACE_SIGNS   (1000)
+
+int main(int argc, char ** argv)
+{
+    uint8_t digest[32] = {0x01, 0x02, 0x03};
+    uint8_t signature[80];
+    uint16_t signature_length;
+    uint32_t signs;
+    uint32_t index;
+    uint32_t failed = 0;
+    uint8_t record;
+    uint64_t start_us;
+    uint64_t open_us;
+    uint64_t end_us;
+
+    if (argc < 3)
+    {
+        printf("usage: %s record|replay|changed <trace> [signs]\n", argv[0]);
+        return 1;
+    }
+    record = (0 == strcmp(argv[1], "record")) ? TRUE : FALSE;
+    signs = (argc > 3) ? (uint32_t)atoi(argv[3]) : BENCH_TRACE_SIGNS;
+
+#ifdef BENCH_LINUX_PAL
+    if (record)
+    {
+        printf("recording needs the simulated OPTIGA\n");
+        return 1;
+    }
+    (void)pal_os_event_get_handle();
+    (void)pal_os_event_init();
+#else
+    pal_sim_set_virtual_time(TRUE);
+#endif
+
+    if (record)
+    {
+        (void)pal_trace_record_start();
+    }
+    else if (PAL_STATUS_SUCCESS != pal_trace_replay_start(argv[2], FALSE))
+    {
+        printf("%s could not be loaded\n", argv[2]);
+        return 1;
+    }
+
+    start_us = bench_time_us();
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("open_application failed, mismatches %u\n", pal_trace_stats.mismatches);
+        return 1;
+    }
+    open_us = bench_time_us();
+    for (index = 0; index < signs; index++)
+    {
+        digest[5] = (uint8_t)(index + ((0 == strcmp(argv[1], "changed")) ? 1 : 0));
+        signature_length = sizeof(signature);
+        if (OPTIGA_LIB_SUCCESS != optiga_crypt_ecdsa_sign(&optiga_comms, digest, sizeof(digest),
+                                                          OPTIGA_KEY_STORE_ID_E0F0, signature, &signature_length))
+        {
+            failed++;
+        }
+    }
+    end_us = bench_time_us();
+
+    if (record)
+    {
+        printf("record  %u signs, %u failed, %u records, %u i2c requests, %u bytes\n", signs, failed,
+               pal_trace_stats.records, pal_trace_stats.i2c_requests, pal_trace_stats.i2c_bytes);
+        if (PAL_STATUS_SUCCESS != pal_trace_record_stop(argv[2]))
+        {
+            printf("%s could not be written\n", argv[2]);
+            return 1;
+        }
+    }
+    else
+    {
+        printf("%-7s open %llu us, %u signs %.2f us per sign, %u failed\n", argv[1],
+               (unsigned long long)(open_us - start_us), signs, (double)(end_us - open_us) / signs, failed);
+        printf("        %u records, %u i2c requests, %u bytes, %u gpio, %u timers, %u timer mismatches, "
+               "%u mismatches, first at %u, recorded %.1f ms\n", pal_trace_stats.records,
+               pal_trace_stats.i2c_requests, pal_trace_stats.i2c_bytes, pal_trace_stats.gpio_calls,
+               pal_trace_stats.timers, pal_trace_stats.timer_mismatches, pal_trace_stats.mismatches,
+               pal_trace_stats.first_mismatch, pal_trace_stats.recorded_time_us / 1000.0);
+        printf("        %u records left\n", pal_trace_replay_stop());
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,148 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_warm_open.c
+*
+* \brief   Compares #optiga_util_open_application with #optiga_util_open_application_warm on the simulated OPTIGA.
+*
+* Each open starts over from the initial host state, as a new process would, while the OPTIGA stays powered.
+* The driver runs the full open, the warm open with the parameters saved in the datastore by the previous open,
+* and the warm open after the OPTIGA was reset by someone else. The reset restores the default DATA_REG_LEN, so
+* the frame length read back differs from the saved one and the physical layer falls back to the negotiation.
+* Reported are the device time, the transactions and bus bytes per open, the opens which kept the warm path
+* and the frame size afterwards.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_warm_open [opens]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "optiga/optiga_util.h"
+#include "optiga/pal/pal_os_datastore.h"
+#include "bench_common.h"
+
+#define BENCH_MODE_FULL         (0)
+#define BENCH_MODE_WARM         (1)
+#define BENCH_MODE_CHANGED      (2)
+
+static const char * const bench_mode_name[] = {"full", "warm", "frame length changed"};
+
+/// Host state before the first open
+static ifx_i2c_context_t bench_initial_context;
+
+// Starts over as a new process would, the OPTIGA stays powered
+static void bench_restart(void)
+{
+    ifx_i2c_context_0 = bench_initial_context;
+    optiga_comms.max_comms_buffer = 0;
+}
+
+static void bench_opens(uint8_t mode, uint32_t opens)
+{
+    uint32_t transactions = optiga_sim_0.stats.transactions;
+    uint32_t bus_bytes = optiga_sim_0.stats.bus_bytes;
+    uint64_t start_us = pal_sim_get_time_us();
+    optiga_lib_status_t status;
+    uint32_t warm = 0;
+    uint32_t errors = 0;
+    uint32_t count;
+
+    for (count = 0; count < opens; count++)
+    {
+        bench_restart();
+        if (BENCH_MODE_FULL == mode)
+        {
+            status = optiga_util_open_application(&optiga_comms);
+        }
+        else
+        {
+            if (BENCH_MODE_CHANGED == mode)
+            {
+                pal_sim_reset(&optiga_sim_0);
+            }
+            status = optiga_util_open_application_warm(&optiga_comms, PAL_OS_DATASTORE_ID_WARM_CACHE);
+        }
+        if (OPTIGA_LIB_SUCCESS != status)
+        {
+            errors++;
+        }
+        // Cleared by the stack if the open fell back to the full sequence
+        if (TRUE == ifx_i2c_context_0.warm_open)
+        {
+            warm++;
+        }
+    }
+    printf("%-20s %3u opens: %7.1f us %5.1f transactions %6.1f bus bytes per open, %3u warm, frame size %u, "
+           "errors %u\n", bench_mode_name[mode], opens, (double)(pal_sim_get_time_us() - start_us) / opens,
+           (double)(optiga_sim_0.stats.transactions - transactions) / opens,
+           (double)(optiga_sim_0.stats.bus_bytes - bus_bytes) / opens, warm, ifx_i2c_context_0.frame_size, errors);
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t opens = (argc > 1) ? (uint32_t)atoi(argv[1]) : 20;
+    uint8_t invalid = 0;
+
+    if (0 == opens)
+    {
+        printf("at least 1 open\n");
+        return 1;
+    }
+    pal_sim_set_virtual_time(TRUE);
+    bench_initial_context = ifx_i2c_context_0;
+    // Parameters left by a previous run are not used, the first warm open saves them
+    if (PAL_STATUS_SUCCESS != pal_os_datastore_write(PAL_OS_DATASTORE_ID_WARM_CACHE, &invalid, sizeof(invalid)))
+    {
+        printf("pal_os_datastore_write failed\n");
+        return 1;
+    }
+
+    bench_opens(BENCH_MODE_FULL, opens);
+    // Saves the parameters for the warm opens
+    bench_restart();
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application_warm(&optiga_comms, PAL_OS_DATASTORE_ID_WARM_CACHE))
+    {
+        printf("optiga_util_open_application_warm failed\n");
+        return 1;
+    }
+    bench_opens(BENCH_MODE_WARM, opens);
+    bench_opens(BENCH_MODE_CHANGED, opens);
+    // The parameters saved by the fallback are valid again
+    bench_opens(BENCH_MODE_WARM, opens);
+    return 0;
+}
+
+/**
+* @}
+*/
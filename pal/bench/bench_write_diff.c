@@ -0,0 +1,211 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_write_diff.c
+*
+* \brief   Compares full and differential writes of a data object, on the simulated OPTIGA.
+*
+* A 1500 byte object is written with a base content and then updated with a pattern of changes, once with a
+* full write, once differentially without the object cache and once differentially against the copy in the
+* object cache. The SetDataObject and GetDataObject commands, the bytes on the bus and the device time of the
+* update are reported, and the content of the object and of the cached copy are verified afterwards. Without the
+* cache, the differential write is expected to cost as much as the full write, with no GetDataObject command.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_write_diff
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+
+/// Object written
+#define BENCH_OID           (0xF1E0)
+#define BENCH_SIZE          (1500)
+/// Command codes without the MSB
+#define BENCH_GET_DATA      (0x01)
+#define BENCH_SET_DATA      (0x02)
+
+/// Patterns of changes
+#define BENCH_UNCHANGED     (0)
+#define BENCH_FOUR_BYTES    (1)
+#define BENCH_THREE_FIELDS  (2)
+#define BENCH_RANDOM_BYTES  (3)
+#define BENCH_ALL_BYTES     (4)
+#define BENCH_PATTERNS      (5)
+
+/// Ways of writing
+#define BENCH_FULL              (0)
+#define BENCH_DIFF_UNCACHED     (1)
+#define BENCH_DIFF_CACHED       (2)
+#define BENCH_MODES             (3)
+
+static const char * const bench_pattern_name[BENCH_PATTERNS] =
+{
+    "unchanged", "4 bytes", "3 fields", "150 random bytes", "all bytes"
+};
+static const char * const bench_mode_name[BENCH_MODES] = {"full write", "diff, no cache", "diff, cached"};
+
+static uint8_t bench_base[BENCH_SIZE];
+static uint8_t bench_update[BENCH_SIZE];
+static uint8_t bench_cached[BENCH_SIZE];
+
+static optiga_util_metadata_entry_t bench_metadata_entries[4];
+static optiga_util_object_entry_t bench_object_entry;
+static optiga_util_cache_t bench_cache;
+
+static void bench_make_update(uint8_t pattern)
+{
+    uint16_t index;
+
+    memcpy(bench_update, bench_base, BENCH_SIZE);
+    switch (pattern)
+    {
+        case BENCH_FOUR_BYTES:
+            for (index = 0; index < 4; index++)
+            {
+                bench_update[700 + index] ^= (uint8_t)(index + 1);
+            }
+            break;
+        case BENCH_THREE_FIELDS:
+            for (index = 0; index < 8; index++)
+            {
+                bench_update[100 + index] ^= 0x55;
+                bench_update[130 + index] ^= 0x55;
+            }
+            for (index = 0; index < 16; index++)
+            {
+                bench_update[1200 + index] ^= 0xAA;
+            }
+            break;
+        case BENCH_RANDOM_BYTES:
+            srand(7);
+            for (index = 0; index < 150; index++)
+            {
+                bench_update[rand() % BENCH_SIZE] ^= 0x5A;
+            }
+            break;
+        case BENCH_ALL_BYTES:
+            for (index = 0; index < BENCH_SIZE; index++)
+            {
+                bench_update[index] ^= 0xFF;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static void bench_update_object(uint8_t pattern, uint8_t mode)
+{
+    uint8_t read[BENCH_SIZE];
+    uint16_t length = 4;
+    pal_sim_stats_t stats;
+    uint32_t set_data;
+    uint32_t get_data;
+    uint32_t bus_bytes;
+    uint64_t start_us;
+    uint64_t time_us;
+    optiga_lib_status_t status;
+    uint8_t correct;
+
+    (void)optiga_util_enable_cache(&optiga_comms, (BENCH_DIFF_CACHED == mode) ? &bench_cache : NULL);
+    (void)optiga_util_write_data(&optiga_comms, BENCH_OID, OPTIGA_UTIL_ERASE_AND_WRITE, 0, bench_base, BENCH_SIZE);
+    if (BENCH_DIFF_CACHED == mode)
+    {
+        // Fills the cache
+        (void)optiga_util_read_data(&optiga_comms, BENCH_OID, 0, read, &length);
+    }
+    bench_make_update(pattern);
+
+    stats = optiga_sim_0.stats;
+    start_us = pal_sim_get_time_us();
+    status = optiga_util_write_data(&optiga_comms, BENCH_OID,
+                                    (BENCH_FULL == mode) ? OPTIGA_UTIL_WRITE_ONLY : OPTIGA_UTIL_WRITE_DIFFERENTIAL,
+                                    0, bench_update, BENCH_SIZE);
+    time_us = pal_sim_get_time_us() - start_us;
+    set_data = optiga_sim_0.stats.commands[BENCH_SET_DATA] - stats.commands[BENCH_SET_DATA];
+    get_data = optiga_sim_0.stats.commands[BENCH_GET_DATA] - stats.commands[BENCH_GET_DATA];
+    bus_bytes = optiga_sim_0.stats.bus_bytes - stats.bus_bytes;
+
+    (void)optiga_util_enable_cache(&optiga_comms, NULL);
+    length = BENCH_SIZE;
+    correct = ((OPTIGA_LIB_SUCCESS == status) &&
+               (OPTIGA_LIB_SUCCESS == optiga_util_read_data(&optiga_comms, BENCH_OID, 0, read, &length)) &&
+               (BENCH_SIZE == length) && (0 == memcmp(read, bench_update, BENCH_SIZE)) &&
+               ((BENCH_DIFF_CACHED != mode) || (0 == memcmp(bench_cached, bench_update, BENCH_SIZE))));
+
+    printf("%-18s %-14s %5u %5u %9u %9llu %s\n", bench_pattern_name[pattern], bench_mode_name[mode], set_data,
+           get_data, bus_bytes, (unsigned long long)time_us, correct ? "" : "MISMATCH");
+}
+
+int main(void)
+{
+    uint16_t index;
+    uint8_t pattern;
+    uint8_t mode;
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+    for (index = 0; index < BENCH_SIZE; index++)
+    {
+        bench_base[index] = (uint8_t)((index * 13) + 5);
+    }
+    bench_cache.p_metadata_entries = bench_metadata_entries;
+    bench_cache.metadata_entry_count = sizeof(bench_metadata_entries) / sizeof(bench_metadata_entries[0]);
+    bench_cache.p_object_entries = &bench_object_entry;
+    bench_cache.object_entry_count = 1;
+    bench_object_entry.optiga_oid = BENCH_OID;
+    bench_object_entry.buffer = bench_cached;
+    bench_object_entry.buffer_size = BENCH_SIZE;
+
+    printf("%-18s %-14s %5s %5s %9s %9s\n", "pattern", "mode", "Set", "Get", "bus bytes", "time us");
+    for (pattern = 0; pattern < BENCH_PATTERNS; pattern++)
+    {
+        for (mode = 0; mode < BENCH_MODES; mode++)
+        {
+            bench_update_object(pattern, mode);
+        }
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
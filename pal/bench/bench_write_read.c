@@ -0,0 +1,140 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_write_read.c
+*
+* \brief   Counts the I2C transactions per APDU with and without the combined write-read transfer.
+*
+* Built with #PAL_I2C_HAS_WRITE_READ, the physical layer writes a register address and reads the register in one
+* transaction with a repeated start, see #pal_i2c_write_read. Without it, the address is written and the register
+* read in two transactions. The driver runs random number generation, a read of the UID, a read of the device
+* certificate and ECDSA signs on the simulated OPTIGA and reports per APDU the transactions, the status register
+* polls, the bus bytes and the device time.
+*
+* Build as described in README.md, once with DEFS and once with PAL_I2C_HAS_WRITE_READ removed from DEFS, then run:
+* \code
+* ./bench_write_read [apdus]
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "optiga/optiga_util.h"
+#include "optiga/optiga_crypt.h"
+#include "bench_common.h"
+
+#define BENCH_RANDOM            (0)
+#define BENCH_UID               (1)
+#define BENCH_CERTIFICATE       (2)
+#define BENCH_SIGN              (3)
+#define BENCH_WORKLOADS         (4)
+
+static const char * const bench_workload_name[] = {"random", "read UID", "read certificate", "sign"};
+
+// Runs one call of the workload, returns 1 on failure
+static uint32_t bench_call(uint8_t workload)
+{
+    static uint8_t buffer[1728];
+    uint8_t digest[32] = {0};
+    uint16_t length = sizeof(buffer);
+    optiga_lib_status_t status;
+
+    switch (workload)
+    {
+        case BENCH_RANDOM:
+            status = optiga_crypt_random(&optiga_comms, OPTIGA_RNG_TYPE_TRNG, buffer, 32);
+            break;
+        case BENCH_UID:
+            status = optiga_util_read_data(&optiga_comms, 0xE0C2, 0, buffer, &length);
+            break;
+        case BENCH_CERTIFICATE:
+            status = optiga_util_read_data(&optiga_comms, 0xE0E0, 0, buffer, &length);
+            break;
+        default:
+            length = 80;
+            status = optiga_crypt_ecdsa_sign(&optiga_comms, digest, sizeof(digest), OPTIGA_KEY_STORE_ID_E0F0,
+                                             buffer, &length);
+            break;
+    }
+    return (OPTIGA_LIB_SUCCESS == status) ? 0 : 1;
+}
+
+int main(int argc, char ** argv)
+{
+    uint32_t calls = (argc > 1) ? (uint32_t)atoi(argv[1]) : 100;
+    pal_sim_stats_t stats;
+    uint64_t start_us;
+    uint32_t apdus;
+    uint32_t errors;
+    uint32_t count;
+    uint8_t workload;
+
+    if (0 == calls)
+    {
+        printf("at least 1 call\n");
+        return 1;
+    }
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+#ifdef PAL_I2C_HAS_WRITE_READ
+    printf("PAL_I2C_HAS_WRITE_READ defined\n");
+#else
+    printf("PAL_I2C_HAS_WRITE_READ not defined\n");
+#endif
+    for (workload = 0; workload < BENCH_WORKLOADS; workload++)
+    {
+        stats = optiga_sim_0.stats;
+        apdus = bench_apdus();
+        start_us = pal_sim_get_time_us();
+        errors = 0;
+        for (count = 0; count < calls; count++)
+        {
+            errors += bench_call(workload);
+        }
+        apdus = bench_apdus() - apdus;
+        printf("%-17s %4u APDUs: %5.1f transactions %5.1f status polls %7.1f bus bytes %8.1f us per APDU, errors %u\n",
+               bench_workload_name[workload], apdus,
+               (double)(optiga_sim_0.stats.transactions - stats.transactions) / apdus,
+               (double)(optiga_sim_0.stats.status_polls - stats.status_polls) / apdus,
+               (double)(optiga_sim_0.stats.bus_bytes - stats.bus_bytes) / apdus,
+               (double)(pal_sim_get_time_us() - start_us) / apdus, errors);
+    }
+    return 0;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,225 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file bench_write_stream.c
+*
+* \brief   Compares optiga_util_write_data with optiga_util_write_data_stream from a file, on the simulated OPTIGA.
+*
+* A 1500 byte object is written from a temporary file, once read into memory and written with
+* optiga_util_write_data and then streamed with buffers of 256, 1024 and 3106 bytes. The SetDataObject
+* commands, the chunks read, the bytes on the bus and the device time are reported, and the object is read
+* back and compared. Then the error handling is checked: a read callback failing at the third chunk, a buffer
+* of 1 byte, a buffer of 254 bytes (below two chunks of CMD_LIB_STREAM_MIN_CHUNK) and a differential write, each followed by a read which must succeed.
+*
+* Build as described in README.md, then run:
+* \code
+* ./bench_write_stream
+* \endcode
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "optiga/optiga_util.h"
+#include "bench_common.h"
+
+/// Object written
+#define BENCH_OID           (0xF1E0)
+#define BENCH_SIZE          (1500)
+/// Largest stream buffer, two chunks of the largest APDU
+#define BENCH_BUFFER_MAX    (3106)
+/// Command code of SetDataObject without the MSB
+#define BENCH_SET_DATA      (0x02)
+
+/// Context of the stream callbacks
+typedef struct bench_stream
+{
+    /// File the data is read from
+    int fd;
+    /// Chunks read
+    uint32_t reads;
+    /// Chunk at which the read fails, 0 to never fail
+    uint32_t fail_at;
+    /// Bytes written as last reported
+    uint16_t written;
+} bench_stream_t;
+
+static uint8_t bench_data[BENCH_SIZE];
+static uint8_t bench_buffer[BENCH_BUFFER_MAX];
+
+static int32_t bench_stream_read(void * p_ctx, uint8_t * p_chunk, uint16_t length)
+{
+    bench_stream_t * p_stream = (bench_stream_t *)p_ctx;
+    uint16_t offset = 0;
+    ssize_t count;
+
+    if (++p_stream->reads == p_stream->fail_at)
+    {
+        return -1;
+    }
+    while (offset < length)
+    {
+        count = read(p_stream->fd, &p_chunk[offset], length - offset);
+        if (count <= 0)
+        {
+            return -1;
+        }
+        offset += (uint16_t)count;
+    }
+    return 0;
+}
+
+static void bench_stream_progress(void * p_ctx, uint16_t bytes_written)
+{
+    ((bench_stream_t *)p_ctx)->written = bytes_written;
+}
+
+// Writes new content to the file and to the object, buffer_size 0 reads the file into memory first
+static void bench_write(int fd, uint16_t buffer_size)
+{
+    bench_stream_t context = {fd, 0, 0, 0};
+    optiga_util_stream_t stream = {bench_stream_read, bench_stream_progress, &context, bench_buffer, buffer_size};
+    uint8_t data[BENCH_SIZE];
+    uint16_t length = BENCH_SIZE;
+    pal_sim_stats_t stats = optiga_sim_0.stats;
+    uint32_t set_data;
+    uint32_t bus_bytes;
+    uint64_t start_us;
+    uint64_t time_us;
+    optiga_lib_status_t status;
+    uint16_t index;
+
+    for (index = 0; index < BENCH_SIZE; index++)
+    {
+        bench_data[index] ^= 0x11;
+    }
+    if ((BENCH_SIZE != pwrite(fd, bench_data, BENCH_SIZE, 0)) || (0 != lseek(fd, 0, SEEK_SET)))
+    {
+        printf("the file could not be written\n");
+        return;
+    }
+
+    start_us = pal_sim_get_time_us();
+    if (0 == buffer_size)
+    {
+        status = (BENCH_SIZE == read(fd, data, BENCH_SIZE)) ?
+                 optiga_util_write_data(&optiga_comms, BENCH_OID, OPTIGA_UTIL_ERASE_AND_WRITE, 0, data, BENCH_SIZE) :
+                 OPTIGA_LIB_ERROR;
+    }
+    else
+    {
+        status = optiga_util_write_data_stream(&optiga_comms, BENCH_OID, OPTIGA_UTIL_ERASE_AND_WRITE, 0, &stream,
+                                               BENCH_SIZE);
+    }
+    time_us = pal_sim_get_time_us() - start_us;
+    set_data = optiga_sim_0.stats.commands[BENCH_SET_DATA] - stats.commands[BENCH_SET_DATA];
+    bus_bytes = optiga_sim_0.stats.bus_bytes - stats.bus_bytes;
+
+    memset(data, 0x00, sizeof(data));
+    printf("%-22s %7u %5u %5u %9u %9llu %s\n", buffer_size ? "write_data_stream" : "write_data, in memory",
+           buffer_size ? buffer_size : BENCH_SIZE, set_data, context.reads, bus_bytes, (unsigned long long)time_us,
+           ((OPTIGA_LIB_SUCCESS == status) &&
+            (OPTIGA_LIB_SUCCESS == optiga_util_read_data(&optiga_comms, BENCH_OID, 0, data, &length)) &&
+            (BENCH_SIZE == length) && (0 == memcmp(data, bench_data, BENCH_SIZE)) &&
+            ((0 == buffer_size) || (BENCH_SIZE == context.written))) ? "ok" : "MISMATCH");
+}
+
+static void bench_usable(void)
+{
+    uint8_t data[4];
+    uint16_t length = sizeof(data);
+
+    printf("    read afterwards: status 0x%04X\n",
+           (unsigned int)optiga_util_read_data(&optiga_comms, BENCH_OID, 0, data, &length));
+}
+
+int main(void)
+{
+    static const uint16_t buffer_size[] = {0, 256, 1024, BENCH_BUFFER_MAX};
+    char path[] = "/tmp/bench_write_streamXXXXXX";
+    bench_stream_t context = {0, 0, 3, 0};
+    optiga_util_stream_t stream = {bench_stream_read, bench_stream_progress, &context, bench_buffer, 256};
+    optiga_lib_status_t status;
+    uint16_t index;
+    int fd;
+
+    fd = mkstemp(path);
+    if (fd < 0)
+    {
+        printf("%s could not be created\n", path);
+        return 1;
+    }
+    (void)unlink(path);
+    context.fd = fd;
+    for (index = 0; index < BENCH_SIZE; index++)
+    {
+        bench_data[index] = (uint8_t)((index * 7) + 3);
+    }
+
+    pal_sim_set_virtual_time(TRUE);
+    if (OPTIGA_LIB_SUCCESS != optiga_util_open_application(&optiga_comms))
+    {
+        printf("optiga_util_open_application failed\n");
+        return 1;
+    }
+
+    printf("%-22s %7s %5s %5s %9s %9s\n", "mode", "buffer", "Set", "reads", "bus bytes", "time us");
+    for (index = 0; index < (sizeof(buffer_size) / sizeof(buffer_size[0])); index++)
+    {
+        bench_write(fd, buffer_size[index]);
+    }
+
+    (void)lseek(fd, 0, SEEK_SET);
+    status = optiga_util_write_data_stream(&optiga_comms, BENCH_OID, OPTIGA_UTIL_WRITE_ONLY, 0, &stream, BENCH_SIZE);
+    printf("read failure at chunk 3: status 0x%04X, progress %u\n", (unsigned int)status, context.written);
+    bench_usable();
+    stream.buffer_size = 1;
+    printf("buffer of 1 byte: status 0x%04X\n",
+           (unsigned int)optiga_util_write_data_stream(&optiga_comms, BENCH_OID, OPTIGA_UTIL_WRITE_ONLY, 0, &stream,
+                                                       BENCH_SIZE));
+    bench_usable();
+    stream.buffer_size = (2 * CMD_LIB_STREAM_MIN_CHUNK) - 2;
+    printf("buffer of %u bytes: status 0x%04X\n", stream.buffer_size,
+           (unsigned int)optiga_util_write_data_stream(&optiga_comms, BENCH_OID, OPTIGA_UTIL_WRITE_ONLY, 0, &stream,
+                                                       BENCH_SIZE));
+    bench_usable();
+    printf("differential write: status 0x%04X\n",
+           (unsigned int)optiga_util_write_data_stream(&optiga_comms, BENCH_OID, OPTIGA_UTIL_WRITE_DIFFERENTIAL, 0,
+                                                       &stream, BENCH_SIZE));
+    bench_usable();
+    close(fd);
+    return 0;
+}
+
+/**
+* @}
+*/
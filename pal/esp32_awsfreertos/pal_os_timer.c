@@ -36,6 +36,7 @@
 #include "optiga/pal/pal_os_timer.h"
 #include "FreeRTOS.h"
 #include "task.h"
+#include "esp_timer.h"
 #include "stdio.h"
 /**********************************************************************************************************************
  * MACROS
@@ -67,6 +68,17 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
     return xTaskGetTickCount();
 }
 
+/**
+* Get the time of a monotonic clock in microseconds<br>
+*
+*
+* \retval  uint64_t time in microseconds
+*/
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    return (uint64_t)esp_timer_get_time();
+}
+
 /**
 * Waits or delays until the given milliseconds time
 * 
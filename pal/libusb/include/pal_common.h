@@ -46,7 +46,7 @@
 #include "optiga/pal/pal_i2c.h"
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/common/Datatypes.h"
-#ifdef WIN32
+#if defined(WIN32) || defined(PAL_USB_STANDIN)
 #include "libusb.h"
 #else // LINUX
 #include <libusb-1.0/libusb.h>
@@ -43,7 +43,7 @@
  *********************************************************************************************************************/
 
 #include "optiga/pal/pal.h"
-#ifdef __WIN32__
+#if defined(__WIN32__) || defined(PAL_USB_STANDIN)
 #include "libusb.h"
 #else // LINUX
 #include <libusb-1.0/libusb.h>
@@ -89,6 +89,24 @@
 #define I2C_STATUS_CONTROLLER_IDLE  0x20
 #define I2C_STATUS_BUS_BUSY         0x40
 
+// Status polling of the I2C controller, the interval doubles from the minimum up to the maximum
+#ifndef PAL_USB_STATUS_POLL_MIN_US
+#define PAL_USB_STATUS_POLL_MIN_US  (250)
+#endif
+#ifndef PAL_USB_STATUS_POLL_MAX_US
+#define PAL_USB_STATUS_POLL_MAX_US  (2000)
+#endif
+// Longest time libusb events are waited for in one go while an I2C request is pending
+#ifndef PAL_USB_EVENT_MAX_WAIT_US
+#define PAL_USB_EVENT_MAX_WAIT_US   (10000)
+#endif
+
+// Steps of an I2C request
+#define PAL_USB_STATE_IDLE          (0x00)
+#define PAL_USB_STATE_REQUEST       (0x01)
+#define PAL_USB_STATE_STATUS        (0x02)
+#define PAL_USB_STATE_RECEIVE       (0x03)
+
 #define false 0
 #define true 1
 
@@ -107,6 +125,19 @@
 */
 LIBRARY_EXPORTS void get_pal_context(void *_optiga_pal_i2c_context_0,int32_t context_type);
 
+/** @brief Statistics of the I2C requests, may be read and cleared by the application */
+typedef struct pal_usb_stats
+{
+    /// Number of I2C write and read requests sent to the bridge
+    uint32_t requests;
+    /// Number of I2C status reports fetched
+    uint32_t status_polls;
+    /// Number of status reports with the I2C controller still busy
+    uint32_t busy_polls;
+    /// Number of requests failed on USB or reported as failed by the bridge
+    uint32_t errors;
+} pal_usb_stats_t;
+
 /** @brief PAL I2C context structure */
 typedef struct pal_usb
 {
@@ -116,7 +147,76 @@ typedef struct pal_usb
     uint8_t hid_ep_in;
     /// Endpoint to write to device
     uint8_t hid_ep_out;
-   
+    /// Step of the pending I2C request, #PAL_USB_STATE_IDLE if none
+    uint8_t state;
+    /// Transfer used by all steps of an I2C request, allocated by pal_init
+    struct libusb_transfer* p_transfer;
+    /// Buffer of the transfer, a report or a control setup packet followed by a feature report
+    uint8_t transfer_buffer[LIBUSB_CONTROL_SETUP_SIZE + HID_REPORT_SIZE];
+    /// Destination of a pending read, NULL for a write
+    uint8_t* p_rx_data;
+    /// Length of a pending read
+    uint16_t rx_length;
+    /// Delay before the next status poll
+    uint32_t poll_interval_us;
+    /// Time at which a busy I2C controller is given up
+    uint64_t deadline_us;
+    /// Statistics of the I2C requests
+    pal_usb_stats_t stats;
 } pal_usb_t;
 
+/**
+ * @brief Waits up to timeout_us for USB transfers to complete and runs their completion handlers.
+ *
+ * Called by the pal os event loop, which is the only context running the handlers.
+ */
+void pal_usb_handle_events(uint32_t timeout_us);
+
+/**
+ * @brief Checks whether an I2C request is waiting for a USB transfer.
+ */
+bool_t pal_usb_is_busy(void);
+
+#ifdef PAL_USB_STANDIN
+// Latency of a USB transfer of the stand-in bridge, the interrupt endpoints are polled every full speed frame
+#ifndef PAL_USB_STANDIN_LATENCY_US
+#define PAL_USB_STANDIN_LATENCY_US      (1000)
+#endif
+// Address of the I2C memory behind the stand-in bridge
+#ifndef PAL_USB_STANDIN_SLAVE_ADDRESS
+#define PAL_USB_STANDIN_SLAVE_ADDRESS   (0x30)
+#endif
+
+/** @brief Behaviour of the stand-in bridge, may be changed by the application at any time */
+typedef struct pal_usb_standin_config
+{
+    /// Time from the submission to the completion of a transfer
+    uint32_t latency_us;
+    /// I2C address acknowledged by the memory
+    uint8_t slave_address;
+    /// Time the memory does not acknowledge its address after a write, as an EEPROM during its write cycle
+    uint32_t write_cycle_us;
+} pal_usb_standin_config_t;
+
+/** @brief Activity seen by the stand-in bridge since libusb_init */
+typedef struct pal_usb_standin_stats
+{
+    /// Number of control transfers, i.e. feature reports
+    uint32_t control_transfers;
+    /// Number of interrupt transfers carrying a report
+    uint32_t interrupt_transfers;
+    /// Number of I2C write and read requests
+    uint32_t i2c_requests;
+    /// Number of I2C status reports answered while the controller was busy
+    uint32_t busy_status_reports;
+    /// Number of I2C requests not acknowledged by the memory
+    uint32_t nacks;
+} pal_usb_standin_stats_t;
+
+/// Configuration of the stand-in bridge
+extern pal_usb_standin_config_t pal_usb_standin_config;
+/// Statistics of the stand-in bridge
+extern pal_usb_standin_stats_t pal_usb_standin_stats;
+#endif
+
 #endif
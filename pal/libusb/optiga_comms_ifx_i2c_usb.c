@@ -66,12 +66,14 @@
 static host_lib_status_t check_optiga_comms_state(optiga_comms_t *p_ctx);
 static void ifx_i2c_event_handler(void* upper_layer_ctx, host_lib_status_t event);
 
-uint16_t completion_status;
+/// Status of the ongoing operation, OPTIGA_COMMS_BUSY until the ifx i2c stack reports its completion
+static volatile uint32_t completion_status;
 
 extern pal_i2c_t optiga_pal_i2c_context_0;
 //pal_gpio_t optiga_vdd_0;
 extern pal_gpio_t optiga_reset_0;
-extern void pal_os_event_trigger_registered_callback(void);
+
+static uint8_t ifx_i2c_frame_arena_1[IFX_I2C_FRAME_ARENA_SIZE(55)];
 
 ifx_i2c_context_t ifx_i2c_context_1 =
 {
@@ -86,7 +88,15 @@ ifx_i2c_context_t ifx_i2c_context_1 =
     /// Reset pin
     &optiga_reset_0,
     /// optiga pal i2c context
-    &optiga_pal_i2c_context_0
+    &optiga_pal_i2c_context_0,
+    /// Warm open
+    FALSE,
+    /// Frame arena
+    ifx_i2c_frame_arena_1,
+    /// Size of the frame arena
+    sizeof(ifx_i2c_frame_arena_1),
+    /// Response pin, the bridge has none
+    NULL
 };
 
 //pal_i2c_t optiga_pal_i2c_context_0;
@@ -146,10 +156,7 @@ host_lib_status_t optiga_comms_open(optiga_comms_t *p_ctx)
             p_ctx->state = OPTIGA_COMMS_FREE;
             return status;
         }
-        do
-        {
-            pal_os_event_trigger_registered_callback();
-        }while(completion_status == OPTIGA_COMMS_BUSY);
+        pal_os_event_wait(&completion_status, OPTIGA_COMMS_BUSY);
         status = completion_status;
     }
     return status; 
@@ -189,16 +196,14 @@ host_lib_status_t optiga_comms_reset(optiga_comms_t *p_ctx,uint8_t reset_type)
     {
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        completion_status = OPTIGA_COMMS_BUSY;
         status = ifx_i2c_reset((ifx_i2c_context_t*)(p_ctx->comms_ctx),(ifx_i2c_reset_type_t)reset_type); 
         if (IFX_I2C_STACK_SUCCESS != status)
         {
             p_ctx->state = OPTIGA_COMMS_FREE;
             return status;
         }
-        do
-        {       
-            pal_os_event_trigger_registered_callback();
-        }while(completion_status == OPTIGA_COMMS_BUSY);
+        pal_os_event_wait(&completion_status, OPTIGA_COMMS_BUSY);
     }
     return status;
 }
@@ -259,10 +264,69 @@ host_lib_status_t optiga_comms_transceive(optiga_comms_t *p_ctx,const uint8_t* p
             p_ctx->state = OPTIGA_COMMS_FREE;
             return status;
         }
-        do
+        pal_os_event_wait(&completion_status, OPTIGA_COMMS_BUSY);
+
+        status = completion_status;
+    }
+    return status;
+}
+
+/**
+ * Sends a command to OPTIGA and receives a response, both scattered over several buffers.<br>
+ *
+ *
+ *<b>Pre Conditions:</b>
+ * - Communication channel must be established with OPTIGA.<br>
+ *
+ *<b>API Details:</b>
+ * - Same as #optiga_comms_transceive(), the command is the concatenation of the transmit segments
+ *   and the response is stored in the receive segments in order.<br>
+ * - The segments are framed and filled directly, e.g. an APDU header and the caller's payload are sent
+ *   without assembling the APDU in a separate buffer first.<br>
+ *<br>
+ *
+ *<b>User Input:</b><br>
+ * - The same as for #optiga_comms_transceive().<br>
+ * - The segments and the buffers they point to must remain valid until the transceive is completed.<br>
+ *
+ *<b>Notes:</b>
+ * - The actual number of bytes received is stored in p_buffer_len.<br>
+ * - If the receive segments are insufficient to copy the response bytes then
+ *   #IFX_I2C_STACK_MEM_ERROR error is returned.
+ *
+ *
+ * \param[in,out] p_ctx             Pointer to #optiga_comms_t
+ * \param[in]     p_tx_vector       Segments of the command
+ * \param[in]     tx_count          Number of segments in p_tx_vector
+ * \param[in]     p_rx_vector       Segments of the receive buffer
+ * \param[in]     rx_count          Number of segments in p_rx_vector
+ * \param[out]    p_buffer_len      Number of bytes received
+ *
+ * \retval  #OPTIGA_COMMS_SUCCESS
+ * \retval  #OPTIGA_COMMS_ERROR
+ * \retval  #IFX_I2C_STACK_MEM_ERROR
+ */
+host_lib_status_t optiga_comms_transceive_vector(optiga_comms_t *p_ctx,
+                                                 const sbBlob_d* p_tx_vector, uint8_t tx_count,
+                                                 const sbBlob_d* p_rx_vector, uint8_t rx_count,
+                                                 uint16_t* p_buffer_len)
+{
+    host_lib_status_t status = OPTIGA_COMMS_ERROR;
+    if (OPTIGA_COMMS_SUCCESS == check_optiga_comms_state(p_ctx))
+    {
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
+        ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+
+        completion_status = OPTIGA_COMMS_BUSY;
+
+        status = ifx_i2c_transceive_vector((ifx_i2c_context_t*)(p_ctx->comms_ctx), p_tx_vector, tx_count,
+                                           p_rx_vector, rx_count, p_buffer_len);
+        if (IFX_I2C_STACK_SUCCESS != status)
         {
-            pal_os_event_trigger_registered_callback();
-        }while(completion_status == OPTIGA_COMMS_BUSY);
+            p_ctx->state = OPTIGA_COMMS_FREE;
+            return status;
+        }
+        pal_os_event_wait(&completion_status, OPTIGA_COMMS_BUSY);
 
         status = completion_status;
     }
@@ -296,16 +360,14 @@ host_lib_status_t optiga_comms_close(optiga_comms_t *p_ctx)
     {      
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->p_upper_layer_ctx = (void*)p_ctx;
         ((ifx_i2c_context_t*)(p_ctx->comms_ctx))->upper_layer_event_handler = ifx_i2c_event_handler;
+        completion_status = OPTIGA_COMMS_BUSY;
         status = ifx_i2c_close((ifx_i2c_context_t*)(p_ctx->comms_ctx)); 
         if (IFX_I2C_STACK_SUCCESS != status)
         {
             p_ctx->state = OPTIGA_COMMS_FREE;
             return status;
         } 
-        do
-        {
-            pal_os_event_trigger_registered_callback();
-        }while(completion_status == OPTIGA_COMMS_BUSY);
+        pal_os_event_wait(&completion_status, OPTIGA_COMMS_BUSY);
     }
     return status;
 }
@@ -327,12 +389,13 @@ static void ifx_i2c_event_handler(void* upper_layer_ctx, host_lib_status_t event
 {
     void* ctx = ((optiga_comms_t*)upper_layer_ctx)->upper_layer_ctx;
     
+    // Free before the handler wakes up the caller, which may start the next transaction right away
+    ((optiga_comms_t*)upper_layer_ctx)->state = OPTIGA_COMMS_FREE;
     if(NULL != ((optiga_comms_t*)upper_layer_ctx)->upper_layer_handler)
     {
         ((optiga_comms_t*)upper_layer_ctx)->upper_layer_handler(ctx,event);
     }
-    completion_status = event;
-    ((optiga_comms_t*)upper_layer_ctx)->state = OPTIGA_COMMS_FREE;
+    pal_os_event_notify(&completion_status, event);
 }
 
 /// @endcond
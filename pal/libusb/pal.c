@@ -38,7 +38,7 @@
  * HEADER FILES
  *********************************************************************************************************************/
 #include "optiga/pal/pal_i2c.h"
-#ifdef __WIN32__
+#if defined(__WIN32__) || defined(PAL_USB_STANDIN)
 #include "libusb.h"
 #else // LINUX
 #include <libusb-1.0/libusb.h>
@@ -129,14 +129,48 @@ pal_status_t pal_init(void)
 		return PAL_I2C_EVENT_ERROR;
 	}
 
+	libusb_free_config_descriptor(config_desc);
+
 	if (ifx_i2c_usb_reset(usb_events) != PAL_STATUS_SUCCESS)
 	{
 		return PAL_I2C_EVENT_ERROR;
 	}
+
+	// Reused by every I2C request, which are submitted asynchronously
+	usb_events.state = PAL_USB_STATE_IDLE;
+	usb_events.p_transfer = libusb_alloc_transfer(0);
+	if (usb_events.p_transfer == NULL)
+	{
+		return PAL_I2C_EVENT_ERROR;
+	}
 	return PAL_STATUS_SUCCESS;
 }
 
 pal_status_t pal_deinit(void)
 {
-    return PAL_STATUS_SUCCESS;
+	if (usb_events.p_transfer != NULL)
+	{
+		if (usb_events.state != PAL_USB_STATE_IDLE)
+		{
+			// Wait for the cancelled transfer to call back before it is freed, unless it is not in flight
+			if (libusb_cancel_transfer(usb_events.p_transfer) != 0)
+			{
+				usb_events.state = PAL_USB_STATE_IDLE;
+			}
+			while (usb_events.state != PAL_USB_STATE_IDLE)
+			{
+				pal_usb_handle_events(PAL_USB_EVENT_MAX_WAIT_US);
+			}
+		}
+		libusb_free_transfer(usb_events.p_transfer);
+		usb_events.p_transfer = NULL;
+	}
+	if (dev_handle != NULL)
+	{
+		libusb_close(dev_handle);
+		dev_handle = NULL;
+		usb_events.handle = NULL;
+		libusb_exit(NULL);
+	}
+	return PAL_STATUS_SUCCESS;
 }
@@ -41,7 +41,7 @@
 //#include <DAVE.h>
 #include "optiga/pal/pal_gpio.h"
 #include "pal_usb.h"
-#ifdef __WIN32__
+#if defined(__WIN32__) || defined(PAL_USB_STANDIN)
 #include "libusb.h"
 #else // LINUX
 #include <libusb-1.0/libusb.h>
@@ -38,12 +38,14 @@
  * HEADER FILES
  *********************************************************************************************************************/
 #include "optiga/pal/pal_i2c.h"
-#ifdef __WIN32__
+#if defined(__WIN32__) || defined(PAL_USB_STANDIN)
 #include "libusb.h"
 #else // LINUX
 #include <libusb-1.0/libusb.h>
 #include <unistd.h>
 #endif
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
 #include "pal_usb.h"
 #include "pal_common.h"
 
@@ -58,6 +60,12 @@
 #define LOG_PAL(...) //printf(__VA_ARGS__)
 #endif
 
+// Size of the I2C status feature report
+#define I2C_STATUS_REPORT_SIZE      (5)
+// Offset of the data in a write request report and in a read input report
+#define I2C_WRITE_DATA_OFFSET       (4)
+#define I2C_READ_DATA_OFFSET        (2)
+
 /// @cond hidden
 /*********************************************************************************************************************
  * LOCAL DATA
@@ -65,8 +73,9 @@
 
 void i2c_master_end_of_transmit_callback(void);
 void i2c_master_end_of_receive_callback(void);
+void i2c_master_error_detected_callback(void);
 void invoke_upper_layer_callback(const pal_i2c_t * p_pal_i2c_ctx, host_lib_status_t event);
-static uint16_t usb_i2c_poll_operation_result(pal_i2c_t * p_i2c_context);
+static void LIBUSB_CALL pal_usb_transfer_callback(struct libusb_transfer * p_transfer);
 
 /* Variable to indicate the re-entrant count of the i2c bus acquire function*/
 static volatile uint32_t g_entry_count = 0;
@@ -160,34 +169,204 @@ void i2c_master_arbitration_lost_callback(void)
 }
 
 
-uint16_t usb_i2c_poll_operation_result(pal_i2c_t * p_i2c_context)
+// Ends the pending request and reports it to the upper layer
+static void pal_usb_complete(pal_usb_t * pal_usb, host_lib_status_t event)
 {
-    uint8_t report[HID_REPORT_SIZE] = {0};
-    LOG_PAL("usb_i2c_poll_operation_result\n. ");
-    while (1)
+    uint8_t * p_rx_data = pal_usb->p_rx_data;
+
+    pal_usb->state = PAL_USB_STATE_IDLE;
+    pal_usb->p_rx_data = NULL;
+    if (PAL_I2C_EVENT_SUCCESS != event)
+    {
+        pal_usb->stats.errors++;
+        i2c_master_error_detected_callback();
+    }
+    else if (NULL != p_rx_data)
+    {
+        i2c_master_end_of_receive_callback();
+    }
+    else
     {
-        if (usb_hid_get_feature(REPORT_ID_I2C_STATUS, report, &usb_events) != 5)
+        i2c_master_end_of_transmit_callback();
+    }
+}
+
+// Submits the transfer prepared for the current step, a failure ends the request
+static void pal_usb_submit(pal_usb_t * pal_usb, uint8_t state)
+{
+    int32_t usb_lib_status;
+
+    pal_usb->state = state;
+    usb_lib_status = libusb_submit_transfer(pal_usb->p_transfer);
+    if (0 != usb_lib_status)
+    {
+        LOG_PAL("[IFX-HAL]: libusb_submit_transfer ERROR %d\n.", usb_lib_status);
+        pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+    }
+}
+
+// Fetches the I2C status report of the bridge, scheduled by pal os event
+static void pal_usb_status_poll(void * p_ctx)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * )p_ctx;
+
+    // Stopped by pal_deinit
+    if (NULL == pal_usb->p_transfer)
+    {
+        return;
+    }
+    libusb_fill_control_setup(pal_usb->transfer_buffer,
+                              LIBUSB_ENDPOINT_IN | LIBUSB_REQUEST_TYPE_CLASS | LIBUSB_RECIPIENT_INTERFACE,
+                              HID_REQ_GET_REPORT,
+                              (HID_REPORT_TYPE_FEATURE << 8) | REPORT_ID_I2C_STATUS, USB_INTERFACE,
+                              HID_REPORT_SIZE);
+    libusb_fill_control_transfer(pal_usb->p_transfer, pal_usb->handle, pal_usb->transfer_buffer,
+                                 pal_usb_transfer_callback, pal_usb, USB_TIMEOUT);
+    pal_usb->stats.status_polls++;
+    pal_usb_submit(pal_usb, PAL_USB_STATE_STATUS);
+}
+
+// Fetches the input report with the data of a read request
+static void pal_usb_receive(pal_usb_t * pal_usb)
+{
+    memset(pal_usb->transfer_buffer, 0x00, HID_REPORT_SIZE);
+    libusb_fill_interrupt_transfer(pal_usb->p_transfer, pal_usb->handle, pal_usb->hid_ep_in,
+                                   pal_usb->transfer_buffer, HID_REPORT_SIZE,
+                                   pal_usb_transfer_callback, pal_usb, USB_TIMEOUT);
+    pal_usb_submit(pal_usb, PAL_USB_STATE_RECEIVE);
+}
+
+/*
+ * The request is done once the controller is idle and the bus is free. While the controller is busy the status
+ * is polled again after an interval doubling up to PAL_USB_STATUS_POLL_MAX_US, for at most USB_TIMEOUT.
+ */
+static void pal_usb_status_received(pal_usb_t * pal_usb, const uint8_t * p_report)
+{
+    uint8_t status = p_report[1];
+
+    if (!(status & I2C_STATUS_CONTROLLER_BUSY))
+    {
+        if (status & I2C_STATUS_ERROR_CONDITION)
         {
-            LOG_PAL("[IFX-HAL]: USB get I2C status failed.\n");
-            return PAL_I2C_EVENT_ERROR;
+            pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+            return;
         }
-
-        if (!(report[1] & I2C_STATUS_CONTROLLER_BUSY))
+        if ((status & I2C_STATUS_CONTROLLER_IDLE) && !(status & I2C_STATUS_BUS_BUSY))
         {
-            if (report[1] & I2C_STATUS_ERROR_CONDITION)
+            if (NULL != pal_usb->p_rx_data)
+            {
+                pal_usb_receive(pal_usb);
+            }
+            else
             {
-                return PAL_I2C_EVENT_ERROR;
+                pal_usb_complete(pal_usb, PAL_I2C_EVENT_SUCCESS);
             }
+            return;
+        }
+    }
+
+    if (pal_os_timer_get_time_in_microseconds() > pal_usb->deadline_us)
+    {
+        LOG_PAL("[IFX-HAL]: I2C controller busy for too long.\n");
+        pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+        return;
+    }
+    pal_usb->stats.busy_polls++;
+    pal_os_event_register_callback_oneshot(pal_usb_status_poll, pal_usb, pal_usb->poll_interval_us);
+    pal_usb->poll_interval_us = (pal_usb->poll_interval_us < (PAL_USB_STATUS_POLL_MAX_US / 2)) ?
+                                (pal_usb->poll_interval_us * 2) : PAL_USB_STATUS_POLL_MAX_US;
+}
+
+// Completion of every transfer of a request, runs from pal_usb_handle_events
+static void LIBUSB_CALL pal_usb_transfer_callback(struct libusb_transfer * p_transfer)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * )p_transfer->user_data;
+    uint8_t * p_report = p_transfer->buffer;
+
+    if (LIBUSB_TRANSFER_COMPLETED != p_transfer->status)
+    {
+        LOG_PAL("[IFX-HAL]: USB transfer failed, status %d in step %d.\n", p_transfer->status, pal_usb->state);
+        pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+        return;
+    }
 
-            if (report[1] & I2C_STATUS_CONTROLLER_IDLE)
+    switch (pal_usb->state)
+    {
+        case PAL_USB_STATE_REQUEST:
+        {
+            if (HID_REPORT_SIZE != p_transfer->actual_length)
+            {
+                pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+                break;
+            }
+            // The round trip of the first poll usually covers the I2C transfer, later ones back off
+            pal_usb->poll_interval_us = PAL_USB_STATUS_POLL_MIN_US;
+            pal_usb->deadline_us = pal_os_timer_get_time_in_microseconds() + ((uint64_t)USB_TIMEOUT * 1000);
+            pal_usb_status_poll(pal_usb);
+        }
+        break;
+        case PAL_USB_STATE_STATUS:
+        {
+            if (I2C_STATUS_REPORT_SIZE != p_transfer->actual_length)
             {
-                if (!(report[1] & I2C_STATUS_BUS_BUSY))
-                {
-                    return PAL_STATUS_SUCCESS;
-                }
+                LOG_PAL("[IFX-HAL]: USB get I2C status failed.\n");
+                pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+                break;
             }
+            pal_usb_status_received(pal_usb, libusb_control_transfer_get_data(p_transfer));
         }
+        break;
+        case PAL_USB_STATE_RECEIVE:
+        {
+            if ((p_transfer->actual_length < (I2C_READ_DATA_OFFSET + pal_usb->rx_length)) ||
+                (p_report[1] != pal_usb->rx_length))
+            {
+                pal_usb_complete(pal_usb, PAL_I2C_EVENT_ERROR);
+                break;
+            }
+            memcpy(pal_usb->p_rx_data, &p_report[I2C_READ_DATA_OFFSET], pal_usb->rx_length);
+            pal_usb_complete(pal_usb, PAL_I2C_EVENT_SUCCESS);
+        }
+        break;
+        default:
+        break;
+    }
+}
+
+// Sends the request report prepared in the transfer buffer, the request goes on in pal_usb_transfer_callback
+static pal_status_t pal_usb_send_request(pal_i2c_t * p_i2c_context)
+{
+    pal_usb_t * pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+
+    libusb_fill_interrupt_transfer(pal_usb->p_transfer, pal_usb->handle, pal_usb->hid_ep_out,
+                                   pal_usb->transfer_buffer, HID_REPORT_SIZE,
+                                   pal_usb_transfer_callback, pal_usb, USB_TIMEOUT);
+    pal_usb->stats.requests++;
+    pal_usb->state = PAL_USB_STATE_REQUEST;
+    if (0 != libusb_submit_transfer(pal_usb->p_transfer))
+    {
+        pal_usb->state = PAL_USB_STATE_IDLE;
+        pal_usb->p_rx_data = NULL;
+        pal_usb->stats.errors++;
+        //If I2C Master fails to invoke the operation, invoke upper layer event handler with error.
+        invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
+        return PAL_STATUS_FAILURE;
     }
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_usb_handle_events(uint32_t timeout_us)
+{
+    struct timeval timeout;
+
+    timeout.tv_sec = (long)(timeout_us / 1000000);
+    timeout.tv_usec = (long)(timeout_us % 1000000);
+    (void)libusb_handle_events_timeout_completed(NULL, &timeout, NULL);
+}
+
+bool_t pal_usb_is_busy(void)
+{
+    return (PAL_USB_STATE_IDLE != usb_events.state) ? TRUE : FALSE;
 }
 
 /// @endcond
@@ -287,52 +466,32 @@ pal_status_t pal_i2c_deinit(const pal_i2c_t * p_i2c_context)
 pal_status_t pal_i2c_write(pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
 {
     pal_status_t status = PAL_STATUS_FAILURE;
-    int32_t usb_lib_status;
-    int32_t transfered = 0;
     pal_usb_t * pal_usb;
-    uint8_t report[HID_REPORT_SIZE] = {0};
+    uint8_t * report;
 
     pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
-    report[0] = REPORT_ID_I2C_WRITE_REQ;
-    report[1] = p_i2c_context->slave_address;
-    report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
-    report[3] = (uint8_t)length;
+    report = pal_usb->transfer_buffer;
 
-    memcpy(&report[4], p_data, length);
     //Acquire the I2C bus before read/write
-
     if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {
         gp_pal_i2c_current_ctx = p_i2c_context;
-
-        //Invoke the low level i2c master driver API to write to the bus
-        usb_lib_status = libusb_interrupt_transfer(pal_usb->handle,
-                                                   pal_usb->hid_ep_out,
-                                                   report,
-                                                   sizeof(report),
-                                                   &transfered,
-                                                   USB_TIMEOUT);
-        if (usb_lib_status != 0 || transfered != HID_REPORT_SIZE)
-        {
-            //If I2C Master fails to invoke the write operation, invoke upper layer event handler with error.
-            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
-            ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))
-                                                       (p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-            //Release I2C Bus
-            pal_i2c_release((void * )p_i2c_context);
-        }
-        else
+        if ((NULL == pal_usb->p_transfer) || (length > (HID_REPORT_SIZE - I2C_WRITE_DATA_OFFSET)))
         {
-            if (usb_i2c_poll_operation_result(p_i2c_context) == PAL_STATUS_SUCCESS)
-            {
-                i2c_master_end_of_transmit_callback();
-                status = PAL_STATUS_SUCCESS;
-            }
-            else
-            {
-                invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
-            }
+            invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
+            return status;
         }
+
+        memset(report, 0x00, HID_REPORT_SIZE);
+        report[0] = REPORT_ID_I2C_WRITE_REQ;
+        report[1] = p_i2c_context->slave_address;
+        report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
+        report[3] = (uint8_t)length;
+        memcpy(&report[I2C_WRITE_DATA_OFFSET], p_data, length);
+        pal_usb->p_rx_data = NULL;
+
+        //Invoke the low level i2c master driver API to write to the bus, completed by pal_usb_transfer_callback
+        status = pal_usb_send_request(p_i2c_context);
     }
     else
     {
@@ -378,71 +537,44 @@ pal_status_t pal_i2c_write(pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t
  */
 pal_status_t pal_i2c_read(pal_i2c_t * p_i2c_context, uint8_t * p_data, uint16_t length)
 {
-    int32_t usb_lib_status = PAL_STATUS_FAILURE;
-    int32_t transfered;
-    uint8_t report[HID_REPORT_SIZE] = {0};
-    uint16_t rx_result;
+    pal_status_t status = PAL_STATUS_FAILURE;
     pal_usb_t * pal_usb;
+    uint8_t * report;
     LOG_PAL("[IFX-HAL]: I2C RX (%d)\n", length);
 
-    report[0] = REPORT_ID_I2C_READ_REQ;
-    report[1] = p_i2c_context->slave_address;
-    report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
-    report[3] = (uint8_t)length;
-    report[4] = 0;
     pal_usb = (pal_usb_t * ) p_i2c_context->p_i2c_hw_config;
+    report = pal_usb->transfer_buffer;
+
     //Acquire the I2C bus before read/write
     if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
     {
         gp_pal_i2c_current_ctx = p_i2c_context;
-        usb_lib_status = libusb_interrupt_transfer(pal_usb->handle,
-                                                   pal_usb->hid_ep_out,
-                                                   report,
-                                                   sizeof(report),
-                                                   &transfered,
-                                                   USB_TIMEOUT);
-        LOG_PAL("[IFX-HAL]: HID Write status = %d, %d\n", usb_lib_status, transfered);
-        if (usb_lib_status)
-        {
-            LOG_PAL("[IFX-HAL]: libusb_interrupt_transfer ERROR %d\n.", usb_lib_status);
-            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
-            ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))
-                                                       (p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-            return usb_lib_status;
-        }
-        //Invoke the low level i2c master driver API to read from the bus
-        memset(report, 0x00, sizeof(report));
-        transfered = 0;
-        usb_lib_status = libusb_interrupt_transfer(pal_usb->handle,
-                                                   pal_usb->hid_ep_in,
-                                                   report,
-                                                   sizeof(report),
-                                                   &transfered,
-                                                   USB_TIMEOUT);
-        rx_result = usb_i2c_poll_operation_result(p_i2c_context);
-        if (rx_result == PAL_STATUS_SUCCESS && usb_lib_status == 0 && transfered >= (2 + length) && report[1] == length)
+        if ((NULL == pal_usb->p_transfer) || (length > (HID_REPORT_SIZE - I2C_READ_DATA_OFFSET)))
         {
-            memcpy(p_data, &report[2], report[1]);
-            usb_lib_status = PAL_STATUS_SUCCESS;
-            i2c_master_end_of_receive_callback();
-        }
-        else
-        {
-            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
-            ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))
-                                                        (p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_ERROR);
-            //Release I2C Bus
-            pal_i2c_release((void * )p_i2c_context);
+            invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
+            return status;
         }
+
+        memset(report, 0x00, HID_REPORT_SIZE);
+        report[0] = REPORT_ID_I2C_READ_REQ;
+        report[1] = p_i2c_context->slave_address;
+        report[2] = I2C_FLAG_START | I2C_FLAG_STOP;
+        report[3] = (uint8_t)length;
+        report[4] = 0;
+        pal_usb->p_rx_data = p_data;
+        pal_usb->rx_length = length;
+
+        // The data is fetched once the status reports the read as done, a NACK fails without waiting for it
+        status = pal_usb_send_request(p_i2c_context);
     }
     else
     {
-        usb_lib_status = PAL_STATUS_I2C_BUSY;
+        status = PAL_STATUS_I2C_BUSY;
         //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t type"
         ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))
                                                         (p_i2c_context->upper_layer_ctx, PAL_I2C_EVENT_BUSY);
     }
-    return usb_lib_status;
+    return status;
 }
 
 
@@ -30,6 +30,9 @@
 *
 * \brief   This file implements the platform abstraction layer APIs for os event/scheduler.
 *
+* There is no event thread: the thread waiting for a response runs the libusb completions and the pending
+* callbacks from #pal_os_event_wait. It sleeps in libusb until a transfer completes or the next callback is due.
+*
 * \ingroup  grPAL
 * @{
 */
@@ -37,47 +40,100 @@
 /**********************************************************************************************************************
  * HEADER FILES
  *********************************************************************************************************************/
+#include <stdio.h>
 #include "optiga/pal/pal.h"
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_event.h"
+#include "pal_usb.h"
+
+#ifndef PAL_OS_HAS_EVENT_WAIT
+#error "The libusb pal runs the callbacks from pal_os_event_wait, define PAL_OS_HAS_EVENT_WAIT"
+#endif
 
 /**********************************************************************************************************************
  * MACROS
  *********************************************************************************************************************/
-#define CONVERT_US_TO_MS 1000
+/// Maximum number of callback contexts (ifx i2c instances and the USB bridge) with a pending callback
+#ifndef PAL_OS_EVENT_MAX_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES  (4)
+#endif
 
 /*********************************************************************************************************************
  * LOCAL DATA
  *********************************************************************************************************************/
 /// @cond hidden 
-/// Callback function when timer elapses
-static volatile register_callback callback_registered = NULL;
-/// Pointer to store upper layer callback context (For example: Ifx i2c context)
-static void * callback_ctx;
-/// User provided delay
-static uint32_t timer_delay_in_ms = 0;
-/// Timer required or not
-static volatile uint8_t time_required = 0;
-/// To maintain thread status
-static volatile uint8_t timer_stub_is_active = 0;
+/** \brief PAL os event structure, a pending one-shot callback */
+typedef struct pal_os_event
+{
+    /// Expiry time on the microsecond timer
+    uint64_t deadline_us;
+    /// Registration order, callbacks with the same expiry run in this order
+    uint32_t sequence;
+    /// registered callback, NULL if the slot is free
+    register_callback callback_registered;
+    /// context to be passed to callback
+    void * callback_ctx;
+}pal_os_event_t;
 
-pal_status_t pal_os_event_init(void)
+// Each callback context has at most one pending callback, registering again for the same context replaces it
+static pal_os_event_t pal_os_event_slots[PAL_OS_EVENT_MAX_INSTANCES];
+static uint32_t pal_os_event_sequence = 0;
+
+// Earliest pending callback, NULL if none
+static pal_os_event_t * pal_os_event_next(void)
+{
+    pal_os_event_t * p_next = NULL;
+    uint32_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if ((NULL != pal_os_event_slots[index].callback_registered) &&
+            ((NULL == p_next) || (pal_os_event_slots[index].deadline_us < p_next->deadline_us) ||
+             ((pal_os_event_slots[index].deadline_us == p_next->deadline_us) &&
+              ((int32_t)(pal_os_event_slots[index].sequence - p_next->sequence) < 0))))
+        {
+            p_next = &pal_os_event_slots[index];
+        }
+    }
+    return p_next;
+}
+
+// Time until the earliest pending callback is due, capped to max_wait_us
+static uint32_t pal_os_event_timeout(uint32_t max_wait_us)
 {
+    pal_os_event_t * p_next = pal_os_event_next();
+    uint64_t now_us = pal_os_timer_get_time_in_microseconds();
 
-	return PAL_STATUS_SUCCESS;
+    if ((NULL == p_next) || (p_next->deadline_us > (now_us + max_wait_us)))
+    {
+        return max_wait_us;
+    }
+    return (p_next->deadline_us > now_us) ? (uint32_t)(p_next->deadline_us - now_us) : 0;
 }
 
-void pal_os_event_trigger_registered_callback(void)
+// Runs the callbacks which are due, in order of expiry
+static void pal_os_event_run_due(void)
 {
+    pal_os_event_t * p_next;
     register_callback callback;
-    if (callback_registered)
+    void * callback_ctx;
+
+    while ((NULL != (p_next = pal_os_event_next())) &&
+           (p_next->deadline_us <= pal_os_timer_get_time_in_microseconds()))
     {
-        callback = callback_registered;
-        callback_registered = NULL;
-        callback((void * )callback_ctx);
+        callback = p_next->callback_registered;
+        callback_ctx = p_next->callback_ctx;
+        // Freed before the call, the callback usually registers the next one for the same context
+        p_next->callback_registered = NULL;
+        callback(callback_ctx);
     }
 }
 
+pal_status_t pal_os_event_init(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
 /// @endcond
 
 /**
@@ -98,13 +154,84 @@ void pal_os_event_register_callback_oneshot(register_callback callback,
                                             void * callback_args, 
                                             uint32_t time_us)
 {
-    callback_registered = callback;
-    callback_ctx = callback_args;
-    time_required = 1;
-    timer_delay_in_ms = (time_us / CONVERT_US_TO_MS);
+    pal_os_event_t * p_slot = NULL;
+    uint32_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if ((NULL != pal_os_event_slots[index].callback_registered) &&
+            (callback_args == pal_os_event_slots[index].callback_ctx))
+        {
+            p_slot = &pal_os_event_slots[index];
+            break;
+        }
+        if ((NULL == p_slot) && (NULL == pal_os_event_slots[index].callback_registered))
+        {
+            p_slot = &pal_os_event_slots[index];
+        }
+    }
+    if (NULL == p_slot)
+    {
+        fprintf(stderr, "Too many pending callbacks, increase PAL_OS_EVENT_MAX_INSTANCES\n");
+        return;
+    }
+    p_slot->deadline_us = pal_os_timer_get_time_in_microseconds() + time_us;
+    p_slot->sequence = pal_os_event_sequence++;
+    p_slot->callback_ctx = callback_args;
+    p_slot->callback_registered = callback;
+}
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+int32_t pal_os_event_get_handle(void)
+{
+    // libusb may use several handles, the caller relies on pal_os_event_get_next_timeout_us instead
+    return -1;
+}
+
+uint32_t pal_os_event_get_next_timeout_us(void)
+{
+    // A pending transfer is checked for completion at the status polling rate
+    if (pal_usb_is_busy())
+    {
+        return pal_os_event_timeout(PAL_USB_STATUS_POLL_MIN_US);
+    }
+    return (NULL == pal_os_event_next()) ? PAL_OS_EVENT_NO_TIMEOUT : pal_os_event_timeout(PAL_OS_EVENT_NO_TIMEOUT - 1);
+}
+
+void pal_os_event_process(void)
+{
+    pal_usb_handle_events(0);
+    pal_os_event_run_due();
 }
+#endif
 
 /**
-* @}
+* Runs the libusb completions and the callbacks until the value at p_status differs from busy_value.
+*
+* \param[in] p_status              Status updated by the upper layer handler
+* \param[in] busy_value            Value of the status while the operation is ongoing
+*
 */
+void pal_os_event_wait(volatile uint32_t* p_status, uint32_t busy_value)
+{
+    uint32_t timeout_us;
+
+    while (busy_value == *p_status)
+    {
+        timeout_us = pal_os_event_timeout(PAL_USB_EVENT_MAX_WAIT_US);
+        if (0 != timeout_us)
+        {
+            pal_usb_handle_events(timeout_us);
+        }
+        pal_os_event_run_due();
+    }
+}
 
+void pal_os_event_notify(volatile uint32_t* p_status, uint32_t new_value)
+{
+    *p_status = new_value;
+}
+
+/**
+* @}
+*/
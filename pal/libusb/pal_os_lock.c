@@ -31,6 +31,7 @@
 */
 
 #include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_event.h"
 
 /**
  * @brief PAL OS lock structure. Might be extended if needed
@@ -66,6 +67,36 @@ void pal_os_lock_release(void)
     }
 }
 
+#ifdef PAL_OS_HAS_LOCK_FLAG
+pal_status_t pal_os_lock_acquire_flag(volatile uint32_t * p_flag)
+{
+    uint8_t acquired = FALSE;
+
+    do
+    {
+        while (PAL_STATUS_SUCCESS != pal_os_lock_acquire()){};
+        if (FALSE == *p_flag)
+        {
+            *p_flag = TRUE;
+            acquired = TRUE;
+        }
+        pal_os_lock_release();
+
+        if (FALSE == acquired)
+        {
+            // Waiting runs the libusb callbacks which complete the command of the holder
+            pal_os_event_wait(p_flag, TRUE);
+        }
+    } while (FALSE == acquired);
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_os_lock_release_flag(volatile uint32_t * p_flag)
+{
+    pal_os_event_notify(p_flag, FALSE);
+}
+#endif
+
 /**
 * @}
 */
@@ -50,6 +50,7 @@
 #include <stdio.h>
 #include <stdint.h>
 #include "optiga/common/Datatypes.h"
+#include "optiga/pal/pal_os_timer.h"
 
 /**********************************************************************************************************************
  * MACROS
@@ -87,14 +88,35 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
 #else
 uint32_t pal_os_timer_get_time_in_milliseconds(void)
 {
-    long ms; // Milliseconds
+    return (uint32_t)(pal_os_timer_get_time_in_microseconds() / 1000);
+}
+#endif
+
+/**
+ * Function to get the time of a monotonic clock in microseconds
+ *
+ * \retval  uint64_t time in microseconds
+ */
+#ifdef __WIN32__
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (uint64_t)((counter.QuadPart / frequency.QuadPart) * 1000000) +
+           (uint64_t)(((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+}
+#else
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
     struct timespec spec;
- 
-    clock_gettime(CLOCK_REALTIME, &spec);
- 
-    ms = round(spec.tv_nsec / 1.0e6); // Convert nanoseconds to milliseconds
- 
-    return ms;
+
+    clock_gettime(CLOCK_MONOTONIC, &spec);
+
+    return ((uint64_t)spec.tv_sec * 1000000) + ((uint64_t)spec.tv_nsec / 1000);
 }
 #endif
 
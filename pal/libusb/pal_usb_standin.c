@@ -0,0 +1,589 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_usb_standin.c
+*
+* \brief   This file implements a stand-in for libusb and the FT260 USB to I2C bridge.
+*
+* Built instead of linking libusb if PAL_USB_STANDIN is defined, which allows to run the libusb pal without
+* hardware. The bridge answers the HID reports used by the pal with the timing of a full speed device, an I2C
+* memory is connected to it. Transfers complete from #libusb_handle_events_timeout_completed only, as with
+* libusb, the synchronous transfers are built on top of the asynchronous ones.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+/**********************************************************************************************************************
+ * HEADER FILES
+ *********************************************************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "optiga/pal/pal_os_timer.h"
+#include "pal_usb.h"
+
+#ifndef PAL_USB_STANDIN
+#error "pal_usb_standin.c replaces libusb, define PAL_USB_STANDIN or link libusb instead"
+#endif
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// Maximum number of transfers submitted at the same time
+#define PAL_USB_STANDIN_MAX_TRANSFERS   (4)
+/// I2C status bits reported while a request is ongoing
+#define PAL_USB_STANDIN_BUSY            (I2C_STATUS_CONTROLLER_BUSY | I2C_STATUS_BUS_BUSY)
+/// I2C status bits reported for an address NACK
+#define PAL_USB_STANDIN_ADDRESS_NACK    (0x02 | 0x04)
+/// First report ID of the I2C input reports, increased by one per 4 data bytes
+#define PAL_USB_STANDIN_I2C_INPUT       (0xD0)
+
+/// @cond hidden
+/*********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+struct libusb_device
+{
+    struct libusb_config_descriptor config;
+    struct libusb_interface interface;
+    struct libusb_interface_descriptor altsetting;
+    struct libusb_endpoint_descriptor endpoint[2];
+};
+
+struct libusb_device_handle
+{
+    libusb_device * p_device;
+};
+
+// A submitted transfer and the time it completes
+typedef struct pal_usb_standin_transfer
+{
+    struct libusb_transfer * p_transfer;
+    uint64_t due_us;
+} pal_usb_standin_transfer_t;
+
+// The bridge, the I2C memory behind it and the transfers in flight
+typedef struct pal_usb_standin_device
+{
+    uint8_t gpio[4];
+    uint8_t i2c_status;
+    uint64_t i2c_done_us;
+    uint8_t input_report[HID_REPORT_SIZE];
+    uint8_t input_pending;
+    uint8_t memory[256];
+    uint8_t memory_pointer;
+    uint64_t write_cycle_end_us;
+    pal_usb_standin_transfer_t pending[PAL_USB_STANDIN_MAX_TRANSFERS];
+} pal_usb_standin_device_t;
+
+static libusb_device pal_usb_standin_ft260;
+static libusb_device_handle pal_usb_standin_handle = {&pal_usb_standin_ft260};
+static pal_usb_standin_device_t pal_usb_standin_device;
+
+pal_usb_standin_config_t pal_usb_standin_config =
+{
+    PAL_USB_STANDIN_LATENCY_US,
+    PAL_USB_STANDIN_SLAVE_ADDRESS,
+    0,
+};
+pal_usb_standin_stats_t pal_usb_standin_stats;
+
+/**********************************************************************************************************************
+ * LOCAL ROUTINES
+ *********************************************************************************************************************/
+static void pal_usb_standin_sleep_until(uint64_t time_us)
+{
+    struct timespec delay;
+    uint64_t now_us = pal_os_timer_get_time_in_microseconds();
+
+    if (time_us > now_us)
+    {
+        delay.tv_sec = (time_t)((time_us - now_us) / 1000000);
+        delay.tv_nsec = (long)(((time_us - now_us) % 1000000) * 1000);
+        nanosleep(&delay, NULL);
+    }
+}
+
+// Time the I2C controller needs for the address and length bytes, at 400 KHz
+static uint32_t pal_usb_standin_i2c_time(uint16_t length)
+{
+    return (((uint32_t)length + 1) * 9 * 1000) / 400;
+}
+
+// Starts the I2C request of an output report at time_us, the effect is visible once the controller is done
+static void pal_usb_standin_i2c_request(pal_usb_standin_device_t * p_device, const uint8_t * p_report, uint64_t time_us)
+{
+    uint8_t length = p_report[3];
+    uint8_t index;
+
+    pal_usb_standin_stats.i2c_requests++;
+    p_device->input_pending = FALSE;
+
+    // The memory does not acknowledge its address during the write cycle
+    if ((p_report[1] != pal_usb_standin_config.slave_address) || (time_us < p_device->write_cycle_end_us))
+    {
+        pal_usb_standin_stats.nacks++;
+        p_device->i2c_status = I2C_STATUS_CONTROLLER_IDLE | PAL_USB_STANDIN_ADDRESS_NACK;
+        p_device->i2c_done_us = time_us + pal_usb_standin_i2c_time(0);
+        return;
+    }
+
+    p_device->i2c_status = I2C_STATUS_CONTROLLER_IDLE;
+    p_device->i2c_done_us = time_us + pal_usb_standin_i2c_time(length);
+    if (REPORT_ID_I2C_WRITE_REQ == p_report[0])
+    {
+        // The first byte sets the memory pointer, the following ones are stored
+        if (0 != length)
+        {
+            p_device->memory_pointer = p_report[4];
+            for (index = 1; index < length; index++)
+            {
+                p_device->memory[p_device->memory_pointer++] = p_report[4 + index];
+            }
+            if (1 < length)
+            {
+                p_device->write_cycle_end_us = p_device->i2c_done_us + pal_usb_standin_config.write_cycle_us;
+            }
+        }
+    }
+    else
+    {
+        memset(p_device->input_report, 0x00, sizeof(p_device->input_report));
+        p_device->input_report[0] = PAL_USB_STANDIN_I2C_INPUT + ((0 != length) ? ((length - 1) / 4) : 0);
+        p_device->input_report[1] = length;
+        for (index = 0; index < length; index++)
+        {
+            p_device->input_report[2 + index] = p_device->memory[p_device->memory_pointer++];
+        }
+        p_device->input_pending = TRUE;
+
+        // An input transfer already waiting gets the report as soon as the read is done
+        for (index = 0; index < PAL_USB_STANDIN_MAX_TRANSFERS; index++)
+        {
+            if ((NULL != p_device->pending[index].p_transfer) &&
+                (LIBUSB_TRANSFER_TYPE_INTERRUPT == p_device->pending[index].p_transfer->type) &&
+                (0 != (p_device->pending[index].p_transfer->endpoint & LIBUSB_ENDPOINT_IN)) &&
+                (LIBUSB_TRANSFER_CANCELLED != p_device->pending[index].p_transfer->status))
+            {
+                p_device->pending[index].due_us = p_device->i2c_done_us;
+            }
+        }
+    }
+}
+
+// Answers a control transfer on the HID interface at time_us
+static void pal_usb_standin_control(pal_usb_standin_device_t * p_device, struct libusb_transfer * p_transfer,
+                                    uint64_t time_us)
+{
+    struct libusb_control_setup * p_setup = libusb_control_transfer_get_setup(p_transfer);
+    uint8_t * p_data = libusb_control_transfer_get_data(p_transfer);
+    uint8_t report_id = (uint8_t)(libusb_le16_to_cpu(p_setup->wValue) & 0xFF);
+
+    pal_usb_standin_stats.control_transfers++;
+    p_transfer->status = LIBUSB_TRANSFER_COMPLETED;
+    p_transfer->actual_length = 0;
+
+    if (HID_REQ_GET_REPORT == p_setup->bRequest)
+    {
+        memset(p_data, 0x00, libusb_le16_to_cpu(p_setup->wLength));
+        p_data[0] = report_id;
+        if (REPORT_ID_I2C_STATUS == report_id)
+        {
+            if (time_us < p_device->i2c_done_us)
+            {
+                pal_usb_standin_stats.busy_status_reports++;
+                p_data[1] = PAL_USB_STANDIN_BUSY;
+            }
+            else
+            {
+                p_data[1] = p_device->i2c_status;
+            }
+            p_transfer->actual_length = 5;
+        }
+        else if (REPORT_ID_GPIO == report_id)
+        {
+            memcpy(&p_data[1], p_device->gpio, sizeof(p_device->gpio));
+            p_transfer->actual_length = 5;
+        }
+        else
+        {
+            p_transfer->status = LIBUSB_TRANSFER_STALL;
+        }
+    }
+    else if (HID_REQ_SET_REPORT == p_setup->bRequest)
+    {
+        if (REPORT_ID_GPIO == report_id)
+        {
+            memcpy(p_device->gpio, &p_data[1], sizeof(p_device->gpio));
+        }
+        else if (REPORT_ID_SYSTEM_SETTING != report_id)
+        {
+            p_transfer->status = LIBUSB_TRANSFER_STALL;
+        }
+        p_transfer->actual_length = libusb_le16_to_cpu(p_setup->wLength);
+    }
+    else
+    {
+        p_transfer->status = LIBUSB_TRANSFER_STALL;
+    }
+}
+
+// Time at which a submitted transfer completes, the input report waits for the I2C read
+static uint64_t pal_usb_standin_due(const pal_usb_standin_device_t * p_device, const struct libusb_transfer * p_transfer,
+                                    uint64_t now_us)
+{
+    uint64_t due_us = now_us + pal_usb_standin_config.latency_us;
+
+    if ((LIBUSB_TRANSFER_TYPE_INTERRUPT == p_transfer->type) && (0 != (p_transfer->endpoint & LIBUSB_ENDPOINT_IN)))
+    {
+        if (!p_device->input_pending)
+        {
+            // Nothing to send, the host polls until the transfer times out
+            return now_us + ((uint64_t)p_transfer->timeout * 1000);
+        }
+        if (p_device->i2c_done_us > due_us)
+        {
+            due_us = p_device->i2c_done_us;
+        }
+    }
+    return due_us;
+}
+
+// Completes a transfer which is due and calls its callback
+static void pal_usb_standin_complete(pal_usb_standin_device_t * p_device, pal_usb_standin_transfer_t * p_pending)
+{
+    struct libusb_transfer * p_transfer = p_pending->p_transfer;
+    uint64_t due_us = p_pending->due_us;
+
+    p_pending->p_transfer = NULL;
+    if (LIBUSB_TRANSFER_CANCELLED == p_transfer->status)
+    {
+        p_transfer->actual_length = 0;
+    }
+    else if (LIBUSB_TRANSFER_TYPE_CONTROL == p_transfer->type)
+    {
+        pal_usb_standin_control(p_device, p_transfer, due_us);
+    }
+    else if (0 == (p_transfer->endpoint & LIBUSB_ENDPOINT_IN))
+    {
+        pal_usb_standin_stats.interrupt_transfers++;
+        pal_usb_standin_i2c_request(p_device, p_transfer->buffer, due_us);
+        p_transfer->actual_length = p_transfer->length;
+        p_transfer->status = LIBUSB_TRANSFER_COMPLETED;
+    }
+    else if (p_device->input_pending)
+    {
+        pal_usb_standin_stats.interrupt_transfers++;
+        memcpy(p_transfer->buffer, p_device->input_report, (size_t)p_transfer->length);
+        p_device->input_pending = FALSE;
+        p_transfer->actual_length = p_transfer->length;
+        p_transfer->status = LIBUSB_TRANSFER_COMPLETED;
+    }
+    else
+    {
+        p_transfer->actual_length = 0;
+        p_transfer->status = LIBUSB_TRANSFER_TIMED_OUT;
+    }
+    p_transfer->callback(p_transfer);
+}
+
+// Earliest pending transfer, NULL if none
+static pal_usb_standin_transfer_t * pal_usb_standin_next(pal_usb_standin_device_t * p_device)
+{
+    pal_usb_standin_transfer_t * p_next = NULL;
+    uint32_t index;
+
+    for (index = 0; index < PAL_USB_STANDIN_MAX_TRANSFERS; index++)
+    {
+        if ((NULL != p_device->pending[index].p_transfer) &&
+            ((NULL == p_next) || (p_device->pending[index].due_us < p_next->due_us)))
+        {
+            p_next = &p_device->pending[index];
+        }
+    }
+    return p_next;
+}
+
+static void LIBUSB_CALL pal_usb_standin_sync_callback(struct libusb_transfer * p_transfer)
+{
+    *(int *)p_transfer->user_data = 1;
+}
+
+// Runs a transfer to completion as the synchronous libusb API does
+static int pal_usb_standin_sync(struct libusb_transfer * p_transfer)
+{
+    int completed = 0;
+    int status;
+
+    p_transfer->callback = pal_usb_standin_sync_callback;
+    p_transfer->user_data = &completed;
+    status = libusb_submit_transfer(p_transfer);
+    while ((0 == status) && (0 == completed))
+    {
+        libusb_handle_events_timeout_completed(NULL, NULL, &completed);
+    }
+    if (0 != status)
+    {
+        return status;
+    }
+    switch (p_transfer->status)
+    {
+        case LIBUSB_TRANSFER_COMPLETED:
+            return 0;
+        case LIBUSB_TRANSFER_TIMED_OUT:
+            return LIBUSB_ERROR_TIMEOUT;
+        case LIBUSB_TRANSFER_STALL:
+            return LIBUSB_ERROR_PIPE;
+        default:
+            return LIBUSB_ERROR_IO;
+    }
+}
+/// @endcond
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+int LIBUSB_CALL libusb_init(libusb_context ** ctx)
+{
+    if (NULL != ctx)
+    {
+        *ctx = NULL;
+    }
+    memset(&pal_usb_standin_device, 0x00, sizeof(pal_usb_standin_device));
+    memset(&pal_usb_standin_stats, 0x00, sizeof(pal_usb_standin_stats));
+    pal_usb_standin_device.i2c_status = I2C_STATUS_CONTROLLER_IDLE;
+    return 0;
+}
+
+void LIBUSB_CALL libusb_exit(libusb_context * ctx)
+{
+    (void)ctx;
+}
+
+libusb_device_handle * LIBUSB_CALL libusb_open_device_with_vid_pid(libusb_context * ctx, uint16_t vendor_id,
+                                                                   uint16_t product_id)
+{
+    libusb_device * p_device = &pal_usb_standin_ft260;
+
+    (void)ctx;
+    if ((USB_VID != vendor_id) || (USB_PID != product_id))
+    {
+        return NULL;
+    }
+
+    memset(p_device, 0x00, sizeof(*p_device));
+    p_device->endpoint[0].bEndpointAddress = LIBUSB_ENDPOINT_IN | 0x01;
+    p_device->endpoint[0].bmAttributes = LIBUSB_TRANSFER_TYPE_INTERRUPT;
+    p_device->endpoint[0].wMaxPacketSize = HID_REPORT_SIZE;
+    p_device->endpoint[0].bInterval = 1;
+    p_device->endpoint[1].bEndpointAddress = LIBUSB_ENDPOINT_OUT | 0x02;
+    p_device->endpoint[1].bmAttributes = LIBUSB_TRANSFER_TYPE_INTERRUPT;
+    p_device->endpoint[1].wMaxPacketSize = HID_REPORT_SIZE;
+    p_device->endpoint[1].bInterval = 1;
+    p_device->altsetting.bInterfaceNumber = USB_INTERFACE;
+    p_device->altsetting.bInterfaceClass = LIBUSB_CLASS_HID;
+    p_device->altsetting.bNumEndpoints = 2;
+    p_device->altsetting.endpoint = p_device->endpoint;
+    p_device->interface.altsetting = &p_device->altsetting;
+    p_device->interface.num_altsetting = 1;
+    p_device->config.bNumInterfaces = 1;
+    p_device->config.interface = &p_device->interface;
+    return &pal_usb_standin_handle;
+}
+
+void LIBUSB_CALL libusb_close(libusb_device_handle * dev_handle)
+{
+    (void)dev_handle;
+}
+
+libusb_device * LIBUSB_CALL libusb_get_device(libusb_device_handle * dev_handle)
+{
+    return dev_handle->p_device;
+}
+
+int LIBUSB_CALL libusb_detach_kernel_driver(libusb_device_handle * dev_handle, int interface_number)
+{
+    (void)dev_handle;
+    (void)interface_number;
+    return 0;
+}
+
+int LIBUSB_CALL libusb_claim_interface(libusb_device_handle * dev_handle, int interface_number)
+{
+    (void)dev_handle;
+    return (USB_INTERFACE == interface_number) ? 0 : LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_get_active_config_descriptor(libusb_device * dev, struct libusb_config_descriptor ** config)
+{
+    *config = &dev->config;
+    return 0;
+}
+
+void LIBUSB_CALL libusb_free_config_descriptor(struct libusb_config_descriptor * config)
+{
+    // Part of the static device
+    (void)config;
+}
+
+struct libusb_transfer * LIBUSB_CALL libusb_alloc_transfer(int iso_packets)
+{
+    (void)iso_packets;
+    return (struct libusb_transfer *)calloc(1, sizeof(struct libusb_transfer));
+}
+
+void LIBUSB_CALL libusb_free_transfer(struct libusb_transfer * transfer)
+{
+    free(transfer);
+}
+
+int LIBUSB_CALL libusb_submit_transfer(struct libusb_transfer * transfer)
+{
+    pal_usb_standin_device_t * p_device = &pal_usb_standin_device;
+    uint32_t index;
+
+    if ((NULL == transfer) || (&pal_usb_standin_handle != transfer->dev_handle) || (NULL == transfer->callback))
+    {
+        return LIBUSB_ERROR_INVALID_PARAM;
+    }
+    for (index = 0; index < PAL_USB_STANDIN_MAX_TRANSFERS; index++)
+    {
+        if (transfer == p_device->pending[index].p_transfer)
+        {
+            return LIBUSB_ERROR_BUSY;
+        }
+    }
+    for (index = 0; index < PAL_USB_STANDIN_MAX_TRANSFERS; index++)
+    {
+        if (NULL == p_device->pending[index].p_transfer)
+        {
+            transfer->status = LIBUSB_TRANSFER_COMPLETED;
+            transfer->actual_length = 0;
+            p_device->pending[index].due_us = pal_usb_standin_due(p_device, transfer,
+                                                                 pal_os_timer_get_time_in_microseconds());
+            p_device->pending[index].p_transfer = transfer;
+            return 0;
+        }
+    }
+    return LIBUSB_ERROR_NO_MEM;
+}
+
+int LIBUSB_CALL libusb_cancel_transfer(struct libusb_transfer * transfer)
+{
+    pal_usb_standin_device_t * p_device = &pal_usb_standin_device;
+    uint32_t index;
+
+    for (index = 0; index < PAL_USB_STANDIN_MAX_TRANSFERS; index++)
+    {
+        if (transfer == p_device->pending[index].p_transfer)
+        {
+            // Called back by the next libusb_handle_events_timeout_completed
+            transfer->status = LIBUSB_TRANSFER_CANCELLED;
+            p_device->pending[index].due_us = pal_os_timer_get_time_in_microseconds();
+            return 0;
+        }
+    }
+    return LIBUSB_ERROR_NOT_FOUND;
+}
+
+int LIBUSB_CALL libusb_handle_events_timeout_completed(libusb_context * ctx, struct timeval * tv, int * completed)
+{
+    pal_usb_standin_device_t * p_device = &pal_usb_standin_device;
+    pal_usb_standin_transfer_t * p_next;
+    uint64_t deadline_us = pal_os_timer_get_time_in_microseconds();
+    uint8_t handled = FALSE;
+
+    (void)ctx;
+    // Without a timeout, waits as long as the earliest transfer needs
+    deadline_us += (NULL != tv) ? (((uint64_t)tv->tv_sec * 1000000) + (uint64_t)tv->tv_usec) : (uint64_t)-1 / 2;
+
+    while ((NULL == completed) || (0 == *completed))
+    {
+        p_next = pal_usb_standin_next(p_device);
+        if ((NULL == p_next) || (p_next->due_us > deadline_us))
+        {
+            if (!handled)
+            {
+                pal_usb_standin_sleep_until(deadline_us);
+            }
+            break;
+        }
+        pal_usb_standin_sleep_until(p_next->due_us);
+        pal_usb_standin_complete(p_device, p_next);
+        handled = TRUE;
+        // Returns after the first event as libusb does, unless the completion flag is awaited
+        if (NULL == completed)
+        {
+            break;
+        }
+    }
+    return 0;
+}
+
+int LIBUSB_CALL libusb_control_transfer(libusb_device_handle * dev_handle, uint8_t request_type, uint8_t bRequest,
+                                        uint16_t wValue, uint16_t wIndex, unsigned char * data, uint16_t wLength,
+                                        unsigned int timeout)
+{
+    uint8_t buffer[LIBUSB_CONTROL_SETUP_SIZE + HID_REPORT_SIZE];
+    struct libusb_transfer transfer;
+    int status;
+
+    if (wLength > HID_REPORT_SIZE)
+    {
+        return LIBUSB_ERROR_INVALID_PARAM;
+    }
+    memset(&transfer, 0x00, sizeof(transfer));
+    libusb_fill_control_setup(buffer, request_type, bRequest, wValue, wIndex, wLength);
+    memcpy(&buffer[LIBUSB_CONTROL_SETUP_SIZE], data, wLength);
+    libusb_fill_control_transfer(&transfer, dev_handle, buffer, NULL, NULL, timeout);
+    status = pal_usb_standin_sync(&transfer);
+    if (0 != status)
+    {
+        return status;
+    }
+    memcpy(data, &buffer[LIBUSB_CONTROL_SETUP_SIZE], (size_t)transfer.actual_length);
+    return transfer.actual_length;
+}
+
+int LIBUSB_CALL libusb_interrupt_transfer(libusb_device_handle * dev_handle, unsigned char endpoint,
+                                          unsigned char * data, int length, int * actual_length, unsigned int timeout)
+{
+    struct libusb_transfer transfer;
+    int status;
+
+    memset(&transfer, 0x00, sizeof(transfer));
+    libusb_fill_interrupt_transfer(&transfer, dev_handle, endpoint, data, length, NULL, NULL, timeout);
+    status = pal_usb_standin_sync(&transfer);
+    *actual_length = transfer.actual_length;
+    return status;
+}
+
+/**
+* @}
+*/
@@ -30,18 +30,33 @@
 *
 * \brief   This file implements the platform abstraction layer APIs for GPIO.
 *
+* The lines are requested once from the GPIO character device and kept open, a level change is a single ioctl.
+* The deprecated sysfs interface is used instead if PAL_LINUX_GPIO_SYSFS is defined, e.g. for kernels older
+* than 5.10 which lack the v2 character device API.
+*
+* With PAL_GPIO_HAS_IRQ, a line can be requested for rising edge events by pal_gpio_register_irq. A thread
+* waits for the events and hands them to the pal os event context, the sysfs interface does not support this.
+*
 * \ingroup  grPAL
 * @{
 */
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/ioctl.h>
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
+#ifndef PAL_LINUX_GPIO_SYSFS
+#include <linux/gpio.h>
+#endif
 
 #include "optiga/pal/pal_gpio.h"
 #include "optiga/pal/pal_ifx_i2c_config.h"
+#include "optiga/pal/pal_os_timer.h"
 #include "pal_linux.h"
 
 #define IN  0
@@ -50,17 +65,25 @@
 #define LOW  0
 #define HIGH 1
 
+/// GPIO chip used for lines which do not name one
+#ifndef PAL_LINUX_GPIO_DEFAULT_CHIP
+#define PAL_LINUX_GPIO_DEFAULT_CHIP	"/dev/gpiochip0"
+#endif
+/// Consumer label of the requested lines, shown by gpioinfo
+#define PAL_LINUX_GPIO_CONSUMER		"optiga"
+/// Number of edge events read from the kernel at once
+#define PAL_LINUX_GPIO_EVENT_BATCH	(8)
 
+#ifdef PAL_LINUX_GPIO_SYSFS
 static int
 GPIOExport(int pin)
 {
-#define BUFFER_MAX 3
+#define BUFFER_MAX 11
 	char buffer[BUFFER_MAX];
 	ssize_t bytes_written;
 	int fd;
 	fd = open("/sys/class/gpio/export", O_WRONLY);
 	if (-1 == fd) {
-		free("/sys/class/gpio/export");
 		fprintf(stderr, "Failed to open export for writing!\n");
 		return(-1);
 	}
@@ -140,94 +163,369 @@ GPIOWrite(int pin, int value)
 }
 
 
-//lint --e{714,715} suppress "This function is used for to support multiple platforms "
-pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
+// Exports the pin and configures it as output
+static pal_status_t pal_gpio_request_output(pal_linux_gpio_t * p_gpio)
 {
-	if (optiga_reset_0.p_gpio_hw != NULL)
+	if (p_gpio->line_fd >= 0)
 	{
-		int res_pin = *((gpio_pin_t*)(optiga_reset_0.p_gpio_hw));
-			/*
-		 * Enable GPIO pins
-		 */
-		if (-1 == GPIOExport(res_pin))
-			return(1);
+		return PAL_STATUS_SUCCESS;
+	}
+	/*
+	 * Enable GPIO pins
+	 */
+	if (-1 == GPIOExport(p_gpio->line))
+		return(1);
+
+	/*
+	 * Set GPIO directions
+	 */
+	if (-1 == GPIODirection(p_gpio->line, OUT))
+		return(2);
+
+	// No handle is kept, marks the pin as exported
+	p_gpio->line_fd = 0;
+	return PAL_STATUS_SUCCESS;
+}
 
-		/*
-		 * Set GPIO directions
-		 */
-		if (-1 == GPIODirection(res_pin, OUT))
-			return(2);
+// Unexports the pin
+static pal_status_t pal_gpio_release(pal_linux_gpio_t * p_gpio)
+{
+	/*
+	 * Disable GPIO pins
+	 */
+	if (-1 == GPIOUnexport(p_gpio->line))
+		return(1);
+
+	p_gpio->line_fd = -1;
+	return PAL_STATUS_SUCCESS;
+}
+
+static int pal_gpio_write(pal_linux_gpio_t * p_gpio, int value)
+{
+	return GPIOWrite(p_gpio->line, value);
+}
+#else
+// Requests the line with the given flags. The handle is kept until released.
+static pal_status_t pal_gpio_request_line(pal_linux_gpio_t * p_gpio, uint64_t flags)
+{
+	struct gpio_v2_line_request request;
+	const char * chip = (NULL != p_gpio->chip) ? p_gpio->chip : PAL_LINUX_GPIO_DEFAULT_CHIP;
+	int chip_fd;
+
+	if (p_gpio->line_fd >= 0)
+	{
+		return PAL_STATUS_SUCCESS;
 	}
-	
-	if (optiga_vdd_0.p_gpio_hw != NULL)
+
+	chip_fd = open(chip, O_RDWR | O_CLOEXEC);
+	if (-1 == chip_fd)
 	{
-		int vdd_pin = *((gpio_pin_t*)(optiga_vdd_0.p_gpio_hw));
-			/*
-		 * Enable GPIO pins
-		 */
-		if (-1 == GPIOExport(vdd_pin))
-			return(1);
+		fprintf(stderr, "Failed to open %s!\n", chip);
+		return PAL_STATUS_FAILURE;
+	}
 
-		/*
-		 * Set GPIO directions
-		 */
-		if (-1 == GPIODirection(vdd_pin, OUT))
-			return(2);
+	memset(&request, 0, sizeof(request));
+	request.offsets[0] = p_gpio->line;
+	request.num_lines = 1;
+	strncpy(request.consumer, PAL_LINUX_GPIO_CONSUMER, sizeof(request.consumer) - 1);
+	request.config.flags = flags;
+
+	// The line stays requested after the chip is closed
+	if (-1 == ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &request))
+	{
+		fprintf(stderr, "Failed to request line %u of %s!\n", (unsigned)p_gpio->line, chip);
+		close(chip_fd);
+		return PAL_STATUS_FAILURE;
 	}
+	close(chip_fd);
 
-    return PAL_STATUS_SUCCESS;
+	p_gpio->line_fd = request.fd;
+	return PAL_STATUS_SUCCESS;
 }
 
-//lint --e{714,715} suppress "This function is used for to support multiple platforms "
-pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
+// Requests the line as output, driven low as by the sysfs interface
+static pal_status_t pal_gpio_request_output(pal_linux_gpio_t * p_gpio)
 {
-	if (optiga_reset_0.p_gpio_hw != NULL)
+	return pal_gpio_request_line(p_gpio, GPIO_V2_LINE_FLAG_OUTPUT);
+}
+
+// Releases the line, it keeps its level until requested by another consumer
+static pal_status_t pal_gpio_release(pal_linux_gpio_t * p_gpio)
+{
+	if (p_gpio->line_fd >= 0)
+	{
+		close(p_gpio->line_fd);
+		p_gpio->line_fd = -1;
+	}
+	return PAL_STATUS_SUCCESS;
+}
+
+static int pal_gpio_write(pal_linux_gpio_t * p_gpio, int value)
+{
+	struct gpio_v2_line_values values;
+
+	values.bits = (LOW == value) ? 0 : 1;
+	values.mask = 1;
+	if (-1 == ioctl(p_gpio->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &values))
+	{
+		fprintf(stderr, "Failed to write value!\n");
+		return(-1);
+	}
+	return(0);
+}
+
+#ifdef PAL_GPIO_HAS_IRQ
+// Runs in the pal os event context and hands the edges seen since the last dispatch to the handler
+static void pal_gpio_irq_dispatch(void * p_ctx)
+{
+	pal_linux_gpio_t * p_gpio = (pal_linux_gpio_t *)p_ctx;
+	register_callback handler = p_gpio->irq_handler;
+
+	if (NULL != handler)
+	{
+		p_gpio->stats.irq_dispatches++;
+		handler(p_gpio->p_irq_ctx);
+	}
+}
+
+// Waits for the edge events of the line. The handler is never called from this thread.
+static void * pal_gpio_irq_thread(void * p_arg)
+{
+	pal_linux_gpio_t * p_gpio = (pal_linux_gpio_t *)p_arg;
+	struct gpio_v2_line_event events[PAL_LINUX_GPIO_EVENT_BATCH];
+	ssize_t length;
+	int cancel_state;
+
+	for (;;)
+	{
+		// Blocks until an edge arrives, pal_gpio_unregister_irq cancels the thread here
+		length = read(p_gpio->line_fd, events, sizeof(events));
+		if (length < (ssize_t)sizeof(events[0]))
+		{
+			if ((-1 == length) && (EINTR == errno))
+			{
+				continue;
+			}
+			fprintf(stderr, "Failed to read line events!\n");
+			break;
+		}
+		p_gpio->stats.irq_events += (uint32_t)((size_t)length / sizeof(events[0]));
+
+		// Keyed by the line, a dispatch still pending absorbs the new edges instead of queuing another.
+		// Not cancelled while the event lock is held.
+		pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cancel_state);
+		pal_os_event_register_callback_oneshot(pal_gpio_irq_dispatch, p_gpio, 0);
+		pthread_setcancelstate(cancel_state, NULL);
+	}
+	return NULL;
+}
+#endif
+#endif
+
+/// @cond hidden
+// Sets the level of the line and records the timing of the edge
+static void pal_gpio_set_level(const pal_gpio_t * p_gpio_context, int value)
+{
+	pal_linux_gpio_t * p_gpio;
+	uint64_t start_us;
+	uint64_t end_us;
+	uint64_t low_us;
+
+	if ((p_gpio_context == NULL) || (p_gpio_context->p_gpio_hw == NULL))
+	{
+		return;
+	}
+	p_gpio = (pal_linux_gpio_t *)p_gpio_context->p_gpio_hw;
+
+	// Lines not initialized by the application are requested at the first use
+	if (PAL_STATUS_SUCCESS != pal_gpio_request_output(p_gpio))
+	{
+		return;
+	}
+
+	start_us = pal_os_timer_get_time_in_microseconds();
+	if (0 != pal_gpio_write(p_gpio, value))
 	{
-		int res_pin = *((gpio_pin_t*)(optiga_reset_0.p_gpio_hw));
-		/*
-		 * Disable GPIO pins
-		 */
-		if (-1 == GPIOUnexport(res_pin))
-			return(1);
+		return;
+	}
+	end_us = pal_os_timer_get_time_in_microseconds();
 
+	p_gpio->stats.writes++;
+	if ((end_us - start_us) > p_gpio->stats.max_write_us)
+	{
+		p_gpio->stats.max_write_us = (uint32_t)(end_us - start_us);
+	}
+	if (LOW == value)
+	{
+		p_gpio->stats.low_edge_us = end_us;
+	}
+	else if (0 != p_gpio->stats.low_edge_us)
+	{
+		// The line was low at least from the end of the low write to the start of this write
+		low_us = start_us - p_gpio->stats.low_edge_us;
+		if ((0 == p_gpio->stats.pulses) || (low_us < p_gpio->stats.min_low_us))
+		{
+			p_gpio->stats.min_low_us = (uint32_t)low_us;
+		}
+		if (low_us > p_gpio->stats.max_low_us)
+		{
+			p_gpio->stats.max_low_us = (uint32_t)low_us;
+		}
+		p_gpio->stats.pulses++;
+		p_gpio->stats.low_edge_us = 0;
 	}
-	
-	if (optiga_vdd_0.p_gpio_hw != NULL)
+}
+
+// Requests the line of the gpio context as output
+static pal_status_t pal_gpio_export_output(const pal_gpio_t * p_gpio_context)
+{
+	if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
 	{
-		int vdd_pin = *((gpio_pin_t*)(optiga_vdd_0.p_gpio_hw));
-		/*
-		 * Disable GPIO pins
-		 */
-		if (-1 == GPIOUnexport(vdd_pin))
-			return(1);
+		return pal_gpio_request_output((pal_linux_gpio_t *)p_gpio_context->p_gpio_hw);
 	}
-    	
 	return PAL_STATUS_SUCCESS;
 }
 
-void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
+// Releases the line of the gpio context
+static pal_status_t pal_gpio_unexport(const pal_gpio_t * p_gpio_context)
 {
 	if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
 	{
-		int pin = *((gpio_pin_t*)(p_gpio_context->p_gpio_hw));
-		/*
-		* Write GPIO value
-		*/
-		GPIOWrite(pin, HIGH );
+		return pal_gpio_release((pal_linux_gpio_t *)p_gpio_context->p_gpio_hw);
 	}
+	return PAL_STATUS_SUCCESS;
+}
+/// @endcond
+
+/*
+ * Initializes the pin of the given gpio context. If p_gpio_context is NULL, the reset and vdd pins of the
+ * default OPTIGA instance are initialized.
+ */
+pal_status_t pal_gpio_init(const pal_gpio_t * p_gpio_context)
+{
+	pal_status_t status;
+
+	if (p_gpio_context != NULL)
+	{
+		return pal_gpio_export_output(p_gpio_context);
+	}
+
+	status = pal_gpio_export_output(&optiga_reset_0);
+	if (PAL_STATUS_SUCCESS == status)
+	{
+		status = pal_gpio_export_output(&optiga_vdd_0);
+	}
+	return status;
+}
+
+/*
+ * De-initializes the pin of the given gpio context. If p_gpio_context is NULL, the reset and vdd pins of the
+ * default OPTIGA instance are de-initialized.
+ */
+pal_status_t pal_gpio_deinit(const pal_gpio_t * p_gpio_context)
+{
+	pal_status_t status;
+
+	if (p_gpio_context != NULL)
+	{
+		return pal_gpio_unexport(p_gpio_context);
+	}
+
+	status = pal_gpio_unexport(&optiga_reset_0);
+	if (PAL_STATUS_SUCCESS == status)
+	{
+		status = pal_gpio_unexport(&optiga_vdd_0);
+	}
+	return status;
+}
+
+void pal_gpio_set_high(const pal_gpio_t * p_gpio_context)
+{
+	pal_gpio_set_level(p_gpio_context, HIGH);
 }
 
 void pal_gpio_set_low(const pal_gpio_t* p_gpio_context)
 {
-	if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+	pal_gpio_set_level(p_gpio_context, LOW);
+}
+
+#ifdef PAL_GPIO_HAS_IRQ
+/*
+ * Requests the line as input with rising edge events, replacing an output request of the same line.
+ * A handler registered again is replaced without requesting the line again.
+ */
+pal_status_t pal_gpio_register_irq(const pal_gpio_t * p_gpio_context, register_callback handler, void * p_handler_ctx)
+{
+#ifdef PAL_LINUX_GPIO_SYSFS
+	// Edge events are not supported through sysfs, the caller keeps polling
+	(void)p_gpio_context;
+	(void)handler;
+	(void)p_handler_ctx;
+	return PAL_STATUS_FAILURE;
+#else
+	pal_linux_gpio_t * p_gpio;
+
+	if ((p_gpio_context == NULL) || (p_gpio_context->p_gpio_hw == NULL) || (handler == NULL))
+	{
+		return PAL_STATUS_FAILURE;
+	}
+	p_gpio = (pal_linux_gpio_t *)p_gpio_context->p_gpio_hw;
+
+	if (NULL != p_gpio->irq_handler)
+	{
+		p_gpio->p_irq_ctx = p_handler_ctx;
+		p_gpio->irq_handler = handler;
+		return PAL_STATUS_SUCCESS;
+	}
+
+	pal_gpio_release(p_gpio);
+	if (PAL_STATUS_SUCCESS != pal_gpio_request_line(p_gpio, GPIO_V2_LINE_FLAG_INPUT | GPIO_V2_LINE_FLAG_EDGE_RISING))
+	{
+		return PAL_STATUS_FAILURE;
+	}
+
+	p_gpio->p_irq_ctx = p_handler_ctx;
+	p_gpio->irq_handler = handler;
+	if (0 != pthread_create(&p_gpio->irq_thread, NULL, pal_gpio_irq_thread, p_gpio))
 	{
-		int pin = *((gpio_pin_t*)(p_gpio_context->p_gpio_hw));
-		/*
-		 * Write GPIO value
-		 */
-		GPIOWrite(pin, LOW );
+		fprintf(stderr, "Failed to start the event thread of line %u!\n", (unsigned)p_gpio->line);
+		p_gpio->irq_handler = NULL;
+		pal_gpio_release(p_gpio);
+		return PAL_STATUS_FAILURE;
 	}
+	return PAL_STATUS_SUCCESS;
+#endif
+}
+
+/*
+ * Stops the event thread and releases the line. A dispatch already pending in the event context finds no
+ * handler and is dropped.
+ */
+void pal_gpio_unregister_irq(const pal_gpio_t * p_gpio_context)
+{
+#ifndef PAL_LINUX_GPIO_SYSFS
+	pal_linux_gpio_t * p_gpio;
+
+	if ((p_gpio_context == NULL) || (p_gpio_context->p_gpio_hw == NULL))
+	{
+		return;
+	}
+	p_gpio = (pal_linux_gpio_t *)p_gpio_context->p_gpio_hw;
+	if (NULL == p_gpio->irq_handler)
+	{
+		return;
+	}
+
+	pthread_cancel(p_gpio->irq_thread);
+	pthread_join(p_gpio->irq_thread, NULL);
+	p_gpio->irq_handler = NULL;
+	p_gpio->p_irq_ctx = NULL;
+	pal_gpio_release(p_gpio);
+#else
+	(void)p_gpio_context;
+#endif
 }
+#endif
 
 /**
 * @}
@@ -34,8 +34,10 @@
 * @{
 */
 
+#include <linux/i2c.h>
 #include <linux/i2c-dev.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 
@@ -49,45 +51,159 @@
 #define LOG_HAL(...) //printf(__VA_ARGS__)
 #endif
 
-/// I2C device
+/// Default I2C device, used when the bus context does not name one
 char * i2c_if = "/dev/i2c-1";
 
 // Slave address not initialization
 #define IFXI2C_SLAVE_ADDRESS_INIT 0xFFFF
 #define PAL_I2C_MASTER_MAX_BITRATE 100
 #define WAIT_500_MS	(500)
+/// Bus free time between the write and the read of a write-read done as two transactions
+#define PAL_I2C_GUARD_TIME_US	(50)
 /// @cond hidden
 
-void i2c_master_end_of_transmit_callback(void);
-void i2c_master_end_of_receive_callback(void);
+void i2c_master_end_of_transmit_callback(const pal_i2c_t* p_pal_i2c_ctx);
+void i2c_master_end_of_receive_callback(const pal_i2c_t* p_pal_i2c_ctx);
 void invoke_upper_layer_callback (const pal_i2c_t* p_pal_i2c_ctx, optiga_lib_status_t event);
 uint16_t usb_i2c_poll_operation_result(pal_i2c_t* p_i2c_context);
 
-/* Varibale to indicate the re-entrant count of the i2c bus acquire function*/
-static volatile uint32_t g_entry_count = 0;
-
-/* Pointer to the current pal i2c context*/
-static pal_i2c_t * gp_pal_i2c_current_ctx;
-
-//lint --e{715} suppress the unused p_i2c_context variable lint error , since this is kept for future enhancements
+// I2C acquire bus function. The entry count is kept per bus, so that the buses are used independently
 static pal_status_t pal_i2c_acquire(const void * p_i2c_context)
 {
-    if (0 == g_entry_count)
+    pal_linux_t * pal_linux = (pal_linux_t*)((const pal_i2c_t*)p_i2c_context)->p_i2c_hw_config;
+
+    if (__sync_bool_compare_and_swap(&pal_linux->entry_count, 0, 1))
     {
-        g_entry_count++;
-        if (1 == g_entry_count)
-        {
-            return PAL_STATUS_SUCCESS;
-        }
+        return PAL_STATUS_SUCCESS;
     }
     return PAL_STATUS_FAILURE;
 }
 
 // I2C release bus function
-//lint --e{715} suppress the unused p_i2c_context variable lint, since this is kept for future enhancements
 static void pal_i2c_release(const void* p_i2c_context)
 {
-    g_entry_count = 0;
+    pal_linux_t * pal_linux = (pal_linux_t*)((const pal_i2c_t*)p_i2c_context)->p_i2c_hw_config;
+
+    __sync_lock_release(&pal_linux->entry_count);
+}
+
+// Binds the handle to the slave address. Slaves on the same bus share the handle
+static int pal_i2c_bind(pal_linux_t * pal_linux, uint8_t slave_address)
+{
+    if (pal_linux->i2c_slave_address == slave_address)
+    {
+        return 0;
+    }
+    pal_linux->stats.syscalls++;
+    if (0 > ioctl(pal_linux->i2c_handle, I2C_SLAVE, slave_address))
+    {
+        pal_linux->i2c_slave_address = 0;
+        return -1;
+    }
+    pal_linux->i2c_slave_address = slave_address;
+    return 0;
+}
+
+// Writes p_tx_data and/or reads into p_rx_data, a write followed by a read is one I2C_RDWR transaction if enabled
+static int pal_i2c_transfer(pal_linux_t * pal_linux, uint8_t slave_address, uint8_t * p_tx_data, uint16_t tx_length,
+                            uint8_t * p_rx_data, uint16_t rx_length)
+{
+    struct i2c_msg msgs[2];
+    struct i2c_rdwr_ioctl_data rdwr;
+
+    if ((0 != tx_length) && (0 != rx_length) && pal_linux->combined_transfers)
+    {
+        msgs[0].addr = slave_address;
+        msgs[0].flags = 0;
+        msgs[0].len = tx_length;
+        msgs[0].buf = p_tx_data;
+        msgs[1].addr = slave_address;
+        msgs[1].flags = I2C_M_RD;
+        msgs[1].len = rx_length;
+        msgs[1].buf = p_rx_data;
+        rdwr.msgs = msgs;
+        rdwr.nmsgs = 2;
+        pal_linux->stats.syscalls++;
+        pal_linux->stats.combined++;
+        return (0 > ioctl(pal_linux->i2c_handle, I2C_RDWR, &rdwr)) ? -1 : 0;
+    }
+
+    if (0 != pal_i2c_bind(pal_linux, slave_address))
+    {
+        return -1;
+    }
+    if (0 != tx_length)
+    {
+        pal_linux->stats.syscalls++;
+        if (tx_length != write(pal_linux->i2c_handle, p_tx_data, tx_length))
+        {
+            return -1;
+        }
+        if (0 != rx_length)
+        {
+            usleep(PAL_I2C_GUARD_TIME_US);
+        }
+    }
+    if (0 != rx_length)
+    {
+        pal_linux->stats.syscalls++;
+        if (rx_length != read(pal_linux->i2c_handle, p_rx_data, rx_length))
+        {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Runs a transfer on the bus and reports the result to the upper layer
+static pal_status_t pal_i2c_start(pal_i2c_t * p_i2c_context, uint8_t * p_tx_data, uint16_t tx_length,
+                                  uint8_t * p_rx_data, uint16_t rx_length)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    pal_linux_t * pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
+    uint8_t attempts;
+
+    if (PAL_STATUS_SUCCESS != pal_i2c_acquire(p_i2c_context))
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
+        ((app_event_handler_t )(p_i2c_context->upper_layer_event_handler))
+                                                        (p_i2c_context->upper_layer_ctx  , PAL_I2C_EVENT_BUSY);
+        return PAL_STATUS_I2C_BUSY;
+    }
+
+    // A NACK while the OPTIGA wakes up is common, it is retried here before the ifx i2c stack polls again
+    for (attempts = 0; attempts <= pal_linux->retries; attempts++)
+    {
+        if (0 != attempts)
+        {
+            pal_linux->stats.retries++;
+        }
+        if (0 == pal_i2c_transfer(pal_linux, p_i2c_context->slave_address, p_tx_data, tx_length, p_rx_data, rx_length))
+        {
+            status = PAL_STATUS_SUCCESS;
+            break;
+        }
+    }
+
+    if (PAL_STATUS_SUCCESS == status)
+    {
+        if (0 != rx_length)
+        {
+            i2c_master_end_of_receive_callback(p_i2c_context);
+        }
+        else
+        {
+            i2c_master_end_of_transmit_callback(p_i2c_context);
+        }
+    }
+    else
+    {
+        pal_linux->stats.errors++;
+        LOG_HAL("[IFX-HAL]: I2C transfer failed, errno %d\n", errno);
+        //If I2C Master fails to invoke the operation, invoke upper layer event handler with error.
+        invoke_upper_layer_callback(p_i2c_context, PAL_I2C_EVENT_ERROR);
+    }
+    return status;
 }
 /// @endcond
 
@@ -100,184 +216,85 @@ void invoke_upper_layer_callback (const pal_i2c_t * p_pal_i2c_ctx, optiga_lib_st
     upper_layer_handler(p_pal_i2c_ctx->upper_layer_ctx , event);
 
     //Release I2C Bus
-    pal_i2c_release(p_pal_i2c_ctx->upper_layer_ctx );
+    pal_i2c_release(p_pal_i2c_ctx);
 }
 
 /// @cond hidden
 // I2C driver callback function when the transmit is completed successfully
-void i2c_master_end_of_transmit_callback(void)
+void i2c_master_end_of_transmit_callback(const pal_i2c_t* p_pal_i2c_ctx)
 {
-    invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_SUCCESS);
+    invoke_upper_layer_callback(p_pal_i2c_ctx, PAL_I2C_EVENT_SUCCESS);
 }
 
 
 // I2C driver callback function when the receive is completed successfully
-void i2c_master_end_of_receive_callback(void)
+void i2c_master_end_of_receive_callback(const pal_i2c_t* p_pal_i2c_ctx)
 {
-	invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_SUCCESS);
+	invoke_upper_layer_callback(p_pal_i2c_ctx, PAL_I2C_EVENT_SUCCESS);
 }
 
-// I2C error callback function
-void i2c_master_error_detected_callback(void)
-{
-    //I2C_MASTER_t *p_i2c_master;
-    //
-    //p_i2c_master = gp_pal_i2c_current_ctx->p_i2c_hw_config;
-    //if (I2C_MASTER_IsTxBusy(p_i2c_master))
-    //{
-    //    //lint --e{534} suppress "Return value is not required to be checked"
-    //    I2C_MASTER_AbortTransmit(p_i2c_master);
-    //    while (I2C_MASTER_IsTxBusy(p_i2c_master)){}
-    //}  
-
-    //if (I2C_MASTER_IsRxBusy(p_i2c_master)) 
-    //{
-    //    //lint --e{534} suppress "Return value is not required to be checked"
-    //    I2C_MASTER_AbortReceive(p_i2c_master);
-    //    while (I2C_MASTER_IsRxBusy(p_i2c_master)){}
-    //}
-
-    invoke_upper_layer_callback(gp_pal_i2c_current_ctx, PAL_I2C_EVENT_ERROR);
-}
-
-
-void i2c_master_nack_received_callback(void)
-{
-    i2c_master_error_detected_callback();
-}
-
-void i2c_master_arbitration_lost_callback(void)
-{
-    i2c_master_error_detected_callback();
-}
-
-
 /// @endcond
 
 pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
 {
-	int32_t ret = PAL_I2C_EVENT_ERROR;
+	pal_status_t status = PAL_STATUS_SUCCESS;
 	pal_linux_t *pal_linux;
-	do
+
+	pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
+	// The handle of the bus is opened once and reused by every open and reset of the ifx i2c stack
+	if (!pal_linux->i2c_open)
 	{
-		pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
-		pal_linux->i2c_handle = open(i2c_if, O_RDWR);
-		LOG_HAL("IFX OPTIGA TRUST X Logs \n");
-		printf("IFX OPTIGA TRUX X Logs \n");	
-		// Assign the slave address
-		ret = ioctl(pal_linux->i2c_handle, I2C_SLAVE, p_i2c_context->slave_address);
-		if(PAL_STATUS_SUCCESS != ret)
+		pal_linux->stats.syscalls++;
+		pal_linux->i2c_handle = open((NULL != pal_linux->i2c_if) ? pal_linux->i2c_if : i2c_if, O_RDWR | O_CLOEXEC);
+		if (0 > pal_linux->i2c_handle)
 		{
-			LOG_HAL((uint32_t)pal_linux->i2c_handle, "ioctl returned an error = ", ret);
-			break;
+			LOG_HAL("[IFX-HAL]: open failed, errno %d\n", errno);
+			return PAL_STATUS_FAILURE;
 		}
-		
-		//start_transceive_thread();
-	}while(0);
-    return ret;
+		LOG_HAL("IFX OPTIGA TRUST X Logs \n");
+		pal_linux->i2c_open = TRUE;
+		pal_linux->i2c_slave_address = 0;
+	}
+	// Assign the slave address
+	if (0 != pal_i2c_bind(pal_linux, p_i2c_context->slave_address))
+	{
+		LOG_HAL("[IFX-HAL]: ioctl returned an error, errno %d\n", errno);
+		status = PAL_STATUS_FAILURE;
+	}
+	return status;
 }
 
 
 pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
 {
 	LOG_HAL("pal_i2c_deinit\n. ");
-	
+	// The handle stays open, it is reused by the next pal_i2c_init
     return PAL_STATUS_SUCCESS;
 }
 
 
 pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context,uint8_t* p_data , uint16_t length)
 {
-    pal_status_t status = PAL_STATUS_FAILURE;
-    int32_t i2c_write_status;
-	pal_linux_t *pal_linux;
-
-	pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
-	LOG_HAL("[IFX-HAL]: I2C TX (%d): ", length);
-#if 0
-    for (i = 0; i < length; i++)
-    {
-        LOG_HAL("%02X ", p_data[i]);
-    }
-#endif
-    LOG_HAL("\n");
-    if(PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
-    {
-        gp_pal_i2c_current_ctx = p_i2c_context;
-
-        //Invoke the low level i2c master driver API to write to the bus
-
-		i2c_write_status = write(pal_linux->i2c_handle, p_data, length);
-        if (0 > i2c_write_status)
-        {
-            //If I2C Master fails to invoke the write operation, invoke upper layer event handler with error.
-
-            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
-            ((app_event_handler_t )(p_i2c_context->upper_layer_event_handler))
-                                                       (p_i2c_context->upper_layer_ctx  , PAL_I2C_EVENT_ERROR);
-            
-            //Release I2C Bus
-            pal_i2c_release((void *)p_i2c_context);
-        }
-        else
-        {
-        	i2c_master_end_of_transmit_callback();
-            status = PAL_STATUS_SUCCESS;
-			//transmission_completed = true;
-        }
-    }
-    else
-    {
-        status = PAL_STATUS_I2C_BUSY;
-        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
-        ((app_event_handler_t )(p_i2c_context->upper_layer_event_handler))
-                                                        (p_i2c_context->upper_layer_ctx  , PAL_I2C_EVENT_BUSY);
-    }
-
-    return status;
+	LOG_HAL("[IFX-HAL]: I2C TX (%d)\n", length);
+	return pal_i2c_start(p_i2c_context, p_data, length, NULL, 0);
 }
 
 
 pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context , uint8_t* p_data , uint16_t length)
 {
-    int32_t i2c_read_status = PAL_STATUS_FAILURE;
-	pal_linux_t *pal_linux;
     LOG_HAL("[IFX-HAL]: I2C RX (%d)\n", length);
-
-	pal_linux = (pal_linux_t*) p_i2c_context->p_i2c_hw_config;
-    //Acquire the I2C bus before read/write
-    if (PAL_STATUS_SUCCESS == pal_i2c_acquire(p_i2c_context))
-    {    
-        gp_pal_i2c_current_ctx = p_i2c_context;
-		i2c_read_status = read(pal_linux->i2c_handle,p_data, length);
-		if (0 > i2c_read_status)
-		{
-    		LOG_HAL("[IFX-HAL]: libusb_interrupt_transfer ERROR %d\n.", i2c_read_status);
-            //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
-            ((app_event_handler_t )(p_i2c_context->upper_layer_event_handler))
-                                                       (p_i2c_context->upper_layer_ctx  , PAL_I2C_EVENT_ERROR);
-													   			//Release I2C Bus
-			pal_i2c_release((void *)p_i2c_context);
-    		return i2c_read_status;
-		}
-		else
-        {
-			i2c_master_end_of_receive_callback();
-			i2c_read_status = PAL_STATUS_SUCCESS;
-			//reception_started = true;
-        }
-    }
-    else
-    {
-        i2c_read_status = PAL_STATUS_I2C_BUSY;
-        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
-        ((app_event_handler_t )(p_i2c_context->upper_layer_event_handler))
-                                                        (p_i2c_context->upper_layer_ctx  , PAL_I2C_EVENT_BUSY);
-    }
-    return i2c_read_status;
+	return pal_i2c_start(p_i2c_context, NULL, 0, p_data, length);
 }
 
-   
+
+#ifdef PAL_I2C_HAS_WRITE_READ
+pal_status_t pal_i2c_write_read(pal_i2c_t* p_i2c_context, uint8_t* p_tx_data, uint16_t tx_length,
+                                uint8_t* p_rx_data, uint16_t rx_length)
+{
+    LOG_HAL("[IFX-HAL]: I2C TX (%d) RX (%d)\n", tx_length, rx_length);
+	return pal_i2c_start(p_i2c_context, p_tx_data, tx_length, p_rx_data, rx_length);
+}
+#endif
 
 pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context , uint16_t bitrate)
 {
@@ -41,11 +41,34 @@
 
 #include "pal_linux.h"
 
-pal_linux_t linux_events = {0};
+/**
+ * \brief PAL I2C bus of the OPTIGA.
+ */
+pal_linux_t linux_events =
+{
+    /// I2C handle, opened by pal_i2c_init
+    -1,
+    /// Callback event handler
+    NULL,
+    /// I2C device, NULL for the default device
+    NULL,
+    /// Entry count
+    0,
+    /// Register reads are issued as combined transactions
+    TRUE,
+    /// Failed transfers are repeated once before the ifx i2c stack polls again
+    1,
+    /// The handle is opened by pal_i2c_init
+    FALSE,
+    /// No slave address bound yet
+    0x00,
+    /// Transfer statistics
+    {0, 0, 0, 0}
+};
 
 // If you use Raspberry Pi, you can uncomment the following lines
-gpio_pin_t gpio_pin_vdd = 27;
-gpio_pin_t gpio_pin_reset = 17;
+pal_linux_gpio_t gpio_pin_vdd = {NULL, 27, -1, {0}, NULL, NULL, 0};
+pal_linux_gpio_t gpio_pin_reset = {NULL, 17, -1, {0}, NULL, NULL, 0};
 
 /**
  * \brief PAL I2C configuration for OPTIGA. 
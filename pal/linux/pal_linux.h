@@ -37,7 +37,9 @@
 #ifndef _PAL_LINUX_H_
 #define _PAL_LINUX_H_
 
+#include <pthread.h>
 #include "optiga/pal/pal.h"
+#include "optiga/pal/pal_os_event.h"
 
 #define false 0
 #define true 1
@@ -46,13 +48,149 @@
 #define LOW 0
 typedef uint8_t gpio_pin_t;
 
-/** @brief PAL I2C context structure */
+/** @brief Timing of the level changes of a GPIO line, on the #pal_os_timer_get_time_in_microseconds clock */
+typedef struct pal_linux_gpio_stats
+{
+    /// Number of level changes written
+    uint32_t writes;
+    /// Longest time taken by a write, in microseconds
+    uint32_t max_write_us;
+    /// Number of low pulses, i.e. a low write followed by a high write
+    uint32_t pulses;
+    /// Shortest time the line was guaranteed low during a pulse, in microseconds
+    uint32_t min_low_us;
+    /// Longest time the line was guaranteed low during a pulse, in microseconds
+    uint32_t max_low_us;
+    /// End of the last low write, 0 if the line is not low
+    uint64_t low_edge_us;
+    /// Number of rising edges reported by the kernel on an interrupt line
+    uint32_t irq_events;
+    /// Number of edges handed to the interrupt handler, edges arriving before the handler ran are merged
+    uint32_t irq_dispatches;
+} pal_linux_gpio_stats_t;
+
+/** @brief GPIO line, pointed to by pal_gpio_t.p_gpio_hw */
+typedef struct pal_linux_gpio
+{
+    /// GPIO chip device of the line, e.g. "/dev/gpiochip0". If NULL, the default chip is used
+    const char * chip;
+    /// Offset of the line on the chip, with PAL_LINUX_GPIO_SYSFS the global sysfs GPIO number
+    uint32_t line;
+    /// Handle of the requested line, -1 until requested by pal_gpio_init or the first level change
+    int32_t line_fd;
+    /// Timing statistics, may be read and cleared by the application
+    pal_linux_gpio_stats_t stats;
+    /// Handler registered by pal_gpio_register_irq, NULL if the line is not used as interrupt
+    register_callback irq_handler;
+    /// Context passed to the interrupt handler
+    void * p_irq_ctx;
+    /// Thread waiting for the edge events of the line
+    pthread_t irq_thread;
+} pal_linux_gpio_t;
+
+/** @brief Transfer statistics of an I2C bus */
+typedef struct pal_linux_i2c_stats
+{
+    /// Number of open, ioctl, write and read system calls issued on the bus
+    uint32_t syscalls;
+    /// Number of write-read transfers done as one I2C_RDWR transaction
+    uint32_t combined;
+    /// Number of transfers repeated after a failure
+    uint32_t retries;
+    /// Number of transfers which failed after all retries
+    uint32_t errors;
+} pal_linux_i2c_stats_t;
+
+/** @brief PAL I2C context structure, one per I2C bus */
 typedef struct pal_linux
 {
     /// This field consists the handle for I2c device
     int32_t i2c_handle;
     /// Pointer to store the callers handler
     void * upper_layer_event_handler;
+    /// I2C device of the bus, e.g. "/dev/i2c-1". If NULL, the default device is used
+    const char * i2c_if;
+    /// Re-entrant count of the i2c bus acquire function
+    volatile uint32_t entry_count;
+    /// Issue a write followed by a read as one I2C_RDWR transaction with a repeated start
+    uint8_t combined_transfers;
+    /// Number of times a failed transfer is repeated before the error is reported
+    uint8_t retries;
+    /// The handle is open. It is kept open for the lifetime of the process and shared by all slaves on the bus
+    uint8_t i2c_open;
+    /// Slave address the handle is bound to with I2C_SLAVE
+    uint8_t i2c_slave_address;
+    /// Transfer statistics, may be read and cleared by the application
+    pal_linux_i2c_stats_t stats;
 } pal_linux_t;
 
+/** @brief Statistics of the pal os event thread, delays are measured from the requested expiry */
+typedef struct pal_os_event_stats
+{
+    /// Number of callbacks run
+    uint32_t callbacks;
+    /// Number of callbacks dropped, as no event slot was free
+    uint32_t dropped;
+    /// Smallest delay of a callback, in microseconds
+    uint32_t min_latency_us;
+    /// Largest delay of a callback, in microseconds
+    uint32_t max_latency_us;
+    /// Sum of the delays of all callbacks, in microseconds
+    uint64_t total_latency_us;
+} pal_os_event_stats_t;
+
+/**
+ * \brief Gets the statistics of the pal os event thread.
+ */
+void pal_os_event_get_stats(pal_os_event_stats_t * p_stats);
+
+/**
+ * \brief Resets the statistics of the pal os event thread.
+ */
+void pal_os_event_reset_stats(void);
+
+/// Priority class of the pal os lock served first
+#define PAL_OS_LOCK_PRIORITY_HIGH        (0)
+/// Priority class of the pal os lock of threads which did not select one
+#define PAL_OS_LOCK_PRIORITY_NORMAL      (1)
+/// Priority class of the pal os lock served last
+#define PAL_OS_LOCK_PRIORITY_LOW         (2)
+/// Number of priority classes of the pal os lock
+#define PAL_OS_LOCK_PRIORITY_CLASSES     (3)
+
+/** @brief Contention statistics of the pal os lock */
+typedef struct pal_os_lock_stats
+{
+    /// Number of times the lock was acquired
+    uint32_t acquisitions;
+    /// Number of acquisitions which had to wait for the lock
+    uint32_t contended;
+    /// Largest number of threads waiting at the same time
+    uint32_t max_waiters;
+    /// Longest wait for the lock, in microseconds
+    uint32_t max_wait_us;
+    /// Sum of the waits for the lock, in microseconds
+    uint64_t total_wait_us;
+    /// Number of acquisitions per priority class
+    uint32_t class_acquisitions[PAL_OS_LOCK_PRIORITY_CLASSES];
+} pal_os_lock_stats_t;
+
+/**
+ * \brief Sets the priority class the calling thread waits for the pal os lock with.
+ *
+ * When the lock is released, it is handed to the longest waiting thread of the highest class with a waiter.
+ * A busy high class therefore delays the lower ones, the classes are meant for a few latency sensitive threads.
+ */
+void pal_os_lock_set_priority(uint8_t priority_class);
+
+/**
+ * \brief Gets the contention statistics of the pal os lock.
+ */
+void pal_os_lock_get_stats(pal_os_lock_stats_t * p_stats);
+
+/**
+ * \brief Resets the contention statistics of the pal os lock.
+ */
+void pal_os_lock_reset_stats(void);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,214 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore.c
+*
+* \brief   This file implements the platform abstraction layer APIs for the host side datastore.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include "optiga/pal/pal_os_datastore.h"
+
+#if IFX_I2C_LOG_PAL == 1
+#define LOG(...)  printf(__VA_ARGS__)
+#else
+#define LOG(...)
+#endif
+
+#define ERR(...)  fprintf(stderr, __VA_ARGS__)
+#define LOG_PREFIX "[IFX-PAL-OS-DATASTORE] "
+
+/*
+ * The datastores are kept in a directory private to the user, one file per datastore. The directory is
+ * taken from the environment variable OPTIGA_DATASTORE_DIR, else PAL_OS_DATASTORE_DIR if defined at build
+ * time, else $XDG_CACHE_HOME/optiga or $HOME/.cache/optiga. It is created with mode 0700 and must be owned
+ * by the user and not accessible to others, so that no other user can plant or replace a datastore.
+ */
+/// Environment variable overriding the directory of the datastores
+#define PAL_OS_DATASTORE_ENV        "OPTIGA_DATASTORE_DIR"
+/// Sub directory of the user cache directory
+#define PAL_OS_DATASTORE_SUBDIR     "optiga"
+
+// Creates the directory with mode 0700 if missing and checks that it is private to the user
+static pal_status_t pal_os_datastore_check_dir(const char * p_dir)
+{
+    struct stat dir_stat;
+
+    if ((0 != mkdir(p_dir, S_IRWXU)) && (EEXIST != errno))
+    {
+        ERR(LOG_PREFIX "Failed to create %s, errno %d\n", p_dir, errno);
+        return PAL_STATUS_FAILURE;
+    }
+    if ((0 != lstat(p_dir, &dir_stat)) || (!S_ISDIR(dir_stat.st_mode)) ||
+        (geteuid() != dir_stat.st_uid) || (0 != (dir_stat.st_mode & (S_IRWXG | S_IRWXO))))
+    {
+        ERR(LOG_PREFIX "%s is not a directory private to the user\n", p_dir);
+        return PAL_STATUS_FAILURE;
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+// Gets the path of the datastore, after checking its directory
+static pal_status_t pal_os_datastore_path(char * p_path, uint16_t datastore_id)
+{
+    char dir[PATH_MAX];
+    const char * p_base = getenv(PAL_OS_DATASTORE_ENV);
+    int length;
+
+    if ((NULL != p_base) && ('\0' != p_base[0]))
+    {
+        length = snprintf(dir, sizeof(dir), "%s", p_base);
+    }
+    else
+    {
+#ifdef PAL_OS_DATASTORE_DIR
+        length = snprintf(dir, sizeof(dir), "%s", PAL_OS_DATASTORE_DIR);
+#else
+        p_base = getenv("XDG_CACHE_HOME");
+        if ((NULL != p_base) && ('/' == p_base[0]))
+        {
+            length = snprintf(dir, sizeof(dir), "%s", p_base);
+        }
+        else
+        {
+            p_base = getenv("HOME");
+            if ((NULL == p_base) || ('/' != p_base[0]))
+            {
+                ERR(LOG_PREFIX "No directory for the datastore, set " PAL_OS_DATASTORE_ENV "\n");
+                return PAL_STATUS_FAILURE;
+            }
+            length = snprintf(dir, sizeof(dir), "%s/.cache", p_base);
+        }
+        // The user cache directory may be missing, it is created private as well
+        if ((length <= 0) || ((size_t)length >= sizeof(dir)) ||
+            ((0 != mkdir(dir, S_IRWXU)) && (EEXIST != errno)))
+        {
+            return PAL_STATUS_FAILURE;
+        }
+        length = snprintf(dir + length, sizeof(dir) - (size_t)length, "/" PAL_OS_DATASTORE_SUBDIR) + length;
+#endif
+    }
+    if ((length <= 0) || ((size_t)length >= sizeof(dir)) || (PAL_STATUS_SUCCESS != pal_os_datastore_check_dir(dir)))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    length = snprintf(p_path, PATH_MAX, "%s/optiga_datastore_%04x", dir, datastore_id);
+    return ((length > 0) && (length < PATH_MAX)) ? PAL_STATUS_SUCCESS : PAL_STATUS_FAILURE;
+}
+
+pal_status_t pal_os_datastore_write(uint16_t datastore_id, const uint8_t * p_buffer, uint16_t length)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    char path[PATH_MAX];
+    char temp_path[PATH_MAX + 8];
+    int fd;
+
+    if (PAL_STATUS_SUCCESS != pal_os_datastore_path(path, datastore_id))
+    {
+        return status;
+    }
+    // Write to a new temporary file and rename it, so that readers never see a partial content.
+    // mkstemp creates the file exclusively with mode 0600, an existing file or symbolic link is never followed
+    snprintf(temp_path, sizeof(temp_path), "%s.XXXXXX", path);
+    fd = mkstemp(temp_path);
+    if (fd < 0)
+    {
+        ERR(LOG_PREFIX "Failed to create %s, errno %d\n", temp_path, errno);
+        return status;
+    }
+    if ((length == write(fd, p_buffer, length)) && (0 == fsync(fd)))
+    {
+        status = PAL_STATUS_SUCCESS;
+    }
+    if ((0 != close(fd)) || (PAL_STATUS_SUCCESS != status) || (0 != rename(temp_path, path)))
+    {
+        ERR(LOG_PREFIX "Failed to write %s\n", path);
+        unlink(temp_path);
+        status = PAL_STATUS_FAILURE;
+    }
+
+    return status;
+}
+
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, uint8_t * p_buffer, uint16_t * p_length)
+{
+    char path[PATH_MAX];
+    struct stat file_stat;
+    ssize_t bytes_read;
+    int fd = -1;
+
+    do
+    {
+        if (PAL_STATUS_SUCCESS != pal_os_datastore_path(path, datastore_id))
+        {
+            break;
+        }
+        fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+        if (fd < 0)
+        {
+            LOG(LOG_PREFIX "No datastore %s\n", path);
+            break;
+        }
+        // Only a regular file written by the user is trusted
+        if ((0 != fstat(fd, &file_stat)) || (!S_ISREG(file_stat.st_mode)) ||
+            (geteuid() != file_stat.st_uid) || (0 != (file_stat.st_mode & (S_IWGRP | S_IWOTH))))
+        {
+            ERR(LOG_PREFIX "Ignoring %s, not a private file of the user\n", path);
+            break;
+        }
+        bytes_read = read(fd, p_buffer, *p_length);
+        if (bytes_read < 0)
+        {
+            break;
+        }
+        close(fd);
+        *p_length = (uint16_t)bytes_read;
+        return PAL_STATUS_SUCCESS;
+    } while (0);
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+    *p_length = 0;
+    return PAL_STATUS_FAILURE;
+}
+
+/**
+* @}
+*/
@@ -34,73 +34,272 @@
 * @{
 */
 
-#include <stdlib.h>
+
 #include <stdint.h>
 #include <unistd.h>
 #include <stdio.h>
-#include <signal.h>
+#include <string.h>
 #include <time.h>
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
 #include "optiga/pal/pal_os_timer.h"
 #include "optiga/pal/pal_os_event.h"
 
 #include "pal_linux.h"
 
+#define ERR(...)  fprintf(stderr, __VA_ARGS__)
+#define LOG_PREFIX "[IFX-PAL-OS-EVENT] "
+
+/// Maximum number of callback contexts (one per ifx i2c instance) with a pending callback
+#ifndef PAL_OS_EVENT_MAX_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES	(4)
+#endif
 
-#define CLOCKID CLOCK_REALTIME
-#define SIG SIGRTMIN
+#define NSEC_PER_SEC	(1000000000ULL)
+#define NSEC_PER_USEC	(1000ULL)
 
-/** \brief PAL os event structure */
+/** \brief PAL os event structure, a pending one-shot callback */
 typedef struct pal_os_event
 {
+    /// Expiry time on CLOCK_MONOTONIC, in nanoseconds
+    uint64_t deadline_ns;
     /// registered callback
     register_callback callback_registered;
     /// context to be passed to callback
     void * callback_ctx;
 }pal_os_event_t;
 
-static pal_os_event_t pal_os_event_0 = {0};
-static 	timer_t timerid;
+/*
+ * Pending callbacks are kept in a min-heap ordered by expiry time. Each callback context has at most one
+ * pending callback, registering again for the same context replaces it, hence every ifx i2c instance can
+ * have its own timer pending at the same time.
+ * The callbacks are run by a dedicated thread waiting on a timerfd, which is armed for the earliest expiry.
+ * If the application takes the timerfd using pal_os_event_get_handle, the thread is not started and the
+ * application runs the callbacks from its own event loop.
+ */
+static pal_os_event_t pal_os_event_heap[PAL_OS_EVENT_MAX_INSTANCES];
+static uint32_t pal_os_event_count = 0;
+/// Expiry the timerfd is armed for, 0 if disarmed
+static uint64_t pal_os_event_armed_ns = 0;
+static int pal_os_event_timer_fd = -1;
+static int pal_os_event_epoll_fd = -1;
+static pal_status_t pal_os_event_status = PAL_STATUS_FAILURE;
+/// Set once pal_os_event_start has run, the event mode can not change afterwards
+static uint8_t pal_os_event_started = FALSE;
+/// Callbacks are run by the application instead of the event thread
+static uint8_t pal_os_event_external = FALSE;
+static pal_os_event_stats_t pal_os_event_stats = {0};
+static pthread_mutex_t pal_os_event_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t pal_os_event_once = PTHREAD_ONCE_INIT;
 
-static void handler(int sig, siginfo_t *si, void *uc)
+static uint64_t pal_os_event_now_ns(void)
 {
-	register_callback callback;
-	
-	if (pal_os_event_0.callback_registered)
-    {
-        callback = pal_os_event_0.callback_registered;
-        pal_os_event_0.callback_registered = NULL;
-        callback((void * )pal_os_event_0.callback_ctx);
-    }
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
 }
 
-pal_status_t pal_os_event_init(void)
+static void pal_os_event_swap(uint32_t first, uint32_t second)
+{
+	pal_os_event_t temp = pal_os_event_heap[first];
+
+	pal_os_event_heap[first] = pal_os_event_heap[second];
+	pal_os_event_heap[second] = temp;
+}
+
+static void pal_os_event_sift_up(uint32_t index)
+{
+	while ((index > 0) &&
+		   (pal_os_event_heap[index].deadline_ns < pal_os_event_heap[(index - 1) / 2].deadline_ns))
+	{
+		pal_os_event_swap(index, (index - 1) / 2);
+		index = (index - 1) / 2;
+	}
+}
+
+static void pal_os_event_sift_down(uint32_t index)
+{
+	uint32_t smallest;
+	uint32_t child;
+
+	for (;;)
+	{
+		smallest = index;
+		for (child = (2 * index) + 1; (child <= (2 * index) + 2) && (child < pal_os_event_count); child++)
+		{
+			if (pal_os_event_heap[child].deadline_ns < pal_os_event_heap[smallest].deadline_ns)
+			{
+				smallest = child;
+			}
+		}
+		if (smallest == index)
+		{
+			break;
+		}
+		pal_os_event_swap(index, smallest);
+		index = smallest;
+	}
+}
+
+static void pal_os_event_remove(uint32_t index)
+{
+	pal_os_event_count--;
+	if (index != pal_os_event_count)
+	{
+		pal_os_event_heap[index] = pal_os_event_heap[pal_os_event_count];
+		pal_os_event_sift_up(index);
+		pal_os_event_sift_down(index);
+	}
+}
+
+// Arms the timerfd for the earliest pending callback. Must be called with the mutex held
+static void pal_os_event_arm(void)
+{
+	struct itimerspec its;
+	uint64_t deadline_ns = (pal_os_event_count > 0) ? pal_os_event_heap[0].deadline_ns : 0;
+
+	if (deadline_ns == pal_os_event_armed_ns)
+	{
+		return;
+	}
+	memset(&its, 0, sizeof(its));
+	// One-shot at an absolute time, it_interval stays zero. A zero it_value disarms the timer
+	its.it_value.tv_sec = (time_t)(deadline_ns / NSEC_PER_SEC);
+	its.it_value.tv_nsec = (long)(deadline_ns % NSEC_PER_SEC);
+	if (timerfd_settime(pal_os_event_timer_fd, TFD_TIMER_ABSTIME, &its, NULL) == -1)
+	{
+		ERR(LOG_PREFIX "timerfd_settime failed, errno %d\n", errno);
+		return;
+	}
+	pal_os_event_armed_ns = deadline_ns;
+}
+
+// Runs all callbacks which are due
+static void pal_os_event_run_expired(void)
 {
-	struct sigevent sev;
-	struct sigaction sa;
-	
-	/* Establishing handler for signal */
-	
-	sa.sa_flags = SA_SIGINFO;
-	sa.sa_sigaction = handler;
-	sigemptyset(&sa.sa_mask);
-	if (sigaction(SIG, &sa, NULL) == -1)
+	pal_os_event_t event;
+	uint64_t now_ns;
+	uint64_t latency_us;
+
+	pthread_mutex_lock(&pal_os_event_mutex);
+	// The timer has expired, it is re-armed below if callbacks are pending
+	pal_os_event_armed_ns = 0;
+	now_ns = pal_os_event_now_ns();
+	while ((pal_os_event_count > 0) && (pal_os_event_heap[0].deadline_ns <= now_ns))
 	{
-		printf("sigaction\n");
-		exit(1);
+		event = pal_os_event_heap[0];
+		pal_os_event_remove(0);
+
+		latency_us = (now_ns - event.deadline_ns) / NSEC_PER_USEC;
+		if ((0 == pal_os_event_stats.callbacks) || (latency_us < pal_os_event_stats.min_latency_us))
+		{
+			pal_os_event_stats.min_latency_us = (uint32_t)latency_us;
+		}
+		if (latency_us > pal_os_event_stats.max_latency_us)
+		{
+			pal_os_event_stats.max_latency_us = (uint32_t)latency_us;
+		}
+		pal_os_event_stats.total_latency_us += latency_us;
+		pal_os_event_stats.callbacks++;
+
+		// The callback typically registers the next callback, hence it is called without the mutex held
+		pthread_mutex_unlock(&pal_os_event_mutex);
+		event.callback_registered(event.callback_ctx);
+		pthread_mutex_lock(&pal_os_event_mutex);
+		now_ns = pal_os_event_now_ns();
 	}
+	pal_os_event_arm();
+	pthread_mutex_unlock(&pal_os_event_mutex);
+}
 
-	/* Create the timer */
+static void * pal_os_event_thread(void * arg)
+{
+	struct epoll_event event;
+	uint64_t expirations;
+	int count;
 
-	sev.sigev_notify = SIGEV_SIGNAL;
-	sev.sigev_signo = SIG;
-	sev.sigev_value.sival_ptr = &timerid;
-	if (timer_create(CLOCKID, &sev, &timerid) == -1)
+	(void)arg;
+	for (;;)
 	{
-		printf("timer_create\n");
-		exit(1);
+		count = epoll_wait(pal_os_event_epoll_fd, &event, 1, -1);
+		if (count < 0)
+		{
+			if (EINTR == errno)
+			{
+				continue;
+			}
+			ERR(LOG_PREFIX "epoll_wait failed, errno %d. Event thread stopped\n", errno);
+			break;
+		}
+		// The timerfd is non-blocking, a timer re-armed meanwhile reads EAGAIN
+		if (read(pal_os_event_timer_fd, &expirations, sizeof(expirations)) < 0)
+		{
+			expirations = 0;
+		}
+		pal_os_event_run_expired();
 	}
-	
-	return PAL_STATUS_SUCCESS;
+	return NULL;
+}
+
+static void pal_os_event_start(void)
+{
+	struct epoll_event event = {0};
+	pthread_t thread;
+	uint8_t external;
+
+	pthread_mutex_lock(&pal_os_event_mutex);
+	pal_os_event_started = TRUE;
+	external = pal_os_event_external;
+	pthread_mutex_unlock(&pal_os_event_mutex);
+
+	do
+	{
+		pal_os_event_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		if (pal_os_event_timer_fd < 0)
+		{
+			ERR(LOG_PREFIX "timerfd_create failed, errno %d\n", errno);
+			break;
+		}
+		if (external)
+		{
+			// The application polls the timerfd itself
+			pal_os_event_status = PAL_STATUS_SUCCESS;
+			break;
+		}
+		pal_os_event_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (pal_os_event_epoll_fd < 0)
+		{
+			ERR(LOG_PREFIX "epoll_create1 failed, errno %d\n", errno);
+			break;
+		}
+		event.events = EPOLLIN;
+		event.data.fd = pal_os_event_timer_fd;
+		if (epoll_ctl(pal_os_event_epoll_fd, EPOLL_CTL_ADD, pal_os_event_timer_fd, &event) == -1)
+		{
+			ERR(LOG_PREFIX "epoll_ctl failed, errno %d\n", errno);
+			break;
+		}
+		if (0 != pthread_create(&thread, NULL, pal_os_event_thread, NULL))
+		{
+			ERR(LOG_PREFIX "Failed to create the event thread\n");
+			break;
+		}
+		pthread_detach(thread);
+		pal_os_event_status = PAL_STATUS_SUCCESS;
+	} while (0);
+}
+
+pal_status_t pal_os_event_init(void)
+{
+	pthread_once(&pal_os_event_once, pal_os_event_start);
+	return pal_os_event_status;
 }
 
 
@@ -108,27 +307,167 @@ void pal_os_event_register_callback_oneshot(register_callback callback,
                                             void*             callback_args,
                                             uint32_t          time_us)
 {
-	struct itimerspec its;
-	long long freq_nanosecs;
-    pal_os_event_0.callback_registered = callback;
-    pal_os_event_0.callback_ctx = callback_args;
-	
-	/* Start the timer */
+	uint64_t deadline_ns;
+	uint32_t index;
+
+	if (PAL_STATUS_SUCCESS != pal_os_event_init())
+	{
+		ERR(LOG_PREFIX "Event thread not running, callback dropped\n");
+		return;
+	}
+	deadline_ns = pal_os_event_now_ns() + ((uint64_t)time_us * NSEC_PER_USEC);
+
+	pthread_mutex_lock(&pal_os_event_mutex);
+	for (index = 0; index < pal_os_event_count; index++)
+	{
+		if (pal_os_event_heap[index].callback_ctx == callback_args)
+		{
+			break;
+		}
+	}
+	if (index == pal_os_event_count)
+	{
+		if (PAL_OS_EVENT_MAX_INSTANCES == pal_os_event_count)
+		{
+			pal_os_event_stats.dropped++;
+			pthread_mutex_unlock(&pal_os_event_mutex);
+			ERR(LOG_PREFIX "No free event slot, increase PAL_OS_EVENT_MAX_INSTANCES\n");
+			return;
+		}
+		pal_os_event_count++;
+	}
+	pal_os_event_heap[index].deadline_ns = deadline_ns;
+	pal_os_event_heap[index].callback_registered = callback;
+	pal_os_event_heap[index].callback_ctx = callback_args;
+	pal_os_event_sift_up(index);
+	pal_os_event_sift_down(index);
+	pal_os_event_arm();
+	pthread_mutex_unlock(&pal_os_event_mutex);
+}
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+int32_t pal_os_event_get_handle(void)
+{
+	pthread_mutex_lock(&pal_os_event_mutex);
+	if (!pal_os_event_started)
+	{
+		pal_os_event_external = TRUE;
+	}
+	pthread_mutex_unlock(&pal_os_event_mutex);
+
+	// The event thread is already running, it would race with the application for the timerfd
+	if ((PAL_STATUS_SUCCESS != pal_os_event_init()) || (!pal_os_event_external))
+	{
+		return -1;
+	}
+	return (int32_t)pal_os_event_timer_fd;
+}
+
+uint32_t pal_os_event_get_next_timeout_us(void)
+{
+	uint32_t timeout_us = PAL_OS_EVENT_NO_TIMEOUT;
+	uint64_t now_ns;
+	uint64_t remaining_us;
+
+	pthread_mutex_lock(&pal_os_event_mutex);
+	if (pal_os_event_count > 0)
+	{
+		now_ns = pal_os_event_now_ns();
+		remaining_us = 0;
+		if (pal_os_event_heap[0].deadline_ns > now_ns)
+		{
+			// Rounded up, waking up before the deadline would find nothing to run
+			remaining_us = ((pal_os_event_heap[0].deadline_ns - now_ns) + NSEC_PER_USEC - 1) / NSEC_PER_USEC;
+		}
+		timeout_us = (remaining_us < PAL_OS_EVENT_NO_TIMEOUT) ? (uint32_t)remaining_us : (PAL_OS_EVENT_NO_TIMEOUT - 1);
+	}
+	pthread_mutex_unlock(&pal_os_event_mutex);
+	return timeout_us;
+}
+
+void pal_os_event_process(void)
+{
+	uint64_t expirations;
+
+	if (PAL_STATUS_SUCCESS != pal_os_event_init())
+	{
+		return;
+	}
+	// Clears the readable state of the timerfd, EAGAIN if it did not expire yet
+	if (read(pal_os_event_timer_fd, &expirations, sizeof(expirations)) < 0)
+	{
+		expirations = 0;
+	}
+	pal_os_event_run_expired();
+}
+
+#ifdef PAL_OS_HAS_EVENT_WAIT
+// Blocks until the timerfd expires, used if no thread runs the callbacks
+static void pal_os_event_poll_timer(void)
+{
+	struct pollfd timer_poll;
 
-	freq_nanosecs = time_us * 1000;
-	its.it_value.tv_sec = freq_nanosecs / 1000000000;
-	its.it_value.tv_nsec = freq_nanosecs % 1000000000;
-	its.it_interval.tv_sec = its.it_value.tv_sec;
-	its.it_interval.tv_nsec = its.it_value.tv_nsec;
-	
-	if (timer_settime(timerid, 0, &its, NULL) == -1)
+	timer_poll.fd = pal_os_event_timer_fd;
+	timer_poll.events = POLLIN;
+	timer_poll.revents = 0;
+	if ((poll(&timer_poll, 1, -1) < 0) && (EINTR != errno))
 	{
-		printf("Error in timer_settime\n");
-	    exit(1);
+		pal_os_timer_delay_in_milliseconds(1);
 	}
 }
+#endif
+#endif
+
+void pal_os_event_get_stats(pal_os_event_stats_t * p_stats)
+{
+	pthread_mutex_lock(&pal_os_event_mutex);
+	*p_stats = pal_os_event_stats;
+	pthread_mutex_unlock(&pal_os_event_mutex);
+}
+
+void pal_os_event_reset_stats(void)
+{
+	pthread_mutex_lock(&pal_os_event_mutex);
+	pal_os_event_stats = (pal_os_event_stats_t){0};
+	pthread_mutex_unlock(&pal_os_event_mutex);
+}
+
+#ifdef PAL_OS_HAS_EVENT_WAIT
+/*
+ * The status word doubles as a futex. The waker runs in the event thread, FUTEX_WAIT returns
+ * EAGAIN if the value changed before the waiter went to sleep.
+ */
+void pal_os_event_wait(volatile uint32_t* p_status, uint32_t busy_value)
+{
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+	// Without the event thread, the waiting thread runs the callbacks which complete the wait
+	while (pal_os_event_external && (*p_status == busy_value))
+	{
+		pal_os_event_poll_timer();
+		pal_os_event_process();
+	}
+#endif
+	while (*p_status == busy_value)
+	{
+		if ((syscall(SYS_futex, (uint32_t *)p_status, FUTEX_WAIT_PRIVATE, busy_value, NULL, NULL, 0) == -1) &&
+			(errno != EAGAIN) && (errno != EINTR))
+		{
+			// futex not usable, degrade to coarse polling
+			pal_os_timer_delay_in_milliseconds(1);
+		}
+	}
+}
+
+void pal_os_event_notify(volatile uint32_t* p_status, uint32_t new_value)
+{
+	int saved_errno = errno;
+
+	__atomic_store_n(p_status, new_value, __ATOMIC_SEQ_CST);
+	(void)syscall(SYS_futex, (uint32_t *)p_status, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	errno = saved_errno;
+}
+#endif
 
 /**
 * @}
 */
-
@@ -26,44 +26,223 @@
 *
 * \brief   This file implements the platform abstraction layer APIs for os locks (e.g. semaphore).
 *
+* The lock blocks instead of failing when it is taken, hence the callers retrying until success no longer spin.
+* Waiting threads sleep on a futex each and are served first in, first out within their priority class, the
+* lock is handed over by the releasing thread so a thread arriving later can not overtake a waiting one.
+* The same queue guards the in use flags of the command library, see #pal_os_lock_acquire_flag, so the order
+* and the priority classes apply to the use of the OPTIGA itself and not only to the short flag updates.
+*
 * \ingroup  grPAL
 * @{
 */
 
+#include <stdint.h>
+#include <time.h>
+#include <errno.h>
+#include <pthread.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #include "optiga/pal/pal_os_lock.h"
+#include "optiga/pal/pal_os_timer.h"
+#include "pal_linux.h"
+
+#define NSEC_PER_SEC    (1000000000ULL)
+#define NSEC_PER_USEC    (1000ULL)
+
+/** @brief A thread waiting for the lock, lives on the stack of the waiting thread */
+typedef struct pal_os_lock_waiter
+{
+    /// Next waiter of the same priority class
+    struct pal_os_lock_waiter * p_next;
+    /// Flag the waiter waits for
+    volatile uint32_t * p_flag;
+    /// Set by the releasing thread when the lock is handed over, the futex the waiter sleeps on
+    volatile uint32_t granted;
+} pal_os_lock_waiter_t;
 
 /**
  * @brief PAL OS lock structure. Might be extended if needed
  */
 typedef struct pal_os_lock
 {
-    uint8_t lock;
+    /// Protects all fields, held only while the lock state changes and never while sleeping
+    pthread_mutex_t mutex;
+    /// The lock is taken
+    volatile uint32_t lock;
+    /// Number of waiting threads
+    uint32_t waiters;
+    /// First waiter of each priority class
+    pal_os_lock_waiter_t * p_head[PAL_OS_LOCK_PRIORITY_CLASSES];
+    /// Last waiter of each priority class
+    pal_os_lock_waiter_t * p_tail[PAL_OS_LOCK_PRIORITY_CLASSES];
+    /// Contention statistics
+    pal_os_lock_stats_t stats;
 } pal_os_lock_t;
 
-volatile static pal_os_lock_t pal_os_lock = {.lock = 0};
+static pal_os_lock_t pal_os_lock = {.mutex = PTHREAD_MUTEX_INITIALIZER};
 
-pal_status_t pal_os_lock_acquire(void)
+/// Priority class of the calling thread
+static __thread uint8_t pal_os_lock_priority = PAL_OS_LOCK_PRIORITY_NORMAL;
+
+static uint64_t pal_os_lock_now_ns(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * NSEC_PER_SEC) + (uint64_t)now.tv_nsec;
+}
+
+// Called with the mutex held, wait_ns is the time spent in the queue, 0 if the lock was free
+static void pal_os_lock_count_acquisition(uint8_t priority, uint8_t contended, uint64_t wait_ns)
 {
-    pal_status_t return_status = PAL_STATUS_FAILURE;
+    uint64_t wait_us = wait_ns / NSEC_PER_USEC;
 
-    if(!(pal_os_lock.lock))
+    pal_os_lock.stats.acquisitions++;
+    pal_os_lock.stats.class_acquisitions[priority]++;
+    if (contended)
     {
-    	pal_os_lock.lock++;
-        if(pal_os_lock.lock != 1)
+        pal_os_lock.stats.contended++;
+        pal_os_lock.stats.total_wait_us += wait_us;
+        if (wait_us > pal_os_lock.stats.max_wait_us)
         {
-        	pal_os_lock.lock--;
+            pal_os_lock.stats.max_wait_us = (uint32_t)wait_us;
         }
-        return_status = PAL_STATUS_SUCCESS;
     }
-    return return_status;
 }
 
-void pal_os_lock_release(void)
+pal_status_t pal_os_lock_acquire_flag(volatile uint32_t * p_flag)
 {
-    if(pal_os_lock.lock)
+    pal_os_lock_waiter_t waiter = {NULL, p_flag, FALSE};
+    uint8_t priority = pal_os_lock_priority;
+    uint64_t start_ns;
+
+    pthread_mutex_lock(&pal_os_lock.mutex);
+    if (!*p_flag)
+    {
+        *p_flag = TRUE;
+        pal_os_lock_count_acquisition(priority, FALSE, 0);
+        pthread_mutex_unlock(&pal_os_lock.mutex);
+        return PAL_STATUS_SUCCESS;
+    }
+
+    // Taken, queue behind the waiters of the same class
+    if (NULL == pal_os_lock.p_tail[priority])
+    {
+        pal_os_lock.p_head[priority] = &waiter;
+    }
+    else
+    {
+        pal_os_lock.p_tail[priority]->p_next = &waiter;
+    }
+    pal_os_lock.p_tail[priority] = &waiter;
+    pal_os_lock.waiters++;
+    if (pal_os_lock.waiters > pal_os_lock.stats.max_waiters)
+    {
+        pal_os_lock.stats.max_waiters = pal_os_lock.waiters;
+    }
+    start_ns = pal_os_lock_now_ns();
+    pthread_mutex_unlock(&pal_os_lock.mutex);
+
+    while (!__atomic_load_n(&waiter.granted, __ATOMIC_SEQ_CST))
     {
-    	pal_os_lock.lock--;
+        if ((syscall(SYS_futex, (uint32_t *)&waiter.granted, FUTEX_WAIT_PRIVATE, FALSE, NULL, NULL, 0) == -1) &&
+            (errno != EAGAIN) && (errno != EINTR))
+        {
+            // futex not usable, degrade to coarse polling
+            pal_os_timer_delay_in_milliseconds(1);
+        }
     }
+
+    // The releasing thread wakes the waiter with the mutex held, taking it here ensures the wake is done
+    // before the waiter and its futex word go out of scope
+    pthread_mutex_lock(&pal_os_lock.mutex);
+    pal_os_lock_count_acquisition(priority, TRUE, pal_os_lock_now_ns() - start_ns);
+    pthread_mutex_unlock(&pal_os_lock.mutex);
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_os_lock_release_flag(volatile uint32_t * p_flag)
+{
+    pal_os_lock_waiter_t * p_waiter = NULL;
+    pal_os_lock_waiter_t * p_previous;
+    uint8_t priority;
+
+    pthread_mutex_lock(&pal_os_lock.mutex);
+    if (*p_flag)
+    {
+        // Oldest waiter for this flag in the highest class, waiters for other flags keep their place
+        for (priority = 0; (priority < PAL_OS_LOCK_PRIORITY_CLASSES) && (NULL == p_waiter); priority++)
+        {
+            p_previous = NULL;
+            for (p_waiter = pal_os_lock.p_head[priority]; NULL != p_waiter; p_waiter = p_waiter->p_next)
+            {
+                if (p_flag == p_waiter->p_flag)
+                {
+                    break;
+                }
+                p_previous = p_waiter;
+            }
+            if (NULL != p_waiter)
+            {
+                if (NULL == p_previous)
+                {
+                    pal_os_lock.p_head[priority] = p_waiter->p_next;
+                }
+                else
+                {
+                    p_previous->p_next = p_waiter->p_next;
+                }
+                if (p_waiter == pal_os_lock.p_tail[priority])
+                {
+                    pal_os_lock.p_tail[priority] = p_previous;
+                }
+            }
+        }
+
+        if (NULL == p_waiter)
+        {
+            *p_flag = FALSE;
+        }
+        else
+        {
+            // Hand over, the flag stays set
+            pal_os_lock.waiters--;
+            __atomic_store_n(&p_waiter->granted, TRUE, __ATOMIC_SEQ_CST);
+            (void)syscall(SYS_futex, (uint32_t *)&p_waiter->granted, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+        }
+    }
+    pthread_mutex_unlock(&pal_os_lock.mutex);
+}
+
+pal_status_t pal_os_lock_acquire(void)
+{
+    return pal_os_lock_acquire_flag(&pal_os_lock.lock);
+}
+
+void pal_os_lock_release(void)
+{
+    pal_os_lock_release_flag(&pal_os_lock.lock);
+}
+
+void pal_os_lock_set_priority(uint8_t priority_class)
+{
+    pal_os_lock_priority = (priority_class < PAL_OS_LOCK_PRIORITY_CLASSES) ?
+                           priority_class : (PAL_OS_LOCK_PRIORITY_CLASSES - 1);
+}
+
+void pal_os_lock_get_stats(pal_os_lock_stats_t * p_stats)
+{
+    pthread_mutex_lock(&pal_os_lock.mutex);
+    *p_stats = pal_os_lock.stats;
+    pthread_mutex_unlock(&pal_os_lock.mutex);
+}
+
+void pal_os_lock_reset_stats(void)
+{
+    pthread_mutex_lock(&pal_os_lock.mutex);
+    pal_os_lock.stats = (pal_os_lock_stats_t){0};
+    pthread_mutex_unlock(&pal_os_lock.mutex);
 }
 
 /**
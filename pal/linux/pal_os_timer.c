@@ -34,7 +34,7 @@
 * @{
 */
 
-#include <sys/time.h> 
+#include <time.h>
 #include <stdio.h>
 #include "stdint.h"
 #include <unistd.h>
@@ -50,23 +50,26 @@
 #define ERR(...)  fprintf(stderr, __VA_ARGS__)
 #define LOG_PREFIX "[IFX-PAL-OS-TIMER] "
 
-uint32_t pal_os_timer_get_time_in_milliseconds()
+#define NSEC_PER_USEC   (1000ULL)
+#define USEC_PER_SEC    (1000000ULL)
+
+// CLOCK_MONOTONIC is not stepped by NTP or settimeofday, hence timeouts survive wall clock changes
+uint64_t pal_os_timer_get_time_in_microseconds(void)
 {
-    uint32_t       now_ms = 0;
-    struct timeval tv;
+    struct timespec now;
 
-    // gettimeofday() returns 0 for success, or -1 for failure
-    if (0 == gettimeofday(&tv, NULL))
-    {
-    	now_ms = ((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
-    }
-    else
+    if (0 != clock_gettime(CLOCK_MONOTONIC, &now))
     {
-    	now_ms = 0;
-    	exit(-1);
+        ERR(LOG_PREFIX "clock_gettime failed\n");
+        return 0;
     }
-    //LOG(LOG_PREFIX "pal_os_timer_get_time_in_milliseconds() <\n");
-    return now_ms;
+    return ((uint64_t)now.tv_sec * USEC_PER_SEC) + ((uint64_t)now.tv_nsec / NSEC_PER_USEC);
+}
+
+uint32_t pal_os_timer_get_time_in_milliseconds(void)
+{
+    // Wraps after ~49 days, users compute differences in uint32_t
+    return (uint32_t)(pal_os_timer_get_time_in_microseconds() / 1000);
 }
 
 
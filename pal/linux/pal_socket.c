@@ -0,0 +1,587 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_socket.c
+*
+* \brief   This file implements the platform abstraction layer APIs for UDP sockets on Linux.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+// recvmmsg() and sendmmsg() are GNU extensions
+#define _GNU_SOURCE
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netdb.h>
+#include <poll.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "optiga/pal/pal_socket.h"
+#include "optiga/pal/pal_os_timer.h"
+
+#ifdef MODULE_ENABLE_DTLS_MUTUAL_AUTH
+
+/**********************************************************************************************************************
+ * MACROS
+ *********************************************************************************************************************/
+/// @cond hidden
+/// Datagrams moved by one recvmmsg() or sendmmsg() call
+#define PAL_SOCKET_BATCH_SIZE               (8U)
+/// Largest datagram held in the batch buffers, the upper limit of the DTLS path MTU
+#define PAL_SOCKET_DATAGRAM_SIZE            (1500U)
+
+/// Content types of the DTLS records that make up a handshake flight
+#define PAL_SOCKET_DTLS_CHANGE_CIPHER_SPEC  (0x14U)
+#define PAL_SOCKET_DTLS_HANDSHAKE           (0x16U)
+
+/**********************************************************************************************************************
+ * LOCAL DATA
+ *********************************************************************************************************************/
+typedef struct pal_socket_batch
+{
+    /// Datagrams received by the last recvmmsg(), handed out one per pal_socket_listen
+    uint8_t rx_data[PAL_SOCKET_BATCH_SIZE][PAL_SOCKET_DATAGRAM_SIZE];
+    struct sockaddr_storage rx_peer[PAL_SOCKET_BATCH_SIZE];
+    struct iovec rx_iov[PAL_SOCKET_BATCH_SIZE];
+    struct mmsghdr rx_msg[PAL_SOCKET_BATCH_SIZE];
+    uint32_t rx_count;
+    uint32_t rx_next;
+
+    /// Records queued by pal_socket_send and not yet passed to sendmmsg()
+    uint8_t tx_data[PAL_SOCKET_BATCH_SIZE][PAL_SOCKET_DATAGRAM_SIZE];
+    struct sockaddr_storage tx_peer;
+    struct iovec tx_iov[PAL_SOCKET_BATCH_SIZE];
+    struct mmsghdr tx_msg[PAL_SOCKET_BATCH_SIZE];
+    uint32_t tx_count;
+} pal_socket_batch_t;
+
+static socklen_t pal_socket_address_length(const struct sockaddr_storage* p_address)
+{
+    return (AF_INET6 == p_address->ss_family) ? (socklen_t)sizeof(struct sockaddr_in6) :
+                                                 (socklen_t)sizeof(struct sockaddr_in);
+}
+
+static void pal_socket_set_port(struct sockaddr_storage* p_address, uint16_t port)
+{
+    if (AF_INET6 == p_address->ss_family)
+    {
+        ((struct sockaddr_in6*)p_address)->sin6_port = htons(port);
+    }
+    else
+    {
+        ((struct sockaddr_in*)p_address)->sin_port = htons(port);
+    }
+}
+
+static int32_t pal_socket_map_error(int error)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+
+    if ((ENOBUFS == error) || (ENOMEM == error))
+    {
+        i4RetVal = (int32_t) E_COMMS_INSUFFICIENT_MEMORY;
+    }
+    else if ((ENETUNREACH == error) || (EHOSTUNREACH == error) || (EADDRNOTAVAIL == error))
+    {
+        i4RetVal = (int32_t) E_COMMS_UDP_ROUTING_FAILURE;
+    }
+    return i4RetVal;
+}
+
+// Passes all queued records to the kernel, to the peer held in sIPAddress and wPort
+static int32_t pal_socket_flush(const pal_socket_t* p_socket)
+{
+    pal_socket_batch_t* p_batch = p_socket->psBatch;
+    socklen_t address_length = pal_socket_address_length(&p_socket->sIPAddress);
+    struct pollfd poll_fd;
+    uint32_t sent = 0;
+    uint32_t index;
+    int count;
+
+    memcpy(&p_batch->tx_peer, &p_socket->sIPAddress, sizeof(p_batch->tx_peer));
+    pal_socket_set_port(&p_batch->tx_peer, p_socket->wPort);
+    for (index = 0; index < p_batch->tx_count; index++)
+    {
+        p_batch->tx_msg[index].msg_hdr.msg_namelen = address_length;
+    }
+
+    while (sent < p_batch->tx_count)
+    {
+        count = sendmmsg(p_socket->iSocketHdl, &p_batch->tx_msg[sent], p_batch->tx_count - sent, 0);
+        if (count > 0)
+        {
+            sent += (uint32_t)count;
+            continue;
+        }
+        // ECONNREFUSED reports an ICMP error for an earlier datagram, this one was not sent yet
+        if ((EINTR == errno) || (ECONNREFUSED == errno))
+        {
+            continue;
+        }
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+        {
+            poll_fd.fd = p_socket->iSocketHdl;
+            poll_fd.events = POLLOUT;
+            if ((poll(&poll_fd, 1, -1) >= 0) || (EINTR == errno))
+            {
+                continue;
+            }
+        }
+        p_batch->tx_count = 0;
+        return pal_socket_map_error(errno);
+    }
+    p_batch->tx_count = 0;
+    return (int32_t) E_COMMS_SUCCESS;
+}
+
+// Refills the receive ring, waiting up to wTimeout in eNonBlock mode and without limit in eBlock mode
+static int32_t pal_socket_receive_batch(pal_socket_t* p_socket)
+{
+    pal_socket_batch_t* p_batch = p_socket->psBatch;
+    uint32_t start = pal_os_timer_get_time_in_milliseconds();
+    uint32_t elapsed;
+    struct pollfd poll_fd;
+    int timeout = -1;
+    uint32_t index;
+    int count;
+
+    poll_fd.fd = p_socket->iSocketHdl;
+    poll_fd.events = POLLIN;
+
+    for (;;)
+    {
+        for (index = 0; index < PAL_SOCKET_BATCH_SIZE; index++)
+        {
+            p_batch->rx_msg[index].msg_hdr.msg_namelen = sizeof(p_batch->rx_peer[index]);
+            p_batch->rx_msg[index].msg_hdr.msg_flags = 0;
+        }
+
+        // Everything already queued on the socket is collected with one system call
+        count = recvmmsg(p_socket->iSocketHdl, p_batch->rx_msg, PAL_SOCKET_BATCH_SIZE, MSG_DONTWAIT, NULL);
+        if (count > 0)
+        {
+            p_batch->rx_count = (uint32_t)count;
+            p_batch->rx_next = 0;
+            return (int32_t) E_COMMS_SUCCESS;
+        }
+        // ECONNREFUSED reports an ICMP error for an earlier send, the peer may still answer a retransmission
+        if ((count < 0) && (EINTR != errno) && (ECONNREFUSED != errno) && (EAGAIN != errno) && (EWOULDBLOCK != errno))
+        {
+            return pal_socket_map_error(errno);
+        }
+
+        if ((uint8_t)eNonBlock == p_socket->bMode)
+        {
+            elapsed = pal_os_timer_get_time_in_milliseconds() - start;
+            if (elapsed >= (uint32_t)p_socket->wTimeout)
+            {
+                return (int32_t) E_COMMS_UDP_NO_DATA_RECEIVED;
+            }
+            timeout = (int)((uint32_t)p_socket->wTimeout - elapsed);
+        }
+
+        // Sleep in the kernel until a datagram arrives instead of polling the timer
+        if ((poll(&poll_fd, 1, timeout) < 0) && (EINTR != errno))
+        {
+            return (int32_t) E_COMMS_FAILURE;
+        }
+    }
+}
+/// @endcond
+
+/**
+ * Converts an IPv4 or IPv6 address or a host name to a socket address
+ *
+ * \param[in]      p_ip_address       Pointer to the address string
+ * \param[in,out]  p_input_ip_address Pointer to the struct sockaddr_storage to be assigned
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_FAILURE on failure
+ */
+int32_t pal_socket_assign_ip_address(const char* p_ip_address, void* p_input_ip_address)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    struct addrinfo hints;
+    struct addrinfo* p_result = NULL;
+
+    do
+    {
+        //check for null values
+        if ((NULL == p_ip_address) || (NULL == p_input_ip_address))
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_DGRAM;
+        hints.ai_protocol = IPPROTO_UDP;
+
+        if ((0 != getaddrinfo(p_ip_address, NULL, &hints, &p_result)) ||
+            (p_result->ai_addrlen > sizeof(struct sockaddr_storage)))
+        {
+            break;
+        }
+
+        memset(p_input_ip_address, 0, sizeof(struct sockaddr_storage));
+        memcpy(p_input_ip_address, p_result->ai_addr, p_result->ai_addrlen);
+
+        i4RetVal = (int32_t) E_COMMS_SUCCESS;
+    } while (FALSE);
+
+    if (NULL != p_result)
+    {
+        freeaddrinfo(p_result);
+    }
+    return i4RetVal;
+}
+
+/**
+ * Initializes socket communication structure and creates a non-blocking socket
+ * of the address family of sIPAddress
+ *
+ * \param[out]  p_socket Pointer to the socket communication structure
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_UDP_ALLOCATE_FAILURE on failure to allocate memory or the socket
+ */
+int32_t pal_socket_init(pal_socket_t* p_socket)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    pal_socket_batch_t* p_batch;
+    uint32_t index;
+
+    do
+    {
+        //check for null values
+        if (NULL == p_socket)
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+
+        p_socket->iSocketHdl = -1;
+        p_socket->psBatch = (pal_socket_batch_t*)calloc(1, sizeof(pal_socket_batch_t));
+        if (NULL == p_socket->psBatch)
+        {
+            i4RetVal = (int32_t) E_COMMS_UDP_ALLOCATE_FAILURE;
+            break;
+        }
+
+        p_batch = p_socket->psBatch;
+        for (index = 0; index < PAL_SOCKET_BATCH_SIZE; index++)
+        {
+            p_batch->rx_iov[index].iov_base = p_batch->rx_data[index];
+            p_batch->rx_iov[index].iov_len = PAL_SOCKET_DATAGRAM_SIZE;
+            p_batch->rx_msg[index].msg_hdr.msg_name = &p_batch->rx_peer[index];
+            p_batch->rx_msg[index].msg_hdr.msg_iov = &p_batch->rx_iov[index];
+            p_batch->rx_msg[index].msg_hdr.msg_iovlen = 1;
+
+            p_batch->tx_iov[index].iov_base = p_batch->tx_data[index];
+            p_batch->tx_msg[index].msg_hdr.msg_name = &p_batch->tx_peer;
+            p_batch->tx_msg[index].msg_hdr.msg_iov = &p_batch->tx_iov[index];
+            p_batch->tx_msg[index].msg_hdr.msg_iovlen = 1;
+        }
+
+        p_socket->iSocketHdl = socket((AF_INET6 == p_socket->sIPAddress.ss_family) ? AF_INET6 : AF_INET,
+                                      SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+        if (p_socket->iSocketHdl < 0)
+        {
+            free(p_socket->psBatch);
+            p_socket->psBatch = NULL;
+            i4RetVal = (int32_t) E_COMMS_UDP_ALLOCATE_FAILURE;
+            break;
+        }
+
+        i4RetVal = (int32_t) E_COMMS_SUCCESS;
+    } while (FALSE);
+    return i4RetVal;
+}
+
+/**
+ * Opens a socket server port on sIPAddress
+ *
+ * \param[out]  p_socket    Pointer to the socket communication structure
+ * \param[in]   port        Port number for server
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_UDP_BINDING_FAILURE on port binding failure
+ */
+int32_t pal_socket_open(pal_socket_t* p_socket,
+                        uint16_t port)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    struct sockaddr_storage local_address;
+
+    do
+    {
+        //check for null values
+        if ((NULL == p_socket) || (p_socket->iSocketHdl < 0))
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+
+        memcpy(&local_address, &p_socket->sIPAddress, sizeof(local_address));
+        pal_socket_set_port(&local_address, port);
+        if (0 != bind(p_socket->iSocketHdl, (struct sockaddr*)&local_address,
+                      pal_socket_address_length(&local_address)))
+        {
+            i4RetVal = (int32_t) E_COMMS_UDP_BINDING_FAILURE;
+            break;
+        }
+
+        p_socket->wPort = port;
+
+        i4RetVal = (int32_t) E_COMMS_SUCCESS;
+    } while (FALSE);
+    return i4RetVal;
+}
+
+/**
+ * Connects the socket to the server at sIPAddress and port.<br>
+ * Unlike the lwIP port the local port is left to the kernel, so that the server may run on the same host.
+ * The connected socket only accepts datagrams from the server.
+ *
+ * \param[out]  p_socket    Pointer to the socket communication structure
+ * \param[in]   port        Port number for server
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_UDP_CONNECT_FAILURE on connect failure
+ */
+int32_t pal_socket_connect(pal_socket_t* p_socket,
+                           uint16_t port)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    struct sockaddr_storage server_address;
+
+    do
+    {
+        //check for null values
+        if ((NULL == p_socket) || (p_socket->iSocketHdl < 0))
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+
+        memcpy(&server_address, &p_socket->sIPAddress, sizeof(server_address));
+        pal_socket_set_port(&server_address, port);
+        if (0 != connect(p_socket->iSocketHdl, (struct sockaddr*)&server_address,
+                         pal_socket_address_length(&server_address)))
+        {
+            i4RetVal = (int32_t) E_COMMS_UDP_CONNECT_FAILURE;
+            break;
+        }
+        p_socket->wPort = port;
+
+        i4RetVal = (int32_t) E_COMMS_SUCCESS;
+    } while (FALSE);
+    return i4RetVal;
+}
+
+/**
+ * Transmits the data to sIPAddress and wPort.<br>
+ * Handshake and ChangeCipherSpec records are queued while the flight is written and sent with a single
+ * sendmmsg() when the flight is followed by pal_socket_listen, or when the queue is full.
+ * Any other record is sent at once, together with the queued ones.
+ *
+ * \param[in]  p_socket     Pointer to the socket communication structure
+ * \param[in]  p_data       Pointer to the data buffer to be transmitted
+ * \param[in]  length       The length of the data to be transmitted
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_UDP_NO_DATA_TO_SEND on no data present to send
+ * \return  E_COMMS_INSUFFICIENT_BUF_SIZE on datagram larger than the path MTU limit
+ * \return  E_COMMS_INSUFFICIENT_MEMORY on out of memory failure
+ * \return  E_COMMS_UDP_ROUTING_FAILURE on failure to route the UDP packet
+ * \return  E_COMMS_FAILURE on failure
+ */
+int32_t pal_socket_send(const pal_socket_t* p_socket, uint8_t *p_data, uint32_t length)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    pal_socket_batch_t* p_batch;
+
+    do
+    {
+        //check for null values
+        if ((NULL == p_socket) || (NULL == p_data) || (NULL == p_socket->psBatch) || (p_socket->iSocketHdl < 0))
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+
+        if (0 == length)
+        {
+            i4RetVal = (int32_t) E_COMMS_UDP_NO_DATA_TO_SEND;
+            break;
+        }
+
+        if (length > PAL_SOCKET_DATAGRAM_SIZE)
+        {
+            i4RetVal = (int32_t) E_COMMS_INSUFFICIENT_BUF_SIZE;
+            break;
+        }
+
+        p_batch = p_socket->psBatch;
+        memcpy(p_batch->tx_data[p_batch->tx_count], p_data, length);
+        p_batch->tx_iov[p_batch->tx_count].iov_len = length;
+        p_batch->tx_count++;
+
+        if (((PAL_SOCKET_DTLS_HANDSHAKE == p_data[0]) || (PAL_SOCKET_DTLS_CHANGE_CIPHER_SPEC == p_data[0])) &&
+            (p_batch->tx_count < PAL_SOCKET_BATCH_SIZE))
+        {
+            i4RetVal = (int32_t) E_COMMS_SUCCESS;
+            break;
+        }
+
+        i4RetVal = pal_socket_flush(p_socket);
+    } while (FALSE);
+
+    return i4RetVal;
+}
+
+/**
+ * Receives the data from the peer.<br>
+ * Sends the queued flight first, then hands out the datagrams collected by the last recvmmsg().
+ * In eNonBlock mode waits up to wTimeout milliseconds, in eBlock mode until a datagram arrives.
+ *
+ * \param[in,out]  p_socket     Pointer to the socket communication structure
+ * \param[out]     p_data       Pointer to the data buffer to be received
+ * \param[in,out]  p_length     Pointer to the length of the buffer
+ *
+ * \return  E_COMMS_SUCCESS on successful execution
+ * \return  E_COMMS_PARAMETER_NULL on parameter received is NULL
+ * \return  E_COMMS_UDP_NO_DATA_RECEIVED on no data received from the target
+ * \return  E_COMMS_INSUFFICIENT_BUF_SIZE on insufficient buffer size
+ * \return  E_COMMS_FAILURE on failure
+ */
+int32_t pal_socket_listen(pal_socket_t *p_socket,
+                          uint8_t *p_data, uint32_t *p_length)
+{
+    int32_t i4RetVal = (int32_t) E_COMMS_FAILURE;
+    pal_socket_batch_t* p_batch;
+    struct mmsghdr* p_msg;
+    uint32_t index;
+
+    do
+    {
+        //check for null values
+        if ((NULL == p_socket) || (NULL == p_data) || (NULL == p_length) ||
+            (NULL == p_socket->psBatch) || (p_socket->iSocketHdl < 0))
+        {
+            i4RetVal = (int32_t) E_COMMS_PARAMETER_NULL;
+            break;
+        }
+        p_batch = p_socket->psBatch;
+
+        i4RetVal = pal_socket_flush(p_socket);
+        if ((int32_t)E_COMMS_SUCCESS != i4RetVal)
+        {
+            break;
+        }
+
+        if (p_batch->rx_next == p_batch->rx_count)
+        {
+            i4RetVal = pal_socket_receive_batch(p_socket);
+            if ((int32_t)E_COMMS_SUCCESS != i4RetVal)
+            {
+                break;
+            }
+        }
+
+        index = p_batch->rx_next++;
+        p_msg = &p_batch->rx_msg[index];
+        if ((0 != (p_msg->msg_hdr.msg_flags & MSG_TRUNC)) || (p_msg->msg_len > *p_length))
+        {
+            i4RetVal = (int32_t) E_COMMS_INSUFFICIENT_BUF_SIZE;
+            break;
+        }
+
+        if (0 == p_msg->msg_len)
+        {
+            i4RetVal = (int32_t) E_COMMS_UDP_NO_DATA_RECEIVED;
+            break;
+        }
+
+        memcpy(p_data, p_batch->rx_data[index], p_msg->msg_len);
+        *p_length = p_msg->msg_len;
+        memcpy(&p_socket->sIPAddress, &p_batch->rx_peer[index], sizeof(p_socket->sIPAddress));
+
+        i4RetVal = (int32_t) E_COMMS_SUCCESS;
+    } while (FALSE);
+
+    return i4RetVal;
+}
+
+/**
+ * Closes the UDP communication and releases all the resources
+ *
+ * \param[in]  p_socket     Pointer to the socket communication structure
+ *
+ * \return  None
+ */
+void pal_socket_close(pal_socket_t* p_socket)
+{
+    //check for null values
+    if (NULL != p_socket)
+    {
+        if (p_socket->iSocketHdl >= 0)
+        {
+            // Records of a flight that was not followed by a receive still go out
+            if (NULL != p_socket->psBatch)
+            {
+                //lint --e{534} suppress "The socket is closed regardless of the result"
+                pal_socket_flush(p_socket);
+            }
+            close(p_socket->iSocketHdl);
+            p_socket->iSocketHdl = -1;
+        }
+
+        free(p_socket->psBatch);
+        p_socket->psBatch = NULL;
+
+        memset(&p_socket->sIPAddress, 0, sizeof(p_socket->sIPAddress));
+        p_socket->wPort = 0;
+    }
+}
+
+#endif
+/**
+* @}
+*/
@@ -37,6 +37,7 @@
 #include "nrf_delay.h"
 #include "nrf_rtc.h"
 #include "nrf_drv_rtc.h"
+#include "app_util_platform.h"
 
 /**********************************************************************************************************************
  * MACROS
@@ -48,6 +49,8 @@
 // it's a 24bit counter, so it will overflow every ~68min
 #define RTC_PRESCALER 8
 #define RTC_TICK_FREQ (RTC_CLOCK_FREQUENCY/RTC_PRESCALER)
+// Number of values of the 24bit counter
+#define RTC_COUNTER_RANGE (0x1000000ULL)
 
 /// @cond hidden 
 /*********************************************************************************************************************
@@ -76,6 +79,34 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
     return nrf_drv_rtc_counter_get(&rtc2)*1000/RTC_TICK_FREQ;
 }
 
+/**
+* Get the time of a monotonic clock in microseconds<br>
+*
+*
+* \retval  uint64_t time in microseconds
+*/
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    static uint32_t last_ticks = 0;
+    static uint64_t tick_base = 0;
+    uint32_t ticks;
+    uint64_t now_us;
+
+    // The counter wraps every ~68min, it is extended to 64 bits on each call. The stack reads the time
+    // several times per transfer, hence no wrap is missed while it is used.
+    CRITICAL_REGION_ENTER();
+    ticks = nrf_drv_rtc_counter_get(&rtc2);
+    if (ticks < last_ticks)
+    {
+        tick_base += RTC_COUNTER_RANGE;
+    }
+    last_ticks = ticks;
+    now_us = ((tick_base + ticks) * 1000000ULL) / RTC_TICK_FREQ;
+    CRITICAL_REGION_EXIT();
+
+    return now_us;
+}
+
 /**
 * Function to wait or delay until the given milliseconds time
 * 
@@ -0,0 +1,115 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_gpio.c
+*
+* \brief   This file implements the platform abstraction layer APIs for GPIO on the simulated OPTIGA.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include "optiga/pal/pal_gpio.h"
+
+#include "pal_sim.h"
+
+void pal_sim_set_pin(const pal_sim_pin_t * p_pin, uint8_t high)
+{
+    pal_sim_t * p_sim = p_pin->p_device;
+
+    (void)pal_sim_init(p_sim);
+    if (PAL_SIM_PIN_IRQ == p_pin->pin)
+    {
+        // Driven by the device
+        return;
+    }
+    if (!high)
+    {
+        p_sim->pins_low |= p_pin->pin;
+        p_sim->powered = FALSE;
+    }
+    else
+    {
+        p_sim->pins_low &= (uint8_t)~p_pin->pin;
+        // Leaves reset once all pins are high, with the persistent address and mode
+        if ((0 == p_sim->pins_low) && (!p_sim->powered))
+        {
+            p_sim->powered = TRUE;
+            pal_sim_reset(p_sim);
+        }
+    }
+}
+
+void pal_gpio_set_high(const pal_gpio_t* p_gpio_context)
+{
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        pal_sim_set_pin((const pal_sim_pin_t *)p_gpio_context->p_gpio_hw, TRUE);
+    }
+}
+
+void pal_gpio_set_low(const pal_gpio_t* p_gpio_context)
+{
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        pal_sim_set_pin((const pal_sim_pin_t *)p_gpio_context->p_gpio_hw, FALSE);
+    }
+}
+
+#ifdef PAL_GPIO_HAS_IRQ
+pal_status_t pal_gpio_register_irq(const pal_gpio_t* p_gpio_context, register_callback handler, void* p_handler_ctx)
+{
+    const pal_sim_pin_t * p_pin;
+
+    if ((p_gpio_context == NULL) || (p_gpio_context->p_gpio_hw == NULL))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_pin = (const pal_sim_pin_t *)p_gpio_context->p_gpio_hw;
+    if (PAL_SIM_PIN_IRQ != p_pin->pin)
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    (void)pal_sim_init(p_pin->p_device);
+    p_pin->p_device->p_irq_ctx = p_handler_ctx;
+    p_pin->p_device->irq_handler = handler;
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_gpio_unregister_irq(const pal_gpio_t* p_gpio_context)
+{
+    if ((p_gpio_context != NULL) && (p_gpio_context->p_gpio_hw != NULL))
+    {
+        ((const pal_sim_pin_t *)p_gpio_context->p_gpio_hw)->p_device->irq_handler = NULL;
+    }
+}
+#endif
+
+/**
+* @}
+*/
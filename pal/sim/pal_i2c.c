@@ -0,0 +1,724 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_i2c.c
+*
+* \brief   This file implements the platform abstraction layer APIs for I2C on the simulated OPTIGA.
+*
+* A transfer is decoded as a register access of the OPTIGA and completes synchronously. Writes to the DATA
+* register are handled by the slave side of the data link and transport layer, a complete command is executed
+* and its response is available in the DATA register once its latency has elapsed.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <string.h>
+#include <stdio.h>
+#include "optiga/pal/pal_i2c.h"
+
+#include "pal_sim.h"
+
+#if IFX_I2C_LOG_PAL == 1
+#define LOG(...)  printf(__VA_ARGS__)
+#else
+#define LOG(...)
+#endif
+
+#define LOG_PREFIX "[IFX-PAL-SIM-I2C] "
+
+/// @cond hidden
+// Registers of the OPTIGA
+#define PAL_SIM_REG_DATA                    (0x80)
+#define PAL_SIM_REG_DATA_REG_LEN            (0x81)
+#define PAL_SIM_REG_I2C_STATE               (0x82)
+#define PAL_SIM_REG_BASE_ADDR               (0x83)
+#define PAL_SIM_REG_MAX_SCL_FREQU           (0x84)
+#define PAL_SIM_REG_SOFT_RESET              (0x88)
+#define PAL_SIM_REG_I2C_MODE                (0x89)
+
+// I2C_STATE flags
+#define PAL_SIM_I2C_STATE_BUSY              (0x80)
+#define PAL_SIM_I2C_STATE_RESPONSE_READY    (0x40)
+#define PAL_SIM_I2C_STATE_SOFT_RESET        (0x08)
+
+// I2C_MODE values and the maximum SCL frequency in kHz of each
+#define PAL_SIM_I2C_MODE_SM_FM              (0x03)
+#define PAL_SIM_I2C_MODE_FM_PLUS            (0x04)
+#define PAL_SIM_SM_FM_FREQUENCY             (400)
+#define PAL_SIM_FM_PLUS_FREQUENCY           (1000)
+#define PAL_SIM_DEFAULT_BITRATE             (100)
+// Mode byte of BASE_ADDR and I2C_MODE writes to keep the value over a reset
+#define PAL_SIM_PERSISTENT                  (0x80)
+// Smallest DATA_REG_LEN accepted
+#define PAL_SIM_MIN_FRAME_SIZE              (0x0010)
+
+// Data link layer frame control byte
+#define PAL_SIM_DL_HEADER_SIZE              (5)
+#define PAL_SIM_DL_FCTR_CONTROL_FRAME       (0x80)
+#define PAL_SIM_DL_SEQCTR_MASK              (0x60)
+#define PAL_SIM_DL_SEQCTR_ACK               (0x00)
+#define PAL_SIM_DL_SEQCTR_NACK              (0x20)
+#define PAL_SIM_DL_SEQCTR_RESYNC            (0x40)
+#define PAL_SIM_DL_FRNR_OFFSET              (2)
+#define PAL_SIM_DL_FRAME_NUM_MASK           (0x03)
+
+// Transport layer packet control byte
+#define PAL_SIM_TL_HEADER_SIZE              (1)
+#define PAL_SIM_TL_CHANNEL_MASK             (0xF8)
+#define PAL_SIM_TL_CHAIN_MASK               (0x07)
+#define PAL_SIM_TL_CHAINING_NO              (0x00)
+#define PAL_SIM_TL_CHAINING_FIRST           (0x01)
+#define PAL_SIM_TL_CHAINING_INTERMEDIATE    (0x02)
+#define PAL_SIM_TL_CHAINING_LAST            (0x04)
+#define PAL_SIM_TL_CHAINING_ERROR           (0x07)
+/// @endcond
+
+/**********************************************************************************************************************
+ * DATA LINK AND TRANSPORT LAYER
+ *********************************************************************************************************************/
+
+// CRC of the data link layer, bit by bit like the ifx i2c stack does
+static uint16_t pal_sim_crc(const uint8_t * p_data, uint16_t length)
+{
+    uint16_t crc = 0;
+    uint16_t wh1;
+    uint16_t wh2;
+    uint16_t wh3;
+    uint16_t wh4;
+    uint16_t index;
+
+    for (index = 0; index < length; index++)
+    {
+        wh1 = (crc ^ p_data[index]) & 0xFF;
+        wh2 = wh1 & 0x0F;
+        wh3 = ((uint16_t)(wh2 << 4)) ^ wh1;
+        wh4 = wh3 >> 4;
+        crc = ((uint16_t)((((uint16_t)((((uint16_t)(wh3 << 1)) ^ wh4) << 4)) ^ wh2) << 3)) ^ wh4 ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void pal_sim_dl_control_frame(pal_sim_t * p_sim, uint8_t seqctr)
+{
+    uint16_t crc;
+    uint8_t ack_nr = p_sim->rx_seq_nr;
+
+    // A NACK references the frame expected next
+    if (PAL_SIM_DL_SEQCTR_NACK == seqctr)
+    {
+        ack_nr = (p_sim->rx_seq_nr + 1) & PAL_SIM_DL_FRAME_NUM_MASK;
+    }
+    p_sim->control_frame[0] = PAL_SIM_DL_FCTR_CONTROL_FRAME | seqctr | ack_nr;
+    p_sim->control_frame[1] = 0;
+    p_sim->control_frame[2] = 0;
+    crc = pal_sim_crc(p_sim->control_frame, 3);
+    p_sim->control_frame[3] = (uint8_t)(crc >> 8);
+    p_sim->control_frame[4] = (uint8_t)crc;
+    p_sim->control_frame_pending = TRUE;
+    pal_sim_irq_schedule(p_sim, pal_sim_get_time_us());
+}
+
+// Sends the packet fragment stored after the header of data_frame, it acknowledges the last frame received
+static void pal_sim_dl_data_frame(pal_sim_t * p_sim, uint16_t payload_length)
+{
+    uint16_t crc;
+
+    p_sim->tx_seq_nr = (p_sim->tx_seq_nr + 1) & PAL_SIM_DL_FRAME_NUM_MASK;
+    p_sim->data_frame[0] = (uint8_t)(p_sim->tx_seq_nr << PAL_SIM_DL_FRNR_OFFSET) | p_sim->rx_seq_nr;
+    p_sim->data_frame[1] = (uint8_t)(payload_length >> 8);
+    p_sim->data_frame[2] = (uint8_t)payload_length;
+    crc = pal_sim_crc(p_sim->data_frame, 3 + payload_length);
+    p_sim->data_frame[3 + payload_length] = (uint8_t)(crc >> 8);
+    p_sim->data_frame[4 + payload_length] = (uint8_t)crc;
+    p_sim->data_frame_len = PAL_SIM_DL_HEADER_SIZE + payload_length;
+    p_sim->data_frame_pending = TRUE;
+    p_sim->data_frame_unacked = FALSE;
+    pal_sim_irq_schedule(p_sim, pal_sim_get_time_us());
+}
+
+static void pal_sim_tl_send_fragment(pal_sim_t * p_sim)
+{
+    uint16_t max_length = p_sim->frame_size - (PAL_SIM_DL_HEADER_SIZE + PAL_SIM_TL_HEADER_SIZE);
+    uint16_t remaining = p_sim->tx_packet_len - p_sim->tx_packet_offset;
+    uint8_t pctr;
+
+    if (0 == p_sim->tx_packet_offset)
+    {
+        pctr = (remaining <= max_length) ? PAL_SIM_TL_CHAINING_NO : PAL_SIM_TL_CHAINING_FIRST;
+    }
+    else
+    {
+        pctr = (remaining <= max_length) ? PAL_SIM_TL_CHAINING_LAST : PAL_SIM_TL_CHAINING_INTERMEDIATE;
+    }
+    p_sim->tx_fragment_len = (remaining <= max_length) ? remaining : max_length;
+    p_sim->data_frame[3] = pctr;
+    memcpy(&p_sim->data_frame[3 + PAL_SIM_TL_HEADER_SIZE], &p_sim->tx_packet[p_sim->tx_packet_offset],
+           p_sim->tx_fragment_len);
+    pal_sim_dl_data_frame(p_sim, PAL_SIM_TL_HEADER_SIZE + p_sim->tx_fragment_len);
+}
+
+// Rejects the command being received. The data frame with the chaining error also acknowledges the fragment
+static void pal_sim_tl_chaining_error(pal_sim_t * p_sim)
+{
+    p_sim->rx_packet_len = 0;
+    p_sim->rx_chaining = PAL_SIM_TL_CHAINING_NO;
+    p_sim->tx_active = FALSE;
+    p_sim->control_frame_pending = FALSE;
+    p_sim->data_frame[3] = PAL_SIM_TL_CHAINING_ERROR;
+    pal_sim_dl_data_frame(p_sim, PAL_SIM_TL_HEADER_SIZE);
+}
+
+static void pal_sim_tl_receive(pal_sim_t * p_sim, const uint8_t * p_fragment, uint16_t length)
+{
+    uint8_t chaining = p_fragment[0] & PAL_SIM_TL_CHAIN_MASK;
+    uint32_t latency_us;
+
+    do
+    {
+        if (p_fragment[0] & PAL_SIM_TL_CHANNEL_MASK)
+        {
+            pal_sim_tl_chaining_error(p_sim);
+            break;
+        }
+        // The host lost a fragment of the response, the response is sent again from its start
+        if (PAL_SIM_TL_CHAINING_ERROR == chaining)
+        {
+            if (p_sim->tx_active)
+            {
+                p_sim->stats.retransmissions++;
+                p_sim->tx_packet_offset = 0;
+                pal_sim_tl_send_fragment(p_sim);
+            }
+            break;
+        }
+        // A new command discards the rest of a response not read
+        p_sim->tx_active = FALSE;
+        if ((PAL_SIM_TL_CHAINING_NO == chaining) || (PAL_SIM_TL_CHAINING_FIRST == chaining))
+        {
+            p_sim->rx_packet_len = 0;
+        }
+        else if (((PAL_SIM_TL_CHAINING_INTERMEDIATE != chaining) && (PAL_SIM_TL_CHAINING_LAST != chaining)) ||
+                 ((PAL_SIM_TL_CHAINING_FIRST != p_sim->rx_chaining) &&
+                  (PAL_SIM_TL_CHAINING_INTERMEDIATE != p_sim->rx_chaining)))
+        {
+            pal_sim_tl_chaining_error(p_sim);
+            break;
+        }
+        if (((uint32_t)p_sim->rx_packet_len + length - PAL_SIM_TL_HEADER_SIZE) > sizeof(p_sim->rx_packet))
+        {
+            pal_sim_tl_chaining_error(p_sim);
+            break;
+        }
+        memcpy(&p_sim->rx_packet[p_sim->rx_packet_len], &p_fragment[PAL_SIM_TL_HEADER_SIZE],
+               length - PAL_SIM_TL_HEADER_SIZE);
+        p_sim->rx_packet_len += (length - PAL_SIM_TL_HEADER_SIZE);
+        p_sim->rx_chaining = chaining;
+
+        if ((PAL_SIM_TL_CHAINING_NO == chaining) || (PAL_SIM_TL_CHAINING_LAST == chaining))
+        {
+            // The response is sent once the execution time has elapsed, see pal_sim_tl_poll
+            latency_us = pal_sim_apdu_execute(p_sim, p_sim->rx_packet, p_sim->rx_packet_len);
+            LOG(LOG_PREFIX "Command 0x%02X, %u bytes, response in %u us\n", p_sim->rx_packet[0],
+                p_sim->rx_packet_len, latency_us);
+            p_sim->rx_packet_len = 0;
+            p_sim->rx_chaining = PAL_SIM_TL_CHAINING_NO;
+            p_sim->busy = TRUE;
+            p_sim->response_time_us = pal_sim_get_time_us() + latency_us;
+            p_sim->stats.busy_time_us += latency_us;
+            pal_sim_irq_schedule(p_sim, p_sim->response_time_us);
+        }
+    } while (FALSE);
+}
+
+// Makes the response available once the command completed
+static void pal_sim_tl_poll(pal_sim_t * p_sim)
+{
+    if ((p_sim->busy) && (pal_sim_get_time_us() >= p_sim->response_time_us))
+    {
+        p_sim->busy = FALSE;
+        p_sim->tx_active = TRUE;
+        p_sim->tx_packet_offset = 0;
+        pal_sim_tl_send_fragment(p_sim);
+    }
+}
+
+// Raises the response pin if a frame is ready, the response to a command in execution is checked again later
+static void pal_sim_irq_callback(void * p_ctx)
+{
+    pal_sim_t * p_sim = (pal_sim_t *)p_ctx;
+    uint64_t now_us = pal_sim_get_time_us();
+    uint8_t ready = (p_sim->control_frame_pending) || (p_sim->data_frame_pending) ||
+                    ((p_sim->busy) && (now_us >= p_sim->response_time_us));
+
+    p_sim->irq_scheduled = FALSE;
+    if ((p_sim->busy) && (now_us < p_sim->response_time_us))
+    {
+        pal_sim_irq_schedule(p_sim, p_sim->response_time_us);
+    }
+    if ((ready) && (p_sim->powered) && (NULL != p_sim->irq_handler))
+    {
+        p_sim->stats.irq_edges++;
+        p_sim->irq_handler(p_sim->p_irq_ctx);
+    }
+}
+
+void pal_sim_irq_schedule(pal_sim_t * p_sim, uint64_t time_us)
+{
+    uint64_t now_us = pal_sim_get_time_us();
+
+    // Frames becoming ready while a check is due earlier are seen by that check
+    if ((NULL == p_sim->irq_handler) || ((p_sim->irq_scheduled) && (p_sim->irq_due_us <= time_us)))
+    {
+        return;
+    }
+    p_sim->irq_scheduled = TRUE;
+    p_sim->irq_due_us = time_us;
+    pal_os_event_register_callback_oneshot(pal_sim_irq_callback, (void *)p_sim,
+                                           (time_us > now_us) ? (uint32_t)(time_us - now_us) : 0);
+}
+
+static void pal_sim_dl_resync(pal_sim_t * p_sim)
+{
+    p_sim->tx_seq_nr = PAL_SIM_DL_FRAME_NUM_MASK;
+    p_sim->rx_seq_nr = PAL_SIM_DL_FRAME_NUM_MASK;
+    p_sim->control_frame_pending = FALSE;
+    p_sim->data_frame_pending = FALSE;
+    p_sim->data_frame_unacked = FALSE;
+    p_sim->rx_packet_len = 0;
+    p_sim->rx_chaining = PAL_SIM_TL_CHAINING_NO;
+    p_sim->tx_active = FALSE;
+    p_sim->busy = FALSE;
+}
+
+static void pal_sim_dl_receive(pal_sim_t * p_sim, const uint8_t * p_frame, uint16_t length)
+{
+    uint8_t fctr = p_frame[0];
+    uint8_t fr_nr = (fctr >> PAL_SIM_DL_FRNR_OFFSET) & PAL_SIM_DL_FRAME_NUM_MASK;
+    uint8_t ack_nr = fctr & PAL_SIM_DL_FRAME_NUM_MASK;
+    uint8_t seqctr = fctr & PAL_SIM_DL_SEQCTR_MASK;
+
+    p_sim->stats.frames_received++;
+    do
+    {
+        if ((length < PAL_SIM_DL_HEADER_SIZE) || (length > p_sim->frame_size) ||
+            (length != PAL_SIM_DL_HEADER_SIZE + ((p_frame[1] << 8) | p_frame[2])) ||
+            (pal_sim_crc(p_frame, length - 2) != ((p_frame[length - 2] << 8) | p_frame[length - 1])))
+        {
+            // The host repeats a control frame on its own, a data frame is asked to be repeated
+            p_sim->stats.frame_errors++;
+            if (!(fctr & PAL_SIM_DL_FCTR_CONTROL_FRAME))
+            {
+                pal_sim_dl_control_frame(p_sim, PAL_SIM_DL_SEQCTR_NACK);
+            }
+            break;
+        }
+
+        if (fctr & PAL_SIM_DL_FCTR_CONTROL_FRAME)
+        {
+            if (PAL_SIM_DL_SEQCTR_RESYNC == seqctr)
+            {
+                LOG(LOG_PREFIX "Re-sync\n");
+                p_sim->stats.resyncs++;
+                pal_sim_dl_resync(p_sim);
+            }
+            else if ((p_sim->data_frame_unacked) && (ack_nr == p_sim->tx_seq_nr))
+            {
+                p_sim->data_frame_unacked = FALSE;
+                if (PAL_SIM_DL_SEQCTR_NACK == seqctr)
+                {
+                    p_sim->stats.retransmissions++;
+                    p_sim->data_frame_pending = TRUE;
+                    pal_sim_irq_schedule(p_sim, pal_sim_get_time_us());
+                }
+                else if ((PAL_SIM_DL_SEQCTR_ACK == seqctr) && (p_sim->tx_active))
+                {
+                    // Fragment delivered, continue with the next one
+                    p_sim->tx_packet_offset += p_sim->tx_fragment_len;
+                    if (p_sim->tx_packet_offset < p_sim->tx_packet_len)
+                    {
+                        pal_sim_tl_send_fragment(p_sim);
+                    }
+                    else
+                    {
+                        p_sim->tx_active = FALSE;
+                    }
+                }
+            }
+            break;
+        }
+
+        if (fr_nr == p_sim->rx_seq_nr)
+        {
+            // The acknowledge was lost and the host repeated the frame
+            pal_sim_dl_control_frame(p_sim, PAL_SIM_DL_SEQCTR_ACK);
+            break;
+        }
+        if ((fr_nr != ((p_sim->rx_seq_nr + 1) & PAL_SIM_DL_FRAME_NUM_MASK)) || (PAL_SIM_DL_SEQCTR_ACK != seqctr) ||
+            (length == PAL_SIM_DL_HEADER_SIZE))
+        {
+            pal_sim_dl_control_frame(p_sim, PAL_SIM_DL_SEQCTR_NACK);
+            break;
+        }
+        (void)ack_nr;
+        p_sim->rx_seq_nr = fr_nr;
+        p_sim->data_frame_pending = FALSE;
+        p_sim->data_frame_unacked = FALSE;
+        pal_sim_dl_control_frame(p_sim, PAL_SIM_DL_SEQCTR_ACK);
+        pal_sim_tl_receive(p_sim, &p_frame[3], length - PAL_SIM_DL_HEADER_SIZE);
+    } while (FALSE);
+}
+
+// Hands the next frame to the host, a control frame goes before a data frame
+static uint16_t pal_sim_dl_read(pal_sim_t * p_sim, uint8_t * p_data, uint16_t length)
+{
+    const uint8_t * p_frame;
+    uint16_t frame_length;
+
+    pal_sim_tl_poll(p_sim);
+    if (p_sim->control_frame_pending)
+    {
+        p_frame = p_sim->control_frame;
+        frame_length = PAL_SIM_DL_HEADER_SIZE;
+        p_sim->control_frame_pending = FALSE;
+    }
+    else if (p_sim->data_frame_pending)
+    {
+        p_frame = p_sim->data_frame;
+        frame_length = p_sim->data_frame_len;
+        p_sim->data_frame_pending = FALSE;
+        p_sim->data_frame_unacked = TRUE;
+    }
+    else
+    {
+        return PAL_I2C_EVENT_ERROR;
+    }
+
+    memset(p_data, 0x00, length);
+    memcpy(p_data, p_frame, (length < frame_length) ? length : frame_length);
+    p_sim->stats.frames_sent++;
+    p_sim->frame_counter++;
+    if ((0 != p_sim->fault_interval) && (0 == (p_sim->frame_counter % p_sim->fault_interval)))
+    {
+        // Corrupts the copy on the bus only, the frame stays intact for its retransmission
+        p_sim->stats.faults_injected++;
+        p_data[((length < frame_length) ? length : frame_length) - 1] ^= 0x01;
+    }
+    return PAL_I2C_EVENT_SUCCESS;
+}
+
+/**********************************************************************************************************************
+ * REGISTERS
+ *********************************************************************************************************************/
+
+static uint16_t pal_sim_max_frequency(const pal_sim_t * p_sim)
+{
+    return (PAL_SIM_I2C_MODE_FM_PLUS == p_sim->i2c_mode) ? PAL_SIM_FM_PLUS_FREQUENCY : PAL_SIM_SM_FM_FREQUENCY;
+}
+
+static uint16_t pal_sim_write_register(pal_sim_t * p_sim, uint8_t reg, const uint8_t * p_data, uint16_t length)
+{
+    uint16_t event = PAL_I2C_EVENT_SUCCESS;
+    uint16_t frame_size;
+
+    switch (reg)
+    {
+        case PAL_SIM_REG_DATA:
+        {
+            pal_sim_dl_receive(p_sim, p_data, length);
+        }
+        break;
+        case PAL_SIM_REG_DATA_REG_LEN:
+        {
+            frame_size = (length == 2) ? (uint16_t)((p_data[0] << 8) | p_data[1]) : 0;
+            if (frame_size < PAL_SIM_MIN_FRAME_SIZE)
+            {
+                event = PAL_I2C_EVENT_ERROR;
+                break;
+            }
+            // A larger request is reduced to the largest frame supported, the host reads back the value taken
+            p_sim->frame_size = (frame_size < PAL_SIM_MAX_FRAME_SIZE) ? frame_size : PAL_SIM_MAX_FRAME_SIZE;
+        }
+        break;
+        case PAL_SIM_REG_BASE_ADDR:
+        {
+            if (length != 2)
+            {
+                event = PAL_I2C_EVENT_ERROR;
+                break;
+            }
+            p_sim->slave_address = p_data[1] & 0x7F;
+            if (p_data[0] & PAL_SIM_PERSISTENT)
+            {
+                p_sim->default_slave_address = p_sim->slave_address;
+            }
+        }
+        break;
+        case PAL_SIM_REG_SOFT_RESET:
+        {
+            pal_sim_reset(p_sim);
+        }
+        break;
+        case PAL_SIM_REG_I2C_MODE:
+        {
+            if ((length != 2) ||
+                ((PAL_SIM_I2C_MODE_SM_FM != p_data[1]) && (PAL_SIM_I2C_MODE_FM_PLUS != p_data[1])))
+            {
+                event = PAL_I2C_EVENT_ERROR;
+                break;
+            }
+            p_sim->i2c_mode = p_data[1];
+            if (p_data[0] & PAL_SIM_PERSISTENT)
+            {
+                p_sim->default_i2c_mode = p_sim->i2c_mode;
+            }
+        }
+        break;
+        default:
+        {
+            // MAX_SCL_FREQU and I2C_STATE are read only
+            event = PAL_I2C_EVENT_ERROR;
+        }
+        break;
+    }
+    return event;
+}
+
+static uint16_t pal_sim_read_register(pal_sim_t * p_sim, uint8_t reg, uint8_t * p_data, uint16_t length)
+{
+    uint8_t value[4] = {0};
+    uint16_t value_length = 0;
+    uint16_t frame_length;
+
+    switch (reg)
+    {
+        case PAL_SIM_REG_DATA:
+        {
+            return pal_sim_dl_read(p_sim, p_data, length);
+        }
+        case PAL_SIM_REG_DATA_REG_LEN:
+        {
+            value[0] = (uint8_t)(p_sim->frame_size >> 8);
+            value[1] = (uint8_t)p_sim->frame_size;
+            value_length = 2;
+        }
+        break;
+        case PAL_SIM_REG_I2C_STATE:
+        {
+            pal_sim_tl_poll(p_sim);
+            p_sim->stats.status_polls++;
+            frame_length = p_sim->control_frame_pending ? PAL_SIM_DL_HEADER_SIZE :
+                           (p_sim->data_frame_pending ? p_sim->data_frame_len : 0);
+            value[0] = PAL_SIM_I2C_STATE_SOFT_RESET;
+            if (0 != frame_length)
+            {
+                value[0] |= PAL_SIM_I2C_STATE_RESPONSE_READY;
+            }
+            if (p_sim->busy)
+            {
+                value[0] |= PAL_SIM_I2C_STATE_BUSY;
+                p_sim->stats.busy_polls++;
+            }
+            value[2] = (uint8_t)(frame_length >> 8);
+            value[3] = (uint8_t)frame_length;
+            value_length = 4;
+        }
+        break;
+        case PAL_SIM_REG_BASE_ADDR:
+        {
+            value[1] = p_sim->slave_address;
+            value_length = 2;
+        }
+        break;
+        case PAL_SIM_REG_MAX_SCL_FREQU:
+        {
+            value[2] = (uint8_t)(pal_sim_max_frequency(p_sim) >> 8);
+            value[3] = (uint8_t)pal_sim_max_frequency(p_sim);
+            value_length = 4;
+        }
+        break;
+        case PAL_SIM_REG_I2C_MODE:
+        {
+            value[1] = p_sim->i2c_mode;
+            value_length = 2;
+        }
+        break;
+        default:
+        {
+            return PAL_I2C_EVENT_ERROR;
+        }
+    }
+    memset(p_data, 0x00, length);
+    memcpy(p_data, value, (length < value_length) ? length : value_length);
+    return PAL_I2C_EVENT_SUCCESS;
+}
+
+/**********************************************************************************************************************
+ * DEVICE
+ *********************************************************************************************************************/
+
+pal_status_t pal_sim_init(pal_sim_t * p_sim)
+{
+    if (!p_sim->initialized)
+    {
+        p_sim->default_slave_address = PAL_SIM_DEFAULT_SLAVE_ADDRESS;
+        p_sim->default_i2c_mode = PAL_SIM_I2C_MODE_SM_FM;
+        p_sim->bitrate = PAL_SIM_DEFAULT_BITRATE;
+        pal_sim_apdu_init(p_sim);
+        p_sim->powered = (0 == p_sim->pins_low) ? TRUE : FALSE;
+        p_sim->initialized = TRUE;
+        pal_sim_reset(p_sim);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_sim_reset(pal_sim_t * p_sim)
+{
+    p_sim->slave_address = p_sim->default_slave_address;
+    p_sim->i2c_mode = p_sim->default_i2c_mode;
+    p_sim->frame_size = PAL_SIM_DEFAULT_FRAME_SIZE;
+    pal_sim_dl_resync(p_sim);
+    pal_sim_apdu_reset(p_sim);
+}
+
+// Time the transfer of length bytes takes on the bus, 9 clocks per byte
+static void pal_sim_bus_time(pal_sim_t * p_sim, uint32_t length)
+{
+    uint32_t frequency = p_sim->bitrate;
+    uint32_t time_us;
+
+    if (frequency > pal_sim_max_frequency(p_sim))
+    {
+        frequency = pal_sim_max_frequency(p_sim);
+    }
+    time_us = ((length * 9 * 1000) + frequency - 1) / frequency;
+    p_sim->stats.bus_bytes += length;
+    p_sim->stats.bus_time_us += time_us;
+    if (!p_sim->ideal_bus)
+    {
+        pal_sim_wait_until_us(pal_sim_get_time_us() + time_us);
+    }
+}
+
+static pal_status_t pal_i2c_transfer(pal_i2c_t * p_i2c_context, const uint8_t * p_tx_data, uint16_t tx_length,
+                                     uint8_t * p_rx_data, uint16_t rx_length)
+{
+    pal_sim_t * p_sim = (pal_sim_t *)p_i2c_context->p_i2c_hw_config;
+    uint16_t event = PAL_I2C_EVENT_SUCCESS;
+    uint32_t address_bytes = ((0 != tx_length) ? 1 : 0) + ((0 != rx_length) ? 1 : 0);
+
+    (void)pal_sim_init(p_sim);
+    if ((!p_sim->powered) || (p_i2c_context->slave_address != p_sim->slave_address))
+    {
+        // Nobody acknowledges the address, the transfer ends after the address byte
+        p_sim->stats.nacked++;
+        event = PAL_I2C_EVENT_ERROR;
+        pal_sim_bus_time(p_sim, 1);
+    }
+    else
+    {
+        p_sim->stats.transactions++;
+        if (0 != tx_length)
+        {
+            p_sim->register_address = p_tx_data[0];
+            if (tx_length > 1)
+            {
+                event = pal_sim_write_register(p_sim, p_tx_data[0], &p_tx_data[1], tx_length - 1);
+            }
+        }
+        if ((0 != rx_length) && (PAL_I2C_EVENT_SUCCESS == event))
+        {
+            event = pal_sim_read_register(p_sim, p_sim->register_address, p_rx_data, rx_length);
+        }
+        pal_sim_bus_time(p_sim, address_bytes + tx_length + rx_length);
+    }
+
+    if (0 != p_i2c_context->upper_layer_event_handler)
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
+        ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->upper_layer_ctx, event);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+pal_status_t pal_i2c_init(const pal_i2c_t* p_i2c_context)
+{
+    return pal_sim_init((pal_sim_t *)p_i2c_context->p_i2c_hw_config);
+}
+
+
+pal_status_t pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
+{
+    (void)p_i2c_context;
+    return PAL_STATUS_SUCCESS;
+}
+
+
+pal_status_t pal_i2c_write(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_data, length, NULL, 0);
+}
+
+
+pal_status_t pal_i2c_read(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    return pal_i2c_transfer(p_i2c_context, NULL, 0, p_data, length);
+}
+
+
+#ifdef PAL_I2C_HAS_WRITE_READ
+pal_status_t pal_i2c_write_read(pal_i2c_t* p_i2c_context, uint8_t* p_tx_data, uint16_t tx_length,
+                                uint8_t* p_rx_data, uint16_t rx_length)
+{
+    return pal_i2c_transfer(p_i2c_context, p_tx_data, tx_length, p_rx_data, rx_length);
+}
+#endif
+
+
+pal_status_t pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context, uint16_t bitrate)
+{
+    pal_sim_t * p_sim = (pal_sim_t *)p_i2c_context->p_i2c_hw_config;
+
+    (void)pal_sim_init(p_sim);
+    p_sim->bitrate = (0 != bitrate) ? bitrate : PAL_SIM_DEFAULT_BITRATE;
+    if (0 != p_i2c_context->upper_layer_event_handler)
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
+        ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->upper_layer_ctx,
+                                                                          PAL_I2C_EVENT_SUCCESS);
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* @}
+*/
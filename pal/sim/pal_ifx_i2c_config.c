@@ -0,0 +1,101 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_ifx_i2c_config.c
+*
+* \brief   This file implements platform abstraction layer configurations for ifx i2c protocol on the
+*          simulated OPTIGA.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+
+#include "optiga/pal/pal_gpio.h"
+#include "optiga/pal/pal_i2c.h"
+#include "optiga/ifx_i2c/ifx_i2c_config.h"
+
+#include "pal_sim.h"
+
+/**
+ * \brief Simulated OPTIGA, zero initialized for the factory defaults.
+ */
+pal_sim_t optiga_sim_0;
+
+/// Vdd pin of the simulated OPTIGA
+pal_sim_pin_t optiga_sim_vdd_0 = {&optiga_sim_0, PAL_SIM_PIN_VDD};
+/// Reset pin of the simulated OPTIGA
+pal_sim_pin_t optiga_sim_reset_0 = {&optiga_sim_0, PAL_SIM_PIN_RESET};
+/// Response pin of the simulated OPTIGA
+pal_sim_pin_t optiga_sim_irq_0 = {&optiga_sim_0, PAL_SIM_PIN_IRQ};
+
+/**
+ * \brief PAL I2C configuration for OPTIGA. 
+ */
+pal_i2c_t optiga_pal_i2c_context_0 =
+{
+    /// Pointer to I2C master platform specific context
+    (void*)&optiga_sim_0,
+    /// Slave address
+    PAL_SIM_DEFAULT_SLAVE_ADDRESS,
+    /// Upper layer context
+    NULL,
+    /// Callback event handler
+    NULL
+};
+
+/**
+* \brief PAL vdd pin configuration for OPTIGA. 
+ */
+pal_gpio_t optiga_vdd_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Vdd.
+    (void*)&optiga_sim_vdd_0
+};
+
+/**
+ * \brief PAL reset pin configuration for OPTIGA.
+ */
+pal_gpio_t optiga_reset_0 =
+{
+    // Platform specific GPIO context for the pin used to toggle Reset.
+    (void*)&optiga_sim_reset_0
+};
+
+/**
+ * \brief PAL response pin configuration for OPTIGA, connected by setting ifx_i2c_context_t.p_slave_irq_pin.
+ */
+pal_gpio_t optiga_irq_0 =
+{
+    // Platform specific GPIO context for the pin signalling a response.
+    (void*)&optiga_sim_irq_0
+};
+
+/**
+* @}
+*/
@@ -0,0 +1,123 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_datastore.c
+*
+* \brief   This file implements the platform abstraction layer APIs for the host side datastore on the
+*          simulated OPTIGA. The datastores are kept in memory for the lifetime of the process.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <string.h>
+#include "optiga/pal/pal_os_datastore.h"
+
+/// Number of datastores
+#ifndef PAL_OS_DATASTORE_COUNT
+#define PAL_OS_DATASTORE_COUNT      (4)
+#endif
+
+/// Maximum size of a datastore
+#ifndef PAL_OS_DATASTORE_MAX_SIZE
+#define PAL_OS_DATASTORE_MAX_SIZE   (64)
+#endif
+
+/** \brief Datastore kept in memory */
+typedef struct pal_os_datastore
+{
+    /// Identifier of the datastore, valid if length is not 0
+    uint16_t datastore_id;
+    /// Length of the content
+    uint16_t length;
+    /// Content
+    uint8_t buffer[PAL_OS_DATASTORE_MAX_SIZE];
+} pal_os_datastore_t;
+
+static pal_os_datastore_t pal_os_datastores[PAL_OS_DATASTORE_COUNT];
+
+static pal_os_datastore_t * pal_os_datastore_find(uint16_t datastore_id)
+{
+    uint16_t index;
+
+    for (index = 0; index < PAL_OS_DATASTORE_COUNT; index++)
+    {
+        if ((0 != pal_os_datastores[index].length) && (datastore_id == pal_os_datastores[index].datastore_id))
+        {
+            return &pal_os_datastores[index];
+        }
+    }
+    return NULL;
+}
+
+pal_status_t pal_os_datastore_write(uint16_t datastore_id, const uint8_t * p_buffer, uint16_t length)
+{
+    pal_os_datastore_t * p_datastore = pal_os_datastore_find(datastore_id);
+    uint16_t index;
+
+    if ((0 == length) || (length > PAL_OS_DATASTORE_MAX_SIZE))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    for (index = 0; (NULL == p_datastore) && (index < PAL_OS_DATASTORE_COUNT); index++)
+    {
+        if (0 == pal_os_datastores[index].length)
+        {
+            p_datastore = &pal_os_datastores[index];
+        }
+    }
+    if (NULL == p_datastore)
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_datastore->datastore_id = datastore_id;
+    memcpy(p_datastore->buffer, p_buffer, length);
+    p_datastore->length = length;
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_os_datastore_read(uint16_t datastore_id, uint8_t * p_buffer, uint16_t * p_length)
+{
+    pal_os_datastore_t * p_datastore = pal_os_datastore_find(datastore_id);
+
+    if (NULL == p_datastore)
+    {
+        *p_length = 0;
+        return PAL_STATUS_FAILURE;
+    }
+    if (*p_length > p_datastore->length)
+    {
+        *p_length = p_datastore->length;
+    }
+    memcpy(p_buffer, p_datastore->buffer, *p_length);
+    return PAL_STATUS_SUCCESS;
+}
+
+/**
+* @}
+*/
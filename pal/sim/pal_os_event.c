@@ -0,0 +1,200 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_event.c
+*
+* \brief   This file implements the platform abstraction layer APIs for os event/scheduler on the simulated
+*          OPTIGA.
+*
+* There is no event thread: the thread waiting for a response runs the pending callbacks in order of expiry
+* from #pal_os_event_wait, after waiting on the simulation clock until each one is due.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include "optiga/pal/pal_os_event.h"
+
+#include "pal_sim.h"
+
+#ifndef PAL_OS_HAS_EVENT_WAIT
+#error "The simulated OPTIGA runs the callbacks from pal_os_event_wait, define PAL_OS_HAS_EVENT_WAIT"
+#endif
+
+#define ERR(...)  fprintf(stderr, __VA_ARGS__)
+#define LOG_PREFIX "[IFX-PAL-SIM-EVENT] "
+
+/// Maximum number of callback contexts (one per ifx i2c instance) with a pending callback
+#ifndef PAL_OS_EVENT_MAX_INSTANCES
+#define PAL_OS_EVENT_MAX_INSTANCES  (4)
+#endif
+
+/** \brief PAL os event structure, a pending one-shot callback */
+typedef struct pal_os_event
+{
+    /// Expiry time on the simulation clock
+    uint64_t deadline_us;
+    /// Registration order, callbacks with the same expiry run in this order
+    uint32_t sequence;
+    /// registered callback, NULL if the slot is free
+    register_callback callback_registered;
+    /// context to be passed to callback
+    void * callback_ctx;
+}pal_os_event_t;
+
+// Each callback context has at most one pending callback, registering again for the same context replaces it
+static pal_os_event_t pal_os_event_slots[PAL_OS_EVENT_MAX_INSTANCES];
+static uint32_t pal_os_event_sequence = 0;
+
+// Earliest pending callback, NULL if none
+static pal_os_event_t * pal_os_event_next(void)
+{
+    pal_os_event_t * p_next = NULL;
+    uint32_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if ((NULL != pal_os_event_slots[index].callback_registered) &&
+            ((NULL == p_next) || (pal_os_event_slots[index].deadline_us < p_next->deadline_us) ||
+             ((pal_os_event_slots[index].deadline_us == p_next->deadline_us) &&
+              ((int32_t)(pal_os_event_slots[index].sequence - p_next->sequence) < 0))))
+        {
+            p_next = &pal_os_event_slots[index];
+        }
+    }
+    return p_next;
+}
+
+static void pal_os_event_run(pal_os_event_t * p_event)
+{
+    register_callback callback = p_event->callback_registered;
+    void * callback_ctx = p_event->callback_ctx;
+
+    // Freed before the call, the callback usually registers the next one for the same context
+    p_event->callback_registered = NULL;
+    callback(callback_ctx);
+}
+
+pal_status_t pal_os_event_init(void)
+{
+    return PAL_STATUS_SUCCESS;
+}
+
+void pal_os_event_register_callback_oneshot(register_callback callback,
+                                            void* callback_args,
+                                            uint32_t time_us)
+{
+    pal_os_event_t * p_slot = NULL;
+    uint32_t index;
+
+    for (index = 0; index < PAL_OS_EVENT_MAX_INSTANCES; index++)
+    {
+        if ((NULL != pal_os_event_slots[index].callback_registered) &&
+            (callback_args == pal_os_event_slots[index].callback_ctx))
+        {
+            p_slot = &pal_os_event_slots[index];
+            break;
+        }
+        if ((NULL == p_slot) && (NULL == pal_os_event_slots[index].callback_registered))
+        {
+            p_slot = &pal_os_event_slots[index];
+        }
+    }
+    if (NULL == p_slot)
+    {
+        ERR(LOG_PREFIX "Too many pending callbacks, increase PAL_OS_EVENT_MAX_INSTANCES\n");
+        return;
+    }
+    p_slot->deadline_us = pal_sim_get_time_us() + time_us;
+    p_slot->sequence = pal_os_event_sequence++;
+    p_slot->callback_ctx = callback_args;
+    p_slot->callback_registered = callback;
+}
+
+#ifdef PAL_OS_HAS_EVENT_PROCESS
+int32_t pal_os_event_get_handle(void)
+{
+    // Nothing to poll, the callbacks are driven by pal_os_event_wait
+    return -1;
+}
+
+uint32_t pal_os_event_get_next_timeout_us(void)
+{
+    pal_os_event_t * p_next = pal_os_event_next();
+    uint64_t now_us = pal_sim_get_time_us();
+
+    if (NULL == p_next)
+    {
+        return PAL_OS_EVENT_NO_TIMEOUT;
+    }
+    if (p_next->deadline_us <= now_us)
+    {
+        return 0;
+    }
+    return ((p_next->deadline_us - now_us) < PAL_OS_EVENT_NO_TIMEOUT) ?
+           (uint32_t)(p_next->deadline_us - now_us) : (PAL_OS_EVENT_NO_TIMEOUT - 1);
+}
+
+void pal_os_event_process(void)
+{
+    pal_os_event_t * p_next;
+
+    while ((NULL != (p_next = pal_os_event_next())) && (p_next->deadline_us <= pal_sim_get_time_us()))
+    {
+        pal_os_event_run(p_next);
+    }
+}
+#endif
+
+void pal_os_event_wait(volatile uint32_t* p_status, uint32_t busy_value)
+{
+    pal_os_event_t * p_next;
+
+    while (busy_value == *p_status)
+    {
+        p_next = pal_os_event_next();
+        if (NULL == p_next)
+        {
+            // Nothing can change the status anymore
+            ERR(LOG_PREFIX "Waiting without a pending callback\n");
+            break;
+        }
+        pal_sim_wait_until_us(p_next->deadline_us);
+        pal_os_event_run(p_next);
+    }
+}
+
+void pal_os_event_notify(volatile uint32_t* p_status, uint32_t new_value)
+{
+    *p_status = new_value;
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,112 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_os_timer.c
+*
+* \brief   This file implements the platform abstraction layer APIs for timer on the simulated OPTIGA.
+*
+* The simulation clock runs on CLOCK_MONOTONIC. In virtual time it only advances when a wait is requested,
+* so a run takes the CPU time of the host stack and the model instead of the modelled device time.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <time.h>
+#include <errno.h>
+#include "optiga/pal/pal_os_timer.h"
+
+#include "pal_sim.h"
+
+#define NSEC_PER_USEC   (1000ULL)
+#define USEC_PER_SEC    (1000000ULL)
+
+static uint8_t pal_sim_virtual_time = FALSE;
+/// Current time in virtual time mode
+static uint64_t pal_sim_virtual_now_us = 0;
+
+static uint64_t pal_sim_monotonic_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * USEC_PER_SEC) + ((uint64_t)now.tv_nsec / NSEC_PER_USEC);
+}
+
+void pal_sim_set_virtual_time(uint8_t enable)
+{
+    // The clock continues from the current value, deadlines already computed stay valid
+    if ((enable) && (!pal_sim_virtual_time))
+    {
+        pal_sim_virtual_now_us = pal_sim_monotonic_us();
+    }
+    pal_sim_virtual_time = enable ? TRUE : FALSE;
+}
+
+uint64_t pal_sim_get_time_us(void)
+{
+    return pal_sim_virtual_time ? pal_sim_virtual_now_us : pal_sim_monotonic_us();
+}
+
+void pal_sim_wait_until_us(uint64_t time_us)
+{
+    struct timespec deadline;
+
+    if (pal_sim_virtual_time)
+    {
+        if (time_us > pal_sim_virtual_now_us)
+        {
+            pal_sim_virtual_now_us = time_us;
+        }
+        return;
+    }
+    deadline.tv_sec = (time_t)(time_us / USEC_PER_SEC);
+    deadline.tv_nsec = (long)((time_us % USEC_PER_SEC) * NSEC_PER_USEC);
+    while (EINTR == clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL))
+    {
+    }
+}
+
+uint32_t pal_os_timer_get_time_in_milliseconds(void)
+{
+    return (uint32_t)(pal_sim_get_time_us() / 1000);
+}
+
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    return pal_sim_get_time_us();
+}
+
+void pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
+{
+    pal_sim_wait_until_us(pal_sim_get_time_us() + ((uint64_t)milliseconds * 1000));
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,303 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_sim.h
+*
+* \brief   This file provides the prototype declarations of the simulated OPTIGA.
+*
+* The simulator replaces the I2C bus and the OPTIGA by a software model, which implements the slave side of the
+* ifx i2c protocol and executes the commands with mbedTLS. The ifx i2c stack, the command library and the
+* util/crypt APIs run unmodified on top of it, which allows to test and benchmark them without hardware.
+* The model is single threaded: all callbacks are run by #pal_os_event_wait of the thread waiting for a
+* response, hence PAL_OS_HAS_EVENT_WAIT must be defined.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_SIM_H_
+#define _PAL_SIM_H_
+
+#include "optiga/pal/pal.h"
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_gpio.h"
+#include "mbedtls/sha256.h"
+#include "mbedtls/ctr_drbg.h"
+
+/// Largest DL frame accepted by the simulated OPTIGA, the DATA_REG_LEN negotiated is at most this size
+#ifndef PAL_SIM_MAX_FRAME_SIZE
+#define PAL_SIM_MAX_FRAME_SIZE          (0x0115)
+#endif
+/// DATA_REG_LEN after power up or reset
+#define PAL_SIM_DEFAULT_FRAME_SIZE      (0x0040)
+/// I2C slave address after the first power up
+#define PAL_SIM_DEFAULT_SLAVE_ADDRESS   (0x30)
+/// APDU buffer size of the simulated OPTIGA, reported in the data object 0xE0C6
+#define PAL_SIM_MAX_COMMS_BUFFER        (0x0615)
+/// Number of command codes, the latency is configured per command code without the MSB
+#define PAL_SIM_COMMAND_COUNT           (0x80)
+/// Number of data objects, key objects and session contexts
+#define PAL_SIM_OBJECT_COUNT            (43)
+/// Sum of the maximum sizes of all objects
+#define PAL_SIM_OBJECT_POOL_SIZE        (14597)
+/// Metadata bytes stored per object by SetDataObject
+#define PAL_SIM_METADATA_SIZE           (44)
+
+/// Bit of #pal_sim_t.pins_low for the Vdd pin
+#define PAL_SIM_PIN_VDD                 (0x01)
+/// Bit of #pal_sim_t.pins_low for the reset pin
+#define PAL_SIM_PIN_RESET               (0x02)
+/// Response pin, an output of the device with a rising edge whenever a frame becomes ready to be read
+#define PAL_SIM_PIN_IRQ                 (0x04)
+
+/** @brief Statistics of a simulated OPTIGA, counted since power up or the last clear by the application */
+typedef struct pal_sim_stats
+{
+    /// I2C transactions addressed to the OPTIGA, a combined write-read counts once
+    uint32_t transactions;
+    /// Transactions not acknowledged, as the slave address did not match or the device was unpowered
+    uint32_t nacked;
+    /// Bytes written and read on the bus, including the address bytes
+    uint32_t bus_bytes;
+    /// Time the bus was busy at the negotiated bitrate, in microseconds
+    uint64_t bus_time_us;
+    /// Reads of the I2C_STATE register
+    uint32_t status_polls;
+    /// Reads of the I2C_STATE register while a command was executing
+    uint32_t busy_polls;
+    /// Data frames and control frames received from the host
+    uint32_t frames_received;
+    /// Data frames and control frames read by the host
+    uint32_t frames_sent;
+    /// Frames received with a CRC or length error
+    uint32_t frame_errors;
+    /// Data frames sent again after a NACK or a chaining error
+    uint32_t retransmissions;
+    /// Re-synchronizations requested by the host
+    uint32_t resyncs;
+    /// Frames corrupted on purpose, see #pal_sim_t.fault_interval
+    uint32_t faults_injected;
+    /// Rising edges of the response pin reported to the host
+    uint32_t irq_edges;
+    /// Commands executed, indexed by command code without the MSB
+    uint32_t commands[PAL_SIM_COMMAND_COUNT];
+    /// Commands which returned an error
+    uint32_t command_errors;
+    /// Time spent executing commands, in microseconds
+    uint64_t busy_time_us;
+} pal_sim_stats_t;
+
+/** @brief Pin of a simulated OPTIGA, pointed to by pal_gpio_t.p_gpio_hw */
+typedef struct pal_sim_pin
+{
+    /// Device the pin is connected to
+    struct pal_sim * p_device;
+    /// #PAL_SIM_PIN_VDD, #PAL_SIM_PIN_RESET or #PAL_SIM_PIN_IRQ
+    uint8_t pin;
+} pal_sim_pin_t;
+
+/**
+ * @brief Simulated OPTIGA, pointed to by pal_i2c_t.p_i2c_hw_config.
+ *
+ * A zero initialized instance is a device with factory defaults. Fields documented as configuration may be set
+ * by the application, the statistics may be read and cleared at any time. All other fields are the internal
+ * state of the model.
+ */
+typedef struct pal_sim
+{
+    /// Configuration: seed of the deterministic random generator, the same seed gives the same keys and signatures
+    uint32_t seed;
+    /// Configuration: every fault_interval-th frame sent to the host gets a CRC error, 0 to disable
+    uint32_t fault_interval;
+    /// Configuration: transfers complete instantly instead of taking the bus time at the negotiated bitrate
+    uint8_t ideal_bus;
+
+    /// Defaults, latencies and objects are set up
+    uint8_t initialized;
+    /// Powered and out of reset
+    uint8_t powered;
+    /// Pins currently driven low, see #PAL_SIM_PIN_VDD
+    uint8_t pins_low;
+    /// Slave address after power up, changed by a persistent write to BASE_ADDR
+    uint8_t default_slave_address;
+    /// Current slave address
+    uint8_t slave_address;
+    /// Register addressed by the last write
+    uint8_t register_address;
+    /// I2C mode after power up, changed by a persistent write to I2C_MODE
+    uint8_t default_i2c_mode;
+    /// Current I2C mode, selects the value of MAX_SCL_FREQU
+    uint8_t i2c_mode;
+    /// Bitrate of the master in kHz
+    uint16_t bitrate;
+    /// Current DATA_REG_LEN
+    uint16_t frame_size;
+
+    /// Data link layer: number of the last data frame sent
+    uint8_t tx_seq_nr;
+    /// Data link layer: number of the last data frame received
+    uint8_t rx_seq_nr;
+    /// Control frame waiting to be read by the host
+    uint8_t control_frame_pending;
+    /// Data frame waiting to be read by the host
+    uint8_t data_frame_pending;
+    /// Data frame read by the host and not yet acknowledged
+    uint8_t data_frame_unacked;
+    /// Frames sent since power up, used for fault injection
+    uint32_t frame_counter;
+    /// Control frame to be read
+    uint8_t control_frame[5];
+    /// Last data frame sent, kept for retransmission
+    uint8_t data_frame[PAL_SIM_MAX_FRAME_SIZE];
+    /// Length of data_frame
+    uint16_t data_frame_len;
+
+    /// Transport layer: chaining of the last fragment received
+    uint8_t rx_chaining;
+    /// Transport layer: a response is being sent
+    uint8_t tx_active;
+    /// Length of the command received so far
+    uint16_t rx_packet_len;
+    /// Length of the response
+    uint16_t tx_packet_len;
+    /// Offset in tx_packet of the response fragment in data_frame
+    uint16_t tx_packet_offset;
+    /// Length of the response fragment in data_frame
+    uint16_t tx_fragment_len;
+    /// Command being received
+    uint8_t rx_packet[PAL_SIM_MAX_COMMS_BUFFER];
+    /// Response being sent
+    uint8_t tx_packet[PAL_SIM_MAX_COMMS_BUFFER];
+
+    /// A command is executing, the response is available at response_time_us
+    uint8_t busy;
+    /// Time the running command completes, on the #pal_sim_get_time_us clock
+    uint64_t response_time_us;
+    /// Configuration: execution time of each command in microseconds, indexed by command code without the MSB
+    uint32_t latency_us[PAL_SIM_COMMAND_COUNT];
+
+    /// Handler of the response pin registered by the host, NULL if the pin is not connected
+    register_callback irq_handler;
+    /// Context passed to irq_handler
+    void * p_irq_ctx;
+    /// A check of the response pin is scheduled at irq_due_us
+    uint8_t irq_scheduled;
+    /// Time of the next check of the response pin
+    uint64_t irq_due_us;
+
+    /// Application is opened
+    uint8_t app_open;
+    /// Error code of the last failed command, read through 0xF1C2
+    uint8_t last_error;
+    /// A hash sequence is started
+    uint8_t hash_active;
+    /// Context of the running hash sequence
+    mbedtls_sha256_context hash;
+    /// Deterministic random generator
+    mbedtls_ctr_drbg_context drbg;
+    /// Used length of each object
+    uint16_t object_length[PAL_SIM_OBJECT_COUNT];
+    /// Length of the metadata written to each object
+    uint8_t metadata_length[PAL_SIM_OBJECT_COUNT];
+    /// Metadata written to each object, without the 0x20 tag
+    uint8_t metadata[PAL_SIM_OBJECT_COUNT][PAL_SIM_METADATA_SIZE];
+    /// Content of all objects, each object at the sum of the maximum sizes of the objects before it
+    uint8_t object_pool[PAL_SIM_OBJECT_POOL_SIZE];
+
+    /// Statistics, may be read and cleared by the application
+    pal_sim_stats_t stats;
+} pal_sim_t;
+
+/// Response pin of the default simulated OPTIGA, see #PAL_SIM_PIN_IRQ
+extern pal_gpio_t optiga_irq_0;
+
+/**
+ * \brief Sets up the defaults of a zero initialized device, does nothing if already done.
+ *
+ * Called by the pal functions, the application calls it only to change the configuration before first use.
+ */
+pal_status_t pal_sim_init(pal_sim_t * p_sim);
+
+/**
+ * \brief Sets the execution time of a command, the MSB of the command code is ignored.
+ */
+void pal_sim_set_latency(pal_sim_t * p_sim, uint8_t command, uint32_t latency_us);
+
+/**
+ * \brief Selects virtual time. With virtual time waits complete immediately and advance the clock instead,
+ *        the results are the same as in real time but independent of the host load.
+ */
+void pal_sim_set_virtual_time(uint8_t enable);
+
+/**
+ * \brief Current time of the simulation in microseconds, the timer and event pal use this clock.
+ */
+uint64_t pal_sim_get_time_us(void);
+
+/**
+ * \brief Waits until the simulation time reaches time_us.
+ */
+void pal_sim_wait_until_us(uint64_t time_us);
+
+/**
+ * \brief Drives a pin of the device, the device is reset while any of its pins is low.
+ */
+void pal_sim_set_pin(const pal_sim_pin_t * p_pin, uint8_t high);
+
+/**
+ * \brief Schedules a rising edge of the response pin at time_us, if a frame is ready to be read by then.
+ */
+void pal_sim_irq_schedule(pal_sim_t * p_sim, uint64_t time_us);
+
+/**
+ * \brief Resets the protocol state, as done by power up, the reset pin and the SOFT_RESET register.
+ */
+void pal_sim_reset(pal_sim_t * p_sim);
+
+/**
+ * \brief Sets the factory content of the data objects and the latencies.
+ */
+void pal_sim_apdu_init(pal_sim_t * p_sim);
+
+/**
+ * \brief Resets the volatile state of the application, as done by power up and reset.
+ */
+void pal_sim_apdu_reset(pal_sim_t * p_sim);
+
+/**
+ * \brief Executes a command APDU and stores the response APDU in p_sim->tx_packet.
+ *
+ * \retval  Execution time of the command in microseconds
+ */
+uint32_t pal_sim_apdu_execute(pal_sim_t * p_sim, const uint8_t * p_command, uint16_t command_length);
+
+#endif /* _PAL_SIM_H_ */
+
+/**
+* @}
+*/
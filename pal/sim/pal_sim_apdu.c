@@ -0,0 +1,1530 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_sim_apdu.c
+*
+* \brief   This file implements the command execution of the simulated OPTIGA.
+*
+* Supported are OpenApplication, GetDataObject, SetDataObject, GetRandom, CalcHash (SHA-256), VerifySign,
+* GenKeyPair, CalcSign, CalcSSec (ECDH) and DeriveKey (TLS PRF SHA-256) on the NIST P256 and P384 curves.
+* Access conditions are evaluated as ALW or NEV only, any condition other than NEV is granted.
+* The device certificate in 0xE0E0 is self-signed for the device private key in 0xE0F0, both are generated at
+* initialization from the seed. It is stored as TLS identity, tag 0xC0 followed by a chain of one certificate.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <string.h>
+#include "mbedtls/ecdsa.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/md.h"
+#include "mbedtls/asn1.h"
+#include "mbedtls/x509_crt.h"
+#include "mbedtls/pk.h"
+
+#include "pal_sim.h"
+
+/// @cond hidden
+// Command codes without the MSB
+#define PAL_SIM_CMD_GETDATA                 (0x01)
+#define PAL_SIM_CMD_SETDATA                 (0x02)
+#define PAL_SIM_CMD_GET_RND                 (0x0C)
+#define PAL_SIM_CMD_CALCHASH                (0x30)
+#define PAL_SIM_CMD_CALC_SIGN               (0x31)
+#define PAL_SIM_CMD_VERIFYSIGN              (0x32)
+#define PAL_SIM_CMD_CALC_SHARED_SEC         (0x33)
+#define PAL_SIM_CMD_DERIVE_KEY              (0x34)
+#define PAL_SIM_CMD_GENERATE_KEY_PAIR       (0x38)
+#define PAL_SIM_CMD_OPEN_APP                (0x70)
+#define PAL_SIM_CMD_FLUSH_ERROR             (0x80)
+
+// Error codes reported through 0xF1C2
+#define PAL_SIM_ERR_INVALID_OID             (0x01)
+#define PAL_SIM_ERR_INVALID_PARAM           (0x03)
+#define PAL_SIM_ERR_INVALID_LENGTH          (0x04)
+#define PAL_SIM_ERR_INVALID_DATA            (0x05)
+#define PAL_SIM_ERR_INTERNAL                (0x06)
+#define PAL_SIM_ERR_ACCESS_CONDITION        (0x07)
+#define PAL_SIM_ERR_OUT_OF_BOUNDS           (0x08)
+#define PAL_SIM_ERR_INVALID_COMMAND         (0x0A)
+#define PAL_SIM_ERR_SEQUENCE                (0x0B)
+#define PAL_SIM_ERR_SIGNATURE               (0x2C)
+
+#define PAL_SIM_APDU_HEADER_SIZE            (4)
+#define PAL_SIM_APDU_FAILURE                (0xFF)
+#define PAL_SIM_TLV_HEADER_SIZE             (3)
+#define PAL_SIM_MAX_RESPONSE                (PAL_SIM_MAX_COMMS_BUFFER - PAL_SIM_APDU_HEADER_SIZE)
+
+// Access conditions
+#define PAL_SIM_AC_ALW                      (0x00)
+#define PAL_SIM_AC_NEV                      (0xFF)
+// Metadata tags
+#define PAL_SIM_TAG_METADATA                (0x20)
+#define PAL_SIM_TAG_LCSO                    (0xC0)
+#define PAL_SIM_TAG_MAX_SIZE                (0xC4)
+#define PAL_SIM_TAG_USED_SIZE               (0xC5)
+#define PAL_SIM_TAG_CHANGE                  (0xD0)
+#define PAL_SIM_TAG_READ                    (0xD1)
+#define PAL_SIM_TAG_EXECUTE                 (0xD3)
+#define PAL_SIM_LCS_OPERATIONAL             (0x07)
+
+// Algorithm identifiers, key usage of the factory key and the marker of a secret in a session context
+#define PAL_SIM_ALG_NIST_P256               (0x03)
+#define PAL_SIM_ALG_NIST_P384               (0x04)
+#define PAL_SIM_KEY_USAGE_AUTH_SIGN         (0x11)
+#define PAL_SIM_SESSION_SECRET              (0xFF)
+#define PAL_SIM_KEY_HEADER_SIZE             (2)
+#define PAL_SIM_MAX_KEY_SIZE                (48)
+
+// Device certificate: TLS identity tag, value length (2), chain length (3) and certificate length (3)
+#define PAL_SIM_TAG_TLS_IDENTITY            (0xC0)
+#define PAL_SIM_CERT_HEADER_SIZE            (9)
+#define PAL_SIM_CERT_NAME                   "CN=OPTIGA Trust X simulation,O=pal_sim"
+
+// Hash
+#define PAL_SIM_HASH_SHA256                 (0xE2)
+#define PAL_SIM_HASH_DATA_OID               (0x01)
+#define PAL_SIM_HASH_START                  (0x00)
+#define PAL_SIM_HASH_START_FINAL            (0x01)
+#define PAL_SIM_HASH_CONTINUE               (0x02)
+#define PAL_SIM_HASH_FINAL                  (0x03)
+#define PAL_SIM_HASH_TERMINATE              (0x04)
+#define PAL_SIM_HASH_INTERMEDIATE           (0x05)
+#define PAL_SIM_HASH_SIZE                   (32)
+#define PAL_SIM_HASH_CONTEXT_SIZE           (130)
+#define PAL_SIM_TAG_HASH                    (0x01)
+#define PAL_SIM_TAG_CONTEXT                 (0x06)
+#define PAL_SIM_TAG_EXPORT                  (0x07)
+
+#define PAL_SIM_SIGN_SCHEME_ECDSA           (0x11)
+#define PAL_SIM_KEY_AGREEMENT_ECDH          (0x01)
+#define PAL_SIM_DERIVATION_TLS_PRF_SHA256   (0x01)
+
+// Object types
+#define PAL_SIM_OBJECT_DATA                 (0x00)
+#define PAL_SIM_OBJECT_KEY                  (0x01)
+#define PAL_SIM_OBJECT_SESSION              (0x02)
+#define PAL_SIM_OBJECT_LAST_ERROR           (0x03)
+/// @endcond
+
+/// Data object, key object or session context of the simulated OPTIGA
+typedef struct pal_sim_object
+{
+    /// Object identifier
+    uint16_t oid;
+    /// Maximum size of the content
+    uint16_t max_size;
+    /// Type of the object
+    uint8_t type;
+    /// Default change access condition
+    uint8_t change;
+    /// Default read access condition
+    uint8_t read;
+} pal_sim_object_t;
+
+/// Objects of the simulated OPTIGA, the sizes add up to #PAL_SIM_OBJECT_POOL_SIZE
+static const pal_sim_object_t pal_sim_objects[PAL_SIM_OBJECT_COUNT] =
+{
+    {0xE0C0,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0C1,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0C2,   27, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0C3,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0C4,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0C5,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0C6,    2, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0E0, 1728, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xE0E1, 1728, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0E2, 1728, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0E3, 1728, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0E8, 1200, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0EF, 1200, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE0F0,   50, PAL_SIM_OBJECT_KEY,        PAL_SIM_AC_NEV, PAL_SIM_AC_NEV},
+    {0xE0F1,   50, PAL_SIM_OBJECT_KEY,        PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE0F2,   50, PAL_SIM_OBJECT_KEY,        PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE0F3,   50, PAL_SIM_OBJECT_KEY,        PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE100,   68, PAL_SIM_OBJECT_SESSION,    PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE101,   68, PAL_SIM_OBJECT_SESSION,    PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE102,   68, PAL_SIM_OBJECT_SESSION,    PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE103,   68, PAL_SIM_OBJECT_SESSION,    PAL_SIM_AC_ALW, PAL_SIM_AC_NEV},
+    {0xE120,    8, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE121,    8, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE122,    8, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE123,    8, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xE140,   64, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1C0,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1C1,    1, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1C2,    1, PAL_SIM_OBJECT_LAST_ERROR, PAL_SIM_AC_NEV, PAL_SIM_AC_ALW},
+    {0xF1D0,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D1,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D2,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D3,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D4,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D5,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D6,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D7,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D8,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1D9,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1DA,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1DB,  140, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1E0, 1500, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+    {0xF1E1, 1500, PAL_SIM_OBJECT_DATA,       PAL_SIM_AC_ALW, PAL_SIM_AC_ALW},
+};
+
+/// Unique application identifier of OpenApplication
+static const uint8_t pal_sim_application_id[] =
+{
+    0xD2, 0x76, 0x00, 0x00, 0x04, 0x47, 0x65, 0x6E, 0x41, 0x75, 0x74, 0x68, 0x41, 0x70, 0x70, 0x6C
+};
+
+/// Default execution time of the commands in microseconds, roughly as measured on the OPTIGA Trust X
+static const struct
+{
+    uint8_t command;
+    uint32_t latency_us;
+} pal_sim_default_latency[] =
+{
+    {PAL_SIM_CMD_OPEN_APP,           10000},
+    {PAL_SIM_CMD_GETDATA,             2000},
+    {PAL_SIM_CMD_SETDATA,            15000},
+    {PAL_SIM_CMD_GET_RND,             4000},
+    {PAL_SIM_CMD_CALCHASH,            2000},
+    {PAL_SIM_CMD_CALC_SIGN,          60000},
+    {PAL_SIM_CMD_VERIFYSIGN,         85000},
+    {PAL_SIM_CMD_GENERATE_KEY_PAIR,  55000},
+    {PAL_SIM_CMD_CALC_SHARED_SEC,    60000},
+    {PAL_SIM_CMD_DERIVE_KEY,          5000},
+};
+
+/**********************************************************************************************************************
+ * HELPERS
+ *********************************************************************************************************************/
+
+static uint16_t pal_sim_get_uint16(const uint8_t * p_data)
+{
+    return (uint16_t)((p_data[0] << 8) | p_data[1]);
+}
+
+static void pal_sim_set_uint16(uint8_t * p_data, uint16_t value)
+{
+    p_data[0] = (uint8_t)(value >> 8);
+    p_data[1] = (uint8_t)value;
+}
+
+// Entropy of the random generator, derived from the seed only so that runs are repeatable
+static int pal_sim_entropy(void * p_ctx, unsigned char * p_output, size_t length)
+{
+    uint32_t state = ((pal_sim_t *)p_ctx)->seed ^ 0x4F505449;
+
+    while (length--)
+    {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        *p_output++ = (unsigned char)state;
+    }
+    return 0;
+}
+
+static int16_t pal_sim_object_index(uint16_t oid)
+{
+    int16_t index;
+
+    for (index = 0; index < PAL_SIM_OBJECT_COUNT; index++)
+    {
+        if (oid == pal_sim_objects[index].oid)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+static uint8_t * pal_sim_object_data(pal_sim_t * p_sim, int16_t index)
+{
+    uint16_t offset = 0;
+    int16_t count;
+
+    for (count = 0; count < index; count++)
+    {
+        offset += pal_sim_objects[count].max_size;
+    }
+    return &p_sim->object_pool[offset];
+}
+
+// Finds a TLV with 2 byte length in a sequence of TLVs, returns FALSE if not found or the sequence is malformed
+static uint8_t pal_sim_find_tag(const uint8_t * p_data, uint16_t length, uint8_t tag,
+                                const uint8_t ** pp_value, uint16_t * p_value_length)
+{
+    uint16_t offset = 0;
+    uint16_t value_length;
+
+    while (offset < length)
+    {
+        if ((length - offset) < PAL_SIM_TLV_HEADER_SIZE)
+        {
+            return FALSE;
+        }
+        value_length = pal_sim_get_uint16(&p_data[offset + 1]);
+        if ((length - offset - PAL_SIM_TLV_HEADER_SIZE) < value_length)
+        {
+            return FALSE;
+        }
+        if (tag == p_data[offset])
+        {
+            *pp_value = &p_data[offset + PAL_SIM_TLV_HEADER_SIZE];
+            *p_value_length = value_length;
+            return TRUE;
+        }
+        offset += PAL_SIM_TLV_HEADER_SIZE + value_length;
+    }
+    return FALSE;
+}
+
+// Finds a metadata TLV with 1 byte length, returns NULL if the tag is not set
+static const uint8_t * pal_sim_find_metadata(const uint8_t * p_metadata, uint8_t length, uint8_t tag)
+{
+    uint8_t offset = 0;
+
+    while ((offset + 2) <= length)
+    {
+        if (tag == p_metadata[offset])
+        {
+            return &p_metadata[offset];
+        }
+        offset += 2 + p_metadata[offset + 1];
+    }
+    return NULL;
+}
+
+// Access condition tag of an object granted, conditions set by SetDataObject replace the defaults
+static uint8_t pal_sim_access_granted(const pal_sim_t * p_sim, int16_t index, uint8_t tag)
+{
+    const uint8_t * p_tag = pal_sim_find_metadata(p_sim->metadata[index], p_sim->metadata_length[index], tag);
+    uint8_t condition = (PAL_SIM_TAG_CHANGE == tag) ? pal_sim_objects[index].change : pal_sim_objects[index].read;
+
+    if ((NULL != p_tag) && (0 != p_tag[1]))
+    {
+        condition = p_tag[2];
+    }
+    return (PAL_SIM_AC_NEV != condition) ? TRUE : FALSE;
+}
+
+static mbedtls_ecp_group_id pal_sim_curve(uint8_t algorithm, uint16_t * p_key_size)
+{
+    if (PAL_SIM_ALG_NIST_P256 == algorithm)
+    {
+        *p_key_size = 32;
+        return MBEDTLS_ECP_DP_SECP256R1;
+    }
+    if (PAL_SIM_ALG_NIST_P384 == algorithm)
+    {
+        *p_key_size = 48;
+        return MBEDTLS_ECP_DP_SECP384R1;
+    }
+    return MBEDTLS_ECP_DP_NONE;
+}
+
+// Loads the private key of a key object or session context
+static uint8_t pal_sim_load_private_key(pal_sim_t * p_sim, uint16_t oid, mbedtls_ecp_keypair * p_key)
+{
+    int16_t index = pal_sim_object_index(oid);
+    const uint8_t * p_data;
+    mbedtls_ecp_group_id curve;
+    uint16_t key_size;
+
+    if ((index < 0) || ((PAL_SIM_OBJECT_KEY != pal_sim_objects[index].type) &&
+                        (PAL_SIM_OBJECT_SESSION != pal_sim_objects[index].type)))
+    {
+        return PAL_SIM_ERR_INVALID_OID;
+    }
+    p_data = pal_sim_object_data(p_sim, index);
+    curve = pal_sim_curve(p_data[0], &key_size);
+    if ((0 == p_sim->object_length[index]) || (MBEDTLS_ECP_DP_NONE == curve) ||
+        (p_sim->object_length[index] != PAL_SIM_KEY_HEADER_SIZE + key_size))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    if ((0 != mbedtls_ecp_group_load(&p_key->grp, curve)) ||
+        (0 != mbedtls_mpi_read_binary(&p_key->d, &p_data[PAL_SIM_KEY_HEADER_SIZE], key_size)))
+    {
+        return PAL_SIM_ERR_INTERNAL;
+    }
+    return 0;
+}
+
+// Reads a public key given as BIT STRING (03 len 00 04 X Y) or as uncompressed point (04 X Y)
+static uint8_t pal_sim_read_public_key(uint8_t algorithm, const uint8_t * p_value, uint16_t length,
+                                       mbedtls_ecp_keypair * p_key)
+{
+    uint16_t key_size;
+    mbedtls_ecp_group_id curve = pal_sim_curve(algorithm, &key_size);
+
+    if ((length > 3) && (0x03 == p_value[0]) && (p_value[1] == length - 2) && (0x00 == p_value[2]))
+    {
+        p_value += 3;
+        length -= 3;
+    }
+    if (MBEDTLS_ECP_DP_NONE == curve)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((0 != mbedtls_ecp_group_load(&p_key->grp, curve)) ||
+        (0 != mbedtls_ecp_point_read_binary(&p_key->grp, &p_key->Q, p_value, length)) ||
+        (0 != mbedtls_ecp_check_pubkey(&p_key->grp, &p_key->Q)))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    return 0;
+}
+
+// Writes the public key as TLV with the BIT STRING of the uncompressed point
+static uint16_t pal_sim_write_public_key(uint8_t tag, mbedtls_ecp_keypair * p_key, uint8_t * p_out)
+{
+    size_t point_length = 0;
+
+    (void)mbedtls_ecp_point_write_binary(&p_key->grp, &p_key->Q, MBEDTLS_ECP_PF_UNCOMPRESSED, &point_length,
+                                         &p_out[PAL_SIM_TLV_HEADER_SIZE + 3], 2 * PAL_SIM_MAX_KEY_SIZE + 1);
+    p_out[0] = tag;
+    pal_sim_set_uint16(&p_out[1], (uint16_t)(point_length + 3));
+    p_out[PAL_SIM_TLV_HEADER_SIZE] = 0x03;
+    p_out[PAL_SIM_TLV_HEADER_SIZE + 1] = (uint8_t)(point_length + 1);
+    p_out[PAL_SIM_TLV_HEADER_SIZE + 2] = 0x00;
+    return (uint16_t)(PAL_SIM_TLV_HEADER_SIZE + 3 + point_length);
+}
+
+// Writes a DER INTEGER, positive and of at most 48 bytes
+static uint16_t pal_sim_write_integer(const mbedtls_mpi * p_value, uint8_t * p_out)
+{
+    uint8_t buffer[PAL_SIM_MAX_KEY_SIZE];
+    uint16_t length = (uint16_t)mbedtls_mpi_size(p_value);
+    uint8_t pad;
+
+    (void)mbedtls_mpi_write_binary(p_value, buffer, length);
+    pad = ((0 == length) || (buffer[0] & 0x80)) ? 1 : 0;
+    p_out[0] = MBEDTLS_ASN1_INTEGER;
+    p_out[1] = (uint8_t)(length + pad);
+    p_out[2] = 0x00;
+    memcpy(&p_out[2 + pad], buffer, length);
+    return (uint16_t)(2 + pad + length);
+}
+
+// TLS 1.2 PRF with SHA-256, the label is part of the seed
+static uint8_t pal_sim_tls_prf(const uint8_t * p_secret, uint16_t secret_length, const uint8_t * p_seed,
+                               uint16_t seed_length, uint8_t * p_out, uint16_t length)
+{
+    mbedtls_md_context_t md;
+    uint8_t a[PAL_SIM_HASH_SIZE];
+    uint8_t block[PAL_SIM_HASH_SIZE];
+    uint16_t offset;
+    uint8_t status = PAL_SIM_ERR_INTERNAL;
+
+    mbedtls_md_init(&md);
+    do
+    {
+        if (0 != mbedtls_md_setup(&md, mbedtls_md_info_from_type(MBEDTLS_MD_SHA256), 1))
+        {
+            break;
+        }
+        // A(1) = HMAC(secret, seed)
+        (void)mbedtls_md_hmac_starts(&md, p_secret, secret_length);
+        (void)mbedtls_md_hmac_update(&md, p_seed, seed_length);
+        (void)mbedtls_md_hmac_finish(&md, a);
+        for (offset = 0; offset < length; offset += PAL_SIM_HASH_SIZE)
+        {
+            (void)mbedtls_md_hmac_reset(&md);
+            (void)mbedtls_md_hmac_update(&md, a, sizeof(a));
+            (void)mbedtls_md_hmac_update(&md, p_seed, seed_length);
+            (void)mbedtls_md_hmac_finish(&md, block);
+            memcpy(&p_out[offset], block,
+                   ((length - offset) < PAL_SIM_HASH_SIZE) ? (length - offset) : PAL_SIM_HASH_SIZE);
+            // A(i+1) = HMAC(secret, A(i))
+            (void)mbedtls_md_hmac_reset(&md);
+            (void)mbedtls_md_hmac_update(&md, a, sizeof(a));
+            (void)mbedtls_md_hmac_finish(&md, a);
+        }
+        status = 0;
+    } while (FALSE);
+    mbedtls_md_free(&md);
+    return status;
+}
+
+// The SHA-256 context is exported as total, state and the pending block, big endian, padded to 130 bytes
+static void pal_sim_export_hash(const mbedtls_sha256_context * p_hash, uint8_t * p_out)
+{
+    uint8_t index;
+
+    memset(p_out, 0x00, PAL_SIM_HASH_CONTEXT_SIZE);
+    for (index = 0; index < 2; index++)
+    {
+        pal_sim_set_uint16(&p_out[4 * index], (uint16_t)(p_hash->total[index] >> 16));
+        pal_sim_set_uint16(&p_out[4 * index + 2], (uint16_t)p_hash->total[index]);
+    }
+    for (index = 0; index < 8; index++)
+    {
+        pal_sim_set_uint16(&p_out[8 + 4 * index], (uint16_t)(p_hash->state[index] >> 16));
+        pal_sim_set_uint16(&p_out[8 + 4 * index + 2], (uint16_t)p_hash->state[index]);
+    }
+    memcpy(&p_out[40], p_hash->buffer, sizeof(p_hash->buffer));
+}
+
+static void pal_sim_import_hash(mbedtls_sha256_context * p_hash, const uint8_t * p_in)
+{
+    uint8_t index;
+
+    mbedtls_sha256_init(p_hash);
+    for (index = 0; index < 2; index++)
+    {
+        p_hash->total[index] = ((uint32_t)pal_sim_get_uint16(&p_in[4 * index]) << 16) |
+                               pal_sim_get_uint16(&p_in[4 * index + 2]);
+    }
+    for (index = 0; index < 8; index++)
+    {
+        p_hash->state[index] = ((uint32_t)pal_sim_get_uint16(&p_in[8 + 4 * index]) << 16) |
+                               pal_sim_get_uint16(&p_in[8 + 4 * index + 2]);
+    }
+    memcpy(p_hash->buffer, &p_in[40], sizeof(p_hash->buffer));
+    p_hash->is224 = 0;
+}
+
+/**********************************************************************************************************************
+ * COMMANDS
+ *********************************************************************************************************************/
+
+static uint8_t pal_sim_open_application(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                        uint16_t payload_length)
+{
+    if (0x00 != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((sizeof(pal_sim_application_id) != payload_length) ||
+        (0 != memcmp(p_payload, pal_sim_application_id, payload_length)))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    pal_sim_apdu_reset(p_sim);
+    p_sim->app_open = TRUE;
+    return 0;
+}
+
+static uint16_t pal_sim_read_metadata(const pal_sim_t * p_sim, int16_t index, uint8_t * p_out)
+{
+    const uint8_t * p_user = p_sim->metadata[index];
+    uint8_t user_length = p_sim->metadata_length[index];
+    uint8_t defaults[] =
+    {
+        PAL_SIM_TAG_LCSO, 0x01, PAL_SIM_LCS_OPERATIONAL,
+        PAL_SIM_TAG_MAX_SIZE, 0x02, (uint8_t)(pal_sim_objects[index].max_size >> 8),
+                                    (uint8_t)pal_sim_objects[index].max_size,
+        PAL_SIM_TAG_USED_SIZE, 0x02, (uint8_t)(p_sim->object_length[index] >> 8),
+                                     (uint8_t)p_sim->object_length[index],
+        PAL_SIM_TAG_CHANGE, 0x01, pal_sim_objects[index].change,
+        PAL_SIM_TAG_READ, 0x01, pal_sim_objects[index].read,
+        PAL_SIM_TAG_EXECUTE, 0x01, PAL_SIM_AC_ALW,
+    };
+    const uint8_t * p_tag;
+    uint16_t length = 2;
+    uint8_t offset;
+
+    // Defaults in order, replaced by tags written with SetDataObject, followed by the other tags written
+    for (offset = 0; offset < sizeof(defaults); offset += 2 + defaults[offset + 1])
+    {
+        p_tag = pal_sim_find_metadata(p_user, user_length, defaults[offset]);
+        if (NULL == p_tag)
+        {
+            p_tag = &defaults[offset];
+        }
+        memcpy(&p_out[length], p_tag, 2 + p_tag[1]);
+        length += 2 + p_tag[1];
+    }
+    for (offset = 0; offset < user_length; offset += 2 + p_user[offset + 1])
+    {
+        if (NULL == pal_sim_find_metadata(defaults, sizeof(defaults), p_user[offset]))
+        {
+            memcpy(&p_out[length], &p_user[offset], 2 + p_user[offset + 1]);
+            length += 2 + p_user[offset + 1];
+        }
+    }
+    p_out[0] = PAL_SIM_TAG_METADATA;
+    p_out[1] = (uint8_t)(length - 2);
+    return length;
+}
+
+static uint8_t pal_sim_get_data(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    int16_t index;
+    uint16_t offset = 0;
+    uint16_t length = PAL_SIM_MAX_RESPONSE;
+    uint16_t used;
+
+    if (payload_length < 2)
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    index = pal_sim_object_index(pal_sim_get_uint16(p_payload));
+    if (index < 0)
+    {
+        return PAL_SIM_ERR_INVALID_OID;
+    }
+
+    if (0x01 == param)
+    {
+        if (2 != payload_length)
+        {
+            return PAL_SIM_ERR_INVALID_LENGTH;
+        }
+        *p_out_length = pal_sim_read_metadata(p_sim, index, p_out);
+        return 0;
+    }
+    if (0x00 != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((2 != payload_length) && (6 != payload_length))
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    if (!pal_sim_access_granted(p_sim, index, PAL_SIM_TAG_READ))
+    {
+        return PAL_SIM_ERR_ACCESS_CONDITION;
+    }
+    if (PAL_SIM_OBJECT_LAST_ERROR == pal_sim_objects[index].type)
+    {
+        // Reading the last error code clears it
+        p_out[0] = p_sim->last_error;
+        p_sim->last_error = 0;
+        *p_out_length = 1;
+        return 0;
+    }
+    if (6 == payload_length)
+    {
+        offset = pal_sim_get_uint16(&p_payload[2]);
+        length = pal_sim_get_uint16(&p_payload[4]);
+    }
+    used = p_sim->object_length[index];
+    if ((offset > used) || ((offset == used) && (0 != used)))
+    {
+        return PAL_SIM_ERR_OUT_OF_BOUNDS;
+    }
+    if (length > used - offset)
+    {
+        length = used - offset;
+    }
+    if (length > PAL_SIM_MAX_RESPONSE)
+    {
+        length = PAL_SIM_MAX_RESPONSE;
+    }
+    memcpy(p_out, pal_sim_object_data(p_sim, index) + offset, length);
+    *p_out_length = length;
+    return 0;
+}
+
+static uint8_t pal_sim_set_metadata(pal_sim_t * p_sim, int16_t index, const uint8_t * p_metadata, uint16_t length)
+{
+    uint8_t merged[PAL_SIM_METADATA_SIZE];
+    uint8_t merged_length = 0;
+    const uint8_t * p_user = p_sim->metadata[index];
+    uint8_t offset;
+    uint16_t position;
+
+    if ((length < 2) || (PAL_SIM_TAG_METADATA != p_metadata[0]) || (p_metadata[1] != length - 2))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    p_metadata += 2;
+    length -= 2;
+    for (position = 0; position < length; position += 2 + p_metadata[position + 1])
+    {
+        if (((position + 2) > length) || ((position + 2 + p_metadata[position + 1]) > length) ||
+            (PAL_SIM_TAG_MAX_SIZE == p_metadata[position]) || (PAL_SIM_TAG_USED_SIZE == p_metadata[position]))
+        {
+            return PAL_SIM_ERR_INVALID_DATA;
+        }
+    }
+    // Tags already written and not written again are kept
+    for (offset = 0; offset < p_sim->metadata_length[index]; offset += 2 + p_user[offset + 1])
+    {
+        if (NULL == pal_sim_find_metadata(p_metadata, (uint8_t)length, p_user[offset]))
+        {
+            memcpy(&merged[merged_length], &p_user[offset], 2 + p_user[offset + 1]);
+            merged_length += 2 + p_user[offset + 1];
+        }
+    }
+    if ((merged_length + length) > PAL_SIM_METADATA_SIZE)
+    {
+        return PAL_SIM_ERR_OUT_OF_BOUNDS;
+    }
+    memcpy(&merged[merged_length], p_metadata, length);
+    merged_length += (uint8_t)length;
+    memcpy(p_sim->metadata[index], merged, merged_length);
+    p_sim->metadata_length[index] = merged_length;
+    return 0;
+}
+
+static uint8_t pal_sim_set_data(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                uint16_t payload_length)
+{
+    int16_t index;
+    uint16_t offset;
+    uint16_t length;
+    uint8_t * p_data;
+
+    if (payload_length < 2)
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    index = pal_sim_object_index(pal_sim_get_uint16(p_payload));
+    if (index < 0)
+    {
+        return PAL_SIM_ERR_INVALID_OID;
+    }
+    if ((0x00 != param) && (0x40 != param) && (0x01 != param))
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if (payload_length < 4)
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    if (0x01 == param)
+    {
+        // Metadata is written as a whole, the offset is always 0
+        if (0 != pal_sim_get_uint16(&p_payload[2]))
+        {
+            return PAL_SIM_ERR_OUT_OF_BOUNDS;
+        }
+        return pal_sim_set_metadata(p_sim, index, &p_payload[4], payload_length - 4);
+    }
+    // Keys are written by GenKeyPair only
+    if ((PAL_SIM_OBJECT_DATA != pal_sim_objects[index].type) ||
+        (!pal_sim_access_granted(p_sim, index, PAL_SIM_TAG_CHANGE)))
+    {
+        return PAL_SIM_ERR_ACCESS_CONDITION;
+    }
+    offset = pal_sim_get_uint16(&p_payload[2]);
+    length = payload_length - 4;
+    if (((uint32_t)offset + length) > pal_sim_objects[index].max_size)
+    {
+        return PAL_SIM_ERR_OUT_OF_BOUNDS;
+    }
+    p_data = pal_sim_object_data(p_sim, index);
+    if (0x40 == param)
+    {
+        memset(p_data, 0x00, offset);
+        p_sim->object_length[index] = 0;
+    }
+    else if (offset > p_sim->object_length[index])
+    {
+        return PAL_SIM_ERR_OUT_OF_BOUNDS;
+    }
+    memcpy(p_data + offset, &p_payload[4], length);
+    if ((offset + length) > p_sim->object_length[index])
+    {
+        p_sim->object_length[index] = offset + length;
+    }
+    return 0;
+}
+
+static uint8_t pal_sim_get_random(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                  uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    uint16_t length;
+
+    if ((0x00 != param) && (0x01 != param))
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if (2 != payload_length)
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    length = pal_sim_get_uint16(p_payload);
+    if ((length < 0x08) || (length > 0x100))
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    if (0 != mbedtls_ctr_drbg_random(&p_sim->drbg, p_out, length))
+    {
+        return PAL_SIM_ERR_INTERNAL;
+    }
+    *p_out_length = length;
+    return 0;
+}
+
+static uint8_t pal_sim_calc_hash(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                 uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    uint8_t sequence;
+    uint16_t data_length;
+    const uint8_t * p_data;
+    const uint8_t * p_options;
+    uint16_t options_length;
+    const uint8_t * p_value;
+    uint16_t value_length;
+    int16_t index;
+    uint16_t offset;
+    uint16_t length = 0;
+    mbedtls_sha256_context intermediate;
+
+    if (PAL_SIM_HASH_SHA256 != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if (payload_length < 3)
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+    sequence = p_payload[0] & 0x0F;
+    data_length = pal_sim_get_uint16(&p_payload[1]);
+    if ((sequence > PAL_SIM_HASH_INTERMEDIATE) || (data_length > payload_length - 3))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    p_data = &p_payload[3];
+    p_options = &p_payload[3 + data_length];
+    options_length = payload_length - 3 - data_length;
+
+    if (PAL_SIM_HASH_TERMINATE == sequence)
+    {
+        p_sim->hash_active = FALSE;
+        *p_out_length = 0;
+        return 0;
+    }
+    // Hash of the content of a data object
+    if (PAL_SIM_HASH_DATA_OID == (p_payload[0] >> 4))
+    {
+        if (6 != data_length)
+        {
+            return PAL_SIM_ERR_INVALID_LENGTH;
+        }
+        index = pal_sim_object_index(pal_sim_get_uint16(p_data));
+        if ((index < 0) || (PAL_SIM_OBJECT_DATA != pal_sim_objects[index].type))
+        {
+            return PAL_SIM_ERR_INVALID_OID;
+        }
+        if (!pal_sim_access_granted(p_sim, index, PAL_SIM_TAG_READ))
+        {
+            return PAL_SIM_ERR_ACCESS_CONDITION;
+        }
+        offset = pal_sim_get_uint16(&p_data[2]);
+        data_length = pal_sim_get_uint16(&p_data[4]);
+        if (((uint32_t)offset + data_length) > p_sim->object_length[index])
+        {
+            return PAL_SIM_ERR_OUT_OF_BOUNDS;
+        }
+        p_data = pal_sim_object_data(p_sim, index) + offset;
+    }
+
+    if (pal_sim_find_tag(p_options, options_length, PAL_SIM_TAG_CONTEXT, &p_value, &value_length))
+    {
+        if (PAL_SIM_HASH_CONTEXT_SIZE != value_length)
+        {
+            return PAL_SIM_ERR_INVALID_DATA;
+        }
+        pal_sim_import_hash(&p_sim->hash, p_value);
+        p_sim->hash_active = TRUE;
+    }
+    if ((PAL_SIM_HASH_START == sequence) || (PAL_SIM_HASH_START_FINAL == sequence))
+    {
+        mbedtls_sha256_init(&p_sim->hash);
+        (void)mbedtls_sha256_starts_ret(&p_sim->hash, 0);
+        p_sim->hash_active = TRUE;
+    }
+    else if (!p_sim->hash_active)
+    {
+        return PAL_SIM_ERR_SEQUENCE;
+    }
+    (void)mbedtls_sha256_update_ret(&p_sim->hash, p_data, data_length);
+
+    if ((PAL_SIM_HASH_START_FINAL == sequence) || (PAL_SIM_HASH_FINAL == sequence) ||
+        (PAL_SIM_HASH_INTERMEDIATE == sequence))
+    {
+        mbedtls_sha256_init(&intermediate);
+        mbedtls_sha256_clone(&intermediate, &p_sim->hash);
+        p_out[0] = PAL_SIM_TAG_HASH;
+        pal_sim_set_uint16(&p_out[1], PAL_SIM_HASH_SIZE);
+        (void)mbedtls_sha256_finish_ret(&intermediate, &p_out[PAL_SIM_TLV_HEADER_SIZE]);
+        mbedtls_sha256_free(&intermediate);
+        length = PAL_SIM_TLV_HEADER_SIZE + PAL_SIM_HASH_SIZE;
+        if (PAL_SIM_HASH_INTERMEDIATE != sequence)
+        {
+            p_sim->hash_active = FALSE;
+        }
+    }
+    if ((p_sim->hash_active) && (pal_sim_find_tag(p_options, options_length, PAL_SIM_TAG_EXPORT, &p_value,
+                                                  &value_length)))
+    {
+        p_out[length] = PAL_SIM_TAG_CONTEXT;
+        pal_sim_set_uint16(&p_out[length + 1], PAL_SIM_HASH_CONTEXT_SIZE);
+        pal_sim_export_hash(&p_sim->hash, &p_out[length + PAL_SIM_TLV_HEADER_SIZE]);
+        length += PAL_SIM_TLV_HEADER_SIZE + PAL_SIM_HASH_CONTEXT_SIZE;
+    }
+    *p_out_length = length;
+    return 0;
+}
+
+static uint8_t pal_sim_calc_sign(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                 uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    const uint8_t * p_digest;
+    uint16_t digest_length;
+    const uint8_t * p_oid;
+    uint16_t oid_length;
+    mbedtls_ecp_keypair key;
+    mbedtls_mpi r;
+    mbedtls_mpi s;
+    uint8_t status;
+
+    if (PAL_SIM_SIGN_SCHEME_ECDSA != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((!pal_sim_find_tag(p_payload, payload_length, 0x01, &p_digest, &digest_length)) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x03, &p_oid, &oid_length)) || (2 != oid_length) ||
+        (0 == digest_length) || (digest_length > 64))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+
+    mbedtls_ecp_keypair_init(&key);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    do
+    {
+        status = pal_sim_load_private_key(p_sim, pal_sim_get_uint16(p_oid), &key);
+        if (0 != status)
+        {
+            break;
+        }
+        if (0 != mbedtls_ecdsa_sign(&key.grp, &r, &s, &key.d, p_digest, digest_length, mbedtls_ctr_drbg_random,
+                                    &p_sim->drbg))
+        {
+            status = PAL_SIM_ERR_INTERNAL;
+            break;
+        }
+        *p_out_length = pal_sim_write_integer(&r, p_out);
+        *p_out_length += pal_sim_write_integer(&s, p_out + *p_out_length);
+    } while (FALSE);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_keypair_free(&key);
+    return status;
+}
+
+// Public key of a certificate stored in a data object, either DER or wrapped in the TLS identity format
+static uint8_t pal_sim_certificate_key(pal_sim_t * p_sim, uint16_t oid, mbedtls_ecp_keypair * p_key)
+{
+    int16_t index = pal_sim_object_index(oid);
+    const uint8_t * p_data;
+    uint16_t length;
+    mbedtls_x509_crt certificate;
+    uint8_t status = 0;
+
+    if ((index < 0) || (PAL_SIM_OBJECT_DATA != pal_sim_objects[index].type))
+    {
+        return PAL_SIM_ERR_INVALID_OID;
+    }
+    p_data = pal_sim_object_data(p_sim, index);
+    length = p_sim->object_length[index];
+    if ((length > 9) && (0xC0 == p_data[0]))
+    {
+        // Tag, length, length of the chain and length of the first certificate
+        p_data += 9;
+        length -= 9;
+    }
+
+    mbedtls_x509_crt_init(&certificate);
+    do
+    {
+        if ((0 != mbedtls_x509_crt_parse_der(&certificate, p_data, length)) ||
+            (!mbedtls_pk_can_do(&certificate.pk, MBEDTLS_PK_ECKEY)))
+        {
+            status = PAL_SIM_ERR_INVALID_DATA;
+            break;
+        }
+        if ((0 != mbedtls_ecp_group_copy(&p_key->grp, &mbedtls_pk_ec(certificate.pk)->grp)) ||
+            (0 != mbedtls_ecp_copy(&p_key->Q, &mbedtls_pk_ec(certificate.pk)->Q)))
+        {
+            status = PAL_SIM_ERR_INTERNAL;
+        }
+    } while (FALSE);
+    mbedtls_x509_crt_free(&certificate);
+    return status;
+}
+
+static uint8_t pal_sim_verify_sign(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                   uint16_t payload_length)
+{
+    const uint8_t * p_digest;
+    uint16_t digest_length;
+    const uint8_t * p_signature;
+    uint16_t signature_length;
+    const uint8_t * p_value;
+    uint16_t value_length;
+    const uint8_t * p_algorithm;
+    uint16_t algorithm_length;
+    unsigned char * p_position;
+    mbedtls_ecp_keypair key;
+    mbedtls_mpi r;
+    mbedtls_mpi s;
+    uint8_t status = 0;
+
+    if (PAL_SIM_SIGN_SCHEME_ECDSA != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((!pal_sim_find_tag(p_payload, payload_length, 0x01, &p_digest, &digest_length)) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x02, &p_signature, &signature_length)))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+
+    mbedtls_ecp_keypair_init(&key);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+    do
+    {
+        if (pal_sim_find_tag(p_payload, payload_length, 0x04, &p_value, &value_length))
+        {
+            status = (2 == value_length) ? pal_sim_certificate_key(p_sim, pal_sim_get_uint16(p_value), &key) :
+                                           PAL_SIM_ERR_INVALID_DATA;
+        }
+        else if ((pal_sim_find_tag(p_payload, payload_length, 0x05, &p_algorithm, &algorithm_length)) &&
+                 (1 == algorithm_length) &&
+                 (pal_sim_find_tag(p_payload, payload_length, 0x06, &p_value, &value_length)))
+        {
+            status = pal_sim_read_public_key(p_algorithm[0], p_value, value_length, &key);
+        }
+        else
+        {
+            status = PAL_SIM_ERR_INVALID_DATA;
+        }
+        if (0 != status)
+        {
+            break;
+        }
+        // The signature is the two INTEGERs r and s without the SEQUENCE
+        //lint --e{929} suppress "mbedtls parses from a non const pointer"
+        p_position = (unsigned char *)p_signature;
+        if ((0 != mbedtls_asn1_get_mpi(&p_position, p_signature + signature_length, &r)) ||
+            (0 != mbedtls_asn1_get_mpi(&p_position, p_signature + signature_length, &s)) ||
+            (p_position != p_signature + signature_length))
+        {
+            status = PAL_SIM_ERR_INVALID_DATA;
+            break;
+        }
+        if (0 != mbedtls_ecdsa_verify(&key.grp, p_digest, digest_length, &key.Q, &r, &s))
+        {
+            status = PAL_SIM_ERR_SIGNATURE;
+        }
+    } while (FALSE);
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_keypair_free(&key);
+    return status;
+}
+
+static uint8_t pal_sim_generate_key_pair(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                         uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    const uint8_t * p_oid;
+    uint16_t oid_length;
+    const uint8_t * p_usage;
+    uint16_t usage_length;
+    int16_t index = -1;
+    uint16_t key_size;
+    mbedtls_ecp_group_id curve = pal_sim_curve(param, &key_size);
+    mbedtls_ecp_keypair key;
+    uint8_t * p_data;
+    uint16_t length = 0;
+    uint8_t status = 0;
+
+    if (MBEDTLS_ECP_DP_NONE == curve)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if (pal_sim_find_tag(p_payload, payload_length, 0x01, &p_oid, &oid_length))
+    {
+        if ((2 != oid_length) || (!pal_sim_find_tag(p_payload, payload_length, 0x02, &p_usage, &usage_length)) ||
+            (1 != usage_length))
+        {
+            return PAL_SIM_ERR_INVALID_DATA;
+        }
+        index = pal_sim_object_index(pal_sim_get_uint16(p_oid));
+        if ((index < 0) || ((PAL_SIM_OBJECT_KEY != pal_sim_objects[index].type) &&
+                            (PAL_SIM_OBJECT_SESSION != pal_sim_objects[index].type)))
+        {
+            return PAL_SIM_ERR_INVALID_OID;
+        }
+        if (!pal_sim_access_granted(p_sim, index, PAL_SIM_TAG_CHANGE))
+        {
+            return PAL_SIM_ERR_ACCESS_CONDITION;
+        }
+    }
+    else if (!pal_sim_find_tag(p_payload, payload_length, PAL_SIM_TAG_EXPORT, &p_oid, &oid_length))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+
+    mbedtls_ecp_keypair_init(&key);
+    do
+    {
+        if ((0 != mbedtls_ecp_group_load(&key.grp, curve)) ||
+            (0 != mbedtls_ecp_gen_keypair(&key.grp, &key.d, &key.Q, mbedtls_ctr_drbg_random, &p_sim->drbg)))
+        {
+            status = PAL_SIM_ERR_INTERNAL;
+            break;
+        }
+        if (index >= 0)
+        {
+            p_data = pal_sim_object_data(p_sim, index);
+            p_data[0] = param;
+            p_data[1] = p_usage[0];
+            (void)mbedtls_mpi_write_binary(&key.d, &p_data[PAL_SIM_KEY_HEADER_SIZE], key_size);
+            p_sim->object_length[index] = PAL_SIM_KEY_HEADER_SIZE + key_size;
+        }
+        else
+        {
+            // Private key as OCTET STRING
+            p_out[0] = 0x01;
+            pal_sim_set_uint16(&p_out[1], key_size + 2);
+            p_out[PAL_SIM_TLV_HEADER_SIZE] = MBEDTLS_ASN1_OCTET_STRING;
+            p_out[PAL_SIM_TLV_HEADER_SIZE + 1] = (uint8_t)key_size;
+            (void)mbedtls_mpi_write_binary(&key.d, &p_out[PAL_SIM_TLV_HEADER_SIZE + 2], key_size);
+            length = PAL_SIM_TLV_HEADER_SIZE + 2 + key_size;
+        }
+        length += pal_sim_write_public_key(0x02, &key, &p_out[length]);
+        *p_out_length = length;
+    } while (FALSE);
+    mbedtls_ecp_keypair_free(&key);
+    return status;
+}
+
+static uint8_t pal_sim_calc_shared_secret(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                          uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    const uint8_t * p_oid;
+    uint16_t oid_length;
+    const uint8_t * p_algorithm;
+    uint16_t algorithm_length;
+    const uint8_t * p_public_key;
+    uint16_t public_key_length;
+    const uint8_t * p_target;
+    uint16_t target_length;
+    int16_t index = -1;
+    mbedtls_ecp_keypair private_key;
+    mbedtls_ecp_keypair public_key;
+    mbedtls_mpi secret;
+    uint8_t * p_secret = p_out;
+    uint16_t secret_length;
+    uint8_t status;
+
+    if (PAL_SIM_KEY_AGREEMENT_ECDH != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((!pal_sim_find_tag(p_payload, payload_length, 0x01, &p_oid, &oid_length)) || (2 != oid_length) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x05, &p_algorithm, &algorithm_length)) ||
+        (1 != algorithm_length) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x06, &p_public_key, &public_key_length)))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    if (pal_sim_find_tag(p_payload, payload_length, 0x08, &p_target, &target_length))
+    {
+        index = (2 == target_length) ? pal_sim_object_index(pal_sim_get_uint16(p_target)) : -1;
+        if ((index < 0) || (PAL_SIM_OBJECT_SESSION != pal_sim_objects[index].type))
+        {
+            return PAL_SIM_ERR_INVALID_OID;
+        }
+        p_secret = pal_sim_object_data(p_sim, index) + PAL_SIM_KEY_HEADER_SIZE;
+    }
+    else if (!pal_sim_find_tag(p_payload, payload_length, PAL_SIM_TAG_EXPORT, &p_target, &target_length))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+
+    mbedtls_ecp_keypair_init(&private_key);
+    mbedtls_ecp_keypair_init(&public_key);
+    mbedtls_mpi_init(&secret);
+    do
+    {
+        status = pal_sim_load_private_key(p_sim, pal_sim_get_uint16(p_oid), &private_key);
+        if (0 != status)
+        {
+            break;
+        }
+        status = pal_sim_read_public_key(p_algorithm[0], p_public_key, public_key_length, &public_key);
+        if (0 != status)
+        {
+            break;
+        }
+        if (private_key.grp.id != public_key.grp.id)
+        {
+            status = PAL_SIM_ERR_INVALID_DATA;
+            break;
+        }
+        if (0 != mbedtls_ecdh_compute_shared(&private_key.grp, &secret, &public_key.Q, &private_key.d,
+                                             mbedtls_ctr_drbg_random, &p_sim->drbg))
+        {
+            status = PAL_SIM_ERR_INTERNAL;
+            break;
+        }
+        secret_length = (uint16_t)((private_key.grp.pbits + 7) / 8);
+        (void)mbedtls_mpi_write_binary(&secret, p_secret, secret_length);
+        if (index >= 0)
+        {
+            p_secret[-2] = PAL_SIM_SESSION_SECRET;
+            p_secret[-1] = 0x00;
+            p_sim->object_length[index] = PAL_SIM_KEY_HEADER_SIZE + secret_length;
+        }
+        else
+        {
+            *p_out_length = secret_length;
+        }
+    } while (FALSE);
+    mbedtls_mpi_free(&secret);
+    mbedtls_ecp_keypair_free(&public_key);
+    mbedtls_ecp_keypair_free(&private_key);
+    return status;
+}
+
+static uint8_t pal_sim_derive_key(pal_sim_t * p_sim, uint8_t param, const uint8_t * p_payload,
+                                  uint16_t payload_length, uint8_t * p_out, uint16_t * p_out_length)
+{
+    const uint8_t * p_oid;
+    uint16_t oid_length;
+    const uint8_t * p_seed;
+    uint16_t seed_length;
+    const uint8_t * p_value;
+    uint16_t value_length;
+    int16_t index;
+    int16_t target = -1;
+    const uint8_t * p_secret;
+    uint16_t secret_length;
+    uint16_t length;
+    uint8_t * p_key = p_out;
+    uint8_t status;
+
+    if (PAL_SIM_DERIVATION_TLS_PRF_SHA256 != param)
+    {
+        return PAL_SIM_ERR_INVALID_PARAM;
+    }
+    if ((!pal_sim_find_tag(p_payload, payload_length, 0x01, &p_oid, &oid_length)) || (2 != oid_length) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x02, &p_seed, &seed_length)) ||
+        (!pal_sim_find_tag(p_payload, payload_length, 0x03, &p_value, &value_length)) || (2 != value_length))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    length = pal_sim_get_uint16(p_value);
+
+    // The secret is a shared secret in a session context or the content of a data object
+    index = pal_sim_object_index(pal_sim_get_uint16(p_oid));
+    if ((index < 0) || (PAL_SIM_OBJECT_KEY == pal_sim_objects[index].type) ||
+        (PAL_SIM_OBJECT_LAST_ERROR == pal_sim_objects[index].type))
+    {
+        return PAL_SIM_ERR_INVALID_OID;
+    }
+    p_secret = pal_sim_object_data(p_sim, index);
+    secret_length = p_sim->object_length[index];
+    if (PAL_SIM_OBJECT_SESSION == pal_sim_objects[index].type)
+    {
+        if ((secret_length <= PAL_SIM_KEY_HEADER_SIZE) || (PAL_SIM_SESSION_SECRET != p_secret[0]))
+        {
+            return PAL_SIM_ERR_INVALID_DATA;
+        }
+        p_secret += PAL_SIM_KEY_HEADER_SIZE;
+        secret_length -= PAL_SIM_KEY_HEADER_SIZE;
+    }
+    else if (0 == secret_length)
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+
+    if (pal_sim_find_tag(p_payload, payload_length, 0x08, &p_value, &value_length))
+    {
+        target = (2 == value_length) ? pal_sim_object_index(pal_sim_get_uint16(p_value)) : -1;
+        if ((target < 0) || (PAL_SIM_OBJECT_SESSION != pal_sim_objects[target].type))
+        {
+            return PAL_SIM_ERR_INVALID_OID;
+        }
+        if (length > pal_sim_objects[target].max_size - PAL_SIM_KEY_HEADER_SIZE)
+        {
+            return PAL_SIM_ERR_INVALID_LENGTH;
+        }
+        p_key = pal_sim_object_data(p_sim, target) + PAL_SIM_KEY_HEADER_SIZE;
+    }
+    else if (!pal_sim_find_tag(p_payload, payload_length, PAL_SIM_TAG_EXPORT, &p_value, &value_length))
+    {
+        return PAL_SIM_ERR_INVALID_DATA;
+    }
+    if ((0 == length) || (length > PAL_SIM_MAX_RESPONSE))
+    {
+        return PAL_SIM_ERR_INVALID_LENGTH;
+    }
+
+    // The target may be the session holding the secret, the key is derived into the response buffer first
+    status = pal_sim_tls_prf(p_secret, secret_length, p_seed, seed_length, p_out, length);
+    if (0 != status)
+    {
+        return status;
+    }
+    if (target >= 0)
+    {
+        memmove(p_key, p_out, length);
+        p_key[-2] = PAL_SIM_SESSION_SECRET;
+        p_key[-1] = 0x00;
+        p_sim->object_length[target] = PAL_SIM_KEY_HEADER_SIZE + length;
+    }
+    else
+    {
+        *p_out_length = length;
+    }
+    return 0;
+}
+
+// Writes the self-signed device certificate of p_key to 0xE0E0
+static void pal_sim_write_device_certificate(pal_sim_t * p_sim, mbedtls_pk_context * p_key)
+{
+    int16_t index = pal_sim_object_index(0xE0E0);
+    uint8_t * p_data = pal_sim_object_data(p_sim, index);
+    uint16_t size = pal_sim_objects[index].max_size - PAL_SIM_CERT_HEADER_SIZE;
+    mbedtls_x509write_cert certificate;
+    mbedtls_mpi serial;
+    int length = -1;
+
+    mbedtls_x509write_crt_init(&certificate);
+    mbedtls_mpi_init(&serial);
+    mbedtls_x509write_crt_set_subject_key(&certificate, p_key);
+    mbedtls_x509write_crt_set_issuer_key(&certificate, p_key);
+    mbedtls_x509write_crt_set_md_alg(&certificate, MBEDTLS_MD_SHA256);
+    // The serial number is taken from the coprocessor UID, X.509 allows at most 20 bytes
+    if ((0 == mbedtls_mpi_read_binary(&serial, pal_sim_object_data(p_sim, pal_sim_object_index(0xE0C2)) + 11, 16)) &&
+        (0 == mbedtls_x509write_crt_set_serial(&certificate, &serial)) &&
+        (0 == mbedtls_x509write_crt_set_subject_name(&certificate, PAL_SIM_CERT_NAME)) &&
+        (0 == mbedtls_x509write_crt_set_issuer_name(&certificate, PAL_SIM_CERT_NAME)) &&
+        (0 == mbedtls_x509write_crt_set_validity(&certificate, "20180101000000", "20491231235959")))
+    {
+        // The DER is written at the end of the buffer
+        length = mbedtls_x509write_crt_der(&certificate, &p_data[PAL_SIM_CERT_HEADER_SIZE], size,
+                                           mbedtls_ctr_drbg_random, &p_sim->drbg);
+    }
+    if (length > 0)
+    {
+        memmove(&p_data[PAL_SIM_CERT_HEADER_SIZE], &p_data[PAL_SIM_CERT_HEADER_SIZE + size - length], length);
+        p_data[0] = PAL_SIM_TAG_TLS_IDENTITY;
+        pal_sim_set_uint16(&p_data[1], (uint16_t)(length + 6));
+        p_data[3] = 0x00;
+        pal_sim_set_uint16(&p_data[4], (uint16_t)(length + 3));
+        p_data[6] = 0x00;
+        pal_sim_set_uint16(&p_data[7], (uint16_t)length);
+        p_sim->object_length[index] = (uint16_t)(length + PAL_SIM_CERT_HEADER_SIZE);
+    }
+    mbedtls_mpi_free(&serial);
+    mbedtls_x509write_crt_free(&certificate);
+}
+
+/**********************************************************************************************************************
+ * API IMPLEMENTATION
+ *********************************************************************************************************************/
+
+void pal_sim_set_latency(pal_sim_t * p_sim, uint8_t command, uint32_t latency_us)
+{
+    (void)pal_sim_init(p_sim);
+    p_sim->latency_us[command & (PAL_SIM_COMMAND_COUNT - 1)] = latency_us;
+}
+
+void pal_sim_apdu_init(pal_sim_t * p_sim)
+{
+    static const char personalization[] = "pal_sim";
+    uint8_t index;
+    uint8_t * p_data;
+    mbedtls_pk_context key;
+    mbedtls_ecp_keypair * p_keypair;
+
+    for (index = 0; index < sizeof(pal_sim_default_latency) / sizeof(pal_sim_default_latency[0]); index++)
+    {
+        p_sim->latency_us[pal_sim_default_latency[index].command] = pal_sim_default_latency[index].latency_us;
+    }
+
+    mbedtls_ctr_drbg_init(&p_sim->drbg);
+    (void)mbedtls_ctr_drbg_seed(&p_sim->drbg, pal_sim_entropy, p_sim, (const unsigned char *)personalization,
+                                sizeof(personalization) - 1);
+    mbedtls_sha256_init(&p_sim->hash);
+
+    memset(p_sim->object_length, 0x00, sizeof(p_sim->object_length));
+    memset(p_sim->metadata_length, 0x00, sizeof(p_sim->metadata_length));
+    // Global life cycle status, security status, coprocessor UID, sleep delay, current limit, security event
+    // counter and the maximum command size
+    p_data = pal_sim_object_data(p_sim, pal_sim_object_index(0xE0C0));
+    p_data[0] = PAL_SIM_LCS_OPERATIONAL;
+    p_data[1] = 0x00;
+    (void)mbedtls_ctr_drbg_random(&p_sim->drbg, &p_data[2], 27);
+    p_data[29] = 0x14;
+    p_data[30] = 0x06;
+    p_data[31] = 0x00;
+    pal_sim_set_uint16(&p_data[32], PAL_SIM_MAX_COMMS_BUFFER);
+    for (index = 0; index < 7; index++)
+    {
+        p_sim->object_length[index] = pal_sim_objects[index].max_size;
+    }
+    // Application life cycle status and security status
+    p_data = pal_sim_object_data(p_sim, pal_sim_object_index(0xF1C0));
+    p_data[0] = PAL_SIM_LCS_OPERATIONAL;
+    p_data[1] = 0x00;
+    p_sim->object_length[pal_sim_object_index(0xF1C0)] = 1;
+    p_sim->object_length[pal_sim_object_index(0xF1C1)] = 1;
+
+    // Device private key and its certificate
+    mbedtls_pk_init(&key);
+    if (0 == mbedtls_pk_setup(&key, mbedtls_pk_info_from_type(MBEDTLS_PK_ECKEY)))
+    {
+        p_keypair = mbedtls_pk_ec(key);
+        if ((0 == mbedtls_ecp_group_load(&p_keypair->grp, MBEDTLS_ECP_DP_SECP256R1)) &&
+            (0 == mbedtls_ecp_gen_keypair(&p_keypair->grp, &p_keypair->d, &p_keypair->Q, mbedtls_ctr_drbg_random,
+                                          &p_sim->drbg)))
+        {
+            index = (uint8_t)pal_sim_object_index(0xE0F0);
+            p_data = pal_sim_object_data(p_sim, index);
+            p_data[0] = PAL_SIM_ALG_NIST_P256;
+            p_data[1] = PAL_SIM_KEY_USAGE_AUTH_SIGN;
+            (void)mbedtls_mpi_write_binary(&p_keypair->d, &p_data[PAL_SIM_KEY_HEADER_SIZE], 32);
+            p_sim->object_length[index] = PAL_SIM_KEY_HEADER_SIZE + 32;
+            pal_sim_write_device_certificate(p_sim, &key);
+        }
+    }
+    mbedtls_pk_free(&key);
+}
+
+void pal_sim_apdu_reset(pal_sim_t * p_sim)
+{
+    int16_t index;
+
+    p_sim->app_open = FALSE;
+    p_sim->last_error = 0;
+    p_sim->hash_active = FALSE;
+    // Session contexts are volatile
+    for (index = 0; index < PAL_SIM_OBJECT_COUNT; index++)
+    {
+        if (PAL_SIM_OBJECT_SESSION == pal_sim_objects[index].type)
+        {
+            p_sim->object_length[index] = 0;
+            p_sim->metadata_length[index] = 0;
+        }
+    }
+}
+
+uint32_t pal_sim_apdu_execute(pal_sim_t * p_sim, const uint8_t * p_command, uint16_t command_length)
+{
+    uint8_t command = 0;
+    uint8_t param;
+    const uint8_t * p_payload = &p_command[PAL_SIM_APDU_HEADER_SIZE];
+    uint16_t payload_length;
+    uint8_t * p_out = &p_sim->tx_packet[PAL_SIM_APDU_HEADER_SIZE];
+    uint16_t out_length = 0;
+    uint8_t status;
+
+    do
+    {
+        if ((command_length < PAL_SIM_APDU_HEADER_SIZE) ||
+            (command_length != PAL_SIM_APDU_HEADER_SIZE + pal_sim_get_uint16(&p_command[2])))
+        {
+            status = PAL_SIM_ERR_INVALID_LENGTH;
+            break;
+        }
+        command = p_command[0] & (PAL_SIM_COMMAND_COUNT - 1);
+        param = p_command[1];
+        payload_length = command_length - PAL_SIM_APDU_HEADER_SIZE;
+        if (p_command[0] & PAL_SIM_CMD_FLUSH_ERROR)
+        {
+            p_sim->last_error = 0;
+        }
+        p_sim->stats.commands[command]++;
+
+        if ((!p_sim->app_open) && (PAL_SIM_CMD_OPEN_APP != command))
+        {
+            status = PAL_SIM_ERR_SEQUENCE;
+            break;
+        }
+        switch (command)
+        {
+            case PAL_SIM_CMD_OPEN_APP:
+                status = pal_sim_open_application(p_sim, param, p_payload, payload_length);
+                break;
+            case PAL_SIM_CMD_GETDATA:
+                status = pal_sim_get_data(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_SETDATA:
+                status = pal_sim_set_data(p_sim, param, p_payload, payload_length);
+                break;
+            case PAL_SIM_CMD_GET_RND:
+                status = pal_sim_get_random(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_CALCHASH:
+                status = pal_sim_calc_hash(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_CALC_SIGN:
+                status = pal_sim_calc_sign(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_VERIFYSIGN:
+                status = pal_sim_verify_sign(p_sim, param, p_payload, payload_length);
+                break;
+            case PAL_SIM_CMD_GENERATE_KEY_PAIR:
+                status = pal_sim_generate_key_pair(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_CALC_SHARED_SEC:
+                status = pal_sim_calc_shared_secret(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            case PAL_SIM_CMD_DERIVE_KEY:
+                status = pal_sim_derive_key(p_sim, param, p_payload, payload_length, p_out, &out_length);
+                break;
+            default:
+                status = PAL_SIM_ERR_INVALID_COMMAND;
+                break;
+        }
+    } while (FALSE);
+
+    if (0 != status)
+    {
+        p_sim->last_error = status;
+        p_sim->stats.command_errors++;
+        out_length = 0;
+    }
+    p_sim->tx_packet[0] = (0 != status) ? PAL_SIM_APDU_FAILURE : 0x00;
+    p_sim->tx_packet[1] = 0x00;
+    pal_sim_set_uint16(&p_sim->tx_packet[2], out_length);
+    p_sim->tx_packet_len = PAL_SIM_APDU_HEADER_SIZE + out_length;
+    return p_sim->latency_us[command];
+}
+
+/**
+* @}
+*/
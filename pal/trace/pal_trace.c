@@ -0,0 +1,914 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_trace.c
+*
+* \brief   This file implements the record and replay PAL shim.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "optiga/pal/pal_i2c.h"
+#include "optiga/pal/pal_gpio.h"
+#include "optiga/pal/pal_os_event.h"
+#include "optiga/pal/pal_os_timer.h"
+
+#include "pal_trace.h"
+
+#define ERR(...)  fprintf(stderr, __VA_ARGS__)
+#define LOG_PREFIX "[IFX-PAL-TRACE] "
+
+/// Initial size of the recording buffer, doubled whenever it is full
+#define PAL_TRACE_BUFFER_SIZE       (0x10000)
+/// Completion event of a replayed request which has none in the trace
+#define PAL_TRACE_NO_EVENT          (0xFFFFFFFF)
+
+#define PAL_TRACE_MODE_OFF          (0x00)
+#define PAL_TRACE_MODE_RECORD       (0x01)
+#define PAL_TRACE_MODE_REPLAY       (0x02)
+
+/// @cond hidden
+/// Functions of the PAL, called through the --wrap option of the linker
+pal_status_t __real_pal_i2c_init(const pal_i2c_t* p_i2c_context);
+pal_status_t __real_pal_i2c_deinit(const pal_i2c_t* p_i2c_context);
+pal_status_t __real_pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context, uint16_t bitrate);
+pal_status_t __real_pal_i2c_write(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length);
+pal_status_t __real_pal_i2c_read(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length);
+#ifdef PAL_I2C_HAS_WRITE_READ
+pal_status_t __real_pal_i2c_write_read(pal_i2c_t* p_i2c_context, uint8_t* p_tx_data, uint16_t tx_length,
+                                       uint8_t* p_rx_data, uint16_t rx_length);
+#endif
+void __real_pal_gpio_set_high(const pal_gpio_t* p_gpio_context);
+void __real_pal_gpio_set_low(const pal_gpio_t* p_gpio_context);
+void __real_pal_os_event_register_callback_oneshot(register_callback callback, void* callback_args, uint32_t time_us);
+void __real_pal_os_timer_delay_in_milliseconds(uint16_t milliseconds);
+
+/** \brief Request of the stack outstanding on a bus during recording */
+typedef struct pal_trace_bus
+{
+    /// Handler of the stack, replaced by #pal_trace_i2c_event_handler until the request completes
+    void * upper_layer_event_handler;
+    /// Buffer of a read, NULL for a write
+    uint8_t * p_rx_data;
+    /// Length of the read
+    uint16_t rx_length;
+    /// A request is outstanding
+    uint8_t pending;
+} pal_trace_bus_t;
+
+/** \brief Record of a trace loaded for replay */
+typedef struct pal_trace_record
+{
+    /// Record type, see #PAL_TRACE_I2C_INIT
+    uint8_t type;
+    /// Bus or pin
+    uint8_t id;
+    /// Status returned by the PAL
+    uint8_t status;
+    /// Bitrate, write length, read length of a read, time of a timer or delay
+    uint32_t value;
+    /// Read length of a write-read
+    uint32_t rx_length;
+    /// Time since the start of the recording
+    uint64_t time_us;
+    /// Data written
+    const uint8_t * p_data;
+    /// Completion event of the request, #PAL_TRACE_NO_EVENT if the trace ends before
+    uint32_t event;
+    /// Data read, delivered with a successful completion event
+    const uint8_t * p_rx_data;
+} pal_trace_record_t;
+
+pal_trace_stats_t pal_trace_stats;
+
+static pthread_mutex_t pal_trace_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t pal_trace_mode = PAL_TRACE_MODE_OFF;
+
+// Buses and pins in order of their first use, the index is the id stored in the trace
+static const void * pal_trace_ids[2][PAL_TRACE_MAX_IDS];
+static pal_trace_bus_t pal_trace_buses[PAL_TRACE_MAX_IDS];
+
+// Recording
+static uint8_t * pal_trace_buffer = NULL;
+static uint32_t pal_trace_length = 0;
+static uint32_t pal_trace_size = 0;
+static uint64_t pal_trace_last_us = 0;
+static uint8_t pal_trace_overflow = FALSE;
+
+// Replay
+static uint8_t * pal_trace_file = NULL;
+static pal_trace_record_t * pal_trace_records = NULL;
+static uint32_t pal_trace_count = 0;
+static uint32_t pal_trace_next = 0;
+static uint8_t pal_trace_keep_delays = FALSE;
+
+// Id of a bus (kind 0) or pin (kind 1), assigned on first use
+static uint8_t pal_trace_get_id(uint8_t kind, const void * p_object)
+{
+    uint8_t id;
+
+    for (id = 0; id < PAL_TRACE_MAX_IDS; id++)
+    {
+        if (NULL == pal_trace_ids[kind][id])
+        {
+            pal_trace_ids[kind][id] = p_object;
+        }
+        if (p_object == pal_trace_ids[kind][id])
+        {
+            return id;
+        }
+    }
+    ERR(LOG_PREFIX "More than %d buses or pins, increase PAL_TRACE_MAX_IDS\n", PAL_TRACE_MAX_IDS);
+    return PAL_TRACE_MAX_IDS - 1;
+}
+
+/**********************************************************************************************************************
+ * RECORDING
+ *********************************************************************************************************************/
+
+static void pal_trace_put(const uint8_t * p_data, uint32_t length)
+{
+    uint8_t * p_buffer;
+
+    if (pal_trace_overflow)
+    {
+        return;
+    }
+    if ((pal_trace_length + length) > pal_trace_size)
+    {
+        p_buffer = (uint8_t *)realloc(pal_trace_buffer, (pal_trace_size * 2) + length);
+        if (NULL == p_buffer)
+        {
+            ERR(LOG_PREFIX "Out of memory, the trace is incomplete\n");
+            pal_trace_overflow = TRUE;
+            return;
+        }
+        pal_trace_buffer = p_buffer;
+        pal_trace_size = (pal_trace_size * 2) + length;
+    }
+    memcpy(&pal_trace_buffer[pal_trace_length], p_data, length);
+    pal_trace_length += length;
+}
+
+static void pal_trace_put_varint(uint64_t value)
+{
+    uint8_t bytes[10];
+    uint32_t length = 0;
+
+    do
+    {
+        bytes[length] = (uint8_t)(value & 0x7F);
+        value >>= 7;
+        if (0 != value)
+        {
+            bytes[length] |= 0x80;
+        }
+        length++;
+    } while (0 != value);
+    pal_trace_put(bytes, length);
+}
+
+// Record header, the caller holds pal_trace_lock
+static void pal_trace_put_header(uint8_t type, uint8_t id)
+{
+    uint64_t now_us = pal_os_timer_get_time_in_microseconds();
+    uint8_t header = (uint8_t)(type | (id << 4));
+
+    pal_trace_put(&header, 1);
+    pal_trace_put_varint(now_us - pal_trace_last_us);
+    pal_trace_last_us = now_us;
+    pal_trace_stats.records++;
+}
+
+static void pal_trace_put_status(pal_status_t status)
+{
+    uint8_t byte = (uint8_t)status;
+
+    pal_trace_put(&byte, 1);
+}
+
+// Completion of a recorded request, records the event and the data read and passes both on to the stack
+static void pal_trace_i2c_event_handler(void * p_upper_layer_ctx, host_lib_status_t event)
+{
+    pal_i2c_t * p_i2c_context = NULL;
+    pal_trace_bus_t * p_bus = NULL;
+    uint8_t id;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    for (id = 0; (id < PAL_TRACE_MAX_IDS) && (NULL != pal_trace_ids[0][id]); id++)
+    {
+        if ((p_upper_layer_ctx == ((const pal_i2c_t *)pal_trace_ids[0][id])->upper_layer_ctx) &&
+            (pal_trace_buses[id].pending))
+        {
+            p_i2c_context = (pal_i2c_t *)pal_trace_ids[0][id];
+            p_bus = &pal_trace_buses[id];
+            break;
+        }
+    }
+    if (NULL == p_bus)
+    {
+        pthread_mutex_unlock(&pal_trace_lock);
+        ERR(LOG_PREFIX "Completion without a request\n");
+        return;
+    }
+
+    if (PAL_TRACE_MODE_RECORD == pal_trace_mode)
+    {
+        pal_trace_put_header(PAL_TRACE_I2C_EVENT, id);
+        pal_trace_put_varint(event);
+        if ((PAL_I2C_EVENT_SUCCESS == event) && (NULL != p_bus->p_rx_data))
+        {
+            pal_trace_put(p_bus->p_rx_data, p_bus->rx_length);
+            pal_trace_stats.i2c_bytes += p_bus->rx_length;
+        }
+    }
+    // The stack may install another handler from within its handler, hence it is restored before the call
+    p_i2c_context->upper_layer_event_handler = p_bus->upper_layer_event_handler;
+    p_bus->pending = FALSE;
+    pthread_mutex_unlock(&pal_trace_lock);
+
+    if (NULL != p_i2c_context->upper_layer_event_handler)
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
+        ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))(p_upper_layer_ctx, event);
+    }
+}
+
+/**
+ * Records a request before it is passed on to the PAL. The status byte is patched by pal_trace_record_status once
+ * the PAL returns, as the completion may be recorded by pal_trace_i2c_event_handler before that.
+ * Returns the offset of the status byte.
+ */
+static uint32_t pal_trace_record_request(pal_i2c_t * p_i2c_context, uint8_t type, uint32_t value,
+                                         const uint8_t * p_tx_data, uint8_t * p_rx_data, uint16_t rx_length)
+{
+    uint8_t id;
+    uint32_t status_offset;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    id = pal_trace_get_id(0, p_i2c_context);
+    pal_trace_put_header(type, id);
+    pal_trace_put_varint(value);
+    if (NULL != p_tx_data)
+    {
+        pal_trace_put(p_tx_data, value);
+        pal_trace_stats.i2c_bytes += value;
+    }
+    if (PAL_TRACE_I2C_WRITE_READ == type)
+    {
+        pal_trace_put_varint(rx_length);
+    }
+    status_offset = pal_trace_length;
+    pal_trace_put_status(PAL_STATUS_FAILURE);
+    pal_trace_stats.i2c_requests++;
+
+    pal_trace_buses[id].p_rx_data = p_rx_data;
+    pal_trace_buses[id].rx_length = rx_length;
+    // The handler of the stack may be NULL, e.g. while the bitrate is set, the completion is recorded anyway
+    if ((void *)pal_trace_i2c_event_handler != p_i2c_context->upper_layer_event_handler)
+    {
+        pal_trace_buses[id].upper_layer_event_handler = p_i2c_context->upper_layer_event_handler;
+        p_i2c_context->upper_layer_event_handler = (void *)pal_trace_i2c_event_handler;
+    }
+    pal_trace_buses[id].pending = TRUE;
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status_offset;
+}
+
+// Stores the status returned by the PAL for a request. After a failure no completion follows.
+static pal_status_t pal_trace_record_status(pal_i2c_t * p_i2c_context, uint32_t status_offset, pal_status_t status)
+{
+    uint8_t id;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    if ((!pal_trace_overflow) && (status_offset < pal_trace_length))
+    {
+        pal_trace_buffer[status_offset] = (uint8_t)status;
+    }
+    id = pal_trace_get_id(0, p_i2c_context);
+    if ((PAL_STATUS_SUCCESS != status) && (pal_trace_buses[id].pending))
+    {
+        p_i2c_context->upper_layer_event_handler = pal_trace_buses[id].upper_layer_event_handler;
+        pal_trace_buses[id].pending = FALSE;
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status;
+}
+
+pal_status_t pal_trace_record_start(void)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        pal_trace_buffer = (uint8_t *)malloc(PAL_TRACE_BUFFER_SIZE);
+        if (NULL != pal_trace_buffer)
+        {
+            memset(pal_trace_ids, 0, sizeof(pal_trace_ids));
+            memset(pal_trace_buses, 0, sizeof(pal_trace_buses));
+            memset(&pal_trace_stats, 0, sizeof(pal_trace_stats));
+            pal_trace_size = PAL_TRACE_BUFFER_SIZE;
+            pal_trace_length = 0;
+            pal_trace_overflow = FALSE;
+            pal_trace_put((const uint8_t *)PAL_TRACE_MAGIC, 4);
+            pal_trace_buffer[pal_trace_length++] = PAL_TRACE_VERSION;
+            pal_trace_last_us = pal_os_timer_get_time_in_microseconds();
+            pal_trace_mode = PAL_TRACE_MODE_RECORD;
+            status = PAL_STATUS_SUCCESS;
+        }
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status;
+}
+
+pal_status_t pal_trace_record_stop(const char_t * p_path)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    FILE * p_file;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    do
+    {
+        if (PAL_TRACE_MODE_RECORD != pal_trace_mode)
+        {
+            break;
+        }
+        pal_trace_mode = PAL_TRACE_MODE_OFF;
+        if (pal_trace_overflow)
+        {
+            break;
+        }
+        p_file = fopen(p_path, "wb");
+        if (NULL == p_file)
+        {
+            ERR(LOG_PREFIX "Cannot create %s\n", p_path);
+            break;
+        }
+        if ((pal_trace_length == fwrite(pal_trace_buffer, 1, pal_trace_length, p_file)) && (0 == fclose(p_file)))
+        {
+            status = PAL_STATUS_SUCCESS;
+        }
+        else
+        {
+            ERR(LOG_PREFIX "Cannot write %s\n", p_path);
+        }
+    } while (FALSE);
+    free(pal_trace_buffer);
+    pal_trace_buffer = NULL;
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status;
+}
+
+/**********************************************************************************************************************
+ * REPLAY
+ *********************************************************************************************************************/
+
+static uint8_t pal_trace_get_varint(const uint8_t ** pp_data, const uint8_t * p_end, uint64_t * p_value)
+{
+    uint64_t value = 0;
+    uint8_t shift = 0;
+
+    while ((*pp_data < p_end) && (shift < 64))
+    {
+        value |= (uint64_t)(**pp_data & 0x7F) << shift;
+        shift += 7;
+        if (0 == (*(*pp_data)++ & 0x80))
+        {
+            *p_value = value;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+// Decodes the trace, links each request to its completion and drops the completions from the record list
+static pal_status_t pal_trace_parse(const uint8_t * p_data, uint32_t length)
+{
+    const uint8_t * p_end = p_data + length;
+    pal_trace_record_t * p_pending[PAL_TRACE_MAX_IDS] = {NULL};
+    pal_trace_record_t * p_record;
+    uint64_t time_us = 0;
+    uint64_t value;
+    uint64_t delta_us;
+    uint8_t header;
+
+    if ((length < 5) || (0 != memcmp(p_data, PAL_TRACE_MAGIC, 4)) || (PAL_TRACE_VERSION != p_data[4]))
+    {
+        return PAL_STATUS_FAILURE;
+    }
+    p_data += 5;
+
+    // Every record takes at least two bytes
+    pal_trace_records = (pal_trace_record_t *)calloc((length / 2) + 1, sizeof(pal_trace_record_t));
+    if (NULL == pal_trace_records)
+    {
+        return PAL_STATUS_FAILURE;
+    }
+
+    while (p_data < p_end)
+    {
+        header = *p_data++;
+        if (!pal_trace_get_varint(&p_data, p_end, &delta_us))
+        {
+            return PAL_STATUS_FAILURE;
+        }
+        time_us += delta_us;
+
+        if (PAL_TRACE_I2C_EVENT == (header & 0x0F))
+        {
+            p_record = p_pending[header >> 4];
+            if ((NULL == p_record) || !pal_trace_get_varint(&p_data, p_end, &value))
+            {
+                return PAL_STATUS_FAILURE;
+            }
+            p_record->event = (uint32_t)value;
+            p_pending[header >> 4] = NULL;
+            if ((PAL_I2C_EVENT_SUCCESS == value) && (0 != p_record->rx_length))
+            {
+                if ((uint32_t)(p_end - p_data) < p_record->rx_length)
+                {
+                    return PAL_STATUS_FAILURE;
+                }
+                p_record->p_rx_data = p_data;
+                p_data += p_record->rx_length;
+            }
+            continue;
+        }
+
+        p_record = &pal_trace_records[pal_trace_count++];
+        p_record->type = header & 0x0F;
+        p_record->id = header >> 4;
+        p_record->time_us = time_us;
+        p_record->event = PAL_TRACE_NO_EVENT;
+        switch (p_record->type)
+        {
+            case PAL_TRACE_I2C_BITRATE:
+            case PAL_TRACE_I2C_WRITE:
+            case PAL_TRACE_I2C_WRITE_READ:
+            case PAL_TRACE_I2C_READ:
+            case PAL_TRACE_TIMER:
+            case PAL_TRACE_DELAY:
+            {
+                if (!pal_trace_get_varint(&p_data, p_end, &value))
+                {
+                    return PAL_STATUS_FAILURE;
+                }
+                p_record->value = (uint32_t)value;
+                if (PAL_TRACE_I2C_READ == p_record->type)
+                {
+                    p_record->rx_length = (uint32_t)value;
+                }
+                if ((PAL_TRACE_I2C_WRITE == p_record->type) || (PAL_TRACE_I2C_WRITE_READ == p_record->type))
+                {
+                    if ((uint32_t)(p_end - p_data) < value)
+                    {
+                        return PAL_STATUS_FAILURE;
+                    }
+                    p_record->p_data = p_data;
+                    p_data += value;
+                }
+                if ((PAL_TRACE_I2C_WRITE_READ == p_record->type) &&
+                    !pal_trace_get_varint(&p_data, p_end, &value))
+                {
+                    return PAL_STATUS_FAILURE;
+                }
+                if (PAL_TRACE_I2C_WRITE_READ == p_record->type)
+                {
+                    p_record->rx_length = (uint32_t)value;
+                }
+                break;
+            }
+            case PAL_TRACE_I2C_INIT:
+            case PAL_TRACE_I2C_DEINIT:
+            case PAL_TRACE_GPIO_HIGH:
+            case PAL_TRACE_GPIO_LOW:
+            {
+                break;
+            }
+            default:
+            {
+                return PAL_STATUS_FAILURE;
+            }
+        }
+        if ((PAL_TRACE_I2C_INIT == p_record->type) || (PAL_TRACE_I2C_DEINIT == p_record->type) ||
+            (PAL_TRACE_I2C_BITRATE == p_record->type) || (PAL_TRACE_I2C_WRITE == p_record->type) ||
+            (PAL_TRACE_I2C_READ == p_record->type) || (PAL_TRACE_I2C_WRITE_READ == p_record->type))
+        {
+            if (p_data >= p_end)
+            {
+                return PAL_STATUS_FAILURE;
+            }
+            p_record->status = *p_data++;
+        }
+        if ((PAL_TRACE_I2C_BITRATE == p_record->type) || (PAL_TRACE_I2C_WRITE == p_record->type) ||
+            (PAL_TRACE_I2C_READ == p_record->type) || (PAL_TRACE_I2C_WRITE_READ == p_record->type))
+        {
+            p_pending[p_record->id] = p_record;
+        }
+    }
+    return PAL_STATUS_SUCCESS;
+}
+
+pal_status_t pal_trace_replay_start(const char_t * p_path, uint8_t keep_delays)
+{
+    pal_status_t status = PAL_STATUS_FAILURE;
+    FILE * p_file = NULL;
+    long length;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    do
+    {
+        if (PAL_TRACE_MODE_OFF != pal_trace_mode)
+        {
+            break;
+        }
+        p_file = fopen(p_path, "rb");
+        if ((NULL == p_file) || (0 != fseek(p_file, 0, SEEK_END)) || ((length = ftell(p_file)) <= 0) ||
+            (0 != fseek(p_file, 0, SEEK_SET)))
+        {
+            ERR(LOG_PREFIX "Cannot open %s\n", p_path);
+            break;
+        }
+        // The whole trace is held in memory, the replay does no file access
+        pal_trace_file = (uint8_t *)malloc((size_t)length);
+        if ((NULL == pal_trace_file) || ((size_t)length != fread(pal_trace_file, 1, (size_t)length, p_file)))
+        {
+            ERR(LOG_PREFIX "Cannot read %s\n", p_path);
+            break;
+        }
+        pal_trace_count = 0;
+        if (PAL_STATUS_SUCCESS != pal_trace_parse(pal_trace_file, (uint32_t)length))
+        {
+            ERR(LOG_PREFIX "%s is not a valid trace\n", p_path);
+            break;
+        }
+        memset(pal_trace_ids, 0, sizeof(pal_trace_ids));
+        memset(&pal_trace_stats, 0, sizeof(pal_trace_stats));
+        pal_trace_next = 0;
+        pal_trace_keep_delays = keep_delays;
+        pal_trace_mode = PAL_TRACE_MODE_REPLAY;
+        status = PAL_STATUS_SUCCESS;
+    } while (FALSE);
+    if (NULL != p_file)
+    {
+        fclose(p_file);
+    }
+    if (PAL_STATUS_SUCCESS != status)
+    {
+        free(pal_trace_records);
+        pal_trace_records = NULL;
+        free(pal_trace_file);
+        pal_trace_file = NULL;
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status;
+}
+
+uint32_t pal_trace_replay_stop(void)
+{
+    uint32_t remaining = 0;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        remaining = pal_trace_count - pal_trace_next;
+        pal_trace_mode = PAL_TRACE_MODE_OFF;
+        free(pal_trace_records);
+        pal_trace_records = NULL;
+        free(pal_trace_file);
+        pal_trace_file = NULL;
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return remaining;
+}
+
+/**
+ * Takes the next record of the trace if it matches a call of the stack, the caller holds pal_trace_lock.
+ * Timer records the stack does not ask for are skipped, they were registered by the PAL. Timers match regardless
+ * of their time.
+ * Returns NULL on a mismatch, after which the replay stays stopped.
+ */
+static const pal_trace_record_t * pal_trace_replay_next(uint8_t type, uint8_t id, const uint8_t * p_data,
+                                                        uint32_t value)
+{
+    const pal_trace_record_t * p_record;
+
+    while ((pal_trace_next < pal_trace_count) && (0 == pal_trace_stats.mismatches))
+    {
+        p_record = &pal_trace_records[pal_trace_next];
+        if ((PAL_TRACE_TIMER == p_record->type) && (PAL_TRACE_TIMER != type))
+        {
+            pal_trace_next++;
+            continue;
+        }
+        // The stack derives the timer times from the clock, so they differ between runs
+        if ((type != p_record->type) || (id != p_record->id) ||
+            ((PAL_TRACE_TIMER != type) && (value != p_record->value)) ||
+            ((NULL != p_record->p_data) && (0 != memcmp(p_data, p_record->p_data, value))))
+        {
+            break;
+        }
+        pal_trace_stats.recorded_time_us = p_record->time_us - pal_trace_records[0].time_us;
+        pal_trace_next++;
+        pal_trace_stats.records++;
+        return p_record;
+    }
+
+    if (PAL_TRACE_TIMER == type)
+    {
+        pal_trace_stats.timer_mismatches++;
+    }
+    else if (0 == pal_trace_stats.mismatches++)
+    {
+        pal_trace_stats.first_mismatch = pal_trace_next;
+        ERR(LOG_PREFIX "Call of type %d does not match record %u of the trace\n", type, (unsigned)pal_trace_next);
+    }
+    return NULL;
+}
+
+// Serves an I2C request from the trace, the completion is delivered before returning like most PALs do
+static pal_status_t pal_trace_replay_request(pal_i2c_t * p_i2c_context, uint8_t type, const uint8_t * p_tx_data,
+                                             uint32_t value, uint8_t * p_rx_data, uint16_t rx_length)
+{
+    const pal_trace_record_t * p_record;
+    pal_status_t status = PAL_STATUS_FAILURE;
+    uint32_t event = PAL_TRACE_NO_EVENT;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    p_record = pal_trace_replay_next(type, pal_trace_get_id(0, p_i2c_context), p_tx_data, value);
+    if ((NULL != p_record) && (PAL_TRACE_I2C_WRITE_READ == type) && (rx_length != p_record->rx_length))
+    {
+        pal_trace_stats.mismatches++;
+        pal_trace_stats.first_mismatch = pal_trace_next - 1;
+        p_record = NULL;
+    }
+    if (NULL != p_record)
+    {
+        status = (pal_status_t)p_record->status;
+        event = p_record->event;
+        pal_trace_stats.i2c_requests++;
+        pal_trace_stats.i2c_bytes += (NULL != p_record->p_data) ? p_record->value : 0;
+        if ((PAL_I2C_EVENT_SUCCESS == event) && (NULL != p_record->p_rx_data))
+        {
+            memcpy(p_rx_data, p_record->p_rx_data, p_record->rx_length);
+            pal_trace_stats.i2c_bytes += p_record->rx_length;
+        }
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+
+    if ((PAL_STATUS_SUCCESS == status) && (PAL_TRACE_NO_EVENT != event) &&
+        (NULL != p_i2c_context->upper_layer_event_handler))
+    {
+        //lint --e{611} suppress "void* function pointer is type casted to app_event_handler_t  type"
+        ((app_event_handler_t)(p_i2c_context->upper_layer_event_handler))(p_i2c_context->upper_layer_ctx,
+                                                                          (host_lib_status_t)event);
+    }
+    return status;
+}
+
+static pal_status_t pal_trace_replay_status(uint8_t type, const void * p_i2c_context)
+{
+    const pal_trace_record_t * p_record;
+    pal_status_t status = PAL_STATUS_FAILURE;
+
+    pthread_mutex_lock(&pal_trace_lock);
+    p_record = pal_trace_replay_next(type, pal_trace_get_id(0, p_i2c_context), NULL, 0);
+    if (NULL != p_record)
+    {
+        status = (pal_status_t)p_record->status;
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return status;
+}
+/// @endcond
+
+/**********************************************************************************************************************
+ * WRAPPED PAL FUNCTIONS
+ *********************************************************************************************************************/
+
+pal_status_t __wrap_pal_i2c_init(const pal_i2c_t* p_i2c_context)
+{
+    pal_status_t status;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_status(PAL_TRACE_I2C_INIT, p_i2c_context);
+    }
+    status = __real_pal_i2c_init(p_i2c_context);
+    if (PAL_TRACE_MODE_RECORD == pal_trace_mode)
+    {
+        pthread_mutex_lock(&pal_trace_lock);
+        pal_trace_put_header(PAL_TRACE_I2C_INIT, pal_trace_get_id(0, p_i2c_context));
+        pal_trace_put_status(status);
+        pthread_mutex_unlock(&pal_trace_lock);
+    }
+    return status;
+}
+
+pal_status_t __wrap_pal_i2c_deinit(const pal_i2c_t* p_i2c_context)
+{
+    pal_status_t status;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_status(PAL_TRACE_I2C_DEINIT, p_i2c_context);
+    }
+    status = __real_pal_i2c_deinit(p_i2c_context);
+    if (PAL_TRACE_MODE_RECORD == pal_trace_mode)
+    {
+        pthread_mutex_lock(&pal_trace_lock);
+        pal_trace_put_header(PAL_TRACE_I2C_DEINIT, pal_trace_get_id(0, p_i2c_context));
+        pal_trace_put_status(status);
+        pthread_mutex_unlock(&pal_trace_lock);
+    }
+    return status;
+}
+
+pal_status_t __wrap_pal_i2c_set_bitrate(const pal_i2c_t* p_i2c_context, uint16_t bitrate)
+{
+    uint32_t status_offset;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_request((pal_i2c_t *)p_i2c_context, PAL_TRACE_I2C_BITRATE, NULL, bitrate, NULL, 0);
+    }
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        return __real_pal_i2c_set_bitrate(p_i2c_context, bitrate);
+    }
+    status_offset = pal_trace_record_request((pal_i2c_t *)p_i2c_context, PAL_TRACE_I2C_BITRATE, bitrate,
+                                             NULL, NULL, 0);
+    return pal_trace_record_status((pal_i2c_t *)p_i2c_context, status_offset,
+                                   __real_pal_i2c_set_bitrate(p_i2c_context, bitrate));
+}
+
+pal_status_t __wrap_pal_i2c_write(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    uint32_t status_offset;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_request(p_i2c_context, PAL_TRACE_I2C_WRITE, p_data, length, NULL, 0);
+    }
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        return __real_pal_i2c_write(p_i2c_context, p_data, length);
+    }
+    status_offset = pal_trace_record_request(p_i2c_context, PAL_TRACE_I2C_WRITE, length, p_data, NULL, 0);
+    return pal_trace_record_status(p_i2c_context, status_offset, __real_pal_i2c_write(p_i2c_context, p_data, length));
+}
+
+pal_status_t __wrap_pal_i2c_read(pal_i2c_t* p_i2c_context, uint8_t* p_data, uint16_t length)
+{
+    uint32_t status_offset;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_request(p_i2c_context, PAL_TRACE_I2C_READ, NULL, length, p_data, length);
+    }
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        return __real_pal_i2c_read(p_i2c_context, p_data, length);
+    }
+    status_offset = pal_trace_record_request(p_i2c_context, PAL_TRACE_I2C_READ, length, NULL, p_data, length);
+    return pal_trace_record_status(p_i2c_context, status_offset, __real_pal_i2c_read(p_i2c_context, p_data, length));
+}
+
+#ifdef PAL_I2C_HAS_WRITE_READ
+pal_status_t __wrap_pal_i2c_write_read(pal_i2c_t* p_i2c_context, uint8_t* p_tx_data, uint16_t tx_length,
+                                       uint8_t* p_rx_data, uint16_t rx_length)
+{
+    uint32_t status_offset;
+
+    if (PAL_TRACE_MODE_REPLAY == pal_trace_mode)
+    {
+        return pal_trace_replay_request(p_i2c_context, PAL_TRACE_I2C_WRITE_READ, p_tx_data, tx_length,
+                                        p_rx_data, rx_length);
+    }
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        return __real_pal_i2c_write_read(p_i2c_context, p_tx_data, tx_length, p_rx_data, rx_length);
+    }
+    status_offset = pal_trace_record_request(p_i2c_context, PAL_TRACE_I2C_WRITE_READ, tx_length, p_tx_data,
+                                             p_rx_data, rx_length);
+    return pal_trace_record_status(p_i2c_context, status_offset,
+                                   __real_pal_i2c_write_read(p_i2c_context, p_tx_data, tx_length,
+                                                             p_rx_data, rx_length));
+}
+#endif
+
+/**
+ * Records a GPIO, timer or delay call, or matches it against the trace. Returns TRUE if the PAL is to be called,
+ * during replay with the recorded time in *p_value.
+ */
+static uint8_t pal_trace_other(uint8_t type, const void * p_gpio_context, uint32_t * p_value)
+{
+    const pal_trace_record_t * p_record;
+    uint8_t call_pal = TRUE;
+    uint8_t id = 0;
+
+    if (PAL_TRACE_MODE_OFF == pal_trace_mode)
+    {
+        return TRUE;
+    }
+    pthread_mutex_lock(&pal_trace_lock);
+    if (NULL != p_gpio_context)
+    {
+        id = pal_trace_get_id(1, p_gpio_context);
+        pal_trace_stats.gpio_calls++;
+    }
+    else
+    {
+        pal_trace_stats.timers++;
+    }
+    if (PAL_TRACE_MODE_RECORD == pal_trace_mode)
+    {
+        pal_trace_put_header(type, id);
+        if (NULL == p_gpio_context)
+        {
+            pal_trace_put_varint(*p_value);
+        }
+    }
+    else
+    {
+        p_record = pal_trace_replay_next(type, id, NULL, (NULL != p_value) ? *p_value : 0);
+        call_pal = (NULL == p_gpio_context) && pal_trace_keep_delays;
+        if ((call_pal) && (NULL != p_record))
+        {
+            *p_value = p_record->value;
+        }
+    }
+    pthread_mutex_unlock(&pal_trace_lock);
+    return call_pal;
+}
+
+void __wrap_pal_gpio_set_high(const pal_gpio_t* p_gpio_context)
+{
+    if (pal_trace_other(PAL_TRACE_GPIO_HIGH, p_gpio_context, NULL))
+    {
+        __real_pal_gpio_set_high(p_gpio_context);
+    }
+}
+
+void __wrap_pal_gpio_set_low(const pal_gpio_t* p_gpio_context)
+{
+    if (pal_trace_other(PAL_TRACE_GPIO_LOW, p_gpio_context, NULL))
+    {
+        __real_pal_gpio_set_low(p_gpio_context);
+    }
+}
+
+void __wrap_pal_os_event_register_callback_oneshot(register_callback callback, void* callback_args, uint32_t time_us)
+{
+    // In replay the callback still runs, after the recorded time or without waiting
+    if (!pal_trace_other(PAL_TRACE_TIMER, NULL, &time_us))
+    {
+        time_us = 0;
+    }
+    __real_pal_os_event_register_callback_oneshot(callback, callback_args, time_us);
+}
+
+void __wrap_pal_os_timer_delay_in_milliseconds(uint16_t milliseconds)
+{
+    uint32_t time_ms = milliseconds;
+
+    if (pal_trace_other(PAL_TRACE_DELAY, NULL, &time_ms))
+    {
+        __real_pal_os_timer_delay_in_milliseconds((uint16_t)time_ms);
+    }
+}
+
+/**
+* @}
+*/
@@ -0,0 +1,163 @@
+/**
+* \copyright
+* MIT License
+*
+* Copyright (c) 2018 Infineon Technologies AG
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE
+*
+* \endcopyright
+*
+* \author Infineon Technologies AG
+*
+* \file pal_trace.h
+*
+* \brief   This file provides the prototype declarations of the record and replay PAL shim.
+*
+* The shim sits between the ifx i2c stack and the PAL of a platform. It is linked in with the GNU linker option
+* \code
+* -Wl,--wrap=pal_i2c_init,--wrap=pal_i2c_deinit,--wrap=pal_i2c_set_bitrate,--wrap=pal_i2c_write,
+*    --wrap=pal_i2c_read,--wrap=pal_i2c_write_read,--wrap=pal_gpio_set_high,--wrap=pal_gpio_set_low,
+*    --wrap=pal_os_event_register_callback_oneshot,--wrap=pal_os_timer_delay_in_milliseconds
+* \endcode
+* which routes these calls of the stack to the shim, while the PAL itself stays unchanged.
+*
+* In record mode every call is passed on to the PAL and appended to a trace, together with the completion event
+* and the data read of each I2C request. In replay mode the calls are served from a trace instead: I2C
+* requests complete immediately with the recorded event and data, GPIO calls do nothing and the timer waits are
+* shortened to zero, so that a run measures the host side of the stack only. The PAL then provides the os event,
+* timer and lock functions only, pal_init and pal_i2c_init of the platform are not needed. The callbacks must be
+* run by the thread waiting in #pal_os_event_wait, as the simulated OPTIGA does and the Linux PAL does once the
+* application called pal_os_event_get_handle: with zero delays an event thread would run them concurrently.
+*
+* Replay is deterministic as long as the stack issues the same requests as during recording. The first request
+* which does not match the trace fails with PAL_STATUS_FAILURE and so does every later one, see
+* #pal_trace_stats_t.first_mismatch. Timer registrations are matched by position only, as the stack derives their
+* times from the clock, and a missing one is only counted: a PAL completing transfers asynchronously registers
+* timers of its own. The response pin is not traced, sessions are recorded with p_slave_irq_pin set to NULL.
+*
+* Trace format: the file header #PAL_TRACE_MAGIC followed by the version byte and the records. A record starts
+* with one byte holding the record type in the low nibble and the bus or pin in the high nibble, followed by
+* the time since the previous record in microseconds. Numbers are stored as LEB128 varints, see
+* #PAL_TRACE_I2C_INIT for the content of each record type.
+*
+* \ingroup  grPAL
+* @{
+*/
+
+#ifndef _PAL_TRACE_H_
+#define _PAL_TRACE_H_
+
+#include "optiga/pal/pal.h"
+
+/// First bytes of a trace file
+#define PAL_TRACE_MAGIC                 "OPTR"
+/// Version of the trace format
+#define PAL_TRACE_VERSION               (0x01)
+/// Number of I2C buses and GPIO pins told apart by a trace
+#define PAL_TRACE_MAX_IDS               (16)
+
+/// pal_i2c_init, followed by the status returned
+#define PAL_TRACE_I2C_INIT              (0x01)
+/// pal_i2c_deinit, followed by the status returned
+#define PAL_TRACE_I2C_DEINIT            (0x02)
+/// pal_i2c_set_bitrate, followed by the bitrate and the status returned
+#define PAL_TRACE_I2C_BITRATE           (0x03)
+/// pal_i2c_write, followed by the length, the data and the status returned
+#define PAL_TRACE_I2C_WRITE             (0x04)
+/// pal_i2c_read, followed by the length and the status returned
+#define PAL_TRACE_I2C_READ              (0x05)
+/// pal_i2c_write_read, followed by the write length, the data, the read length and the status returned
+#define PAL_TRACE_I2C_WRITE_READ        (0x06)
+/// Completion of the last request on the bus, followed by the event and after #PAL_I2C_EVENT_SUCCESS the data read
+#define PAL_TRACE_I2C_EVENT             (0x07)
+/// pal_gpio_set_high
+#define PAL_TRACE_GPIO_HIGH             (0x08)
+/// pal_gpio_set_low
+#define PAL_TRACE_GPIO_LOW              (0x09)
+/// pal_os_event_register_callback_oneshot, followed by the time in microseconds
+#define PAL_TRACE_TIMER                 (0x0A)
+/// pal_os_timer_delay_in_milliseconds, followed by the time in milliseconds
+#define PAL_TRACE_DELAY                 (0x0B)
+
+/** @brief Statistics of the shim, counted since start of recording or replay */
+typedef struct pal_trace_stats
+{
+    /// Records written, or records of the trace consumed by the replay
+    uint32_t records;
+    /// I2C requests recorded or replayed
+    uint32_t i2c_requests;
+    /// Bytes written and read by these requests
+    uint32_t i2c_bytes;
+    /// GPIO calls recorded or replayed
+    uint32_t gpio_calls;
+    /// Timer registrations and delays recorded or replayed
+    uint32_t timers;
+    /// Timer registrations which did not match the trace during replay
+    uint32_t timer_mismatches;
+    /// Requests which did not match the trace during replay, replay stops at the first one
+    uint32_t mismatches;
+    /// Index of the record expected by the first mismatching request, valid if mismatches is not 0
+    uint32_t first_mismatch;
+    /// Time the replayed records took during recording, in microseconds
+    uint64_t recorded_time_us;
+} pal_trace_stats_t;
+
+/// Statistics, may be read and cleared by the application
+extern pal_trace_stats_t pal_trace_stats;
+
+/**
+ * \brief Starts recording, the trace is kept in memory until #pal_trace_record_stop.
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Recording started
+ * \retval  #PAL_STATUS_FAILURE  Recording or replay is already running, or out of memory
+ */
+pal_status_t pal_trace_record_start(void);
+
+/**
+ * \brief Stops recording and writes the trace to p_path.
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Trace written
+ * \retval  #PAL_STATUS_FAILURE  Not recording, the trace ran out of memory or the file could not be written
+ */
+pal_status_t pal_trace_record_stop(const char_t * p_path);
+
+/**
+ * \brief Loads the trace from p_path and starts replaying it.
+ *
+ * \param[in] p_path        Trace written by #pal_trace_record_stop
+ * \param[in] keep_delays   TRUE to wait the timer and delay times as recorded, FALSE to wait zero
+ *
+ * \retval  #PAL_STATUS_SUCCESS  Replay started
+ * \retval  #PAL_STATUS_FAILURE  Recording or replay is already running, or the trace is not readable
+ */
+pal_status_t pal_trace_replay_start(const char_t * p_path, uint8_t keep_delays);
+
+/**
+ * \brief Stops replaying, calls are passed on to the PAL again.
+ *
+ * \retval  Number of records of the trace not replayed
+ */
+uint32_t pal_trace_replay_stop(void);
+
+#endif /* _PAL_TRACE_H_ */
+
+/**
+* @}
+*/
@@ -67,6 +67,33 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
     return xTaskGetTickCount();
 }
 
+/**
+* Get the time of a monotonic clock in microseconds<br>
+*
+*
+* \retval  uint64_t time in microseconds
+*/
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    static TickType_t last_ticks = 0;
+    static uint64_t tick_base = 0;
+    TickType_t ticks;
+    uint64_t now_us;
+
+    // The tick count wraps, it is extended to 64 bits on each call
+    taskENTER_CRITICAL();
+    ticks = xTaskGetTickCount();
+    if (ticks < last_ticks)
+    {
+        tick_base += ((uint64_t)((TickType_t)~0U)) + 1;
+    }
+    last_ticks = ticks;
+    now_us = ((tick_base + ticks) * 1000000ULL) / configTICK_RATE_HZ;
+    taskEXIT_CRITICAL();
+
+    return now_us;
+}
+
 /**
 * Waits or delays until the given milliseconds time
 * 
@@ -78,6 +78,33 @@ uint32_t pal_os_timer_get_time_in_milliseconds(void)
     return (g_tick_count);
 }
 
+/**
+* Get the time of a monotonic clock in microseconds<br>
+*
+*
+* \retval  uint64_t time in microseconds
+*/
+uint64_t pal_os_timer_get_time_in_microseconds(void)
+{
+    static uint32_t last_ticks = 0;
+    static uint64_t tick_base = 0;
+    uint32_t ticks;
+    uint64_t now_us;
+
+    // The millisecond tick count wraps, it is extended to 64 bits on each call
+    __disable_irq();
+    ticks = g_tick_count;
+    if (ticks < last_ticks)
+    {
+        tick_base += 0x100000000ULL;
+    }
+    last_ticks = ticks;
+    now_us = (tick_base + ticks) * 1000ULL;
+    __enable_irq();
+
+    return now_us;
+}
+
 /**
 * Waits or delays until the given milliseconds time
 * 